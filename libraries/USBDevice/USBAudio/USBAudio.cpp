@@ -39,6 +39,11 @@ USBAudio::USBAudio(uint32_t frequency_in, uint8_t channel_nb_in, uint32_t freque
     // stereo -> *2, mono -> *1
     PACKET_SIZE_ISO_IN = (FREQ_IN / 500) * channel_nb_in;
     PACKET_SIZE_ISO_OUT = (FREQ_OUT / 500) * channel_nb_out;
+#ifdef EPISO_FEEDBACK
+    PACKET_SIZE_ISO_IN_MAX = PACKET_SIZE_ISO_IN + 2 * channel_nb_in;
+#else
+    PACKET_SIZE_ISO_IN_MAX = PACKET_SIZE_ISO_IN;
+#endif
 
     // STEREO -> left and right
     channel_config_in = (channel_nb_in == 1) ? CHANNEL_M : CHANNEL_L + CHANNEL_R;
@@ -56,10 +61,28 @@ USBAudio::USBAudio(uint32_t frequency_in, uint8_t channel_nb_in, uint32_t freque
 
     volume = 0;
 
+    streaming = false;
+    asynchronous = false;
+    rx_fifo = NULL;
+    tx_fifo = NULL;
+    rx_packet = NULL;
+    tx_packet = NULL;
+    memset(&stats, 0, sizeof(stats));
+    feedback_nominal = (FREQ_IN << 14) / 1000;
+    feedback_level = 0;
+
     // connect the device
     USBDevice::connect();
 }
 
+USBAudio::~USBAudio() {
+    streaming = false;
+    delete rx_fifo;
+    delete tx_fifo;
+    delete[] rx_packet;
+    delete[] tx_packet;
+}
+
 bool USBAudio::read(uint8_t * buf) {
     buf_stream_in = buf;
     SOF_handler = false;
@@ -114,6 +137,118 @@ bool USBAudio::write(uint8_t * buf) {
 }
 
 
+void USBAudio::stream(bool enable) {
+    if (enable && (rx_packet == NULL)) {
+        // only allocated by the applications that stream
+        rx_fifo = new CircBuffer<uint8_t, USBAUDIO_FIFO_SIZE>();
+        tx_fifo = new CircBuffer<uint8_t, USBAUDIO_FIFO_SIZE>();
+        rx_packet = new uint8_t[PACKET_SIZE_ISO_IN_MAX];
+        tx_packet = new uint8_t[PACKET_SIZE_ISO_OUT];
+    }
+#ifdef EPISO_FEEDBACK
+    if (enable != asynchronous) {
+        // the host reads the descriptors of the asynchronous speaker stream,
+        // or of the synchronous one again, when the device reconnects
+        streaming = false;
+        USBDevice::disconnect();
+        asynchronous = enable;
+        USBDevice::connect();
+    }
+#endif
+    streaming = enable;
+}
+
+uint32_t USBAudio::readStream(uint8_t * buf, uint32_t length) {
+    uint32_t n = 0;
+
+    if (rx_fifo == NULL)
+        return 0;
+
+    while (n < length) {
+        uint32_t chunk = length - n;
+        if (chunk > USBAUDIO_FIFO_SIZE)
+            chunk = USBAUDIO_FIFO_SIZE;
+        uint32_t read = rx_fifo->dequeue(&buf[n], chunk);
+        if (!read)
+            break;
+        n += read;
+    }
+    if (n < length) {
+        __disable_irq();
+        stats.rx_underruns++;
+        __enable_irq();
+    }
+    return n;
+}
+
+uint32_t USBAudio::writeStream(const uint8_t * buf, uint32_t length) {
+    uint32_t n = 0;
+
+    if (tx_fifo == NULL)
+        return 0;
+
+    while (n < length) {
+        uint32_t chunk = length - n;
+        if (chunk > USBAUDIO_FIFO_SIZE)
+            chunk = USBAUDIO_FIFO_SIZE;
+        uint32_t queued = tx_fifo->queue(&buf[n], chunk);
+        if (!queued)
+            break;
+        n += queued;
+    }
+    return n;
+}
+
+#ifdef USBAUDIO_CMSIS_DSP
+uint32_t USBAudio::readStream(float32_t * samples, uint32_t count) {
+    q15_t block[32];
+    uint32_t n = 0;
+
+    while (n < count) {
+        uint32_t chunk = count - n;
+        if (chunk > 32)
+            chunk = 32;
+        uint32_t read = readStream((uint8_t *)block, chunk * sizeof(q15_t)) / sizeof(q15_t);
+        arm_q15_to_float(block, &samples[n], read);
+        n += read;
+        if (read < chunk)
+            break;
+    }
+    return n;
+}
+
+uint32_t USBAudio::writeStream(const float32_t * samples, uint32_t count) {
+    q15_t block[32];
+    uint32_t n = 0;
+
+    // never queue a partial sample
+    if (count > streamWriteable() / sizeof(q15_t))
+        count = streamWriteable() / sizeof(q15_t);
+
+    while (n < count) {
+        uint32_t chunk = count - n;
+        if (chunk > 32)
+            chunk = 32;
+        arm_float_to_q15((float32_t *)&samples[n], block, chunk);
+        n += writeStream((uint8_t *)block, chunk * sizeof(q15_t)) / sizeof(q15_t);
+    }
+    return n;
+}
+#endif
+
+void USBAudio::getStats(Stats * stats) {
+    __disable_irq();
+    *stats = this->stats;
+    __enable_irq();
+}
+
+void USBAudio::resetStats() {
+    __disable_irq();
+    memset(&stats, 0, sizeof(stats));
+    __enable_irq();
+}
+
+
 float USBAudio::getVolume() {
     return (mute) ? 0.0 : volume;
 }
@@ -122,7 +257,10 @@ float USBAudio::getVolume() {
 bool USBAudio::EPISO_OUT_callback() {
     uint32_t size = 0;
     interruptOUT = true;
-    if (buf_stream_in != NULL) {
+    if (streaming) {
+        readEP(EP3OUT, rx_packet, &size, PACKET_SIZE_ISO_IN_MAX);
+        streamReceive(size);
+    } else if (buf_stream_in != NULL) {
         readEP(EP3OUT, (uint8_t *)buf_stream_in, &size, PACKET_SIZE_ISO_IN);
         available = true;
         buf_stream_in = NULL;
@@ -140,10 +278,79 @@ bool USBAudio::EPISO_IN_callback() {
 
 
 
+// Called in ISR context with a packet just received in streaming mode
+void USBAudio::streamReceive(uint32_t size) {
+    stats.packets_in++;
+    if (rx_fifo->space() < size) {
+        // dropping the whole packet is heard as one glitch rather than several
+        stats.rx_overruns++;
+        return;
+    }
+    rx_fifo->queue(rx_packet, size);
+    streamRx.call();
+}
+
+// Called in ISR context on each start of frame in streaming mode
+void USBAudio::streamSend() {
+    uint32_t size = tx_fifo->dequeue(tx_packet, PACKET_SIZE_ISO_OUT);
+
+    // the host expects a packet per frame, missing samples are sent as silence
+    if (size < PACKET_SIZE_ISO_OUT) {
+        memset(&tx_packet[size], 0, PACKET_SIZE_ISO_OUT - size);
+        stats.tx_underruns++;
+    }
+    USBDevice::writeNB(EP3IN, tx_packet, PACKET_SIZE_ISO_OUT, PACKET_SIZE_ISO_OUT);
+    stats.packets_out++;
+    streamTx.call();
+}
+
+// Called in ISR context on each start of frame
+void USBAudio::sendFeedback(int frameNumber) {
+#ifdef EPISO_FEEDBACK
+    if (!asynchronous)
+        return;
+
+    feedback_level += rx_fifo->available();
+    if ((frameNumber & ((1 << USBAUDIO_FEEDBACK_REFRESH) - 1)) != 0)
+        return;
+
+    // proportional to how far the average level was from half full, at most half a sample per frame
+    int32_t level = feedback_level >> USBAUDIO_FEEDBACK_REFRESH;
+    int32_t error = (USBAUDIO_FIFO_SIZE / 2 - level) / (2 * channel_nb_in);
+    int32_t correction = error * (1 << 14) / USBAUDIO_FEEDBACK_GAIN;
+    if (correction > (1 << 13))
+        correction = 1 << 13;
+    if (correction < -(1 << 13))
+        correction = -(1 << 13);
+    uint32_t value = feedback_nominal + correction;
+    feedback_level = 0;
+    stats.feedback = value;
+
+    // 10.14 format on 3 bytes, little endian
+    feedback[0] = value & 0xff;
+    feedback[1] = (value >> 8) & 0xff;
+    feedback[2] = (value >> 16) & 0xff;
+    USBDevice::writeNB(EPISO_FEEDBACK, feedback, 3, 3);
+#endif
+}
+
 // Called in ISR context on each start of frame
 void USBAudio::SOF(int frameNumber) {
     uint32_t size = 0;
 
+    if (streaming) {
+        if (!interruptOUT) {
+            if (USBDevice::readEP_NB(EP3OUT, rx_packet, &size, PACKET_SIZE_ISO_IN_MAX) && size) {
+                streamReceive(size);
+                readStart(EP3OUT, PACKET_SIZE_ISO_IN_MAX);
+            }
+        }
+        streamSend();
+        sendFeedback(frameNumber);
+        SOF_handler = true;
+        return;
+    }
+
     if (!interruptOUT) {
         // read the isochronous endpoint
         if (buf_stream_in != NULL) {
@@ -177,11 +384,16 @@ bool USBAudio::USBCallback_setConfiguration(uint8_t configuration) {
     }
 
     // Configure isochronous endpoint
-    realiseEndpoint(EP3OUT, PACKET_SIZE_ISO_IN, ISOCHRONOUS);
+    uint32_t packet_size_out = asynchronous ? PACKET_SIZE_ISO_IN_MAX : PACKET_SIZE_ISO_IN;
+    realiseEndpoint(EP3OUT, packet_size_out, ISOCHRONOUS);
     realiseEndpoint(EP3IN, PACKET_SIZE_ISO_OUT, ISOCHRONOUS);
+#ifdef EPISO_FEEDBACK
+    if (asynchronous)
+        realiseEndpoint(EPISO_FEEDBACK, 3, ISOCHRONOUS);
+#endif
 
     // activate readings on this endpoint
-    readStart(EP3OUT, PACKET_SIZE_ISO_IN);
+    readStart(EP3OUT, packet_size_out);
     return true;
 }
 
@@ -338,6 +550,18 @@ void USBAudio::USBCallback_requestCompleted(uint8_t * buf, uint32_t length) {
 
 
 
+#ifdef EPISO_FEEDBACK
+// in streaming mode the speaker stream is asynchronous, its rate follows the
+// feedback endpoint
+#define FEEDBACK_ENDPOINTS      1
+#define EPISO_OUT_ATTRIBUTES    (E_ISOCHRONOUS | E_ASYNCHRONOUS)
+#define EPISO_OUT_SYNCH_ADDRESS PHY_TO_DESC(EPISO_FEEDBACK)
+#else
+#define FEEDBACK_ENDPOINTS      0
+#define EPISO_OUT_ATTRIBUTES    E_ISOCHRONOUS
+#define EPISO_OUT_SYNCH_ADDRESS 0x00
+#endif
+
 #define TOTAL_DESCRIPTOR_LENGTH ((1 * CONFIGURATION_DESCRIPTOR_LENGTH) \
                                + (5 * INTERFACE_DESCRIPTOR_LENGTH) \
                                + (1 * CONTROL_INTERFACE_DESCRIPTOR_LENGTH + 1) \
@@ -347,7 +571,8 @@ void USBAudio::USBCallback_requestCompleted(uint8_t * buf, uint32_t length) {
                                + (2 * STREAMING_INTERFACE_DESCRIPTOR_LENGTH) \
                                + (2 * FORMAT_TYPE_I_DESCRIPTOR_LENGTH) \
                                + (2 * (ENDPOINT_DESCRIPTOR_LENGTH + 2)) \
-                               + (2 * STREAMING_ENDPOINT_DESCRIPTOR_LENGTH) )
+                               + (2 * STREAMING_ENDPOINT_DESCRIPTOR_LENGTH) \
+                               + (FEEDBACK_ENDPOINTS * (ENDPOINT_DESCRIPTOR_LENGTH + 2)) )
 
 #define TOTAL_CONTROL_INTF_LENGTH    (CONTROL_INTERFACE_DESCRIPTOR_LENGTH + 1 + \
                                       2*INPUT_TERMINAL_DESCRIPTOR_LENGTH     + \
@@ -475,7 +700,7 @@ uint8_t * USBAudio::configurationDesc() {
         INTERFACE_DESCRIPTOR,                   // bDescriptorType
         0x01,                                   // bInterfaceNumber
         0x01,                                   // bAlternateSetting
-        0x01,                                   // bNumEndpoints
+        0x01 + FEEDBACK_ENDPOINTS,              // bNumEndpoints
         AUDIO_CLASS,                            // bInterfaceClass
         SUBCLASS_AUDIOSTREAMING,                // bInterfaceSubClass
         0x00,                                   // bInterfaceProtocol
@@ -507,12 +732,12 @@ uint8_t * USBAudio::configurationDesc() {
         ENDPOINT_DESCRIPTOR_LENGTH + 2,         // bLength
         ENDPOINT_DESCRIPTOR,                    // bDescriptorType
         PHY_TO_DESC(EPISO_OUT),                 // bEndpointAddress
-        E_ISOCHRONOUS,                          // bmAttributes
-        (uint8_t)(LSB(PACKET_SIZE_ISO_IN)),                   // wMaxPacketSize
-        (uint8_t)(MSB(PACKET_SIZE_ISO_IN)),                   // wMaxPacketSize
+        EPISO_OUT_ATTRIBUTES,                   // bmAttributes
+        (uint8_t)(LSB(PACKET_SIZE_ISO_IN_MAX)),               // wMaxPacketSize
+        (uint8_t)(MSB(PACKET_SIZE_ISO_IN_MAX)),               // wMaxPacketSize
         0x01,                                   // bInterval
         0x00,                                   // bRefresh
-        0x00,                                   // bSynchAddress
+        EPISO_OUT_SYNCH_ADDRESS,                // bSynchAddress
 
         // Endpoint - Audio Streaming
         STREAMING_ENDPOINT_DESCRIPTOR_LENGTH,   // bLength
@@ -523,6 +748,19 @@ uint8_t * USBAudio::configurationDesc() {
         LSB(0x0000),                            // wLockDelay
         MSB(0x0000),                            // wLockDelay
 
+#ifdef EPISO_FEEDBACK
+        // Endpoint - Feedback
+        ENDPOINT_DESCRIPTOR_LENGTH + 2,         // bLength
+        ENDPOINT_DESCRIPTOR,                    // bDescriptorType
+        PHY_TO_DESC(EPISO_FEEDBACK),            // bEndpointAddress
+        E_ISOCHRONOUS,                          // bmAttributes
+        LSB(3),                                 // wMaxPacketSize
+        MSB(3),                                 // wMaxPacketSize
+        0x01,                                   // bInterval
+        USBAUDIO_FEEDBACK_REFRESH,              // bRefresh
+        0x00,                                   // bSynchAddress
+#endif
+
 
 
 
@@ -596,6 +834,35 @@ uint8_t * USBAudio::configurationDesc() {
         // Terminator
         0                                       // bLength
     };
+
+#ifdef EPISO_FEEDBACK
+    if (!asynchronous) {
+        // out of streaming mode the speaker stream stays synchronous: the
+        // same descriptors without the feedback endpoint
+        static uint8_t syncDescriptor[TOTAL_DESCRIPTOR_LENGTH - (ENDPOINT_DESCRIPTOR_LENGTH + 2) + 1];
+        uint32_t length = 0;
+        for (uint32_t i = 0; i < TOTAL_DESCRIPTOR_LENGTH; i += configDescriptor[i]) {
+            uint8_t * desc = &configDescriptor[i];
+            if ((desc[1] == ENDPOINT_DESCRIPTOR) && (desc[2] == PHY_TO_DESC(EPISO_FEEDBACK)))
+                continue;
+            memcpy(&syncDescriptor[length], desc, desc[0]);
+            desc = &syncDescriptor[length];
+            length += desc[0];
+            if ((desc[1] == INTERFACE_DESCRIPTOR) && (desc[2] == 0x01) && (desc[3] == 0x01)) {
+                desc[4] = 0x01;                             // bNumEndpoints
+            } else if ((desc[1] == ENDPOINT_DESCRIPTOR) && (desc[2] == PHY_TO_DESC(EPISO_OUT))) {
+                desc[3] = E_ISOCHRONOUS;                    // bmAttributes
+                desc[4] = (uint8_t)(LSB(PACKET_SIZE_ISO_IN));   // wMaxPacketSize
+                desc[5] = (uint8_t)(MSB(PACKET_SIZE_ISO_IN));   // wMaxPacketSize
+                desc[8] = 0x00;                             // bSynchAddress
+            }
+        }
+        syncDescriptor[2] = LSB(length);                    // wTotalLength (LSB)
+        syncDescriptor[3] = MSB(length);                    // wTotalLength (MSB)
+        syncDescriptor[length] = 0;                         // Terminator
+        return syncDescriptor;
+    }
+#endif
     return configDescriptor;
 }
 
@@ -25,7 +25,27 @@
 #include "USBDevice_Types.h"
 
 #include "USBDevice.h"
+#include "CircBuffer.h"
 
+#ifdef USBAUDIO_CMSIS_DSP
+#include "arm_math.h"
+#endif
+
+// Size in bytes of each FIFO between the isochronous endpoints and the application in streaming mode,
+// allocated by the first stream(true)
+#ifndef USBAUDIO_FIFO_SIZE
+#define USBAUDIO_FIFO_SIZE 1024
+#endif
+
+// The feedback is sent every 2^USBAUDIO_FEEDBACK_REFRESH frames
+#ifndef USBAUDIO_FEEDBACK_REFRESH
+#define USBAUDIO_FEEDBACK_REFRESH 2
+#endif
+
+// Number of frames over which the feedback corrects a difference between the receive FIFO level and half full
+#ifndef USBAUDIO_FEEDBACK_GAIN
+#define USBAUDIO_FEEDBACK_GAIN 256
+#endif
 
 /**
 * USBAudio example
@@ -69,6 +89,16 @@
 class USBAudio: public USBDevice {
 public:
 
+    /** Counters of the streaming mode */
+    typedef struct {
+        uint32_t packets_in;    // packets received from the host
+        uint32_t packets_out;   // packets sent to the host
+        uint32_t rx_overruns;   // packets dropped because the receive FIFO was full
+        uint32_t rx_underruns;  // readStream() calls that found fewer bytes than asked for
+        uint32_t tx_underruns;  // packets sent with missing samples replaced by silence
+        uint32_t feedback;      // last feedback sent: samples per frame in 10.14 format
+    } Stats;
+
     /**
     * Constructor
     *
@@ -82,6 +112,11 @@ public:
     */
     USBAudio(uint32_t frequency_in = 48000, uint8_t channel_nb_in = 1, uint32_t frequency_out = 8000, uint8_t channel_nb_out = 1, uint16_t vendor_id = 0x7bb8, uint16_t product_id = 0x1111, uint16_t product_release = 0x0100);
 
+    /**
+    * Destructor
+    */
+    ~USBAudio();
+
     /**
     * Get current volume between 0.0 and 1.0
     *
@@ -124,6 +159,125 @@ public:
     */
     bool readWrite(uint8_t * buf_read, uint8_t * buf_write);
 
+    /**
+    * Switch to streaming mode: packets received are queued in a FIFO that the
+    * application empties with readStream() at its own pace, and a packet is sent
+    * from the FIFO filled with writeStream() on each frame. Where the target
+    * has an endpoint for it (EPISO_FEEDBACK), the host is told to send more or
+    * less samples to keep the receive FIFO half full, so that the host and
+    * device clocks can drift apart without glitches. The feedback endpoint
+    * is only in the descriptors while streaming, so on those targets the
+    * device reconnects to the host when the mode changes.
+    * read(), readNB(), write() and readWrite() must not be used in this mode.
+    *
+    * @param enable true to start streaming, false to go back to packet by packet transfers
+    */
+    void stream(bool enable);
+
+    /**
+    * Read samples received in streaming mode. Non blocking
+    *
+    * @param buf where the data is stored
+    * @param length number of bytes to read
+    * @returns the number of bytes read
+    */
+    uint32_t readStream(uint8_t * buf, uint32_t length);
+
+    /**
+    * Queue samples to be sent in streaming mode. Non blocking
+    *
+    * @param buf data to be sent
+    * @param length number of bytes to send
+    * @returns the number of bytes queued
+    */
+    uint32_t writeStream(const uint8_t * buf, uint32_t length);
+
+#ifdef USBAUDIO_CMSIS_DSP
+    /**
+    * Read samples received in streaming mode, converted to float
+    *
+    * @param samples where the samples are stored
+    * @param count number of samples to read
+    * @returns the number of samples read
+    */
+    uint32_t readStream(float32_t * samples, uint32_t count);
+
+    /**
+    * Queue float samples to be sent in streaming mode
+    *
+    * @param samples samples to be sent, between -1.0 and 1.0
+    * @param count number of samples to send
+    * @returns the number of samples queued
+    */
+    uint32_t writeStream(const float32_t * samples, uint32_t count);
+#endif
+
+    /**
+    * Number of bytes readStream() can read right away
+    */
+    uint32_t streamReadable() {
+        return (rx_fifo != NULL) ? rx_fifo->available() : 0;
+    }
+
+    /**
+    * Number of bytes writeStream() can queue right away
+    */
+    uint32_t streamWriteable() {
+        return (tx_fifo != NULL) ? tx_fifo->space() : 0;
+    }
+
+    /**
+    * Copy the counters of the streaming mode
+    *
+    * @param stats filled with the counters
+    */
+    void getStats(Stats * stats);
+
+    /**
+    * Clear the counters of the streaming mode
+    */
+    void resetStats();
+
+    /** Attach a function called in ISR context each time a packet has been
+     *  queued in the receive FIFO, in streaming mode
+     *
+     * @param fptr function pointer
+     */
+    void attachStreamRx(void(*fptr)(void)) {
+        streamRx.attach(fptr);
+    }
+
+    /** Attach a member function called in ISR context each time a packet has
+     *  been queued in the receive FIFO, in streaming mode
+     *
+     * @param tptr Object pointer
+     * @param mptr Member function pointer
+     */
+    template<typename T>
+    void attachStreamRx(T *tptr, void(T::*mptr)(void)) {
+        streamRx.attach(tptr, mptr);
+    }
+
+    /** Attach a function called in ISR context each time a packet has been
+     *  taken from the transmit FIFO, in streaming mode
+     *
+     * @param fptr function pointer
+     */
+    void attachStreamTx(void(*fptr)(void)) {
+        streamTx.attach(fptr);
+    }
+
+    /** Attach a member function called in ISR context each time a packet has
+     *  been taken from the transmit FIFO, in streaming mode
+     *
+     * @param tptr Object pointer
+     * @param mptr Member function pointer
+     */
+    template<typename T>
+    void attachStreamTx(T *tptr, void(T::*mptr)(void)) {
+        streamTx.attach(tptr, mptr);
+    }
+
 
     /** attach a handler to update the volume
      *
@@ -245,6 +399,12 @@ private:
     uint32_t PACKET_SIZE_ISO_IN;
     uint32_t PACKET_SIZE_ISO_OUT;
 
+    // the host may send one more sample per channel than the nominal rate when the feedback asks for it
+    uint32_t PACKET_SIZE_ISO_IN_MAX;
+
+    // the descriptors last read by the host have the feedback endpoint
+    bool asynchronous;
+
     // mono, stereo,...
     uint8_t channel_nb_in;
     uint8_t channel_nb_out;
@@ -282,6 +442,27 @@ private:
 
     volatile float volume;
 
+    // streaming mode
+    volatile bool streaming;
+    CircBuffer<uint8_t, USBAUDIO_FIFO_SIZE> * rx_fifo;
+    CircBuffer<uint8_t, USBAUDIO_FIFO_SIZE> * tx_fifo;
+    uint8_t * rx_packet;
+    uint8_t * tx_packet;
+    FunctionPointer streamRx;
+    FunctionPointer streamTx;
+    Stats stats;
+
+    // nominal samples per frame in 10.14 format
+    uint32_t feedback_nominal;
+
+    // receive FIFO level summed over the frames of a feedback period
+    uint32_t feedback_level;
+    uint8_t feedback[3];
+
+    void streamReceive(uint32_t size);
+    void streamSend();
+    void sendFeedback(int frameNumber);
+
 };
 
 #endif
@@ -93,6 +93,8 @@
 #define EPISO_IN    (EP3IN)
 #define EPISO_OUT_callback    EP3_OUT_callback
 #define EPISO_IN_callback     EP3_IN_callback
+/* Isochronous endpoint carrying the rate feedback of EPISO_OUT */
+#define EPISO_FEEDBACK  (EP6IN)
 
 #define MAX_PACKET_SIZE_EPBULK  (MAX_PACKET_SIZE_EP2)
 #define MAX_PACKET_SIZE_EPINT   (MAX_PACKET_SIZE_EP1)
@@ -55,6 +55,13 @@
 // max packet size
 #define MAX_PACKET  MAX_PACKET_SIZE_EPBULK
 
+// disk_read() and disk_write() take an 8 bit block count
+#if USBMSD_BUFFER_BLOCKS < 1 || USBMSD_BUFFER_BLOCKS > 255
+#error USBMSD_BUFFER_BLOCKS must be between 1 and 255
+#endif
+
+#define NO_BLOCK    0xFFFFFFFF
+
 // CSW Status
 enum Status {
     CSW_PASSED,
@@ -68,6 +75,16 @@ USBMSD::USBMSD(uint16_t vendor_id, uint16_t product_id, uint16_t product_release
     memset((void *)&cbw, 0, sizeof(CBW));
     memset((void *)&csw, 0, sizeof(CSW));
     page = NULL;
+    deferred = false;
+    memset((void *)buffers, 0, sizeof(buffers));
+    filling = -1;
+    generation = 0;
+    readBlock = NO_BLOCK;
+    fetchBlock = fetchEnd = 0;
+    outPaused = false;
+    inStarved = false;
+    diskError = false;
+    memset(&stats, 0, sizeof(stats));
 }
 
 USBMSD::~USBMSD() {
@@ -124,11 +141,21 @@ bool USBMSD::connect(bool blocking) {
             page = (uint8_t *)malloc(BlockSize * sizeof(uint8_t));
             if (page == NULL)
                 return false;
+            if (deferred) {
+                for (int i = 0; i < 2; i++) {
+                    free(buffers[i].data);
+                    buffers[i].data = (uint8_t *)malloc(USBMSD_BUFFER_BLOCKS * BlockSize);
+                    if (buffers[i].data == NULL)
+                        return false;
+                }
+            }
         }
     } else {
         return false;
     }
 
+    resetStats();
+
     //connect the device
     USBDevice::connect(blocking);
     return true;
@@ -139,10 +166,46 @@ void USBMSD::disconnect() {
     //De-allocate MSD page size:
     free(page);
     page = NULL;
+    for (int i = 0; i < 2; i++) {
+        free(buffers[i].data);
+        buffers[i].data = NULL;
+    }
 }
 
 void USBMSD::reset() {
     stage = READ_CBW;
+    if (deferred) {
+        // whatever process() is doing now belongs to the aborted command
+        invalidate();
+        if (filling >= 0) {
+            buffers[filling].state = BUF_FREE;
+            filling = -1;
+        }
+        for (int i = 0; i < 2; i++) {
+            if (buffers[i].state == BUF_FULL)
+                buffers[i].state = BUF_FREE;
+        }
+        if (outPaused) {
+            outPaused = false;
+            readStart(EPBULK_OUT, MAX_PACKET_SIZE_EPBULK);
+        }
+    }
+}
+
+void USBMSD::deferDiskAccess(bool defer) {
+    deferred = defer;
+}
+
+void USBMSD::getStats(Stats * s) {
+    __disable_irq();
+    *s = stats;
+    __enable_irq();
+}
+
+void USBMSD::resetStats() {
+    __disable_irq();
+    memset(&stats, 0, sizeof(stats));
+    __enable_irq();
 }
 
 
@@ -162,10 +225,16 @@ bool USBMSD::EPBULK_OUT_callback() {
             switch (cbw.CB[0]) {
                 case WRITE10:
                 case WRITE12:
-                    memoryWrite(buf, size);
+                    if (deferred)
+                        receiveData(buf, size);
+                    else
+                        memoryWrite(buf, size);
                     break;
                 case VERIFY10:
-                    memoryVerify(buf, size);
+                    if (deferred)
+                        receiveData(buf, size);
+                    else
+                        memoryVerify(buf, size);
                     break;
             }
             break;
@@ -178,13 +247,22 @@ bool USBMSD::EPBULK_OUT_callback() {
             break;
     }
 
-    //reactivate readings on the OUT bulk endpoint
-    readStart(EPBULK_OUT, MAX_PACKET_SIZE_EPBULK);
+    //reactivate readings on the OUT bulk endpoint, unless the host has to wait for a free buffer
+    if (!outPaused)
+        readStart(EPBULK_OUT, MAX_PACKET_SIZE_EPBULK);
     return true;
 }
 
 // Called in ISR context when a data has been transferred
 bool USBMSD::EPBULK_IN_callback() {
+    // the data of a sent buffer has left the endpoint
+    for (int i = 0; i < 2; i++) {
+        if (buffers[i].state == BUF_SENT) {
+            buffers[i].state = BUF_FREE;
+            pending.call();
+        }
+    }
+
     switch (stage) {
 
             // the device has to send data to the host
@@ -192,7 +270,10 @@ bool USBMSD::EPBULK_IN_callback() {
             switch (cbw.CB[0]) {
                 case READ10:
                 case READ12:
-                    memoryRead();
+                    if (deferred)
+                        sendData();
+                    else
+                        memoryRead();
                     break;
             }
             break;
@@ -226,16 +307,18 @@ void USBMSD::memoryWrite (uint8_t * buf, uint16_t size) {
     }
 
     // we fill an array in RAM of 1 block before writing it in memory
-    for (int i = 0; i < size; i++)
-        page[addr%BlockSize + i] = buf[i];
+    memcpy(&page[addr%BlockSize], buf, size);
 
     // if the array is filled, write it in memory
     if (!((addr + size)%BlockSize)) {
         if (!(disk_status() & WRITE_PROTECT)) {
             disk_write(page, addr/BlockSize, 1);
+            stats.disk_writes++;
+            stats.blocks_written++;
         }
     }
 
+    stats.bytes_written += size;
     addr += size;
     length -= size;
     csw.DataResidue -= size;
@@ -256,8 +339,11 @@ void USBMSD::memoryVerify (uint8_t * buf, uint16_t size) {
     }
 
     // beginning of a new block -> load a whole block in RAM
-    if (!(addr%BlockSize))
+    if (!(addr%BlockSize)) {
         disk_read(page, addr/BlockSize, 1);
+        stats.disk_reads++;
+        stats.blocks_read++;
+    }
 
     // info are in RAM -> no need to re-read memory
     for (n = 0; n < size; n++) {
@@ -427,8 +513,15 @@ void USBMSD::CBWDecode(uint8_t * buf, uint16_t size) {
                     case READ12:
                         if (infoTransfer()) {
                             if ((cbw.Flags & 0x80)) {
-                                stage = PROCESS_CBW;
-                                memoryRead();
+                                if (deferred) {
+                                    if (startRead()) {
+                                        stage = PROCESS_CBW;
+                                        sendData();
+                                    }
+                                } else {
+                                    stage = PROCESS_CBW;
+                                    memoryRead();
+                                }
                             } else {
                                 stallEndpoint(EPBULK_OUT);
                                 csw.Status = CSW_ERROR;
@@ -440,7 +533,8 @@ void USBMSD::CBWDecode(uint8_t * buf, uint16_t size) {
                     case WRITE12:
                         if (infoTransfer()) {
                             if (!(cbw.Flags & 0x80)) {
-                                stage = PROCESS_CBW;
+                                if (!deferred || startWrite())
+                                    stage = PROCESS_CBW;
                             } else {
                                 stallEndpoint(EPBULK_IN);
                                 csw.Status = CSW_ERROR;
@@ -456,8 +550,9 @@ void USBMSD::CBWDecode(uint8_t * buf, uint16_t size) {
                         }
                         if (infoTransfer()) {
                             if (!(cbw.Flags & 0x80)) {
-                                stage = PROCESS_CBW;
                                 memOK = true;
+                                if (!deferred || startWrite())
+                                    stage = PROCESS_CBW;
                             } else {
                                 stallEndpoint(EPBULK_IN);
                                 csw.Status = CSW_ERROR;
@@ -504,12 +599,16 @@ void USBMSD::memoryRead (void) {
     }
 
     // we read an entire block
-    if (!(addr%BlockSize))
+    if (!(addr%BlockSize)) {
         disk_read(page, addr/BlockSize, 1);
+        stats.disk_reads++;
+        stats.blocks_read++;
+    }
 
     // write data which are in RAM
     writeNB(EPBULK_IN, &page[addr%BlockSize], n, MAX_PACKET_SIZE_EPBULK);
 
+    stats.bytes_read += n;
     addr += n;
     length -= n;
 
@@ -569,6 +668,276 @@ bool USBMSD::infoTransfer (void) {
 
 
 
+// Called in ISR context. Returns the buffer in the given state holding the given block, -1 if none.
+int USBMSD::findBuffer(uint8_t state, uint32_t block) {
+    for (int i = 0; i < 2; i++) {
+        if ((buffers[i].state == state) && ((block == NO_BLOCK) || (buffers[i].block == block)))
+            return i;
+    }
+    return -1;
+}
+
+// Called in ISR context to drop the blocks read ahead
+void USBMSD::invalidate() {
+    generation++;
+    for (int i = 0; i < 2; i++) {
+        if ((buffers[i].state == BUF_DATA) || (buffers[i].state == BUF_SENT))
+            buffers[i].state = BUF_FREE;
+    }
+    readBlock = NO_BLOCK;
+    fetchBlock = fetchEnd = 0;
+    inStarved = false;
+}
+
+// Called in ISR context when a READ10/READ12 is accepted and disk accesses are deferred
+bool USBMSD::startRead() {
+    uint32_t block = addr / BlockSize;
+    uint32_t count = length / BlockSize;
+
+    if ((block >= BlockCount) || (count > BlockCount - block)) {
+        stallEndpoint(EPBULK_IN);
+        fail();
+        return false;
+    }
+
+    // a sequential read carries on with the blocks process() is already reading
+    if (block != readBlock) {
+        invalidate();
+        readBlock = fetchBlock = block;
+    } else if (findBuffer(BUF_DATA, block) >= 0) {
+        stats.read_ahead_hits++;
+    }
+
+    // read one buffer ahead of the command, for the next one
+    fetchEnd = block + count + USBMSD_BUFFER_BLOCKS;
+    if (fetchEnd > BlockCount)
+        fetchEnd = BlockCount;
+
+    diskError = false;
+    pending.call();
+    return true;
+}
+
+// Called in ISR context, or by process() with interrupts disabled when the IN endpoint is idle
+void USBMSD::sendData() {
+    int i = findBuffer(BUF_DATA, readBlock);
+    if (i < 0) {
+        // wait for process(), which restarts the transfer
+        if (!inStarved)
+            stats.stalls++;
+        inStarved = true;
+        return;
+    }
+    inStarved = false;
+
+    Buffer * b = &buffers[i];
+    uint32_t n = (length > MAX_PACKET) ? MAX_PACKET : length;
+    if (n > BlockSize - (b->pos % BlockSize))
+        n = BlockSize - (b->pos % BlockSize);
+
+    writeNB(EPBULK_IN, &b->data[b->pos], n, MAX_PACKET_SIZE_EPBULK);
+    if (b->error)
+        diskError = true;
+
+    b->pos += n;
+    if (!(b->pos % BlockSize)) {
+        readBlock = readBlock + 1;
+        b->block = b->block + 1;
+        b->count = b->count - 1;
+        if (!b->count)
+            b->state = BUF_SENT;
+    }
+
+    stats.bytes_read += n;
+    addr += n;
+    length -= n;
+    csw.DataResidue -= n;
+
+    if (!length) {
+        csw.Status = diskError ? CSW_FAILED : CSW_PASSED;
+        stage = SEND_CSW;
+    }
+}
+
+// Called in ISR context when a WRITE10/WRITE12/VERIFY10 is accepted and disk accesses are deferred
+bool USBMSD::startWrite() {
+    uint32_t block = addr / BlockSize;
+    uint32_t count = length / BlockSize;
+
+    if ((block >= BlockCount) || (count > BlockCount - block)) {
+        stallEndpoint(EPBULK_OUT);
+        fail();
+        return false;
+    }
+
+    // blocks read ahead are about to change
+    invalidate();
+    diskError = false;
+
+    // both buffers may still be busy with the read ahead
+    if (findBuffer(BUF_FREE, NO_BLOCK) < 0) {
+        outPaused = true;
+        stats.stalls++;
+    }
+    return true;
+}
+
+// Called in ISR context when a packet of a WRITE10/WRITE12/VERIFY10 is received and disk accesses are deferred
+void USBMSD::receiveData(uint8_t * buf, uint16_t size) {
+    if (size > length)
+        size = length;
+    if (!size)
+        return;
+
+    if (filling < 0) {
+        filling = findBuffer(BUF_FREE, NO_BLOCK);
+        if (filling < 0)
+            return;
+        Buffer * b = &buffers[filling];
+        b->state = BUF_FILLING;
+        b->block = addr / BlockSize;
+        b->count = (length / BlockSize > USBMSD_BUFFER_BLOCKS) ? USBMSD_BUFFER_BLOCKS : length / BlockSize;
+        b->pos = 0;
+    }
+
+    Buffer * b = &buffers[filling];
+    if (size > b->count * BlockSize - b->pos)
+        size = b->count * BlockSize - b->pos;
+    memcpy(&b->data[b->pos], buf, size);
+    b->pos += size;
+
+    if (cbw.CB[0] != VERIFY10)
+        stats.bytes_written += size;
+    addr += size;
+    length -= size;
+    csw.DataResidue -= size;
+
+    if (b->pos == b->count * BlockSize) {
+        // hand the buffer to process(), which sends the CSW after the last one
+        b->last = !length;
+        b->verify = (cbw.CB[0] == VERIFY10);
+        b->state = BUF_FULL;
+        filling = -1;
+        pending.call();
+
+        if (length && (findBuffer(BUF_FREE, NO_BLOCK) < 0)) {
+            outPaused = true;
+            stats.stalls++;
+        }
+    }
+}
+
+// Writes or verifies a full buffer
+void USBMSD::flush(int i) {
+    Buffer * b = &buffers[i];
+
+    __disable_irq();
+    if (b->state != BUF_FULL) {
+        __enable_irq();
+        return;
+    }
+    b->state = BUF_BUSY;
+    uint32_t gen = generation;
+    __enable_irq();
+
+    bool ok = true;
+    if (b->verify) {
+        for (uint32_t n = 0; n < b->count; n++) {
+            disk_read(page, b->block + n, 1);
+            stats.disk_reads++;
+            stats.blocks_read++;
+            if (memcmp(page, &b->data[n * BlockSize], BlockSize)) {
+                ok = false;
+                break;
+            }
+        }
+    } else if (!(disk_status() & WRITE_PROTECT)) {
+        ok = !disk_write(b->data, b->block, b->count);
+        stats.disk_writes++;
+        stats.blocks_written += b->count;
+    }
+
+    __disable_irq();
+    b->state = BUF_FREE;
+    if (gen == generation) {
+        if (!ok) {
+            if (b->verify)
+                memOK = false;
+            else
+                diskError = true;
+        }
+        if (b->last) {
+            csw.Status = (b->verify ? memOK : !diskError) ? CSW_PASSED : CSW_FAILED;
+            sendCSW();
+        }
+        if (outPaused) {
+            outPaused = false;
+            readStart(EPBULK_OUT, MAX_PACKET_SIZE_EPBULK);
+        }
+    }
+    __enable_irq();
+}
+
+// Reads the next blocks into a free buffer, returns false if there is nothing to read
+bool USBMSD::fetch() {
+    __disable_irq();
+    int i = findBuffer(BUF_FREE, NO_BLOCK);
+    if ((i < 0) || (fetchBlock >= fetchEnd) || outPaused) {
+        __enable_irq();
+        return false;
+    }
+    Buffer * b = &buffers[i];
+    uint32_t block = fetchBlock;
+    uint32_t count = fetchEnd - block;
+    if (count > USBMSD_BUFFER_BLOCKS)
+        count = USBMSD_BUFFER_BLOCKS;
+    fetchBlock = block + count;
+    b->state = BUF_BUSY;
+    uint32_t gen = generation;
+    __enable_irq();
+
+    bool ok = !disk_read(b->data, block, count);
+    stats.disk_reads++;
+    stats.blocks_read += count;
+
+    __disable_irq();
+    if (gen == generation) {
+        b->block = block;
+        b->count = count;
+        b->pos = 0;
+        b->error = !ok;
+        b->state = BUF_DATA;
+        if (inStarved && (stage == PROCESS_CBW) && (block == readBlock))
+            sendData();
+    } else {
+        // dropped, a write may be waiting for this buffer
+        b->state = BUF_FREE;
+        if (outPaused) {
+            outPaused = false;
+            readStart(EPBULK_OUT, MAX_PACKET_SIZE_EPBULK);
+        }
+    }
+    __enable_irq();
+    return true;
+}
+
+void USBMSD::process() {
+    if (!deferred)
+        return;
+
+    // the host waits for writes before anything else, lowest blocks first
+    for (;;) {
+        int i = findBuffer(BUF_FULL, NO_BLOCK);
+        if (i < 0)
+            break;
+        if ((buffers[1 - i].state == BUF_FULL) && (buffers[1 - i].block < buffers[i].block))
+            i = 1 - i;
+        flush(i);
+    }
+
+    while (fetch())
+        ;
+}
 
 
 // Called in ISR context
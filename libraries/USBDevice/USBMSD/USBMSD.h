@@ -27,6 +27,11 @@
 
 #include "USBDevice.h"
 
+// Number of blocks held by each of the two buffers used when disk accesses are deferred
+#ifndef USBMSD_BUFFER_BLOCKS
+#define USBMSD_BUFFER_BLOCKS 4
+#endif
+
 /**
  * USBMSD class: generic class in order to use all kinds of blocks storage chip
  *
@@ -54,6 +59,13 @@
  * of USBMSD to connect your mass storage device. connect() will first call disk_status() to test the status of the disk.
  * If disk_status() returns 1 (disk not initialized), then disk_initialize() is called. After this step, connect() will collect information
  * such as the number of blocks and the memory size.
+ *
+ * By default disk_read() and disk_write() are called from the USB interrupt, one block at a time.
+ * Calling deferDiskAccess(true) before connect() moves them to process(), which has to be called
+ * from the main loop or from a thread. The interrupt then only moves packets in and out of two
+ * buffers of USBMSD_BUFFER_BLOCKS blocks each, while process() reads and writes whole buffers with
+ * a single multi-block call and reads ahead of sequential READ10 commands. attach() can be used to
+ * wake a thread up when process() has work to do.
  */
 class USBMSD: public USBDevice {
 public:
@@ -85,6 +97,66 @@ public:
     */
     ~USBMSD();
 
+    /**
+    * Move disk accesses out of the USB interrupt into process(). Must be called before connect().
+    *
+    * @param defer true to have disk accesses done by process()
+    */
+    void deferDiskAccess(bool defer);
+
+    /**
+    * Do the pending disk accesses when they are deferred. Returns straight away if there is nothing to do.
+    */
+    void process();
+
+    /**
+     *  Attach a member function to call when process() has work to do. Called in ISR context.
+     *
+     *  @param tptr pointer to the object to call the member function on
+     *  @param mptr pointer to the member function to be called
+     */
+    template<typename T>
+    void attach(T* tptr, void (T::*mptr)(void)) {
+        if((mptr != NULL) && (tptr != NULL)) {
+            pending.attach(tptr, mptr);
+        }
+    }
+
+    /**
+     * Attach a callback called when process() has work to do. Called in ISR context.
+     *
+     * @param fptr function pointer
+     */
+    void attach(void (*fptr)(void)) {
+        if(fptr != NULL) {
+            pending.attach(fptr);
+        }
+    }
+
+    // Throughput counters, since connect() or the last resetStats()
+    typedef struct {
+        uint32_t bytes_read;      // data bytes sent to the host
+        uint32_t bytes_written;   // data bytes received from the host
+        uint32_t disk_reads;      // calls to disk_read()
+        uint32_t disk_writes;     // calls to disk_write()
+        uint32_t blocks_read;
+        uint32_t blocks_written;
+        uint32_t read_ahead_hits; // READ10 commands whose first block had already been read
+        uint32_t stalls;          // times the host had to wait for process()
+    } Stats;
+
+    /**
+    * Get the throughput counters
+    *
+    * @param stats where the counters are copied
+    */
+    void getStats(Stats * stats);
+
+    /**
+    * Clear the throughput counters
+    */
+    void resetStats();
+
 protected:
 
     /*
@@ -246,6 +318,49 @@ private:
     void memoryWrite (uint8_t * buf, uint16_t size);
     void reset();
     void fail();
+
+    // Deferred disk accesses: the ISR and process() hand the buffers over to each other
+    enum BufferState {
+        BUF_FREE,
+        BUF_FILLING,    // being filled by the ISR with data from the host
+        BUF_FULL,       // waiting for process() to write or verify it
+        BUF_BUSY,       // process() is accessing the disk
+        BUF_DATA,       // read from the disk, waiting to be sent
+        BUF_SENT,       // sent, released once the IN transfer completes
+    };
+
+    typedef struct {
+        uint8_t * data;
+        volatile uint8_t state;
+        volatile uint32_t block;    // block held at data[pos] (BUF_DATA) or data[0]
+        volatile uint32_t count;    // number of blocks from block
+        uint32_t pos;               // byte offset of the next byte to send or to fill
+        bool last;                  // BUF_FULL: last buffer of the command
+        bool verify;                // BUF_FULL: compare with the disk instead of writing
+        bool error;                 // BUF_DATA: disk_read() failed
+    } Buffer;
+
+    bool deferred;
+    Buffer buffers[2];
+    int filling;                    // buffer the ISR is filling, -1 if none
+    volatile uint32_t generation;   // changes when buffered data no longer matches the disk
+    volatile uint32_t readBlock;    // next block to send to the host
+    volatile uint32_t fetchBlock;   // next block process() reads
+    volatile uint32_t fetchEnd;     // process() reads up to this block (excluded)
+    volatile bool outPaused;        // OUT endpoint not rearmed until a buffer is released
+    volatile bool inStarved;        // IN endpoint idle until process() reads the next block
+    volatile bool diskError;
+    FunctionPointer pending;
+    Stats stats;
+
+    bool startRead();
+    bool startWrite();
+    void sendData();
+    void receiveData(uint8_t * buf, uint16_t size);
+    void invalidate();
+    int findBuffer(uint8_t state, uint32_t block);
+    void flush(int i);
+    bool fetch();
 };
 
 #endif
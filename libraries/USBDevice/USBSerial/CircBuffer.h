@@ -19,6 +19,8 @@
 #ifndef CIRCBUFFER_H
 #define CIRCBUFFER_H
 
+#include <string.h>
+
 template <class T, int Size>
 class CircBuffer {
 public:
@@ -41,7 +43,10 @@ public:
     }
 
     uint16_t available() {
-        return (write >= read) ? write - read : size - read + write;
+        // read each index once, the other end may move it from an interrupt
+        uint16_t w = write;
+        uint16_t r = read;
+        return (w >= r) ? w - r : size - r + w;
     };
 
     bool dequeue(T * c) {
@@ -53,6 +58,37 @@ public:
         return(!empty);
     };
 
+    // Number of elements that can be queued without overwriting any
+    uint16_t space() {
+        return Size - available();
+    };
+
+    // Queues up to n elements, returns how many fit. Unlike queue(k), never overwrites.
+    uint16_t queue(const T * k, uint16_t n) {
+        uint16_t w = write;
+        uint16_t free = space();
+        if (n > free)
+            n = free;
+        uint16_t first = (n < size - w) ? n : size - w;
+        memcpy(&buf[w], k, first * sizeof(T));
+        memcpy(&buf[0], k + first, (n - first) * sizeof(T));
+        write = (w + n) % size;
+        return n;
+    };
+
+    // Dequeues up to n elements, returns how many were available
+    uint16_t dequeue(T * c, uint16_t n) {
+        uint16_t r = read;
+        uint16_t used = available();
+        if (n > used)
+            n = used;
+        uint16_t first = (n < size - r) ? n : size - r;
+        memcpy(c, &buf[r], first * sizeof(T));
+        memcpy(c + first, &buf[0], (n - first) * sizeof(T));
+        read = (r + n) % size;
+        return n;
+    };
+
 private:
     volatile uint16_t write;
     volatile uint16_t read;
@@ -19,42 +19,126 @@
 #include "stdint.h"
 #include "USBSerial.h"
 
+// the host is held off until a whole packet fits in the receive buffer
+#if USBSERIAL_RX_BUFFER_SIZE < MAX_PACKET_SIZE_EPBULK
+#error USBSERIAL_RX_BUFFER_SIZE must hold at least one packet
+#endif
+
 int USBSerial::_putc(int c) {
-    if (!terminal_connected)
-        return 0;
-    send((uint8_t *)&c, 1);
-    return 1;
+    uint8_t b = c;
+    return write(&b, 1);
 }
 
 int USBSerial::_getc() {
     uint8_t c = 0;
     while (buf.isEmpty());
     buf.dequeue(&c);
+    resumeReceive();
     return c;
 }
 
+ssize_t USBSerial::write(const void* buffer, size_t length) {
+    const uint8_t * data = (const uint8_t *)buffer;
+    size_t sent = 0;
+
+    while (sent < length) {
+        if (!terminal_connected || !configured())
+            return sent;
+
+        uint32_t n = length - sent;
+        if (n > 0xffff)
+            n = 0xffff;
+        sent += txbuf.queue(&data[sent], n);
+
+        // start sending if the endpoint is idle, the IN callback carries on from there
+        __disable_irq();
+        if (!tx_active)
+            sendNext();
+        __enable_irq();
+    }
+    return sent;
+}
+
+ssize_t USBSerial::read(void* buffer, size_t length) {
+    uint8_t * data = (uint8_t *)buffer;
+    size_t received = 0;
+
+    while (received < length) {
+        uint32_t n = length - received;
+        if (n > 0xffff)
+            n = 0xffff;
+        received += buf.dequeue(&data[received], n);
+        resumeReceive();
+    }
+    return received;
+}
+
 
 bool USBSerial::writeBlock(uint8_t * buf, uint16_t size) {
     if(size > MAX_PACKET_SIZE_EPBULK) {
         return false;
     }
-    if(!send(buf, size)) {
+    if(write(buf, size) != size) {
         return false;
     }
     return true;
 }
 
 
+// Called in ISR context
+bool USBSerial::USBCallback_setConfiguration(uint8_t configuration) {
+    if (!USBCDC::USBCallback_setConfiguration(configuration))
+        return false;
 
-bool USBSerial::EPBULK_OUT_callback() {
+    // a transfer in progress was lost with the previous configuration
+    tx_active = false;
+    tx_zlp = false;
+    rx_paused = false;
+    return true;
+}
+
+
+// Called in ISR context, or with interrupts disabled when no transfer is in progress
+void USBSerial::sendNext() {
+    uint32_t size = txbuf.dequeue(tx_packet, MAX_PACKET_SIZE_EPBULK);
+
+    // a transfer that ends with a full packet is terminated with a zero length one
+    if (!size && !tx_zlp) {
+        tx_active = false;
+        return;
+    }
+    tx_zlp = (size == MAX_PACKET_SIZE_EPBULK);
+    tx_active = (endpointWrite(EPBULK_IN, tx_packet, size) == EP_PENDING);
+}
+
+bool USBSerial::EPBULK_IN_callback() {
+    // a blocking send() is waiting for this one
+    if (!tx_active)
+        return false;
+
+    sendNext();
+    return true;
+}
+
+
+// Called in ISR context, or with interrupts disabled when a packet is waiting
+void USBSerial::receive() {
     uint8_t c[65];
     uint32_t size = 0;
 
     //we read the packet received and put it on the circular buffer
-    readEP(c, &size);
-    for (uint32_t i = 0; i < size; i++) {
-        buf.queue(c[i]);
+    readEP_NB(c, &size);
+    buf.queue(c, size);
+}
+
+bool USBSerial::EPBULK_OUT_callback() {
+    // without room for a whole packet, leave it in the endpoint: the host is NAKed
+    // until the application has read enough for resumeReceive() to take it
+    if (buf.space() < MAX_PACKET_SIZE_EPBULK) {
+        rx_paused = true;
+        return false;
     }
+    receive();
 
     //call a potential handler
     rx.call();
@@ -62,6 +146,18 @@ bool USBSerial::EPBULK_OUT_callback() {
     return true;
 }
 
-uint8_t USBSerial::available() {
+void USBSerial::resumeReceive() {
+    if (!rx_paused || (buf.space() < MAX_PACKET_SIZE_EPBULK))
+        return;
+
+    __disable_irq();
+    if (rx_paused) {
+        rx_paused = false;
+        receive();
+    }
+    __enable_irq();
+}
+
+uint16_t USBSerial::available() {
     return buf.available();
 }
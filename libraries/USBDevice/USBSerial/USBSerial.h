@@ -23,6 +23,16 @@
 #include "Stream.h"
 #include "CircBuffer.h"
 
+// Size of the receive buffer. The host is held off while it has no room for a packet.
+#ifndef USBSERIAL_RX_BUFFER_SIZE
+#define USBSERIAL_RX_BUFFER_SIZE 128
+#endif
+
+// Size of the transmit buffer, sent in the background packet by packet
+#ifndef USBSERIAL_TX_BUFFER_SIZE
+#define USBSERIAL_TX_BUFFER_SIZE 128
+#endif
+
 
 /**
 * USBSerial example
@@ -58,6 +68,9 @@ public:
     */
     USBSerial(uint16_t vendor_id = 0x1f00, uint16_t product_id = 0x2012, uint16_t product_release = 0x0001, bool connect_blocking = true): USBCDC(vendor_id, product_id, product_release, connect_blocking){
         settingsChangedCallback = 0;
+        rx_paused = false;
+        tx_active = false;
+        tx_zlp = false;
     };
 
 
@@ -76,12 +89,32 @@ public:
     */
     virtual int _getc();
 
+    /**
+    * Send a block of data of any size. Returns once it is all in the transmit buffer,
+    * the data is then sent in full packets, followed by a zero length packet if the
+    * last one is full so that the host doesn't wait for more.
+    *
+    * @param buffer data to be sent
+    * @param length number of bytes to send
+    * @returns the number of bytes sent, 0 if no terminal is connected
+    */
+    virtual ssize_t write(const void* buffer, size_t length);
+
+    /**
+    * Read a block of data: blocking until length bytes have been received
+    *
+    * @param buffer where the data is stored
+    * @param length number of bytes to read
+    * @returns the number of bytes read
+    */
+    virtual ssize_t read(void* buffer, size_t length);
+
     /**
     * Check the number of bytes available.
     *
     * @returns the number of bytes available
     */
-    uint8_t available();
+    uint16_t available();
 
     /** Determine if there is a character available to read
      *
@@ -97,7 +130,7 @@ public:
      *    1 if there is space to write a character,
      *    0 otherwise
      */
-    int writeable() { return 1; } // always return 1, for write operation is blocking
+    int writeable() { return txbuf.space() ? 1 : 0; }
 
     /**
     * Write a block of data.
@@ -107,7 +140,7 @@ public:
     * @param buf pointer on data which will be written
     * @param size size of the buffer. The maximum size of a block is limited by the size of the endpoint (64 bytes)
     *
-    * @returns true if successfull
+    * @returns true if successfull. Use write() for larger blocks.
     */
     bool writeBlock(uint8_t * buf, uint16_t size);
 
@@ -146,6 +179,8 @@ public:
 
 protected:
     virtual bool EPBULK_OUT_callback();
+    virtual bool EPBULK_IN_callback();
+    virtual bool USBCallback_setConfiguration(uint8_t configuration);
     virtual void lineCodingChanged(int baud, int bits, int parity, int stop){
         if (settingsChangedCallback) {
             settingsChangedCallback(baud, bits, parity, stop);
@@ -154,8 +189,17 @@ protected:
 
 private:
     FunctionPointer rx;
-    CircBuffer<uint8_t,128> buf;
+    CircBuffer<uint8_t,USBSERIAL_RX_BUFFER_SIZE> buf;
+    CircBuffer<uint8_t,USBSERIAL_TX_BUFFER_SIZE> txbuf;
+    uint8_t tx_packet[MAX_PACKET_SIZE_EPBULK];
+    volatile bool rx_paused;    // a packet waits in the endpoint for room in buf
+    volatile bool tx_active;    // an IN transfer from txbuf is in progress
+    bool tx_zlp;                // the last packet sent was full
     void (*settingsChangedCallback)(int baud, int bits, int parity, int stop);
+
+    void receive();
+    void resumeReceive();
+    void sendNext();
 };
 
 #endif
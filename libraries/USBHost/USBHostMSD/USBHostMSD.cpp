@@ -29,9 +29,19 @@
 #define GET_MAX_LUN             (0xFE)
 #define BO_MASS_STORAGE_RESET   (0xFF)
 
+// An OHCI transfer descriptor holds 8 KB at most and crosses one 4 KB page boundary at most
+#define TD_MAX_SIZE             (8192)
+#define TD_PAGE_SIZE            (4096)
+
+#define NO_BLOCK                (0xFFFFFFFF)
+
 USBHostMSD::USBHostMSD(const char * rootdir) : FATFileSystem(rootdir)
 {
     host = USBHost::getHostInst();
+    cache = NULL;
+    cache_size = 0;
+    memset(&stats, 0, sizeof(stats));
+    timer.start();
     init();
 }
 
@@ -48,6 +58,26 @@ void USBHostMSD::init() {
     disk_init = false;
     dev_connected = false;
     nb_ep = 0;
+    cache_count = 0;
+    next_block = NO_BLOCK;
+}
+
+void USBHostMSD::setReadAhead(uint8_t blocks)
+{
+    free(cache);
+    cache = NULL;
+    cache_size = blocks;
+    cache_count = 0;
+}
+
+void USBHostMSD::getStats(Stats * s)
+{
+    *s = stats;
+}
+
+void USBHostMSD::resetStats()
+{
+    memset(&stats, 0, sizeof(stats));
 }
 
 
@@ -83,6 +113,7 @@ bool USBHostMSD::connect()
                 host->registerDriver(dev, msd_intf, this, &USBHostMSD::init);
 
                 dev_connected = true;
+                resetStats();
                 return true;
             }
         } //if()
@@ -215,20 +246,29 @@ int USBHostMSD::SCSITransfer(uint8_t * cmd, uint8_t cmd_len, int flags, uint8_t
     if (checkResult(res, bulk_out))
         return -1;
 
-    // data stage if needed
+    // data stage if needed, in as many transfers as it takes transfer
+    // descriptors to hold it
     if (data) {
         USB_DBG("data stage");
-        if (flags == HOST_TO_DEVICE) {
+        USBEndpoint * ep = (flags == HOST_TO_DEVICE) ? bulk_out : bulk_in;
+        while (transfer_len) {
+            uint32_t len = TD_MAX_SIZE - ((uintptr_t)data & (TD_PAGE_SIZE - 1));
+            if (len < transfer_len) {
+                // whole packets, a short one would end the data stage
+                len -= len % ep->getSize();
+            } else {
+                len = transfer_len;
+            }
 
-            res = host->bulkWrite(dev, bulk_out, data, transfer_len);
-            if (checkResult(res, bulk_out))
+            if (flags == HOST_TO_DEVICE)
+                res = host->bulkWrite(dev, ep, data, len);
+            else
+                res = host->bulkRead(dev, ep, data, len);
+            if (checkResult(res, ep))
                 return -1;
 
-        } else if (flags == DEVICE_TO_HOST) {
-
-            res = host->bulkRead(dev, bulk_in, data, transfer_len);
-            if (checkResult(res, bulk_in))
-                return -1;
+            data += len;
+            transfer_len -= len;
         }
     }
 
@@ -290,7 +330,43 @@ int USBHostMSD::dataTransfer(uint8_t * buf, uint32_t block, uint8_t nbBlock, int
     cmd[7] = (nbBlock >> 8) & 0xff;
     cmd[8] = nbBlock & 0xff;
 
-    return SCSITransfer(cmd, 10, direction, buf, blockSize*nbBlock);
+    uint32_t start = timer.read_us();
+    int res = SCSITransfer(cmd, 10, direction, buf, blockSize*nbBlock);
+    uint32_t latency = timer.read_us() - start;
+
+    stats.commands++;
+    if (latency > stats.max_latency_us)
+        stats.max_latency_us = latency;
+    if (direction == DEVICE_TO_HOST) {
+        stats.read_time_us += latency;
+        if (res == 0)
+            stats.bytes_read += blockSize*nbBlock;
+    } else {
+        stats.write_time_us += latency;
+        if (res == 0)
+            stats.bytes_written += blockSize*nbBlock;
+    }
+    return res;
+}
+
+// Transfers count blocks with as few commands as a transfer descriptor allows
+int USBHostMSD::blockTransfer(uint8_t * buf, uint32_t block, uint32_t count, int direction) {
+    while (count) {
+        uint32_t n = (TD_MAX_SIZE - ((uintptr_t)buf & (TD_PAGE_SIZE - 1))) / blockSize;
+        // a block that doesn't fit from buf has its data stage split by SCSITransfer
+        if (n == 0)
+            n = 1;
+        if (n > 255)
+            n = 255;
+        if (n > count)
+            n = count;
+        if (dataTransfer(buf, block, n, direction))
+            return -1;
+        buf += n * blockSize;
+        block += n;
+        count -= n;
+    }
+    return 0;
 }
 
 int USBHostMSD::getMaxLun() {
@@ -320,6 +396,12 @@ int USBHostMSD::disk_initialize() {
 
     inquiry(0, 0);
     disk_init = 1;
+
+    // the cache is allocated again for the block size of this device
+    free(cache);
+    cache = NULL;
+    cache_count = 0;
+    next_block = NO_BLOCK;
     return readCapacity();
 }
 
@@ -330,10 +412,17 @@ int USBHostMSD::disk_write(const uint8_t* buffer, uint32_t block_number, uint32_
     }
     if (!disk_init)
         return -1;
-    for (uint32_t b = block_number; b < block_number + count; b++) {
-        if (dataTransfer((uint8_t*)buffer, b, 1, HOST_TO_DEVICE))
-            return -1;
-        buffer += 512;
+
+    // keep the blocks read ahead up to date
+    if (cache_count && (block_number < cache_block + cache_count) && (block_number + count > cache_block)) {
+        uint32_t first = (block_number > cache_block) ? block_number : cache_block;
+        uint32_t last = (block_number + count < cache_block + cache_count) ? block_number + count : cache_block + cache_count;
+        memcpy(&cache[(first - cache_block) * blockSize], &buffer[(first - block_number) * blockSize], (last - first) * blockSize);
+    }
+
+    if (blockTransfer((uint8_t*)buffer, block_number, count, HOST_TO_DEVICE)) {
+        cache_count = 0;
+        return -1;
     }
     return 0;
 }
@@ -345,10 +434,40 @@ int USBHostMSD::disk_read(uint8_t* buffer, uint32_t block_number, uint32_t count
     }
     if (!disk_init)
         return -1;
-    for (uint32_t b = block_number; b < block_number + count; b++) {
-        if (dataTransfer((uint8_t*)buffer, b, 1, DEVICE_TO_HOST))
-            return -1;
-        buffer += 512;
+
+    if (cache_size && !cache) {
+        cache = (uint8_t *)malloc(cache_size * blockSize);
+        if (!cache)
+            cache_size = 0;
+    }
+
+    while (count) {
+        uint32_t n;
+        if (cache_count && (block_number >= cache_block) && (block_number < cache_block + cache_count)) {
+            // already read ahead
+            n = cache_block + cache_count - block_number;
+            if (n > count)
+                n = count;
+            memcpy(buffer, &cache[(block_number - cache_block) * blockSize], n * blockSize);
+            stats.cache_hits += n;
+        } else if (cache_size && (block_number == next_block) && (count < cache_size) &&
+                   (block_number + cache_size <= blockCount)) {
+            // sequential read: fill the cache from here and serve it from there
+            cache_count = 0;
+            if (blockTransfer(cache, block_number, cache_size, DEVICE_TO_HOST))
+                return -1;
+            cache_block = block_number;
+            cache_count = cache_size;
+            continue;
+        } else {
+            n = count;
+            if (blockTransfer(buffer, block_number, n, DEVICE_TO_HOST))
+                return -1;
+        }
+        buffer += n * blockSize;
+        block_number += n;
+        count -= n;
+        next_block = block_number;
     }
     return 0;
 }
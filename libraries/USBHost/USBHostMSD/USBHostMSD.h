@@ -50,6 +50,38 @@ public:
      */
     bool connect();
 
+    /**
+     * Read ahead of sequential reads. A read that carries on where the previous one
+     * stopped fetches blocks into a cache with a single command, so that FAT file
+     * system reads of one sector at a time stream at bus speed.
+     *
+     * @param blocks number of blocks read ahead, 0 to disable the cache
+     */
+    void setReadAhead(uint8_t blocks);
+
+    // Transfer statistics, since connect() or the last resetStats()
+    typedef struct {
+        uint32_t commands;        // READ10 and WRITE10 commands sent
+        uint32_t bytes_read;
+        uint32_t bytes_written;
+        uint32_t read_time_us;    // time spent in READ10 commands
+        uint32_t write_time_us;   // time spent in WRITE10 commands
+        uint32_t max_latency_us;  // longest READ10 or WRITE10 command
+        uint32_t cache_hits;      // blocks served from the read-ahead cache
+    } Stats;
+
+    /**
+     * Get the transfer statistics
+     *
+     * @param stats where the statistics are copied
+     */
+    void getStats(Stats * stats);
+
+    /**
+     * Clear the transfer statistics
+     */
+    void resetStats();
+
 protected:
     //From IUSBEnumerator
     virtual void setVidPid(uint16_t vid, uint16_t pid);
@@ -100,6 +132,7 @@ private:
     int inquiry(uint8_t lun, uint8_t page_code);
     int SCSIRequestSense();
     int dataTransfer(uint8_t * buf, uint32_t block, uint8_t nbBlock, int direction);
+    int blockTransfer(uint8_t * buf, uint32_t block, uint32_t count, int direction);
     int checkResult(uint8_t res, USBEndpoint * ep);
     int getMaxLun();
 
@@ -110,6 +143,16 @@ private:
     bool msd_device_found;
     bool disk_init;
 
+    // read-ahead cache
+    uint8_t * cache;
+    uint8_t cache_size;         // blocks, 0 if disabled
+    uint32_t cache_block;       // first block held
+    uint32_t cache_count;       // blocks held
+    uint32_t next_block;        // block following the last one read
+
+    Stats stats;
+    Timer timer;
+
     void init();
 
 };
@@ -27,6 +27,7 @@
 #include "FATFileSystem.h"
 #include "FATFileHandle.h"
 #include "FATDirHandle.h"
+#include "BufferedFileHandle.h"
 
 DWORD get_fattime(void) {
     time_t rawtime;
@@ -42,7 +43,7 @@ DWORD get_fattime(void) {
 
 FATFileSystem *FATFileSystem::_ffs[_VOLUMES] = {0};
 
-FATFileSystem::FATFileSystem(const char* n) : FileSystemLike(n) {
+FATFileSystem::FATFileSystem(const char* n) : FileSystemLike(n), _buffer_size(FAT_FILE_BUFFER_SIZE) {
     debug_if(FFS_DBG, "FATFileSystem(%s)\n", n);
     for(int i=0; i<_VOLUMES; i++) {
         if(_ffs[i] == 0) {
@@ -97,6 +98,9 @@ FileHandle *FATFileSystem::open(const char* name, int flags) {
     if (flags & O_APPEND) {
         f_lseek(&fh, fh.fsize);
     }
+    if (_buffer_size > 0) {
+        return new BufferedFileHandle(new FATFileHandle(fh), _buffer_size);
+    }
     return new FATFileHandle(fh);
 }
 
@@ -29,6 +29,17 @@
 
 using namespace mbed;
 
+/* Macro FAT_FILE_BUFFER_SIZE
+ *  Size of the buffer files are opened with, a multiple of the sector
+ *  size; 0 for none. None by default, as a FatFS file already caches a
+ *  sector and syncs after each whole sector written past its cache
+ *  (FLUSH_ON_NEW_SECTOR): a buffer pays off for multi-sector reads and
+ *  writes on cards, not for the sector count.
+ */
+#ifndef FAT_FILE_BUFFER_SIZE
+#define FAT_FILE_BUFFER_SIZE    0
+#endif
+
 /**
  * FATFileSystem based on ChaN's Fat Filesystem library v0.8 
  */
@@ -46,6 +57,12 @@ public:
      * Opens a file on the filesystem
      */
     virtual FileHandle *open(const char* name, int flags);
+
+    /**
+     * Sets the size of the write-back buffer of the files opened from now on,
+     * a multiple of the sector size, 0 for none (see BufferedFileHandle)
+     */
+    void set_buffer_size(size_t size) { _buffer_size = size; }
     
     /**
      * Removes a file path
@@ -89,6 +106,8 @@ public:
     virtual int disk_sync() { return 0; }
     virtual uint32_t disk_sectors() = 0;
 
+protected:
+    size_t _buffer_size;
 };
 
 #endif
@@ -0,0 +1,68 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MBED_FLASHDEVICE_H
+#define MBED_FLASHDEVICE_H
+
+#include <stdint.h>
+
+/** An erase-block flash memory, such as a NOR chip or a part of the
+ *  microcontroller's own flash
+ *
+ *  Programming only turns bits from 1 to 0; erasing sets a whole erase
+ *  block back to all 1s. All the calls return 0 on success and -1 on
+ *  failure, and only return once the memory has finished.
+ */
+class FlashDevice {
+public:
+    virtual ~FlashDevice() {}
+
+    /** Get the memory ready, before the other calls
+     */
+    virtual int init() { return 0; }
+
+    /** Read from any address
+     */
+    virtual int read(uint32_t address, void *buffer, uint32_t length) = 0;
+
+    /** Program erased memory, a multiple of program_size() at a multiple of it
+     */
+    virtual int program(uint32_t address, const void *buffer, uint32_t length) = 0;
+
+    /** Erase the erase block starting at address
+     */
+    virtual int erase(uint32_t address) = 0;
+
+    /** Size of the memory in bytes, a multiple of erase_size()
+     */
+    virtual uint32_t size() = 0;
+
+    /** Size of the erase blocks in bytes
+     */
+    virtual uint32_t erase_size() = 0;
+
+    /** Smallest unit that can be programmed, in bytes; a unit is only
+     *  programmed once between erases
+     */
+    virtual uint32_t program_size() { return 1; }
+};
+
+#endif
@@ -0,0 +1,451 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "mbed.h"
+#include "ffconf.h"
+#include "mbed_debug.h"
+#include "FlashFileSystem.h"
+
+/* The layout of an erase block, each part padded to the program size:
+ *   { FLASH_FTL_MAGIC, erase count, ~erase count }   after the erase
+ *   { sequence, ~sequence }                          when it starts being filled
+ *   { sector, ~sector } for each page                after the page's data
+ *   the pages of 512 bytes
+ * A part that reads as all 1s hasn't been programmed, and one whose words
+ * don't complement each other was cut short. A block that failed to erase
+ * has its first part programmed to 0s, which flash with ECC allows too.
+ */
+#define FLASH_FTL_MAGIC     0x4C544631  // "1FTL"
+#define SECTOR_SIZE         512
+#define NO_PAGE             0xFFFF
+#define UNIT_WORDS          3
+
+enum {
+    BLOCK_DIRTY,    // to erase before use
+    BLOCK_FREE,     // erased
+    BLOCK_USED,
+    BLOCK_BAD,      // failed to erase
+};
+
+FlashFileSystem::FlashFileSystem(FlashDevice *flash, const char *name) :
+        FATFileSystem(name), _flash(flash), _blocks(NULL), _map(NULL), _unit(NULL), _mounted(false) {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+FlashFileSystem::~FlashFileSystem() {
+    delete[] _blocks;
+    delete[] _map;
+    delete[] _unit;
+}
+
+uint32_t FlashFileSystem::tag_address(uint32_t page) {
+    return block_address(page / _pages) + _tag_offset + (page % _pages) * _unit_size;
+}
+
+uint32_t FlashFileSystem::data_address(uint32_t page) {
+    return block_address(page / _pages) + _data_offset + (page % _pages) * SECTOR_SIZE;
+}
+
+int FlashFileSystem::program_unit(uint32_t address, uint32_t a, uint32_t b, uint32_t c) {
+    uint32_t words[UNIT_WORDS] = {a, b, c};
+    memset(_unit, 0xFF, _unit_size);
+    memcpy(_unit, words, sizeof(words));
+    return _flash->program(address, _unit, _unit_size);
+}
+
+int FlashFileSystem::read_unit(uint32_t address, uint32_t *words) {
+    return _flash->read(address, words, UNIT_WORDS * sizeof(uint32_t));
+}
+
+int FlashFileSystem::mount_ftl() {
+    if (_flash->init() != 0) {
+        return -1;
+    }
+    uint32_t program_size = _flash->program_size();
+    _erase_size = _flash->erase_size();
+    if ((program_size == 0) || (SECTOR_SIZE % program_size != 0)) {
+        debug_if(FFS_DBG, "FlashFileSystem: program size %d not supported\n", program_size);
+        return -1;
+    }
+    _unit_size = (UNIT_WORDS * sizeof(uint32_t) + program_size - 1) / program_size * program_size;
+    _tag_offset = 2 * _unit_size;
+    _pages = (_erase_size > _tag_offset) ? (_erase_size - _tag_offset) / (_unit_size + SECTOR_SIZE) : 0;
+    _data_offset = _tag_offset + _pages * _unit_size;
+    _data_offset = (_data_offset + program_size - 1) / program_size * program_size;
+    while ((_pages > 0) && (_data_offset + _pages * SECTOR_SIZE > _erase_size)) {
+        _pages--;
+        _data_offset = (_tag_offset + _pages * _unit_size + program_size - 1) / program_size * program_size;
+    }
+    _block_count = _flash->size() / _erase_size;
+    if ((_pages > 0) && (_block_count * _pages >= NO_PAGE)) {
+        _block_count = (NO_PAGE - 1) / _pages;  // what the table can map
+    }
+    if ((_pages == 0) || (_block_count <= FLASH_FTL_SPARE_BLOCKS)) {
+        debug_if(FFS_DBG, "FlashFileSystem: %d blocks of %d bytes are too few\n", _block_count, _erase_size);
+        return -1;
+    }
+    _sectors = (_block_count - FLASH_FTL_SPARE_BLOCKS) * _pages;
+
+    delete[] _blocks;
+    delete[] _map;
+    delete[] _unit;
+    _blocks = new Block[_block_count];
+    _map = new uint16_t[_sectors];
+    _unit = new uint8_t[_unit_size];
+    memset(_map, 0xFF, _sectors * sizeof(uint16_t));
+
+    // the blocks, from their headers
+    uint32_t words[UNIT_WORDS];
+    uint32_t known = 0;
+    uint64_t erases = 0;
+    _seq = 0;
+    for (uint32_t b = 0; b < _block_count; b++) {
+        Block *block = &_blocks[b];
+        block->erases = 0;
+        block->seq = 0;
+        block->valid = 0;
+        block->state = BLOCK_DIRTY;
+        if (read_unit(block_address(b), words) != 0) {
+            return -1;
+        }
+        if (words[0] == 0) {
+            block->state = BLOCK_BAD;
+            continue;
+        }
+        if ((words[0] != FLASH_FTL_MAGIC) || (words[1] != ~words[2])) {
+            continue;   // never formatted, or its erase was cut short
+        }
+        block->erases = words[1];
+        erases += words[1];
+        known++;
+        if (read_unit(block_address(b) + _unit_size, words) != 0) {
+            return -1;
+        }
+        if ((words[0] == 0xFFFFFFFF) && (words[1] == 0xFFFFFFFF)) {
+            block->state = BLOCK_FREE;
+        } else if (words[0] == ~words[1]) {
+            block->state = BLOCK_USED;
+            block->seq = words[0];
+            if (words[0] >= _seq) {
+                _seq = words[0] + 1;
+            }
+        }
+    }
+    // the blocks that lost their count wore like the others
+    for (uint32_t b = 0; b < _block_count; b++) {
+        if ((_blocks[b].state == BLOCK_DIRTY) && (_blocks[b].erases == 0) && (known > 0)) {
+            _blocks[b].erases = erases / known;
+        }
+    }
+
+    // the latest page of each sector, from the tags
+    for (uint32_t b = 0; b < _block_count; b++) {
+        if (_blocks[b].state != BLOCK_USED) {
+            continue;
+        }
+        for (uint32_t slot = 0; slot < _pages; slot++) {
+            uint32_t page = b * _pages + slot;
+            if (read_unit(tag_address(page), words) != 0) {
+                return -1;
+            }
+            // unwritten, or a write that failed before its tag
+            uint32_t sector = words[0];
+            if ((sector != ~words[1]) || (sector >= _sectors)) {
+                continue;
+            }
+            uint32_t current = _map[sector];
+            // a later block, or later in the same block
+            if ((current == NO_PAGE) || (_blocks[current / _pages].seq < _blocks[b].seq) ||
+                ((current / _pages == b) && (current < page))) {
+                _map[sector] = page;
+            }
+        }
+    }
+
+    _free = 0;
+    for (uint32_t sector = 0; sector < _sectors; sector++) {
+        if (_map[sector] != NO_PAGE) {
+            _blocks[_map[sector] / _pages].valid++;
+        }
+    }
+    for (uint32_t b = 0; b < _block_count; b++) {
+        if ((_blocks[b].state == BLOCK_FREE) || (_blocks[b].state == BLOCK_DIRTY)) {
+            _free++;
+        }
+    }
+    // the block being filled may end in a page cut short, so start a new one
+    _active = _block_count;
+    _next_page = _pages;
+    _mounted = true;
+    return 0;
+}
+
+int FlashFileSystem::erase_block(uint32_t b) {
+    Block *block = &_blocks[b];
+    _stats.blocks_erased++;
+    block->erases++;
+    if ((_flash->erase(block_address(b)) != 0) ||
+        (program_unit(block_address(b), FLASH_FTL_MAGIC, block->erases, ~block->erases) != 0)) {
+        return -1;
+    }
+    block->state = BLOCK_FREE;
+    block->valid = 0;
+    return 0;
+}
+
+// Leaves out a block that failed to erase, for good
+void FlashFileSystem::retire_block(uint32_t b) {
+    debug_if(FFS_DBG, "FlashFileSystem: block %d failed to erase\n", b);
+    _blocks[b].state = BLOCK_BAD;
+    // a program cut short still clears the magic, the first word
+    memset(_unit, 0, _unit_size);
+    _flash->program(block_address(b), _unit, _unit_size);
+}
+
+// Starts filling the least worn free block
+int FlashFileSystem::open_block(bool collecting) {
+    if (!collecting) {
+        // keep one free block for the garbage collector to move pages into
+        while (_free < 2) {
+            if (collect_block(false) < 0) {
+                return -1;
+            }
+        }
+        if (worn_unevenly() && (collect_block(true) < 0)) {
+            return -1;
+        }
+        if (_next_page < _pages) {
+            return 0;   // the pages moved started a block with room left
+        }
+    }
+
+    while (true) {
+        uint32_t best = _block_count;
+        for (uint32_t b = 0; b < _block_count; b++) {
+            if (((_blocks[b].state == BLOCK_FREE) || (_blocks[b].state == BLOCK_DIRTY)) &&
+                ((best == _block_count) || (_blocks[b].erases < _blocks[best].erases))) {
+                best = b;
+            }
+        }
+        if (best == _block_count) {
+            return -1;
+        }
+        if ((_blocks[best].state == BLOCK_DIRTY) && (erase_block(best) != 0)) {
+            // worn out
+            retire_block(best);
+            _free--;
+            continue;
+        }
+        if (program_unit(block_address(best) + _unit_size, _seq, ~_seq) != 0) {
+            _blocks[best].state = BLOCK_DIRTY;
+            return -1;
+        }
+        _blocks[best].state = BLOCK_USED;
+        _blocks[best].seq = _seq++;
+        _blocks[best].valid = 0;
+        _free--;
+        _active = best;
+        _next_page = 0;
+        return 0;
+    }
+}
+
+int FlashFileSystem::write_page(uint32_t sector, const uint8_t *buffer, bool collecting) {
+    if ((_next_page >= _pages) && (open_block(collecting) != 0)) {
+        return -1;
+    }
+    uint32_t page = _active * _pages + _next_page;
+    _next_page++;
+    _stats.pages_programmed++;
+    // the tag commits the page
+    if ((_flash->program(data_address(page), buffer, SECTOR_SIZE) != 0) ||
+        (program_unit(tag_address(page), sector, ~sector) != 0)) {
+        return -1;
+    }
+    uint32_t old = _map[sector];
+    if (old != NO_PAGE) {
+        _blocks[old / _pages].valid--;
+    }
+    _map[sector] = page;
+    _blocks[_active].valid++;
+    return 0;
+}
+
+bool FlashFileSystem::worn_unevenly() {
+    uint32_t min = 0xFFFFFFFF, max = 0;
+    for (uint32_t b = 0; b < _block_count; b++) {
+        if (_blocks[b].state == BLOCK_BAD) {
+            continue;
+        }
+        if ((_blocks[b].state == BLOCK_USED) && (b != _active) && (_blocks[b].erases < min)) {
+            min = _blocks[b].erases;
+        }
+        if (_blocks[b].erases > max) {
+            max = _blocks[b].erases;
+        }
+    }
+    return (min != 0xFFFFFFFF) && (max - min > FLASH_FTL_WEAR_DELTA) && (_free >= 2);
+}
+
+/* Frees the used block with the fewest pages in use, or for wear the least
+ * erased one, moving its pages to the block being filled */
+int FlashFileSystem::collect_block(bool wear) {
+    uint32_t victim = _block_count;
+    for (uint32_t b = 0; b < _block_count; b++) {
+        if ((_blocks[b].state != BLOCK_USED) || (b == _active)) {
+            continue;
+        }
+        if (victim == _block_count) {
+            victim = b;
+        } else if (wear) {
+            if (_blocks[b].erases < _blocks[victim].erases) {
+                victim = b;
+            }
+        } else if ((_blocks[b].valid < _blocks[victim].valid) ||
+                   ((_blocks[b].valid == _blocks[victim].valid) && (_blocks[b].erases < _blocks[victim].erases))) {
+            victim = b;
+        }
+    }
+    if ((victim == _block_count) || (!wear && (_blocks[victim].valid >= _pages))) {
+        debug_if(FFS_DBG, "FlashFileSystem: no garbage to collect\n");
+        return -1;
+    }
+
+    uint32_t words[UNIT_WORDS];
+    for (uint32_t slot = 0; (slot < _pages) && (_blocks[victim].valid > 0); slot++) {
+        uint32_t page = victim * _pages + slot;
+        if (read_unit(tag_address(page), words) != 0) {
+            return -1;
+        }
+        uint32_t sector = words[0];
+        if ((sector != ~words[1]) || (sector >= _sectors) || (_map[sector] != page)) {
+            continue;
+        }
+        if ((_flash->read(data_address(page), _page, SECTOR_SIZE) != 0) ||
+            (write_page(sector, _page, true) != 0)) {
+            return -1;
+        }
+        _stats.pages_moved++;
+    }
+    // a power loss before the erase leaves copies of the pages, the later winning
+    if (erase_block(victim) != 0) {
+        // worn out, with nothing left on it
+        retire_block(victim);
+        return 0;
+    }
+    _free++;
+    return 0;
+}
+
+int FlashFileSystem::collect(int blocks) {
+    if (!_mounted) {
+        return 0;
+    }
+    int done = 0;
+    while (done < blocks) {
+        if (worn_unevenly()) {
+            if (collect_block(true) != 0) {
+                return -1;
+            }
+        } else if (_free < FLASH_FTL_FREE_BLOCKS) {
+            if (collect_block(false) != 0) {
+                break;  // nothing stale left to collect
+            }
+        } else {
+            break;
+        }
+        done++;
+    }
+    return done;
+}
+
+int FlashFileSystem::disk_initialize() {
+    if (!_mounted && (mount_ftl() != 0)) {
+        return 1;
+    }
+    return 0;
+}
+
+int FlashFileSystem::disk_status() {
+    return _mounted ? 0 : 1;
+}
+
+int FlashFileSystem::disk_read(uint8_t *buffer, uint32_t sector, uint32_t count) {
+    if (!_mounted || (sector + count > _sectors)) {
+        return 1;
+    }
+    for (uint32_t i = 0; i < count; i++, buffer += SECTOR_SIZE) {
+        uint32_t page = _map[sector + i];
+        if (page == NO_PAGE) {
+            memset(buffer, 0, SECTOR_SIZE);     // never written
+        } else if (_flash->read(data_address(page), buffer, SECTOR_SIZE) != 0) {
+            return 1;
+        }
+    }
+    _stats.sectors_read += count;
+    return 0;
+}
+
+int FlashFileSystem::disk_write(const uint8_t *buffer, uint32_t sector, uint32_t count) {
+    if (!_mounted || (sector + count > _sectors)) {
+        return 1;
+    }
+    for (uint32_t i = 0; i < count; i++, buffer += SECTOR_SIZE) {
+        if (write_page(sector + i, buffer, false) != 0) {
+            return 1;
+        }
+    }
+    _stats.sectors_written += count;
+    return 0;
+}
+
+int FlashFileSystem::disk_sync() {
+    // writes are on the flash once programmed
+    return 0;
+}
+
+uint32_t FlashFileSystem::disk_sectors() {
+    return _sectors;
+}
+
+void FlashFileSystem::stats(FlashFTLStats *stats) {
+    *stats = _stats;
+    stats->free_blocks = _free;
+    stats->min_erases = 0xFFFFFFFF;
+    stats->max_erases = 0;
+    uint64_t total = 0;
+    uint32_t good = 0;
+    for (uint32_t b = 0; b < (_mounted ? _block_count : 0); b++) {
+        if (_blocks[b].state == BLOCK_BAD) {
+            stats->bad_blocks++;
+            continue;
+        }
+        uint32_t erases = _blocks[b].erases;
+        if (erases < stats->min_erases) stats->min_erases = erases;
+        if (erases > stats->max_erases) stats->max_erases = erases;
+        total += erases;
+        good++;
+    }
+    if (good == 0) {
+        stats->min_erases = 0;
+    }
+    stats->mean_erases = good ? (uint32_t)(total / good) : 0;
+}
@@ -0,0 +1,182 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MBED_FLASHFILESYSTEM_H
+#define MBED_FLASHFILESYSTEM_H
+
+#include "FATFileSystem.h"
+#include "FlashDevice.h"
+#include <stdint.h>
+
+/* Macro FLASH_FTL_SPARE_BLOCKS
+ *  Erase blocks left out of the capacity of the disk: one being written,
+ *  one kept for the garbage collector to copy into, and the rest so that
+ *  it finds blocks that are mostly stale. At least 2.
+ */
+#ifndef FLASH_FTL_SPARE_BLOCKS
+#define FLASH_FTL_SPARE_BLOCKS  4
+#endif
+
+/* Macro FLASH_FTL_FREE_BLOCKS
+ *  Free erase blocks collect() keeps ready, so that writes don't wait for
+ *  the garbage collector.
+ */
+#ifndef FLASH_FTL_FREE_BLOCKS
+#define FLASH_FTL_FREE_BLOCKS   3
+#endif
+
+/* Macro FLASH_FTL_WEAR_DELTA
+ *  Difference of erase counts at which the data of the least erased block
+ *  is moved, so that blocks holding data that doesn't change get erased too.
+ */
+#ifndef FLASH_FTL_WEAR_DELTA
+#define FLASH_FTL_WEAR_DELTA    64
+#endif
+
+typedef struct {
+    uint32_t sectors_read;      // asked by the file system
+    uint32_t sectors_written;
+    uint32_t pages_programmed;  // those written plus the ones the garbage collector moved
+    uint32_t pages_moved;
+    uint32_t blocks_erased;
+    uint32_t free_blocks;
+    uint32_t bad_blocks;        // that failed to erase
+    uint32_t min_erases;        // erase counts of the good blocks
+    uint32_t max_erases;
+    uint32_t mean_erases;
+} FlashFTLStats;
+
+/** A FAT file system on an erase-block flash, through a log-structured
+ *  flash translation layer
+ *
+ *  Sectors aren't rewritten in place: each write goes to the next free page
+ *  of the erase block being filled, tagged with its sector number, and a
+ *  table in RAM maps each sector to its latest page. The garbage collector
+ *  makes free blocks by moving the pages still in use out of the block with
+ *  the fewest, least worn first, and erasing it.
+ *
+ *  Every block starts with its erase count and, once it's being filled, a
+ *  sequence number; each page is tagged after its data is programmed, and
+ *  the tags and headers are written with their complement, so a program cut
+ *  short by a power loss is told apart from a finished one. The table is
+ *  rebuilt from the tags when the disk is initialized, the latest tag of a
+ *  sector winning, and a write cut short leaves the sector as it was.
+ *  Blocks that fail to erase are marked on the flash and left out.
+ *
+ *  Writes collect garbage when they run out of free blocks; calling
+ *  collect() when idle does it ahead of time instead. The table takes 2
+ *  bytes per sector, and each block 12 bytes.
+ *
+ * @code
+ * #include "mbed.h"
+ * #include "SPIFlash.h"
+ * #include "FlashFileSystem.h"
+ *
+ * SPIFlash nor(p5, p6, p7, p8);
+ * FlashFileSystem flash(&nor, "flash");
+ *
+ * int main() {
+ *     if (flash.mount() != 0) {
+ *         flash.format();
+ *     }
+ *     FILE *fp = fopen("/flash/log.txt", "a");
+ *     fprintf(fp, "Hello World!\n");
+ *     fclose(fp);
+ *     while (1) {
+ *         flash.collect();
+ *         sleep();
+ *     }
+ * }
+ * @endcode
+ */
+class FlashFileSystem : public FATFileSystem {
+public:
+    /** Create the file system
+     *
+     * @param flash the memory it's stored on
+     * @param name The name used to access the virtual filesystem
+     */
+    FlashFileSystem(FlashDevice *flash, const char *name);
+    virtual ~FlashFileSystem();
+
+    virtual int disk_initialize();
+    virtual int disk_status();
+    virtual int disk_read(uint8_t *buffer, uint32_t sector, uint32_t count);
+    virtual int disk_write(const uint8_t *buffer, uint32_t sector, uint32_t count);
+    virtual int disk_sync();
+    virtual uint32_t disk_sectors();
+
+    /** Collect garbage ahead of the writes, and move data that doesn't
+     *  change off the least worn blocks
+     *
+     *  @param blocks the most erase blocks to reclaim
+     *  @returns the number reclaimed, -1 on a flash error
+     */
+    int collect(int blocks = 1);
+
+    /** The work done and the wear of the blocks
+     */
+    void stats(FlashFTLStats *stats);
+
+protected:
+    typedef struct {
+        uint32_t erases;
+        uint32_t seq;       // of the block's filling, the later the higher
+        uint16_t valid;     // pages the table maps
+        uint8_t state;
+    } Block;
+
+    int mount_ftl();
+    uint32_t block_address(uint32_t block) { return block * _erase_size; }
+    uint32_t tag_address(uint32_t page);
+    uint32_t data_address(uint32_t page);
+    int program_unit(uint32_t address, uint32_t a, uint32_t b, uint32_t c = 0xFFFFFFFF);
+    int read_unit(uint32_t address, uint32_t *words);
+    int erase_block(uint32_t block);
+    void retire_block(uint32_t block);
+    int open_block(bool collecting);
+    int write_page(uint32_t sector, const uint8_t *buffer, bool collecting);
+    int collect_block(bool wear);
+    bool worn_unevenly();
+
+    FlashDevice *_flash;
+    Block *_blocks;
+    uint16_t *_map;         // page of each sector
+    uint8_t *_unit;         // a header or a tag padded to the program size
+    uint8_t _page[512];
+
+    uint32_t _erase_size;
+    uint32_t _unit_size;
+    uint32_t _block_count;
+    uint32_t _pages;        // per block
+    uint32_t _sectors;
+    uint32_t _tag_offset;
+    uint32_t _data_offset;
+
+    uint32_t _active;       // block being filled
+    uint32_t _next_page;
+    uint32_t _seq;
+    uint32_t _free;
+    bool _mounted;
+    FlashFTLStats _stats;
+};
+
+#endif
@@ -0,0 +1,126 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "SPIFlash.h"
+
+#define CMD_READ        0x03
+#define CMD_PAGE_PROGRAM 0x02
+#define CMD_SECTOR_ERASE 0x20
+#define CMD_WRITE_ENABLE 0x06
+#define CMD_READ_STATUS 0x05
+#define CMD_JEDEC_ID    0x9F
+#define STATUS_BUSY     0x01
+#define PAGE_SIZE       256
+
+SPIFlash::SPIFlash(PinName mosi, PinName miso, PinName sclk, PinName cs, uint32_t size, int hz) :
+        _spi(mosi, miso, sclk), _cs(cs), _size(size) {
+    _cs = 1;
+    _spi.format(8, 0);
+    _spi.frequency(hz);
+}
+
+void SPIFlash::command(uint8_t cmd, uint32_t address) {
+    _cs = 0;
+    _spi.write(cmd);
+    _spi.write(address >> 16);
+    _spi.write(address >> 8);
+    _spi.write(address);
+}
+
+int SPIFlash::wait_ready(int timeout_ms) {
+    Timer timer;
+    timer.start();
+    _cs = 0;
+    _spi.write(CMD_READ_STATUS);
+    while (_spi.write(0xFF) & STATUS_BUSY) {
+        if (timer.read_ms() > timeout_ms) {
+            _cs = 1;
+            return -1;
+        }
+    }
+    _cs = 1;
+    return 0;
+}
+
+int SPIFlash::init() {
+    _cs = 0;
+    _spi.write(CMD_JEDEC_ID);
+    int manufacturer = _spi.write(0xFF);
+    _spi.write(0xFF);   // memory type
+    int capacity = _spi.write(0xFF);
+    _cs = 1;
+    if ((manufacturer == 0x00) || (manufacturer == 0xFF)) {
+        return -1;      // nothing answering
+    }
+    if (_size == 0) {
+        if ((capacity < 16) || (capacity > 31)) {
+            return -1;
+        }
+        // 3 byte addresses reach the first 16 MB
+        _size = 1UL << ((capacity > 24) ? 24 : capacity);
+    }
+    return 0;
+}
+
+int SPIFlash::read(uint32_t address, void *buffer, uint32_t length) {
+    uint8_t *p = (uint8_t *)buffer;
+    command(CMD_READ, address);
+    for (uint32_t i = 0; i < length; i++) {
+        p[i] = _spi.write(0xFF);
+    }
+    _cs = 1;
+    return 0;
+}
+
+int SPIFlash::program(uint32_t address, const void *buffer, uint32_t length) {
+    const uint8_t *p = (const uint8_t *)buffer;
+    while (length > 0) {
+        // a program wraps around at the end of its page
+        uint32_t n = PAGE_SIZE - address % PAGE_SIZE;
+        if (n > length) {
+            n = length;
+        }
+        _cs = 0;
+        _spi.write(CMD_WRITE_ENABLE);
+        _cs = 1;
+        command(CMD_PAGE_PROGRAM, address);
+        for (uint32_t i = 0; i < n; i++) {
+            _spi.write(p[i]);
+        }
+        _cs = 1;
+        if (wait_ready(10) != 0) {
+            return -1;
+        }
+        address += n;
+        p += n;
+        length -= n;
+    }
+    return 0;
+}
+
+int SPIFlash::erase(uint32_t address) {
+    _cs = 0;
+    _spi.write(CMD_WRITE_ENABLE);
+    _cs = 1;
+    command(CMD_SECTOR_ERASE, address);
+    _cs = 1;
+    return wait_ready(500);
+}
@@ -0,0 +1,62 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MBED_SPIFLASH_H
+#define MBED_SPIFLASH_H
+
+#include "mbed.h"
+#include "FlashDevice.h"
+
+/** A SPI NOR flash with the common commands (JEDEC ID, READ, PAGE PROGRAM
+ *  and 4 KB SECTOR ERASE), such as the Winbond W25Q, Macronix MX25L and
+ *  Spansion S25FL series
+ *
+ * @code
+ * SPIFlash nor(p5, p6, p7, p8);     // mosi, miso, sclk, cs
+ * FlashFileSystem flash(&nor, "flash");
+ * @endcode
+ */
+class SPIFlash : public FlashDevice {
+public:
+    /** Create the flash
+     *
+     *  @param size size in bytes, 0 to read it from the JEDEC ID
+     *  @param hz SPI clock
+     */
+    SPIFlash(PinName mosi, PinName miso, PinName sclk, PinName cs, uint32_t size = 0, int hz = 20000000);
+
+    virtual int init();
+    virtual int read(uint32_t address, void *buffer, uint32_t length);
+    virtual int program(uint32_t address, const void *buffer, uint32_t length);
+    virtual int erase(uint32_t address);
+    virtual uint32_t size() { return _size; }
+    virtual uint32_t erase_size() { return 4096; }
+
+protected:
+    void command(uint8_t cmd, uint32_t address);
+    int wait_ready(int timeout_ms);
+
+    SPI _spi;
+    DigitalOut _cs;
+    uint32_t _size;
+};
+
+#endif
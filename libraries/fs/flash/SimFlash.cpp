@@ -0,0 +1,128 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "mbed.h"
+#include "SimFlash.h"
+
+SimFlash::SimFlash(uint32_t size, uint32_t erase_size, uint32_t program_size) :
+        _size(size), _erase_size(erase_size), _program_size(program_size), _wait(false), _elapsed_ns(0),
+        _endurance(0), _ops_left(0), _powered(true), _programs(0), _bad_programs(0) {
+    _data = new uint8_t[size];
+    _erases = new uint32_t[size / erase_size];
+    memset(_data, 0xFF, size);
+    memset(_erases, 0, (size / erase_size) * sizeof(uint32_t));
+    // 20 MHz SPI reads, 0.7 ms page programs and 45 ms 4 KB erases
+    set_timing(400, 700, 45000);
+}
+
+SimFlash::~SimFlash() {
+    delete[] _data;
+    delete[] _erases;
+}
+
+void SimFlash::set_timing(uint32_t read_ns_per_byte, uint32_t program_us, uint32_t erase_us, bool wait) {
+    _read_ns_per_byte = read_ns_per_byte;
+    _program_us = program_us;
+    _erase_us = erase_us;
+    _wait = wait;
+}
+
+void SimFlash::spend(uint64_t ns) {
+    _elapsed_ns += ns;
+    if (_wait) {
+        wait_us(ns / 1000);
+    }
+}
+
+// Counts down to the power cut, true once it has happened
+bool SimFlash::power_cut() {
+    if (!_powered) {
+        return true;
+    }
+    if ((_ops_left > 0) && (--_ops_left == 0)) {
+        _powered = false;
+    }
+    return false;
+}
+
+int SimFlash::read(uint32_t address, void *buffer, uint32_t length) {
+    if (!_powered || (address + length > _size)) {
+        return -1;
+    }
+    memcpy(buffer, &_data[address], length);
+    spend((uint64_t)length * _read_ns_per_byte);
+    return 0;
+}
+
+static bool all_zeros(const uint8_t *p, uint32_t length) {
+    for (uint32_t i = 0; i < length; i++) {
+        if (p[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int SimFlash::program(uint32_t address, const void *buffer, uint32_t length) {
+    if (power_cut() || (address + length > _size) ||
+        (address % _program_size != 0) || (length % _program_size != 0)) {
+        return -1;
+    }
+    // the power goes half way through
+    uint32_t done = _powered ? length : length / 2;
+    const uint8_t *p = (const uint8_t *)buffer;
+    bool bad = false;
+    for (uint32_t i = 0; i < done; i++) {
+        uint8_t *q = &_data[address + i];
+        if ((p[i] & ~*q) != 0) {
+            bad = true;
+        }
+        // a unit is programmed once, or again with 0s as ECC flash allows
+        if ((_program_size > 1) && (i % _program_size == 0) && !all_zeros(&p[i], _program_size)) {
+            for (uint32_t j = 0; j < _program_size; j++) {
+                if (q[j] != 0xFF) {
+                    bad = true;
+                }
+            }
+        }
+        *q &= p[i];
+    }
+    _programs++;
+    spend((uint64_t)((address % 256 + length + 255) / 256) * _program_us * 1000);
+    if (bad) {
+        _bad_programs++;
+    }
+    return (bad || !_powered) ? -1 : 0;
+}
+
+int SimFlash::erase(uint32_t address) {
+    if (power_cut() || (address >= _size) || (address % _erase_size != 0)) {
+        return -1;
+    }
+    uint32_t block = address / _erase_size;
+    if ((_endurance > 0) && (_erases[block] >= _endurance)) {
+        return -1;
+    }
+    memset(&_data[address], 0xFF, _powered ? _erase_size : _erase_size / 2);
+    _erases[block]++;
+    spend((uint64_t)_erase_us * 1000);
+    return _powered ? 0 : -1;
+}
@@ -0,0 +1,114 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MBED_SIMFLASH_H
+#define MBED_SIMFLASH_H
+
+#include "FlashDevice.h"
+
+/** A NOR flash simulated in RAM, for testing what runs on flash
+ *
+ *  It behaves as the chip does: programming ANDs the data into the memory
+ *  (a program that would need a 0 turned back into a 1 fails), and erasing
+ *  sets a block to 0xFF. It keeps the erase count of each block, the time
+ *  the calls would have taken, and can wear blocks out and cut the power
+ *  part way through a program or an erase.
+ *
+ * @code
+ * SimFlash nor(64 * 4096, 4096);     // 64 erase blocks of 4 KB
+ * FlashFileSystem flash(&nor, "flash");
+ * @endcode
+ */
+class SimFlash : public FlashDevice {
+public:
+    /** Create an erased memory
+     *
+     *  @param size size in bytes, a multiple of erase_size
+     *  @param erase_size size of the erase blocks
+     *  @param program_size smallest unit programmed, only once per erase
+     *    when larger than 1 as in microcontroller flash with ECC, except
+     *    with all 0s
+     */
+    SimFlash(uint32_t size, uint32_t erase_size, uint32_t program_size = 1);
+    virtual ~SimFlash();
+
+    virtual int read(uint32_t address, void *buffer, uint32_t length);
+    virtual int program(uint32_t address, const void *buffer, uint32_t length);
+    virtual int erase(uint32_t address);
+    virtual uint32_t size() { return _size; }
+    virtual uint32_t erase_size() { return _erase_size; }
+    virtual uint32_t program_size() { return _program_size; }
+
+    /** Set the latencies of the memory, by default those of a common SPI NOR
+     *
+     *  @param read_ns_per_byte time to read a byte
+     *  @param program_us time to program a page of up to 256 bytes
+     *  @param erase_us time to erase a block
+     *  @param wait whether the calls take that long, or only count it
+     */
+    void set_timing(uint32_t read_ns_per_byte, uint32_t program_us, uint32_t erase_us, bool wait = false);
+
+    /** The time the calls took on the memory, in microseconds
+     */
+    uint64_t elapsed_us() { return _elapsed_ns / 1000; }
+
+    /** Wear blocks out: an erase fails once a block was erased cycles times
+     *
+     *  @param cycles erase cycles, 0 for no limit
+     */
+    void set_endurance(uint32_t cycles) { _endurance = cycles; }
+
+    /** Cut the power during the ops'th program or erase from now, which is
+     *  left half done; the memory fails every call until power_on()
+     */
+    void power_loss_after(uint32_t ops) { _ops_left = ops; }
+    void power_on() { _powered = true; _ops_left = 0; }
+    bool powered() { return _powered; }
+
+    uint32_t erases(uint32_t block) { return _erases[block]; }
+    uint32_t blocks() { return _size / _erase_size; }
+    uint32_t programs() { return _programs; }
+    uint32_t bad_programs() { return _bad_programs; }
+
+protected:
+    bool power_cut();
+    void spend(uint64_t ns);
+
+    uint8_t *_data;
+    uint32_t *_erases;
+    uint32_t _size;
+    uint32_t _erase_size;
+    uint32_t _program_size;
+
+    uint32_t _read_ns_per_byte;
+    uint32_t _program_us;
+    uint32_t _erase_us;
+    bool _wait;
+    uint64_t _elapsed_ns;
+
+    uint32_t _endurance;
+    uint32_t _ops_left;     // 0 for no power cut
+    bool _powered;
+    uint32_t _programs;
+    uint32_t _bad_programs; // that needed a 0 back to 1, or programmed a unit twice
+};
+
+#endif
@@ -21,6 +21,15 @@
 #if DEVICE_ANALOGIN
 
 #include "analogin_api.h"
+#include "FunctionPointer.h"
+#include "buffer.h"
+
+#if DEVICE_ANALOGIN_ASYNCH
+#include "CThunk.h"
+#include "dma_api.h"
+#else
+#include "SampleTicker.h"
+#endif
 
 namespace mbed {
 
@@ -52,10 +61,18 @@ public:
      * @param pin AnalogIn pin to connect to
      * @param name (optional) A string to identify the object
      */
-    AnalogIn(PinName pin) {
+    AnalogIn(PinName pin)
+#if DEVICE_ANALOGIN_ASYNCH
+        : _irq(this)
+#else
+        : _sampler(NULL)
+#endif
+    {
         analogin_init(&_adc, pin);
     }
 
+    ~AnalogIn();
+
     /** Read the input voltage, represented as a float in the range [0.0, 1.0]
      *
      * @returns A floating-point value representing the current input voltage, measured as a percentage
@@ -73,6 +90,37 @@ public:
         return analogin_read_u16(&_adc);
     }
 
+    /** Start reading samples at a fixed rate into a buffer, in the background
+     *
+     *  Each sample is a 16-bit value as returned by read_u16(). In continuous mode
+     *  the buffer is filled over and over until abort_read(), with a
+     *  SAMPLE_EVENT_HALF_COMPLETE event when the first half can be processed while
+     *  the second is filled, and a SAMPLE_EVENT_COMPLETE event for the second half.
+     *
+     *  Targets with DEVICE_ANALOGIN_ASYNCH convert on a timer trigger into the buffer
+     *  by DMA, one AnalogIn at a time, and meanwhile read() and read_u16() of a pin
+     *  on the same ADC return 0. The others read each sample from a SampleTicker
+     *  interrupt.
+     *
+     *  @param buffer     The buffer for the samples
+     *  @param length     The number of samples in the buffer
+     *  @param rate       The samples per second
+     *  @param callback   The event callback function, called in interrupt context
+     *  @param event      The logical OR of events to report. Look at buffer.h for the SAMPLE_EVENT events.
+     *  @param continuous Fill the buffer over and over rather than once
+     *
+     *  @returns
+     *    0 if the reading started,
+     *    -1 if an AnalogIn is already reading, the arguments are invalid, the
+     *    rate is more than the ADC converts or the target can't read this pin
+     *    in the background
+     */
+    int read_async(uint16_t *buffer, int length, int rate, const event_callback_t& callback, int event = SAMPLE_EVENT_COMPLETE, bool continuous = false);
+
+    /** Stop reading in the background
+     */
+    void abort_read();
+
 #ifdef MBED_OPERATORS
     /** An operator shorthand for read()
      *
@@ -94,6 +142,18 @@ public:
 
 protected:
     analogin_t _adc;
+
+#if DEVICE_ANALOGIN_ASYNCH
+    void irq_handler_asynch(void);
+
+    CThunk<AnalogIn> _irq;
+    event_callback_t _callback;
+#else
+    void sample(int index);
+
+    SampleTicker *_sampler;
+    uint16_t *_buffer;
+#endif
 };
 
 } // namespace mbed
@@ -21,6 +21,7 @@
 #if DEVICE_ANALOGOUT
 
 #include "analogout_api.h"
+#include "SampleTicker.h"
 
 namespace mbed {
 
@@ -52,10 +53,12 @@ public:
      *
      *  @param AnalogOut pin to connect to (18)
      */
-    AnalogOut(PinName pin) {
+    AnalogOut(PinName pin) : _sampler(NULL) {
         analogout_init(&_dac, pin);
     }
 
+    ~AnalogOut();
+
     /** Set the output voltage, specified as a percentage (float)
      *
      *  @param value A floating-point value representing the output voltage,
@@ -76,6 +79,30 @@ public:
         analogout_write_u16(&_dac, value);
     }
 
+    /** Start writing a waveform at a fixed rate, in the background
+     *
+     *  Each sample is written by write_u16() from a SampleTicker interrupt. In
+     *  continuous mode the waveform is played over and over until abort_write(),
+     *  and the half of the buffer not being played can be refilled on the
+     *  SAMPLE_EVENT_HALF_COMPLETE and SAMPLE_EVENT_COMPLETE events.
+     *
+     *  @param buffer     The samples, as for write_u16()
+     *  @param length     The number of samples in the buffer
+     *  @param rate       The samples per second
+     *  @param callback   The event callback function, called in interrupt context
+     *  @param event      The logical OR of events to report. Look at buffer.h for the SAMPLE_EVENT events.
+     *  @param continuous Play the buffer over and over rather than once
+     *
+     *  @returns
+     *    0 if the writing started,
+     *    -1 if this AnalogOut is already writing or the arguments are invalid
+     */
+    int write_async(const uint16_t *buffer, int length, int rate, const event_callback_t& callback, int event = SAMPLE_EVENT_COMPLETE, bool continuous = false);
+
+    /** Stop writing in the background, the output keeps the last sample written
+     */
+    void abort_write();
+
     /** Return the current output voltage setting, measured as a percentage (float)
      *
      *  @returns
@@ -111,7 +138,11 @@ public:
 #endif
 
 protected:
+    void sample(int index);
+
     dac_t _dac;
+    SampleTicker *_sampler;
+    const uint16_t *_buffer;
 };
 
 } // namespace mbed
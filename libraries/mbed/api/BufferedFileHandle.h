@@ -0,0 +1,111 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BUFFEREDFILEHANDLE_H
+#define MBED_BUFFEREDFILEHANDLE_H
+
+#include <stdint.h>
+#include "FileHandle.h"
+
+namespace mbed {
+
+typedef struct {
+    uint32_t reads;         // calls of read() and write() on the buffered handles
+    uint32_t writes;
+    uint32_t device_reads;  // the calls passed on to the files they hold
+    uint32_t device_writes;
+    uint32_t device_seeks;
+} BufferedFileStats;
+
+/** A FileHandle holding another one, whose small reads and writes it
+ *  gathers into calls of a buffer's size
+ *
+ *  The buffer covers a block of the file starting at a multiple of its
+ *  size, so that with a buffer of a sector (or a multiple of one) the file
+ *  is written a whole sector at a time. Writes stay in the buffer until the
+ *  handle moves to another block, or until fsync() or close(), which is
+ *  when they have reached the file. Reads fill the buffer with the whole of
+ *  the block, so that sequential reads are served from it; reads and writes
+ *  of a buffer or more go straight to the file.
+ *
+ *  LocalFileSystem opens its files with one, as does FATFileSystem after
+ *  set_buffer_size(); it can also be used directly:
+ * @code
+ * FileHandle *f = new BufferedFileHandle(sd.open("log.txt", O_WRONLY | O_CREAT), 512);
+ * @endcode
+ */
+class BufferedFileHandle : public FileHandle {
+
+public:
+    /** Buffer a file
+     *
+     *  @param file the file, closed with this handle
+     *  @param size the size of the buffer in bytes
+     */
+    BufferedFileHandle(FileHandle *file, size_t size);
+
+    virtual ~BufferedFileHandle();
+
+    virtual ssize_t write(const void *buffer, size_t length);
+    virtual ssize_t read(void *buffer, size_t length);
+    virtual int close();
+    virtual int isatty();
+    virtual off_t lseek(off_t offset, int whence);
+    virtual int fsync();
+    virtual off_t flen();
+
+    /** Write the buffered data to the file, without syncing it
+     *
+     *  @returns 0 on success, -1 if the file took less than all of it
+     */
+    int flush();
+
+    /** The calls made on this handle and passed on to its file
+     */
+    const BufferedFileStats &stats() {
+        return _stats;
+    }
+
+    /** The calls made on every buffered handle since the last reset
+     */
+    static const BufferedFileStats &total_stats() {
+        return _total;
+    }
+    static void reset_total_stats();
+
+protected:
+    ssize_t device_read(off_t position, void *buffer, size_t length);
+    ssize_t device_write(off_t position, const void *buffer, size_t length);
+    bool device_seek(off_t position);
+
+    FileHandle *_file;
+    char *_buffer;
+    size_t _size;
+
+    off_t _pos;         // of the handle
+    off_t _file_pos;    // of the file, -1 if it's not known
+    off_t _base;        // of the block in the buffer
+    size_t _start;      // the bytes of the block in the buffer, from the file or written
+    size_t _end;
+    size_t _dirty_start;    // the bytes of those written since, _dirty_start == _dirty_end for none
+    size_t _dirty_end;
+
+    BufferedFileStats _stats;
+    static BufferedFileStats _total;
+};
+
+} // namespace mbed
+
+#endif
@@ -18,6 +18,7 @@
 
 #include "platform.h"
 #include "DigitalIn.h"
+#include "BusPorts.h"
 
 namespace mbed {
 
@@ -87,6 +88,10 @@ protected:
      */
     int _nc_mask;
 
+    /** The pins grouped by port, when the target supports it
+     */
+    BusPorts _ports;
+
     /* disallow copy constructor and assignment operators */
 private:
     BusIn(const BusIn&);
@@ -17,6 +17,7 @@
 #define MBED_BUSINOUT_H
 
 #include "DigitalInOut.h"
+#include "BusPorts.h"
 
 namespace mbed {
 
@@ -106,6 +107,10 @@ protected:
      */
     int _nc_mask;
 
+    /** The pins grouped by port, when the target supports it
+     */
+    BusPorts _ports;
+
     /* disallow copy constructor and assignment operators */
 private:
     BusInOut(const BusInOut&);
@@ -17,6 +17,7 @@
 #define MBED_BUSOUT_H
 
 #include "DigitalOut.h"
+#include "BusPorts.h"
 
 namespace mbed {
 
@@ -90,6 +91,10 @@ protected:
      */
     int _nc_mask;
 
+    /** The pins grouped by port, when the target supports it
+     */
+    BusPorts _ports;
+
    /* disallow copy constructor and assignment operators */
 private:
     BusOut(const BusOut&);
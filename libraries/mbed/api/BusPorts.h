@@ -0,0 +1,71 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BUSPORTS_H
+#define MBED_BUSPORTS_H
+
+#include "platform.h"
+
+namespace mbed {
+
+/** The pins of a bus grouped by GPIO port, so that the bus is read or
+ *  written with one access per port rather than one per pin. Used by
+ *  BusIn, BusOut and BusInOut on targets that implement pin_port().
+ */
+class BusPorts {
+
+public:
+    BusPorts();
+
+    ~BusPorts();
+
+    /** Group the pins by port and set their direction
+     *
+     *  @param pins The pins of the bus, NC for those not connected
+     *  @param dir  The direction of the pins
+     *
+     *  @returns
+     *    false if a pin's port isn't known, the bus is then left ungrouped
+     */
+    bool init(const PinName pins[16], PinDirection dir);
+
+    /** Whether init() succeeded
+     */
+    bool grouped() {
+        return _nports > 0;
+    }
+
+    void write(int value);
+
+    int read();
+
+    void dir(PinDirection dir);
+
+private:
+    struct Run;
+    struct Port;
+
+    Run *_runs;
+    Port *_ports;
+    int _nports;
+
+    /* disallow copy constructor and assignment operators */
+    BusPorts(const BusPorts&);
+    BusPorts & operator = (const BusPorts&);
+};
+
+} // namespace mbed
+
+#endif
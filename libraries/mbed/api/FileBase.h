@@ -19,6 +19,7 @@
 typedef int FILEHANDLE;
 
 #include <stdio.h>
+#include <stdint.h>
 
 #if defined(__ARMCC_VERSION) || defined(__ICCARM__)
 #    define O_RDONLY 0
@@ -44,6 +45,13 @@ typedef long off_t;
 
 namespace mbed {
 
+/* Macro FILEBASE_BUCKETS
+ *  Size of the hash table FileBases are looked up in by name, a power of 2.
+ */
+#ifndef FILEBASE_BUCKETS
+#define FILEBASE_BUCKETS    8
+#endif
+
 typedef enum {
     FilePathType,
     FileSystemPathType
@@ -58,17 +66,25 @@ public:
     const char* getName(void);
     PathType    getPathType(void);
 
+    /** The object named by the first len characters of name, NULL if there's none
+     */
     static FileBase *lookup(const char *name, unsigned int len);
 
     static FileBase *get(int n);
 
 protected:
     static FileBase *_head;
+    static FileBase *_last;     // of the last lookup, as paths tend to be on the same file system
 
     FileBase   *_next;
+    FileBase   *_bucket_next;
     const char *_name;
+    unsigned int _len;
+    uint32_t    _hash;
     PathType    _path_type;
 
+    static uint32_t hash(const char *name, unsigned int len);
+
     /* disallow copy constructor and assignment operators */
 private:
     FileBase(const FileBase&);
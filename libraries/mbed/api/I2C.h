@@ -25,7 +25,9 @@
 #if DEVICE_I2C_ASYNCH
 #include "CThunk.h"
 #include "dma_api.h"
+#include "CircularBuffer.h"
 #include "FunctionPointer.h"
+#include "Transaction.h"
 #endif
 
 namespace mbed {
@@ -137,7 +139,22 @@ public:
 
 #if DEVICE_I2C_ASYNCH
 
+    /** Bus usage of the asynchronous transfers of an I2C object
+     */
+    struct Statistics {
+        uint32_t transfers; /**< Transfers completed */
+        uint32_t queued;    /**< Transfers which waited for the bus */
+        uint32_t errors;    /**< Transfers which ended with an error */
+        uint32_t bytes;     /**< Bytes written and read */
+        uint32_t busy_us;   /**< Time from the start to the end of the transfers */
+    };
+
     /** Start non-blocking I2C transfer.
+     *
+     * The tx buffer is written first and the rx buffer then read after a
+     * repeated start, in one interrupt driven transfer. If the bus is busy,
+     * the transfer is queued and started from the interrupt ending the
+     * transfer before it, with the frequency of this object.
      *
      * @param address   8/10 bit I2c slave address
      * @param tx_buffer The TX buffer with data to be transfered
@@ -147,18 +164,61 @@ public:
      * @param event     The logical OR of events to modify
      * @param callback  The event callback function
      * @param repeated Repeated start, true - do not send stop at end
-     * @return Zero if the transfer has started, or -1 if I2C peripheral is busy
+     * @return Zero if the transfer has started or was queued, or -1 if the queue is full
      */
     int transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t& callback, int event = I2C_EVENT_TRANSFER_COMPLETE, bool repeated = false);
 
-    /** Abort the on-going I2C transfer
+    /** Abort the on-going I2C transfer, and continue with the next queued one
      */
     void abort_transfer();
+
+    /** Clear the transaction buffer
+     */
+    void clear_transfer_buffer();
+
+    /** Clear the transaction buffer and abort on-going transfer.
+     */
+    void abort_all_transfers();
+
+    /** Get the bus usage of the transfers of this object
+     *
+     *  @returns
+     *    The statistics since the object was created or they were reset
+     */
+    const Statistics& statistics() const;
+
+    /** Reset the statistics of this object
+     */
+    void reset_statistics();
+
 protected:
     void irq_handler_asynch(void);
+
+    /** Start a transfer, the bus is idle
+     */
+    void start_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t& callback, int event, bool repeated);
+
+#if TRANSACTION_QUEUE_SIZE_I2C
+
+    /** Start a new transaction
+     *
+     *  @param data Transaction data
+     */
+    void start_transaction(i2c_transaction_t *data);
+
+    /** Dequeue a transaction
+     *
+     */
+    void dequeue_transaction();
+    static CircularBuffer<Transaction<I2C, i2c_transaction_t>, TRANSACTION_QUEUE_SIZE_I2C> _transaction_buffer;
+#endif
+
     event_callback_t _callback;
     CThunk<I2C> _irq;
     DMAUsage _usage;
+    int _event;
+    uint32_t _start_us;
+    Statistics _statistics;
 #endif
 
 protected:
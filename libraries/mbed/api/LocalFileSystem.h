@@ -24,6 +24,13 @@
 
 namespace mbed {
 
+/* Macro LOCAL_FILE_BUFFER_SIZE
+ *  Size of the buffer files are opened with; 0 for none.
+ */
+#ifndef LOCAL_FILE_BUFFER_SIZE
+#define LOCAL_FILE_BUFFER_SIZE  256
+#endif
+
 FILEHANDLE local_file_open(const char* name, int flags);
 
 class LocalFileHandle : public FileHandle {
@@ -87,13 +94,22 @@ protected:
 class LocalFileSystem : public FileSystemLike {
 
 public:
-    LocalFileSystem(const char* n) : FileSystemLike(n) {
+    LocalFileSystem(const char* n) : FileSystemLike(n), _buffer_size(LOCAL_FILE_BUFFER_SIZE) {
 
     }
 
     virtual FileHandle *open(const char* name, int flags);
+
+    /** Sets the size of the buffer of the files opened from now on, 0 for
+     *  none, as each access to the drive is a semihosting call (see
+     *  BufferedFileHandle)
+     */
+    void set_buffer_size(size_t size) { _buffer_size = size; }
     virtual int remove(const char *filename);
     virtual DirHandle *opendir(const char *name);
+
+protected:
+    size_t _buffer_size;
 };
 
 } // namespace mbed
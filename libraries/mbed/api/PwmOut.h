@@ -20,6 +20,7 @@
 
 #if DEVICE_PWMOUT
 #include "pwmout_api.h"
+#include "SampleTicker.h"
 
 namespace mbed {
 
@@ -58,10 +59,12 @@ public:
      *
      *  @param pin PwmOut pin to connect to
      */
-    PwmOut(PinName pin) {
+    PwmOut(PinName pin) : _sampler(NULL) {
         pwmout_init(&_pwm, pin);
     }
 
+    ~PwmOut();
+
     /** Set the ouput duty-cycle, specified as a percentage (float)
      *
      *  @param value A floating-point value representing the output duty-cycle,
@@ -73,6 +76,29 @@ public:
         pwmout_write(&_pwm, value);
     }
 
+    /** Start writing a sequence of duty-cycles at a fixed rate, in the background
+     *
+     *  Each duty-cycle is written by write() from a SampleTicker interrupt, the
+     *  rate is best a divisor of the PWM frequency. In continuous mode the sequence
+     *  is played over and over until abort_write().
+     *
+     *  @param duty       The duty-cycles, as for write()
+     *  @param length     The number of duty-cycles in the sequence
+     *  @param rate       The duty-cycles per second
+     *  @param callback   The event callback function, called in interrupt context
+     *  @param event      The logical OR of events to report. Look at buffer.h for the SAMPLE_EVENT events.
+     *  @param continuous Play the sequence over and over rather than once
+     *
+     *  @returns
+     *    0 if the writing started,
+     *    -1 if this PwmOut is already writing or the arguments are invalid
+     */
+    int write_async(const float *duty, int length, int rate, const event_callback_t& callback, int event = SAMPLE_EVENT_COMPLETE, bool continuous = false);
+
+    /** Stop writing in the background, the output keeps the last duty-cycle written
+     */
+    void abort_write();
+
     /** Return the current output duty-cycle setting, measured as a percentage (float)
      *
      *  @returns
@@ -148,7 +174,11 @@ public:
 #endif
 
 protected:
+    void sample(int index);
+
     pwmout_t _pwm;
+    SampleTicker *_sampler;
+    const float *_duty;
 };
 
 } // namespace mbed
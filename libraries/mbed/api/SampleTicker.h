@@ -0,0 +1,74 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SAMPLETICKER_H
+#define MBED_SAMPLETICKER_H
+
+#include "Ticker.h"
+#include "FunctionPointer.h"
+#include "buffer.h"
+
+namespace mbed {
+
+/** Steps through a buffer of samples at a fixed rate from a Ticker,
+ *  raising the SAMPLE_EVENT events of buffer.h on the way. The software
+ *  engine behind the asynchronous AnalogIn, AnalogOut and PwmOut
+ *  transfers where the target has no hardware for them.
+ *
+ *  The rate is rounded to a whole period in microseconds, and the steps
+ *  and the callback are called in interrupt context.
+ */
+class SampleTicker {
+
+public:
+    SampleTicker();
+
+    /** Start stepping through a buffer
+     *
+     *  @param length     The number of samples in the buffer
+     *  @param rate       The samples per second
+     *  @param continuous Go back to the start of the buffer at its end rather than stopping
+     *  @param step       Called with the index of each sample
+     *  @param callback   The event callback function
+     *  @param event      The logical OR of the events to report
+     */
+    void start(int length, int rate, bool continuous, const FunctionPointerArg1<void, int>& step, const event_callback_t& callback, int event);
+
+    /** Stop before the end of the buffer, without raising any event
+     */
+    void stop();
+
+    /** Check if a buffer is being stepped through
+     */
+    bool active() const {
+        return _active;
+    }
+
+protected:
+    void tick(void);
+
+    Ticker _ticker;
+    FunctionPointerArg1<void, int> _step;
+    event_callback_t _callback;
+    int _length;
+    int _index;
+    int _event;
+    bool _continuous;
+    volatile bool _active;
+};
+
+} // namespace mbed
+
+#endif
@@ -126,6 +126,47 @@ public:
 
     static void _irq_handler(uint32_t id, SerialIrq irq_type);
 
+    /** Begin receiving continuously into a ring buffer, where the received
+     *  data is read in place with received() and released with consume().
+     *  Targets with DEVICE_SERIAL_ASYNCH_CIRCULAR receive by DMA and report
+     *  the match character when the line goes idle or the buffer is half
+     *  full or full, others take the receive interrupt, replacing the
+     *  function attached to RxIrq, and find the line idle from a Timeout.
+     *
+     *  @param buffer     The ring buffer
+     *  @param length     The buffer length in bytes
+     *  @param callback   The event callback function
+     *  @param event      The logical OR of SERIAL_EVENT_RX_HALF_FULL, SERIAL_EVENT_RX_COMPLETE (end of the buffer),
+     *                    SERIAL_EVENT_RX_IDLE, SERIAL_EVENT_RX_CHARACTER_MATCH, SERIAL_EVENT_RX_OVERFLOW and the error events
+     *  @param char_match The matching character
+     *  @return Zero if the reception has started, or -1 if a read is on-going
+     */
+    int read_continuous(uint8_t *buffer, int length, const event_callback_t& callback, int event = SERIAL_EVENT_RX_IDLE, unsigned char char_match = SERIAL_RESERVED_CHAR_MATCH);
+
+    /** Get the oldest data received continuously and not yet consumed,
+     *  without copying it. It stops at the end of the ring buffer, with the
+     *  rest from its start once this is consumed.
+     *
+     *  @param data Set to the data in the ring buffer
+     *  @return The number of bytes at data
+     */
+    int received(const uint8_t **data);
+
+    /** Release data received continuously, so it can be received into again
+     *
+     *  @param length The number of bytes
+     */
+    void consume(int length);
+
+    /** Stop receiving continuously
+     */
+    void abort_read_continuous();
+
+    /** Get the number of times data received continuously was lost, because
+     *  it wasn't consumed in time or by the receiver itself
+     */
+    int overruns();
+
 #if DEVICE_SERIAL_ASYNCH
 
     /** Begin asynchronous write using 8bit buffer. The completition invokes registered TX event callback
@@ -196,12 +237,19 @@ protected:
 
 protected:
     SerialBase(PinName tx, PinName rx);
-    virtual ~SerialBase() {
-    }
+    virtual ~SerialBase();
 
     int _base_getc();
     int _base_putc(int c);
 
+    void rx_continuous_event(int event);
+#if !DEVICE_SERIAL_ASYNCH_CIRCULAR
+    void rx_continuous_irq(void);
+    void rx_idle_timeout(void);
+#endif
+    struct RxContinuous;
+    RxContinuous *_rx_continuous;
+
 #if DEVICE_SERIAL_ASYNCH
     CThunk<SerialBase> _thunk_irq;
     event_callback_t _tx_callback;
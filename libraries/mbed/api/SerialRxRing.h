@@ -0,0 +1,110 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_SERIALRXRING_H
+#define MBED_SERIALRXRING_H
+
+#include <stdint.h>
+
+namespace mbed {
+
+/** A ring buffer the serial receiver writes continuously, by DMA or
+ *  from the receive interrupt, with the received data read in place.
+ *
+ *  The writer side raises the SERIAL_EVENT_RX events of serial_api.h:
+ *  SERIAL_EVENT_RX_HALF_FULL and SERIAL_EVENT_RX_COMPLETE as it passes the
+ *  middle and the end of the buffer, SERIAL_EVENT_RX_CHARACTER_MATCH on
+ *  the match character and SERIAL_EVENT_RX_OVERFLOW when data is lost
+ *  because the reader didn't keep up.
+ */
+class SerialRxRing {
+
+public:
+    SerialRxRing();
+
+    /** Start filling a buffer from its beginning, with nothing received
+     *
+     *  @param buffer     The buffer
+     *  @param length     The buffer length in bytes
+     *  @param char_match The character to be matched, or SERIAL_RESERVED_CHAR_MATCH for none
+     */
+    void start(uint8_t *buffer, uint32_t length, unsigned char char_match);
+
+    /** Account for the bytes a DMA receiver wrote, which can't be held off.
+     *  When it laps the reader, everything not yet consumed is dropped.
+     *  It must be called at least every half buffer, which the half full and
+     *  complete interrupts of the DMA ensure.
+     *
+     *  @param position The index in the buffer the receiver writes next
+     *  @return The events raised
+     */
+    int update(uint32_t position);
+
+    /** Add a character received by interrupt, dropped if the buffer is full
+     *
+     *  @param c The character
+     *  @return The events raised
+     */
+    int put(uint8_t c);
+
+    /** Count a character lost by the receiver itself
+     */
+    void overrun() {
+        _overruns++;
+    }
+
+    /** Get the oldest received data not yet consumed, which stays in the
+     *  buffer until consumed. It stops at the end of the buffer, with the rest
+     *  from its start after consuming it.
+     *
+     *  @param data Set to the data
+     *  @return The number of bytes at data
+     */
+    uint32_t span(const uint8_t **data);
+
+    /** Release the oldest received data to the receiver
+     *
+     *  @param length The number of bytes, up to available()
+     */
+    void consume(uint32_t length);
+
+    /** The number of bytes received and not yet consumed
+     */
+    uint32_t available() const {
+        return _count;
+    }
+
+    /** The number of times received data was lost, by the ring or the receiver
+     */
+    uint32_t overruns() const {
+        return _overruns;
+    }
+
+protected:
+    int advance(uint32_t length);
+
+    uint8_t *_buffer;
+    uint32_t _length;
+    uint32_t _head;
+    uint32_t _tail;
+    volatile uint32_t _count;
+    volatile uint32_t _overruns;
+    int _char_match;
+    bool _dropping;
+};
+
+} // namespace mbed
+
+#endif
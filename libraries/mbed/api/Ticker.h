@@ -57,10 +57,20 @@ namespace mbed {
 class Ticker : public TimerEvent {
 
 public:
-    Ticker() : TimerEvent() {
+    Ticker() : TimerEvent(), _slack(0) {
     }
 
-    Ticker(const ticker_data_t *data) : TimerEvent(data) {
+    Ticker(const ticker_data_t *data) : TimerEvent(data), _slack(0) {
+    }
+
+    /** Let the function be called up to the given time late, from the next
+     *  attach on, so that it can share an interrupt with the events due
+     *  meanwhile. The calls keep to the interval on average.
+     *
+     *  @param us how late the calls may be in micro-seconds, 0 by default
+     */
+    void slack_us(uint32_t us) {
+        _slack = us;
     }
 
     /** Attach a function to be called by the Ticker, specifiying the interval in seconds
@@ -88,7 +98,7 @@ public:
      *  @param fptr pointer to the function to be called
      *  @param t the time between calls in micro-seconds
      */
-    void attach_us(void (*fptr)(void), timestamp_t t) {
+    void attach_us(void (*fptr)(void), us_timestamp_t t) {
         _function.attach(fptr);
         setup(t);
     }
@@ -100,7 +110,7 @@ public:
      *  @param t the time between calls in micro-seconds
      */
     template<typename T>
-    void attach_us(T* tptr, void (T::*mptr)(void), timestamp_t t) {
+    void attach_us(T* tptr, void (T::*mptr)(void), us_timestamp_t t) {
         _function.attach(tptr, mptr);
         setup(t);
     }
@@ -114,11 +124,12 @@ public:
     void detach();
 
 protected:
-    void setup(timestamp_t t);
+    void setup(us_timestamp_t t);
     virtual void handler();
 
 protected:
-    timestamp_t     _delay;     /**< Time delay (in microseconds) for re-setting the multi-shot callback. */
+    us_timestamp_t  _delay;     /**< Time delay (in microseconds) for re-setting the multi-shot callback. */
+    uint32_t        _slack;     /**< How late (in microseconds) the callback may be called. */
     FunctionPointer _function;  /**< Callback. */
 };
 
@@ -43,6 +43,10 @@ protected:
     // insert in to linked list
     void insert(timestamp_t timestamp);
 
+    // insert in to linked list, at a 64-bit time as read by ticker_read_us,
+    // to be handled up to slack microseconds late
+    void insert_absolute(us_timestamp_t timestamp, uint32_t slack = 0);
+
     // remove from linked list, if in it
     void remove();
 
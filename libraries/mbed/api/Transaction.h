@@ -33,12 +33,25 @@ typedef struct {
     uint8_t width;             /**< Buffer's word width (8, 16, 32, 64) */
 } transaction_t;
 
+/** I2C transaction structure
+ */
+typedef struct {
+    int address;               /**< 8/10 bit slave address */
+    const char *tx_buffer;     /**< Tx buffer, written first */
+    int tx_length;             /**< Length of Tx buffer */
+    char *rx_buffer;           /**< Rx buffer, read after a repeated start */
+    int rx_length;             /**< Length of Rx buffer */
+    uint32_t event;            /**< Event for a transaction */
+    event_callback_t callback; /**< User's callback */
+    bool repeated;             /**< No stop at the end */
+} i2c_transaction_t;
+
 /** Transaction class defines a transaction.
  */
-template<typename Class>
+template<typename Class, typename Data = transaction_t>
 class Transaction {
 public:
-    Transaction(Class *tpointer, const transaction_t& transaction) : _obj(tpointer), _data(transaction) {
+    Transaction(Class *tpointer, const Data& transaction) : _obj(tpointer), _data(transaction) {
     }
 
     Transaction() : _obj(), _data() {
@@ -59,13 +72,13 @@ public:
      *
      * @return The transaction which was stored
      */
-    transaction_t* get_transaction() {
+    Data* get_transaction() {
         return &_data;
     }
 
 private:
     Class* _obj;
-    transaction_t _data;
+    Data _data;
 };
 
 }
@@ -0,0 +1,152 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_IRQ_PROFILE_H
+#define MBED_IRQ_PROFILE_H
+
+#include <stdint.h>
+#include "cmsis.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Profiler of interrupt handlers and critical sections
+ *
+ * irq_profile_start() wraps the handlers of the peripheral interrupts in
+ * the vector table, counting how often each runs and for how long. Built
+ * with MBED_IRQ_PROFILE defined, the critical sections of the library
+ * (__disable_irq() to __enable_irq()) are timed too, for each place that
+ * enters one. Times are counted with the DWT cycle counter on Cortex-M3
+ * and up, and in microseconds on the ticker otherwise.
+ *
+ * irq_profile_dump() prints the results for workspace_tools/irq_profile.py.
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ * #include "irq_profile.h"
+ *
+ * int main() {
+ *     // ... set up the peripherals, which installs their handlers
+ *     irq_profile_start();
+ *     while (1) {
+ *         wait(10);
+ *         irq_profile_dump();
+ *     }
+ * }
+ * @endcode
+ */
+
+/* Macro IRQ_PROFILE_SITES
+ *  Places entering a critical section that are told apart; the ones
+ *  seen after the table is full are counted together.
+ */
+#ifndef IRQ_PROFILE_SITES
+#define IRQ_PROFILE_SITES   32
+#endif
+
+typedef struct {
+    uint32_t count;
+    uint32_t max;
+    uint64_t total;
+} irq_profile_stat_t;
+
+typedef struct {
+    const char *file;   // NULL for the sites past IRQ_PROFILE_SITES
+    int line;
+    irq_profile_stat_t stat;
+} irq_profile_site_t;
+
+/** Start timing the interrupt handlers in the vector table. Handlers set
+ *  with NVIC_SetVector afterwards aren't timed until it is called again.
+ */
+void irq_profile_start(void);
+
+/** Clear the results
+ */
+void irq_profile_reset(void);
+
+/** Print the results to stdout, one {{...}} line per interrupt and site
+ */
+void irq_profile_dump(void);
+
+/** Frequency of the counts the times are in
+ */
+uint32_t irq_profile_frequency(void);
+
+/** Add a run of an interrupt handler
+ *
+ *  @param irq the IRQn of the interrupt
+ *  @param cycles how long the handler ran
+ */
+void irq_profile_record_irq(int irq, uint32_t cycles);
+
+/** Add a critical section
+ *
+ *  @param file the source file entering it
+ *  @param line the line entering it
+ *  @param cycles how long interrupts were held off
+ */
+void irq_profile_record_critical(const char *file, int line, uint32_t cycles);
+
+/** The results of an interrupt, NULL if it's out of range
+ */
+const irq_profile_stat_t *irq_profile_irq(int irq);
+
+/** The results of the critical sections, by site in order of first use
+ *
+ *  @param count the number of sites, returned
+ */
+const irq_profile_site_t *irq_profile_sites(uint32_t *count);
+
+/** The mean of a result
+ */
+uint32_t irq_profile_mean(const irq_profile_stat_t *stat);
+
+/** Mark the start and the end of a critical section. A section lasts from
+ *  the first enter to the next exit, as interrupts do.
+ */
+void irq_profile_critical_enter(const char *file, int line);
+void irq_profile_critical_exit(void);
+
+/** Mark the start and the end of a section masking interrupts with BASEPRI,
+ *  timed apart from the ones disabling them, which may be nested in it.
+ */
+void irq_profile_basepri_enter(const char *file, int line);
+void irq_profile_basepri_exit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef MBED_IRQ_PROFILE
+#define IRQ_PROFILE_CRITICAL_ENTER()    irq_profile_critical_enter(__FILE__, __LINE__)
+#define IRQ_PROFILE_CRITICAL_EXIT()     irq_profile_critical_exit()
+#define IRQ_PROFILE_BASEPRI_ENTER()     irq_profile_basepri_enter(__FILE__, __LINE__)
+#define IRQ_PROFILE_BASEPRI_EXIT()      irq_profile_basepri_exit()
+
+/* Time the critical sections of the files including this header; the
+ * names inside the macros are the CMSIS functions */
+#define __disable_irq()     (__disable_irq(), IRQ_PROFILE_CRITICAL_ENTER())
+#define __enable_irq()      (IRQ_PROFILE_CRITICAL_EXIT(), __enable_irq())
+#else
+#define IRQ_PROFILE_CRITICAL_ENTER()
+#define IRQ_PROFILE_CRITICAL_EXIT()
+#define IRQ_PROFILE_BASEPRI_ENTER()
+#define IRQ_PROFILE_BASEPRI_EXIT()
+#endif
+
+#endif
@@ -16,13 +16,19 @@
 #ifndef MBED_WAIT_API_H
 #define MBED_WAIT_API_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /** Generic wait functions.
  *
- * These provide simple NOP type wait capabilities.
+ * Short waits spin on the microsecond ticker. Longer ones leave the CPU to
+ * other threads when called from a thread with an RTOS, or sleep until an
+ * interrupt from the ticker otherwise, and spin only for the end, so they
+ * are as accurate as the short ones. Waits in interrupt handlers, or with
+ * interrupts disabled, always spin.
  *
  * Example:
  * @code
@@ -59,6 +65,16 @@ void wait_ms(int ms);
  */
 void wait_us(int us);
 
+/** Blocks the calling thread for up to a number of microseconds, letting
+ *  other threads run. Implemented by the RTOS; the default returns 0.
+ *
+ *  @param us the most microseconds to block for
+ *  @returns
+ *    1 if the thread was blocked,
+ *    0 if it can't be, and the wait has to sleep or spin instead
+ */
+int wait_thread_us(uint32_t us);
+
 #ifdef __cplusplus
 }
 #endif
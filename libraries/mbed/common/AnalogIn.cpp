@@ -0,0 +1,82 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AnalogIn.h"
+
+#if DEVICE_ANALOGIN
+
+namespace mbed {
+
+#if DEVICE_ANALOGIN_ASYNCH
+
+AnalogIn::~AnalogIn() {
+    abort_read();
+}
+
+int AnalogIn::read_async(uint16_t *buffer, int length, int rate, const event_callback_t& callback, int event, bool continuous) {
+    if ((length <= 0) || (rate <= 0) || analogin_active(&_adc)) {
+        return -1;
+    }
+    _callback = callback;
+    _irq.callback(&AnalogIn::irq_handler_asynch);
+    return analogin_read_asynch(&_adc, buffer, length, rate, continuous, _irq.entry(), event, DMA_USAGE_ALWAYS);
+}
+
+void AnalogIn::abort_read() {
+    analogin_abort_asynch(&_adc);
+}
+
+void AnalogIn::irq_handler_asynch(void) {
+    int event = analogin_irq_handler_asynch(&_adc);
+    if (_callback && (event & SAMPLE_EVENT_ALL)) {
+        _callback.call(event & SAMPLE_EVENT_ALL);
+    }
+}
+
+#else
+
+AnalogIn::~AnalogIn() {
+    delete _sampler;
+}
+
+int AnalogIn::read_async(uint16_t *buffer, int length, int rate, const event_callback_t& callback, int event, bool continuous) {
+    if ((length <= 0) || (rate <= 0) || (rate > 1000000)) {
+        return -1;
+    }
+    if (_sampler == NULL) {
+        _sampler = new SampleTicker();
+    } else if (_sampler->active()) {
+        return -1;
+    }
+    _buffer = buffer;
+    _sampler->start(length, rate, continuous, FunctionPointerArg1<void, int>(this, &AnalogIn::sample), callback, event);
+    return 0;
+}
+
+void AnalogIn::abort_read() {
+    if (_sampler != NULL) {
+        _sampler->stop();
+    }
+}
+
+void AnalogIn::sample(int index) {
+    _buffer[index] = read_u16();
+}
+
+#endif
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,52 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "AnalogOut.h"
+
+#if DEVICE_ANALOGOUT
+
+namespace mbed {
+
+AnalogOut::~AnalogOut() {
+    delete _sampler;
+}
+
+int AnalogOut::write_async(const uint16_t *buffer, int length, int rate, const event_callback_t& callback, int event, bool continuous) {
+    if ((length <= 0) || (rate <= 0) || (rate > 1000000)) {
+        return -1;
+    }
+    if (_sampler == NULL) {
+        _sampler = new SampleTicker();
+    } else if (_sampler->active()) {
+        return -1;
+    }
+    _buffer = buffer;
+    _sampler->start(length, rate, continuous, FunctionPointerArg1<void, int>(this, &AnalogOut::sample), callback, event);
+    return 0;
+}
+
+void AnalogOut::abort_write() {
+    if (_sampler != NULL) {
+        _sampler->stop();
+    }
+}
+
+void AnalogOut::sample(int index) {
+    write_u16(_buffer[index]);
+}
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,264 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "BufferedFileHandle.h"
+#include <string.h>
+
+namespace mbed {
+
+BufferedFileStats BufferedFileHandle::_total;
+
+BufferedFileHandle::BufferedFileHandle(FileHandle *file, size_t size) : _file(file), _size(size),
+        _pos(0), _file_pos(-1), _base(0), _start(0), _end(0), _dirty_start(0), _dirty_end(0) {
+    memset(&_stats, 0, sizeof(_stats));
+    _buffer = (size > 0) ? new char[size] : NULL;
+    if (_buffer == NULL) {
+        // passes the calls through
+        _size = 0;
+    }
+    // where the file system left it, at the end for O_APPEND
+    _pos = _file->lseek(0, SEEK_CUR);
+    if (_pos < 0) {
+        _pos = 0;
+    }
+    _file_pos = _pos;
+}
+
+BufferedFileHandle::~BufferedFileHandle() {
+    if (_file != NULL) {
+        flush();
+        _file->close();
+    }
+    delete[] _buffer;
+}
+
+void BufferedFileHandle::reset_total_stats() {
+    memset(&_total, 0, sizeof(_total));
+}
+
+bool BufferedFileHandle::device_seek(off_t position) {
+    if (_file_pos == position) {
+        return true;
+    }
+    _stats.device_seeks++;
+    _total.device_seeks++;
+    // a file can stop short, as FatFS does reading past the end
+    _file_pos = _file->lseek(position, SEEK_SET);
+    return _file_pos == position;
+}
+
+ssize_t BufferedFileHandle::device_read(off_t position, void *buffer, size_t length) {
+    if (!device_seek(position)) {
+        return 0;
+    }
+    _stats.device_reads++;
+    _total.device_reads++;
+    ssize_t n = _file->read(buffer, length);
+    _file_pos = (n < 0) ? -1 : _file_pos + n;
+    return n;
+}
+
+ssize_t BufferedFileHandle::device_write(off_t position, const void *buffer, size_t length) {
+    if (!device_seek(position)) {
+        return -1;
+    }
+    _stats.device_writes++;
+    _total.device_writes++;
+    ssize_t n = _file->write(buffer, length);
+    _file_pos = (n < 0) ? -1 : _file_pos + n;
+    return n;
+}
+
+int BufferedFileHandle::flush() {
+    if (_dirty_start == _dirty_end) {
+        return 0;
+    }
+    size_t length = _dirty_end - _dirty_start;
+    ssize_t n = device_write(_base + _dirty_start, _buffer + _dirty_start, length);
+    _dirty_start = _dirty_end = 0;
+    if (n != (ssize_t)length) {
+        // what's in the buffer is no longer what's in the file
+        _start = _end = 0;
+        return -1;
+    }
+    return 0;
+}
+
+ssize_t BufferedFileHandle::write(const void *buffer, size_t length) {
+    _stats.writes++;
+    _total.writes++;
+    if (_size == 0) {
+        ssize_t n = device_write(_pos, buffer, length);
+        if (n > 0) {
+            _pos += n;
+        }
+        return n;
+    }
+
+    const char *p = (const char *)buffer;
+    size_t done = 0;
+    while (done < length) {
+        size_t offset = _pos - _base;
+        // the buffer takes the bytes in its block that follow on from the ones it holds
+        if ((_pos < _base) || (offset >= _size) || (offset < _start) || (offset > _end)) {
+            if (flush() < 0) {
+                return done ? (ssize_t)done : -1;
+            }
+            _start = _end = 0;
+
+            size_t left = length - done;
+            if ((_pos % _size == 0) && (left >= _size)) {
+                // whole blocks straight to the file
+                left -= left % _size;
+                ssize_t n = device_write(_pos, p + done, left);
+                if (n <= 0) {
+                    return done ? (ssize_t)done : n;
+                }
+                _pos += n;
+                done += n;
+                if ((size_t)n < left) {
+                    break;
+                }
+                continue;
+            }
+            _base = _pos - _pos % _size;
+            offset = _start = _end = _pos - _base;
+        }
+
+        size_t n = length - done;
+        if (n > _size - offset) {
+            n = _size - offset;
+        }
+        memcpy(_buffer + offset, p + done, n);
+        if (_dirty_start == _dirty_end) {
+            _dirty_start = offset;
+            _dirty_end = offset + n;
+        } else {
+            // whatever lies between them is in the buffer too
+            if (offset < _dirty_start) _dirty_start = offset;
+            if (offset + n > _dirty_end) _dirty_end = offset + n;
+        }
+        if (offset + n > _end) {
+            _end = offset + n;
+        }
+        _pos += n;
+        done += n;
+    }
+    return done;
+}
+
+ssize_t BufferedFileHandle::read(void *buffer, size_t length) {
+    _stats.reads++;
+    _total.reads++;
+    if (_size == 0) {
+        ssize_t n = device_read(_pos, buffer, length);
+        if (n > 0) {
+            _pos += n;
+        }
+        return n;
+    }
+
+    char *p = (char *)buffer;
+    size_t done = 0;
+    while (done < length) {
+        size_t offset = _pos - _base;
+        if ((_pos >= _base) && (offset < _size) && (offset >= _start) && (offset < _end)) {
+            size_t n = length - done;
+            if (n > _end - offset) {
+                n = _end - offset;
+            }
+            memcpy(p + done, _buffer + offset, n);
+            _pos += n;
+            done += n;
+            continue;
+        }
+
+        if (flush() < 0) {
+            return done ? (ssize_t)done : -1;
+        }
+        _start = _end = 0;
+
+        size_t left = length - done;
+        if (left >= _size) {
+            // nothing to gain from the buffer
+            ssize_t n = device_read(_pos, p + done, left);
+            if (n < 0) {
+                return done ? (ssize_t)done : -1;
+            }
+            _pos += n;
+            done += n;
+            break;
+        }
+
+        // read ahead to the end of the block
+        _base = _pos - _pos % _size;
+        ssize_t n = device_read(_base, _buffer, _size);
+        if (n < 0) {
+            return done ? (ssize_t)done : -1;
+        }
+        _end = n;
+        if ((size_t)(_pos - _base) >= _end) {
+            break;  // end of file
+        }
+    }
+    return done;
+}
+
+int BufferedFileHandle::close() {
+    int flushed = flush();
+    int res = _file->close();
+    _file = NULL;
+    delete this;
+    return (flushed < 0) ? -1 : res;
+}
+
+int BufferedFileHandle::isatty() {
+    return _file->isatty();
+}
+
+off_t BufferedFileHandle::lseek(off_t offset, int whence) {
+    // the file is only moved when it's next read or written
+    off_t position;
+    if (whence == SEEK_SET) {
+        position = offset;
+    } else if (whence == SEEK_CUR) {
+        position = _pos + offset;
+    } else if (whence == SEEK_END) {
+        position = flen() + offset;
+    } else {
+        return -1;
+    }
+    if (position < 0) {
+        return -1;
+    }
+    _pos = position;
+    return _pos;
+}
+
+int BufferedFileHandle::fsync() {
+    int flushed = flush();
+    int res = _file->fsync();
+    return (flushed < 0) ? -1 : res;
+}
+
+off_t BufferedFileHandle::flen() {
+    off_t length = _file->flen();
+    if ((_dirty_start != _dirty_end) && (length >= 0) && (_base + (off_t)_dirty_end > length)) {
+        length = _base + _dirty_end;
+    }
+    return length;
+}
+
+} // namespace mbed
@@ -28,6 +28,9 @@ BusIn::BusIn(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, PinName
             _nc_mask |= (1 << i);
         }
     }
+#if DEVICE_PORTIN
+    _ports.init(pins, PIN_INPUT);
+#endif
 }
 
 BusIn::BusIn(PinName pins[16]) {
@@ -38,6 +41,9 @@ BusIn::BusIn(PinName pins[16]) {
             _nc_mask |= (1 << i);
         }
     }
+#if DEVICE_PORTIN
+    _ports.init(pins, PIN_INPUT);
+#endif
 }
 
 BusIn::~BusIn() {
@@ -49,6 +55,9 @@ BusIn::~BusIn() {
 }
 
 int BusIn::read() {
+    if (_ports.grouped()) {
+        return _ports.read();
+    }
     int v = 0;
     for (int i=0; i<16; i++) {
         if (_pin[i] != 0) {
@@ -28,6 +28,9 @@ BusInOut::BusInOut(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, P
             _nc_mask |= (1 << i);
         }
     }
+#if DEVICE_PORTIN && DEVICE_PORTOUT
+    _ports.init(pins, PIN_INPUT);
+#endif
 }
 
 BusInOut::BusInOut(PinName pins[16]) {
@@ -38,6 +41,9 @@ BusInOut::BusInOut(PinName pins[16]) {
             _nc_mask |= (1 << i);
         }
     }
+#if DEVICE_PORTIN && DEVICE_PORTOUT
+    _ports.init(pins, PIN_INPUT);
+#endif
 }
 
 BusInOut::~BusInOut() {
@@ -49,6 +55,10 @@ BusInOut::~BusInOut() {
 }
 
 void BusInOut::write(int value) {
+    if (_ports.grouped()) {
+        _ports.write(value);
+        return;
+    }
     for (int i=0; i<16; i++) {
         if (_pin[i] != 0) {
             _pin[i]->write((value >> i) & 1);
@@ -57,6 +67,9 @@ void BusInOut::write(int value) {
 }
 
 int BusInOut::read() {
+    if (_ports.grouped()) {
+        return _ports.read();
+    }
     int v = 0;
     for (int i=0; i<16; i++) {
         if (_pin[i] != 0) {
@@ -67,6 +80,10 @@ int BusInOut::read() {
 }
 
 void BusInOut::output() {
+    if (_ports.grouped()) {
+        _ports.dir(PIN_OUTPUT);
+        return;
+    }
     for (int i=0; i<16; i++) {
         if (_pin[i] != 0) {
             _pin[i]->output();
@@ -75,6 +92,10 @@ void BusInOut::output() {
 }
 
 void BusInOut::input() {
+    if (_ports.grouped()) {
+        _ports.dir(PIN_INPUT);
+        return;
+    }
     for (int i=0; i<16; i++) {
         if (_pin[i] != 0) {
             _pin[i]->input();
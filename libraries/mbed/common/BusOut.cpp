@@ -28,6 +28,9 @@ BusOut::BusOut(PinName p0, PinName p1, PinName p2, PinName p3, PinName p4, PinNa
             _nc_mask |= (1 << i);
         }
     }
+#if DEVICE_PORTOUT
+    _ports.init(pins, PIN_OUTPUT);
+#endif
 }
 
 BusOut::BusOut(PinName pins[16]) {
@@ -38,6 +41,9 @@ BusOut::BusOut(PinName pins[16]) {
             _nc_mask |= (1 << i);
         }
     }
+#if DEVICE_PORTOUT
+    _ports.init(pins, PIN_OUTPUT);
+#endif
 }
 
 BusOut::~BusOut() {
@@ -49,6 +55,10 @@ BusOut::~BusOut() {
 }
 
 void BusOut::write(int value) {
+    if (_ports.grouped()) {
+        _ports.write(value);
+        return;
+    }
     for (int i=0; i<16; i++) {
         if (_pin[i] != 0) {
             _pin[i]->write((value >> i) & 1);
@@ -57,6 +67,9 @@ void BusOut::write(int value) {
 }
 
 int BusOut::read() {
+    if (_ports.grouped()) {
+        return _ports.read();
+    }
     int v = 0;
     for (int i=0; i<16; i++) {
         if (_pin[i] != 0) {
@@ -0,0 +1,170 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "BusPorts.h"
+
+#if DEVICE_PORTIN || DEVICE_PORTOUT
+#include "port_api.h"
+#endif
+
+namespace mbed {
+
+#if DEVICE_PORTIN || DEVICE_PORTOUT
+
+/* Consecutive bus bits on consecutive bits of a port */
+struct BusPorts::Run {
+    uint16_t mask;  // of the bus bits
+    int8_t shift;   // from the bus bits to the port bits
+};
+
+struct BusPorts::Port {
+    port_t port;
+    Run *run;
+    int runs;
+};
+
+BusPorts::BusPorts() : _runs(0), _ports(0), _nports(0) {
+}
+
+BusPorts::~BusPorts() {
+    delete[] _runs;
+    delete[] _ports;
+}
+
+bool BusPorts::init(const PinName pins[16], PinDirection dir) {
+    PortName names[16];
+    uint32_t masks[16];
+    Run runs[16];
+    int run_port[16];
+    int nports = 0;
+    int nruns = 0;
+    int last_port = -1;
+    int last_bit = -1;
+
+    for (int i=0; i<16; i++) {
+        if (pins[i] == NC) {
+            last_port = -1;
+            continue;
+        }
+        PortName name;
+        int bit = pin_port(pins[i], &name);
+        if (bit < 0) {
+            return false;
+        }
+
+        int p = 0;
+        while ((p < nports) && (names[p] != name)) {
+            p++;
+        }
+        if (p == nports) {
+            names[p] = name;
+            masks[p] = 0;
+            nports++;
+        }
+        masks[p] |= 1UL << bit;
+
+        // carry on with the run of the previous bus bit, or start one
+        if ((p == last_port) && (bit == last_bit + 1)) {
+            runs[nruns - 1].mask |= 1 << i;
+        } else {
+            runs[nruns].mask = 1 << i;
+            runs[nruns].shift = bit - i;
+            run_port[nruns] = p;
+            nruns++;
+        }
+        last_port = p;
+        last_bit = bit;
+    }
+    if (nports == 0) {
+        return false;
+    }
+
+    // the runs of each port together
+    _runs = new Run[nruns];
+    _ports = new Port[nports];
+    int n = 0;
+    for (int p=0; p<nports; p++) {
+        _ports[p].run = &_runs[n];
+        _ports[p].runs = 0;
+        for (int r=0; r<nruns; r++) {
+            if (run_port[r] == p) {
+                _runs[n++] = runs[r];
+                _ports[p].runs++;
+            }
+        }
+        port_init(&_ports[p].port, names[p], (int)masks[p], dir);
+    }
+    _nports = nports;
+    return true;
+}
+
+void BusPorts::write(int value) {
+    for (int p=0; p<_nports; p++) {
+        const Port &port = _ports[p];
+        uint32_t v = 0;
+        for (int r=0; r<port.runs; r++) {
+            const Run &run = port.run[r];
+            uint32_t bits = value & run.mask;
+            v |= (run.shift >= 0) ? (bits << run.shift) : (bits >> -run.shift);
+        }
+        port_write(&_ports[p].port, v);
+    }
+}
+
+int BusPorts::read() {
+    int value = 0;
+    for (int p=0; p<_nports; p++) {
+        const Port &port = _ports[p];
+        uint32_t v = port_read(&_ports[p].port);
+        for (int r=0; r<port.runs; r++) {
+            const Run &run = port.run[r];
+            uint32_t bits = (run.shift >= 0) ? (v >> run.shift) : (v << -run.shift);
+            value |= bits & run.mask;
+        }
+    }
+    return value;
+}
+
+void BusPorts::dir(PinDirection dir) {
+    for (int p=0; p<_nports; p++) {
+        port_dir(&_ports[p].port, dir);
+    }
+}
+
+#else
+
+BusPorts::BusPorts() : _runs(0), _ports(0), _nports(0) {
+}
+
+BusPorts::~BusPorts() {
+}
+
+bool BusPorts::init(const PinName pins[16], PinDirection dir) {
+    return false;
+}
+
+void BusPorts::write(int value) {
+}
+
+int BusPorts::read() {
+    return 0;
+}
+
+void BusPorts::dir(PinDirection dir) {
+}
+
+#endif
+
+} // namespace mbed
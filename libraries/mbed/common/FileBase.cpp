@@ -18,21 +18,44 @@
 namespace mbed {
 
 FileBase *FileBase::_head = NULL;
+FileBase *FileBase::_last = NULL;
+
+// Named objects by hash of their name, chained through _bucket_next
+static FileBase *_buckets[FILEBASE_BUCKETS];
 
 FileBase::FileBase(const char *name, PathType t) : _next(NULL),
+                                                   _bucket_next(NULL),
                                                    _name(name),
+                                                   _len(0),
+                                                   _hash(0),
                                                    _path_type(t) {
     if (name != NULL) {
         // put this object at head of the list
         _next = _head;
         _head = this;
-    } else {
-        _next = NULL;
+
+        // and of its bucket, where it hides older objects of the same name
+        _len = std::strlen(name);
+        _hash = hash(name, _len);
+        FileBase **bucket = &_buckets[_hash & (FILEBASE_BUCKETS - 1)];
+        _bucket_next = *bucket;
+        *bucket = this;
+        _last = NULL;
     }
 }
 
 FileBase::~FileBase() {
     if (_name != NULL) {
+        if (_last == this) {
+            _last = NULL;
+        }
+
+        FileBase **bucket = &_buckets[_hash & (FILEBASE_BUCKETS - 1)];
+        while (*bucket != this) {
+            bucket = &(*bucket)->_bucket_next;
+        }
+        *bucket = _bucket_next;
+
         // remove this object from the list
         if (_head == this) { // first in the list, so just drop me
             _head = _next;
@@ -46,14 +69,29 @@ FileBase::~FileBase() {
     }
 }
 
+// FNV-1a
+uint32_t FileBase::hash(const char *name, unsigned int len) {
+    uint32_t h = 2166136261u;
+    while (len-- > 0) {
+        h ^= (uint8_t)*name++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
 FileBase *FileBase::lookup(const char *name, unsigned int len) {
-    FileBase *p = _head;
-    while (p != NULL) {
+    FileBase *p = _last;
+    if ((p != NULL) && (p->_len == len) && (std::memcmp(p->_name, name, len) == 0)) {
+        return p;
+    }
+
+    uint32_t h = hash(name, len);
+    for (p = _buckets[h & (FILEBASE_BUCKETS - 1)]; p != NULL; p = p->_bucket_next) {
         /* Check that p->_name matches name and is the correct length */
-        if (p->_name != NULL && std::strncmp(p->_name, name, len) == 0 && std::strlen(p->_name) == len) {
+        if ((p->_hash == h) && (p->_len == len) && (std::memcmp(p->_name, name, len) == 0)) {
+            _last = p;
             return p;
         }
-        p = p->_next;
     }
     return NULL;
 }
@@ -17,15 +17,28 @@
 
 #if DEVICE_I2C
 
+#if DEVICE_I2C_ASYNCH
+#include "cmsis.h"
+#include "irq_profile.h"
+#include "us_ticker_api.h"
+#endif
+
 namespace mbed {
 
 I2C *I2C::_owner = NULL;
 
+#if DEVICE_I2C_ASYNCH && TRANSACTION_QUEUE_SIZE_I2C
+CircularBuffer<Transaction<I2C, i2c_transaction_t>, TRANSACTION_QUEUE_SIZE_I2C> I2C::_transaction_buffer;
+#endif
+
 I2C::I2C(PinName sda, PinName scl) :
 #if DEVICE_I2C_ASYNCH
-                                     _irq(this), _usage(DMA_USAGE_NEVER),
+                                     _irq(this), _usage(DMA_USAGE_NEVER), _event(0), _start_us(0),
 #endif
                                       _i2c(), _hz(100000) {
+#if DEVICE_I2C_ASYNCH
+    reset_statistics();
+#endif
     // The init function also set the frequency to 100000
     i2c_init(&_i2c, sda, scl);
 
@@ -94,30 +107,123 @@ void I2C::stop(void) {
 
 int I2C::transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t& callback, int event, bool repeated)
 {
+    // The interrupt ending the current transfer must not miss one queued now
+    __disable_irq();
     if (i2c_active(&_i2c)) {
+#if TRANSACTION_QUEUE_SIZE_I2C
+        i2c_transaction_t t;
+
+        t.address = address;
+        t.tx_buffer = tx_buffer;
+        t.tx_length = tx_length;
+        t.rx_buffer = rx_buffer;
+        t.rx_length = rx_length;
+        t.event = event;
+        t.callback = callback;
+        t.repeated = repeated;
+        Transaction<I2C, i2c_transaction_t> transaction(this, t);
+        if (_transaction_buffer.full()) {
+            __enable_irq();
+            return -1; // the buffer is full
+        }
+        _transaction_buffer.push(transaction);
+        _statistics.queued++;
+        __enable_irq();
+        return 0;
+#else
+        __enable_irq();
         return -1; // transaction ongoing
+#endif
     }
+    __enable_irq();
+
+    start_transfer(address, tx_buffer, tx_length, rx_buffer, rx_length, callback, event, repeated);
+    return 0;
+}
+
+void I2C::start_transfer(int address, const char *tx_buffer, int tx_length, char *rx_buffer, int rx_length, const event_callback_t& callback, int event, bool repeated)
+{
     aquire();
 
     _callback = callback;
+    _event = event;
+    _statistics.bytes += tx_length + rx_length;
+    _start_us = us_ticker_read();
     int stop = (repeated) ? 0 : 1;
     _irq.callback(&I2C::irq_handler_asynch);
-    i2c_transfer_asynch(&_i2c, (void *)tx_buffer, tx_length, (void *)rx_buffer, rx_length, address, stop, _irq.entry(), event, _usage);
-    return 0;
+    // All the events are enabled so that the end of every transfer is seen
+    i2c_transfer_asynch(&_i2c, (void *)tx_buffer, tx_length, (void *)rx_buffer, rx_length, address, stop, _irq.entry(), I2C_EVENT_ALL, _usage);
 }
 
 void I2C::abort_transfer(void)
 {
     i2c_abort_asynch(&_i2c);
+#if TRANSACTION_QUEUE_SIZE_I2C
+    dequeue_transaction();
+#endif
+}
+
+void I2C::clear_transfer_buffer(void)
+{
+#if TRANSACTION_QUEUE_SIZE_I2C
+    _transaction_buffer.reset();
+#endif
 }
 
+void I2C::abort_all_transfers(void)
+{
+    clear_transfer_buffer();
+    abort_transfer();
+}
+
+const I2C::Statistics& I2C::statistics(void) const
+{
+    return _statistics;
+}
+
+void I2C::reset_statistics(void)
+{
+    memset(&_statistics, 0, sizeof(_statistics));
+}
+
+#if TRANSACTION_QUEUE_SIZE_I2C
+
+void I2C::start_transaction(i2c_transaction_t *data)
+{
+    start_transfer(data->address, data->tx_buffer, data->tx_length, data->rx_buffer, data->rx_length, data->callback, data->event, data->repeated);
+}
+
+void I2C::dequeue_transaction(void)
+{
+    Transaction<I2C, i2c_transaction_t> t;
+    if (_transaction_buffer.pop(t)) {
+        I2C* obj = t.get_object();
+        i2c_transaction_t* data = t.get_transaction();
+        obj->start_transaction(data);
+    }
+}
+
+#endif
+
 void I2C::irq_handler_asynch(void)
 {
     int event = i2c_irq_handler_asynch(&_i2c);
-    if (_callback && event) {
-        _callback.call(event);
+    if (!event) {
+        return; // transfer still going
     }
 
+    _statistics.transfers++;
+    _statistics.busy_us += us_ticker_read() - _start_us;
+    if (event & ~I2C_EVENT_TRANSFER_COMPLETE) {
+        _statistics.errors++;
+    }
+    if (_callback && (event & _event)) {
+        _callback.call(event & _event);
+    }
+#if TRANSACTION_QUEUE_SIZE_I2C
+    // The bus is free, the next transfer starts from this interrupt
+    dequeue_transaction();
+#endif
 }
 
 
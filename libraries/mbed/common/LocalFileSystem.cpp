@@ -18,6 +18,7 @@
 #if DEVICE_LOCALFILESYSTEM
 
 #include "semihost_api.h"
+#include "BufferedFileHandle.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -207,7 +208,15 @@ FileHandle *LocalFileSystem::open(const char* name, int flags) {
     if (fh == -1) {
         return NULL;
     }
-    return new LocalFileHandle(fh);
+    LocalFileHandle *file = new LocalFileHandle(fh);
+    if (flags & O_APPEND) {
+        // the host writes at the end, so that is where the handle starts
+        file->lseek(0, SEEK_END);
+    }
+    if (_buffer_size > 0) {
+        return new BufferedFileHandle(file, _buffer_size);
+    }
+    return file;
 }
 
 int LocalFileSystem::remove(const char *filename) {
@@ -0,0 +1,52 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "PwmOut.h"
+
+#if DEVICE_PWMOUT
+
+namespace mbed {
+
+PwmOut::~PwmOut() {
+    delete _sampler;
+}
+
+int PwmOut::write_async(const float *duty, int length, int rate, const event_callback_t& callback, int event, bool continuous) {
+    if ((length <= 0) || (rate <= 0) || (rate > 1000000)) {
+        return -1;
+    }
+    if (_sampler == NULL) {
+        _sampler = new SampleTicker();
+    } else if (_sampler->active()) {
+        return -1;
+    }
+    _duty = duty;
+    _sampler->start(length, rate, continuous, FunctionPointerArg1<void, int>(this, &PwmOut::sample), callback, event);
+    return 0;
+}
+
+void PwmOut::abort_write() {
+    if (_sampler != NULL) {
+        _sampler->stop();
+    }
+}
+
+void PwmOut::sample(int index) {
+    write(_duty[index]);
+}
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,63 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "SampleTicker.h"
+
+namespace mbed {
+
+SampleTicker::SampleTicker() : _length(0), _index(0), _event(0), _continuous(false), _active(false) {
+}
+
+void SampleTicker::start(int length, int rate, bool continuous, const FunctionPointerArg1<void, int>& step, const event_callback_t& callback, int event) {
+    stop();
+    _step = step;
+    _callback = callback;
+    _length = length;
+    _index = 0;
+    _event = event;
+    _continuous = continuous;
+    _active = true;
+    _ticker.attach_us(this, &SampleTicker::tick, 1000000 / rate);
+}
+
+void SampleTicker::stop() {
+    _ticker.detach();
+    _active = false;
+}
+
+void SampleTicker::tick(void) {
+    _step.call(_index);
+
+    int event = 0;
+    _index++;
+    if (_index == _length / 2) {
+        event |= SAMPLE_EVENT_HALF_COMPLETE;
+    }
+    if (_index == _length) {
+        event |= SAMPLE_EVENT_COMPLETE;
+        if (_continuous) {
+            _index = 0;
+        } else {
+            // before the callback, which may start the next buffer
+            stop();
+        }
+    }
+
+    if (_callback && (event & _event)) {
+        _callback.call(event & _event);
+    }
+}
+
+} // namespace mbed
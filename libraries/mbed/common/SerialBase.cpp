@@ -15,21 +15,56 @@
  */
 #include "SerialBase.h"
 #include "wait_api.h"
+#include "Timeout.h"
+#include "SerialRxRing.h"
+#include "cmsis.h"
+#include "irq_profile.h"
 
 #if DEVICE_SERIAL
 
 namespace mbed {
 
+/* The state of read_continuous(), allocated by its first call so that the
+ * other serial ports don't carry it. It is deleted through the virtual
+ * destructor, which keeps ~SerialBase from linking in the Timeout. */
+struct SerialBase::RxContinuous {
+    RxContinuous() : event(0), active(false)
+#if !DEVICE_SERIAL_ASYNCH_CIRCULAR
+                   , chars(0), idle_chars(0)
+#endif
+    {
+    }
+
+    virtual ~RxContinuous() {
+    }
+
+    SerialRxRing ring;
+    event_callback_t callback;
+    int event;
+    bool active;
+#if !DEVICE_SERIAL_ASYNCH_CIRCULAR
+    Timeout idle;
+    uint32_t chars;
+    uint32_t idle_chars;
+#endif
+};
+
 SerialBase::SerialBase(PinName tx, PinName rx) :
 #if DEVICE_SERIAL_ASYNCH
                                                  _thunk_irq(this), _tx_usage(DMA_USAGE_NEVER),
                                                  _rx_usage(DMA_USAGE_NEVER),
 #endif
+                                                _rx_continuous(NULL),
                                                 _serial(), _baud(9600) {
     serial_init(&_serial, tx, rx);
     serial_irq_handler(&_serial, SerialBase::_irq_handler, (uint32_t)this);
 }
 
+SerialBase::~SerialBase() {
+    abort_read_continuous();
+    delete _rx_continuous;
+}
+
 void SerialBase::baud(int baudrate) {
     serial_baud(&_serial, baudrate);
     _baud = baudrate;
@@ -85,6 +120,114 @@ void SerialBase::send_break() {
   serial_break_clear(&_serial);
 }
 
+int SerialBase::read_continuous(uint8_t *buffer, int length, const event_callback_t& callback, int event, unsigned char char_match) {
+#if DEVICE_SERIAL_ASYNCH
+    if (serial_rx_active(&_serial)) {
+        return -1; // transaction ongoing
+    }
+#endif
+    if (_rx_continuous == NULL) {
+        _rx_continuous = new RxContinuous();
+    } else if (_rx_continuous->active) {
+        return -1;
+    }
+    RxContinuous *rx = _rx_continuous;
+    rx->ring.start(buffer, length, char_match);
+    rx->callback = callback;
+    rx->event = event;
+    rx->active = true;
+
+#if DEVICE_SERIAL_ASYNCH_CIRCULAR
+    _thunk_irq.callback(&SerialBase::interrupt_handler_asynch);
+    serial_rx_circular_asynch(&_serial, buffer, length, _thunk_irq.entry(), _rx_usage);
+#else
+    rx->chars = 0;
+    rx->idle_chars = 0;
+    attach(this, &SerialBase::rx_continuous_irq, RxIrq);
+#endif
+    return 0;
+}
+
+int SerialBase::received(const uint8_t **data) {
+    if (_rx_continuous == NULL) {
+        return 0;
+    }
+#if DEVICE_SERIAL_ASYNCH_CIRCULAR
+    // what the DMA wrote since its last interrupt
+    if (_rx_continuous->active) {
+        __disable_irq();
+        _rx_continuous->ring.update(serial_rx_circular_position(&_serial));
+        __enable_irq();
+    }
+#endif
+    return _rx_continuous->ring.span(data);
+}
+
+void SerialBase::consume(int length) {
+    if (_rx_continuous != NULL) {
+        _rx_continuous->ring.consume(length);
+    }
+}
+
+void SerialBase::abort_read_continuous() {
+    if ((_rx_continuous == NULL) || !_rx_continuous->active) {
+        return;
+    }
+    _rx_continuous->active = false;
+#if DEVICE_SERIAL_ASYNCH_CIRCULAR
+    serial_rx_abort_asynch(&_serial);
+#else
+    serial_irq_set(&_serial, (SerialIrq)RxIrq, 0);
+    _rx_continuous->idle.detach();
+#endif
+}
+
+int SerialBase::overruns() {
+    return (_rx_continuous != NULL) ? _rx_continuous->ring.overruns() : 0;
+}
+
+void SerialBase::rx_continuous_event(int event) {
+    RxContinuous *rx = _rx_continuous;
+    if (event & SERIAL_EVENT_RX_OVERRUN_ERROR) {
+        rx->ring.overrun();
+    }
+    event &= rx->event;
+    if (rx->callback && event) {
+        rx->callback.call(event);
+    }
+}
+
+#if !DEVICE_SERIAL_ASYNCH_CIRCULAR
+void SerialBase::rx_continuous_irq(void) {
+    RxContinuous *rx = _rx_continuous;
+    int event = 0;
+    while (serial_readable(&_serial)) {
+        event |= rx->ring.put(serial_getc(&_serial));
+        rx->chars++;
+    }
+
+    /* The line is idle when no character came for two character times,
+     * checked from one Timeout for all the characters of a burst */
+    if (rx->idle_chars == 0) {
+        rx->idle_chars = rx->chars;
+        rx->idle.attach_us(this, &SerialBase::rx_idle_timeout, 20000000 / _baud);
+    }
+    rx_continuous_event(event);
+}
+
+void SerialBase::rx_idle_timeout(void) {
+    RxContinuous *rx = _rx_continuous;
+    if (rx->chars != rx->idle_chars) {
+        rx->idle_chars = rx->chars;
+        rx->idle.attach_us(this, &SerialBase::rx_idle_timeout, 20000000 / _baud);
+        return;
+    }
+    rx->chars = 0;
+    rx->idle_chars = 0;
+    rx_continuous_event(SERIAL_EVENT_RX_IDLE);
+}
+#endif
+
 #if DEVICE_SERIAL_FC
 void SerialBase::set_flow_control(Flow type, PinName flow1, PinName flow2) {
     FlowControl flow_type = (FlowControl)type;
@@ -195,6 +338,13 @@ void SerialBase::interrupt_handler_asynch(void)
 {
     int event = serial_irq_handler_asynch(&_serial);
     int rx_event = event & SERIAL_EVENT_RX_MASK;
+#if DEVICE_SERIAL_ASYNCH_CIRCULAR
+    if ((_rx_continuous != NULL) && _rx_continuous->active) {
+        rx_event |= _rx_continuous->ring.update(serial_rx_circular_position(&_serial));
+        rx_continuous_event(rx_event);
+        rx_event = 0;
+    }
+#endif
     if (_rx_callback && rx_event) {
         _rx_callback.call(rx_event);
     }
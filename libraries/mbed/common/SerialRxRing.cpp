@@ -0,0 +1,122 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "SerialRxRing.h"
+#include "serial_api.h"
+#include "cmsis.h"
+#include "irq_profile.h"
+
+namespace mbed {
+
+SerialRxRing::SerialRxRing() : _buffer(0), _length(0), _head(0), _tail(0), _count(0), _overruns(0),
+                               _char_match(-1), _dropping(false) {
+}
+
+void SerialRxRing::start(uint8_t *buffer, uint32_t length, unsigned char char_match) {
+    _buffer = buffer;
+    _length = length;
+    _head = 0;
+    _tail = 0;
+    _count = 0;
+    _char_match = (char_match == SERIAL_RESERVED_CHAR_MATCH) ? -1 : char_match;
+    _dropping = false;
+}
+
+int SerialRxRing::update(uint32_t position) {
+    if (_length == 0) {
+        return 0;
+    }
+    return advance((position + _length - _head) % _length);
+}
+
+int SerialRxRing::put(uint8_t c) {
+    if (_count == _length) {
+        // one overrun for all the characters dropped until some are consumed
+        if (_dropping) {
+            return 0;
+        }
+        _dropping = true;
+        _overruns++;
+        return SERIAL_EVENT_RX_OVERFLOW;
+    }
+    _buffer[_head] = c;
+    return advance(1);
+}
+
+// The length bytes from _head were written
+int SerialRxRing::advance(uint32_t length) {
+    int event = 0;
+    if (length == 0) {
+        return event;
+    }
+
+    if (_char_match >= 0) {
+        for (uint32_t i = 0, j = _head; i < length; i++) {
+            if (_buffer[j] == _char_match) {
+                event |= SERIAL_EVENT_RX_CHARACTER_MATCH;
+                break;
+            }
+            j = (j + 1 == _length) ? 0 : j + 1;
+        }
+    }
+
+    uint32_t half = _length / 2;
+    uint32_t end = _head + length;
+    if (((_head < half) && (end >= half)) || (end >= _length + half)) {
+        event |= SERIAL_EVENT_RX_HALF_FULL;
+    }
+    if (end >= _length) {
+        event |= SERIAL_EVENT_RX_COMPLETE;
+    }
+    _head = end % _length;
+
+    uint32_t count = _count + length;
+    if (count > _length) {
+        // the receiver wrote over data which wasn't consumed
+        _tail = _head;
+        count = 0;
+        _overruns++;
+        event |= SERIAL_EVENT_RX_OVERFLOW;
+    }
+    _count = count;
+    return event;
+}
+
+uint32_t SerialRxRing::span(const uint8_t **data) {
+    __disable_irq();
+    uint32_t tail = _tail;
+    uint32_t count = _count;
+    __enable_irq();
+
+    *data = &_buffer[tail];
+    return (count < _length - tail) ? count : _length - tail;
+}
+
+void SerialRxRing::consume(uint32_t length) {
+    if (_length == 0) {
+        // not started
+        return;
+    }
+    __disable_irq();
+    if (length > _count) {
+        length = _count;
+    }
+    _tail = (_tail + length) % _length;
+    _count -= length;
+    _dropping = false;
+    __enable_irq();
+}
+
+} // namespace mbed
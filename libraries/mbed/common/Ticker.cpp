@@ -26,14 +26,14 @@ void Ticker::detach() {
     _function.attach(0);
 }
 
-void Ticker::setup(timestamp_t t) {
+void Ticker::setup(us_timestamp_t t) {
     remove();
     _delay = t;
-    insert(_delay + ticker_read(_ticker_data));
+    insert_absolute(_delay + ticker_read_us(_ticker_data), _slack);
 }
 
 void Ticker::handler() {
-    insert(event.timestamp + _delay);
+    insert_absolute(event.timestamp + _delay, _slack);
     _function.call();
 }
 
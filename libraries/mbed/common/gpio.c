@@ -14,6 +14,16 @@
  * limitations under the License.
  */
 #include "gpio_api.h"
+#include "toolchain.h"
+
+#if DEVICE_PORTIN || DEVICE_PORTOUT
+#include "port_api.h"
+
+/* Targets override this so that buses are accessed a port at a time */
+WEAK int pin_port(PinName pin, PortName *port) {
+    return -1;
+}
+#endif
 
 static inline void _gpio_init_in(gpio_t* gpio, PinName pin, PinMode mode)
 {
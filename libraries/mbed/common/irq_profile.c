@@ -0,0 +1,198 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "irq_profile.h"
+#include "us_ticker_api.h"
+
+#if defined(NVIC_NUM_VECTORS)
+#define IRQ_PROFILE_IRQS    (NVIC_NUM_VECTORS - NVIC_USER_IRQ_OFFSET)
+#else
+#define IRQ_PROFILE_IRQS    1   // no vector table to wrap, only critical sections
+#endif
+
+static irq_profile_stat_t irqs[IRQ_PROFILE_IRQS];
+static irq_profile_site_t sites[IRQ_PROFILE_SITES + 1];
+static uint32_t site_count;
+
+/* A critical section being timed. The sections masking with PRIMASK and
+ * with BASEPRI overlap in any order, so each kind has its own. */
+typedef struct {
+    const char *file;
+    int line;
+    uint32_t start;
+} section_t;
+
+static section_t critical;
+static section_t basepri;
+
+static void stat_add(irq_profile_stat_t *stat, uint32_t cycles) {
+    stat->count++;
+    stat->total += cycles;
+    if (cycles > stat->max) {
+        stat->max = cycles;
+    }
+}
+
+static uint32_t cycles(void) {
+#if defined(__CORTEX_M) && (__CORTEX_M >= 0x03)
+    return DWT->CYCCNT;
+#else
+    return us_ticker_read();
+#endif
+}
+
+uint32_t irq_profile_frequency(void) {
+#if defined(__CORTEX_M) && (__CORTEX_M >= 0x03)
+    return SystemCoreClock;
+#else
+    return 1000000;
+#endif
+}
+
+void irq_profile_record_irq(int irq, uint32_t cycles) {
+    if ((irq >= 0) && (irq < IRQ_PROFILE_IRQS)) {
+        stat_add(&irqs[irq], cycles);
+    }
+}
+
+/* Sites are told apart by the pointer to the file name, which is quicker
+ * than comparing it; irq_profile.py merges the names that are the same */
+void irq_profile_record_critical(const char *file, int line, uint32_t cycles) {
+    uint32_t i;
+    for (i = 0; i < site_count; i++) {
+        if ((sites[i].file == file) && (sites[i].line == line)) {
+            break;
+        }
+    }
+    if (i == site_count) {
+        if (site_count < IRQ_PROFILE_SITES) {
+            sites[i].file = file;
+            sites[i].line = line;
+            site_count++;
+        } else {
+            i = IRQ_PROFILE_SITES;
+        }
+    }
+    stat_add(&sites[i].stat, cycles);
+}
+
+const irq_profile_stat_t *irq_profile_irq(int irq) {
+    if ((irq < 0) || (irq >= IRQ_PROFILE_IRQS)) {
+        return NULL;
+    }
+    return &irqs[irq];
+}
+
+const irq_profile_site_t *irq_profile_sites(uint32_t *count) {
+    // the sites past the table are only counted once it's full, right after it
+    *count = site_count + (sites[IRQ_PROFILE_SITES].stat.count ? 1 : 0);
+    return sites;
+}
+
+uint32_t irq_profile_mean(const irq_profile_stat_t *stat) {
+    return stat->count ? (uint32_t)(stat->total / stat->count) : 0;
+}
+
+void irq_profile_reset(void) {
+    memset(irqs, 0, sizeof(irqs));
+    memset(sites, 0, sizeof(sites));
+    site_count = 0;
+    critical.file = NULL;
+    basepri.file = NULL;
+}
+
+static void section_enter(section_t *section, const char *file, int line) {
+    if (section->file == NULL) {
+        section->file = file;
+        section->line = line;
+        section->start = cycles();
+    }
+}
+
+static void section_exit(section_t *section) {
+    if (section->file != NULL) {
+        irq_profile_record_critical(section->file, section->line, cycles() - section->start);
+        section->file = NULL;
+    }
+}
+
+void irq_profile_critical_enter(const char *file, int line) {
+    section_enter(&critical, file, line);
+}
+
+void irq_profile_critical_exit(void) {
+    section_exit(&critical);
+}
+
+void irq_profile_basepri_enter(const char *file, int line) {
+    section_enter(&basepri, file, line);
+}
+
+void irq_profile_basepri_exit(void) {
+    section_exit(&basepri);
+}
+
+#if defined(__CORTEX_M) && defined(NVIC_NUM_VECTORS)
+/* The original handlers, called by the wrapper. The time of a handler
+ * includes the handlers of higher priority interrupts nested in it. */
+static uint32_t handlers[IRQ_PROFILE_IRQS];
+
+static void irq_profile_handler(void) {
+    int irq = (int)__get_IPSR() - NVIC_USER_IRQ_OFFSET;
+    uint32_t start = cycles();
+    ((void (*)(void))handlers[irq])();
+    irq_profile_record_irq(irq, cycles() - start);
+}
+
+void irq_profile_start(void) {
+#if (__CORTEX_M >= 0x03)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#else
+    us_ticker_read();
+#endif
+    for (int irq = 0; irq < IRQ_PROFILE_IRQS; irq++) {
+        uint32_t vector = NVIC_GetVector((IRQn_Type)irq);
+        if (vector != (uint32_t)irq_profile_handler) {
+            handlers[irq] = vector;
+            NVIC_SetVector((IRQn_Type)irq, (uint32_t)irq_profile_handler);
+        }
+    }
+}
+#else
+void irq_profile_start(void) {
+}
+#endif
+
+void irq_profile_dump(void) {
+    uint32_t count;
+    const irq_profile_site_t *site = irq_profile_sites(&count);
+
+    printf("{{irq_profile;%lu}}\r\n", (unsigned long)irq_profile_frequency());
+    for (int irq = 0; irq < IRQ_PROFILE_IRQS; irq++) {
+        if (irqs[irq].count > 0) {
+            printf("{{irq;%d;%lu;%lu;%lu}}\r\n", irq, (unsigned long)irqs[irq].count,
+                   (unsigned long)irqs[irq].max, (unsigned long)irq_profile_mean(&irqs[irq]));
+        }
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        printf("{{critical;%s:%d;%lu;%lu;%lu}}\r\n", site[i].file ? site[i].file : "other", site[i].line,
+               (unsigned long)site[i].stat.count, (unsigned long)site[i].stat.max,
+               (unsigned long)irq_profile_mean(&site[i].stat));
+    }
+    printf("{{irq_profile_end}}\r\n");
+}
@@ -13,23 +13,50 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <stddef.h>
 #include "pinmap.h"
 #include "mbed_error.h"
+#include "toolchain.h"
+
+WEAK const PinMapIndex *pinmap_index(void) {
+    static const PinMapIndex none = {NULL, NULL, 0, 0};
+    return &none;
+}
+
+/* The first entry of a pin, NULL if there's none */
+static const PinMap *pinmap_find(PinName pin, const PinMap *map) {
+    const PinMapIndex *index;
+    for (index = pinmap_index(); index->map != NULL; index++) {
+        if (index->map == map) {
+            int i = (int)pin - index->first;
+            if ((i < 0) || (i >= index->count) || (index->entry[i] == 0))
+                return NULL;
+            return &map[index->entry[i] - 1];
+        }
+    }
+
+    while (map->pin != NC) {
+        if (map->pin == pin)
+            return map;
+        map++;
+    }
+    return NULL;
+}
 
 void pinmap_pinout(PinName pin, const PinMap *map) {
+    const PinMap *entry;
     if (pin == NC)
         return;
 
-    while (map->pin != NC) {
-        if (map->pin == pin) {
-            pin_function(pin, map->function);
-
-            pin_mode(pin, PullNone);
-            return;
-        }
-        map++;
+    entry = pinmap_find(pin, map);
+    if (entry == NULL) {
+        error("could not pinout");
+        return;
     }
-    error("could not pinout");
+
+    pin_function(pin, entry->function);
+
+    pin_mode(pin, PullNone);
 }
 
 uint32_t pinmap_merge(uint32_t a, uint32_t b) {
@@ -49,12 +76,8 @@ uint32_t pinmap_merge(uint32_t a, uint32_t b) {
 }
 
 uint32_t pinmap_find_peripheral(PinName pin, const PinMap* map) {
-    while (map->pin != NC) {
-        if (map->pin == pin)
-            return map->peripheral;
-        map++;
-    }
-    return (uint32_t)NC;
+    const PinMap *entry = pinmap_find(pin, map);
+    return (entry != NULL) ? (uint32_t)entry->peripheral : (uint32_t)NC;
 }
 
 uint32_t pinmap_peripheral(PinName pin, const PinMap* map) {
@@ -69,12 +92,8 @@ uint32_t pinmap_peripheral(PinName pin, const PinMap* map) {
 }
 
 uint32_t pinmap_find_function(PinName pin, const PinMap* map) {
-    while (map->pin != NC) {
-        if (map->pin == pin)
-            return map->function;
-        map++;
-    }
-    return (uint32_t)NC;
+    const PinMap *entry = pinmap_find(pin, map);
+    return (entry != NULL) ? (uint32_t)entry->function : (uint32_t)NC;
 }
 
 uint32_t pinmap_function(PinName pin, const PinMap* map) {
@@ -64,18 +64,52 @@ extern const char __stdout_name[] = "/stdout";
 extern const char __stderr_name[] = "/stderr";
 #endif
 
+/* Macro MBED_OPEN_MAX
+ *  Files that can be open at once, besides stdin, stdout and stderr.
+ */
+#ifndef MBED_OPEN_MAX
+#define MBED_OPEN_MAX   OPEN_MAX
+#endif
+
 /* newlib has the filehandle field in the FILE struct as a short, so
  * we can't just return a Filehandle* from _open and instead have to
  * put it in a filehandles array and return the index into that array
  * (or rather index+3, as filehandles 0-2 are stdin/out/err).
  */
-static FileHandle *filehandles[OPEN_MAX];
+static FileHandle *filehandles[MBED_OPEN_MAX];
+
+/* The slots from filehandles_top up have never been used, and the ones
+ * freed since are chained from filehandles_free through filehandles_next,
+ * as index + 1 with 0 ending the chain, so that opening a file doesn't
+ * search the table for a slot.
+ */
+static unsigned int filehandles_top;
+static unsigned int filehandles_free;
+static unsigned short filehandles_next[MBED_OPEN_MAX];
+
+static int filehandle_alloc(void) {
+    if (filehandles_free != 0) {
+        unsigned int fh_i = filehandles_free - 1;
+        filehandles_free = filehandles_next[fh_i];
+        return fh_i;
+    }
+    if (filehandles_top < MBED_OPEN_MAX) {
+        return filehandles_top++;
+    }
+    return -1;
+}
+
+static void filehandle_free(unsigned int fh_i) {
+    filehandles[fh_i] = NULL;
+    filehandles_next[fh_i] = filehandles_free;
+    filehandles_free = fh_i + 1;
+}
 
 FileHandle::~FileHandle() {
     /* Remove all open filehandles for this */
-    for (unsigned int fh_i = 0; fh_i < sizeof(filehandles)/sizeof(*filehandles); fh_i++) {
+    for (unsigned int fh_i = 0; fh_i < filehandles_top; fh_i++) {
         if (filehandles[fh_i] == this) {
-            filehandles[fh_i] = NULL;
+            filehandle_free(fh_i);
         }
     }
 }
@@ -149,16 +183,14 @@ extern "C" FILEHANDLE PREFIX(_open)(const char* name, int openmode) {
     }
     #endif
 
-    // find the first empty slot in filehandles
-    unsigned int fh_i;
-    for (fh_i = 0; fh_i < sizeof(filehandles)/sizeof(*filehandles); fh_i++) {
-        if (filehandles[fh_i] == NULL) break;
-    }
-    if (fh_i >= sizeof(filehandles)/sizeof(*filehandles)) {
+    // check there's a slot left before opening anything
+    if ((filehandles_free == 0) && (filehandles_top >= MBED_OPEN_MAX)) {
+        errno = EMFILE;
         return -1;
     }
 
     FileHandle *res;
+    bool opened = false;
 
     /* FILENAME: ":0x12345678" describes a FileLike* */
     if (name[0] == ':') {
@@ -179,10 +211,21 @@ extern "C" FILEHANDLE PREFIX(_open)(const char* name, int openmode) {
             if (fs == NULL) return -1;
             int posix_mode = openmode_to_posix(openmode);
             res = fs->open(path.fileName(), posix_mode); /* NULL if fails */
+            opened = true;
         }
     }
 
     if (res == NULL) return -1;
+    int fh_i = filehandle_alloc();
+    if (fh_i < 0) {
+        // the last slot was taken while opening, by another thread; a
+        // FileLike named directly stays open for its owner
+        if (opened) {
+            res->close();
+        }
+        errno = EMFILE;
+        return -1;
+    }
     filehandles[fh_i] = res;
 
     return fh_i + 3; // +3 as filehandles 0-2 are stdin/out/err
@@ -192,8 +235,8 @@ extern "C" int PREFIX(_close)(FILEHANDLE fh) {
     if (fh < 3) return 0;
 
     FileHandle* fhc = filehandles[fh-3];
-    filehandles[fh-3] = NULL;
     if (fhc == NULL) return -1;
+    filehandle_free(fh-3);
 
     return fhc->close();
 }
@@ -18,6 +18,7 @@
 #include <time.h>
 #include "rtc_time.h"
 #include "us_ticker_api.h"
+#include "irq_profile.h"
 
 #if DEVICE_RTC
 static void (*_rtc_init)(void) = rtc_init;
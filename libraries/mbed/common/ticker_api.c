@@ -16,49 +16,125 @@
 #include <stddef.h>
 #include "ticker_api.h"
 #include "cmsis.h"
+#include "irq_profile.h"
 
-void ticker_set_handler(const ticker_data_t *const data, ticker_event_handler handler) {
+/* Bring present_time up to the ticker, with interrupts disabled */
+static void update_present_time(const ticker_data_t *const data) {
+    ticker_event_queue_t *queue = data->queue;
+    uint32_t ticks = data->interface->read();
+
+    queue->present_time += (uint32_t)(ticks - queue->tick_last_read);
+    queue->tick_last_read = ticks;
+    queue->sequence++;
+}
+
+/* Set the interrupt for the earliest time an event must be handled by, or
+ * sooner if needed to keep present_time updated, with interrupts disabled.
+ * The events are in timestamp order, so none after the first whose
+ * timestamp is past that time can lower it. */
+static void schedule_interrupt(const ticker_data_t *const data) {
+    ticker_event_queue_t *queue = data->queue;
+    ticker_event_t *p;
+
+    update_present_time(data);
+    us_timestamp_t next = queue->present_time + TICKER_MAX_DELTA;
+    for (p = queue->head; (p != NULL) && (p->timestamp < next); p = p->next) {
+        if (p->timestamp + p->slack < next) {
+            next = p->timestamp + p->slack;
+        }
+    }
+    if (next < queue->present_time) {
+        next = queue->present_time;
+    }
+    queue->next_interrupt = next;
+    data->interface->set_interrupt((timestamp_t)next);
+
+    /* The match only fires when the counter gets to it, so one the counter
+     * had already passed when it was written would come a wrap later: set
+     * it ahead of the counter again, further each time, until it is. */
+    timestamp_t match = (timestamp_t)next;
+    uint32_t ahead = 1;
+    while ((int32_t)(data->interface->read() - match) >= 0) {
+        match = data->interface->read() + ahead;
+        data->interface->set_interrupt(match);
+        ahead *= 2;
+    }
+}
+
+/* Start present_time in step with the ticker, so that their low 32 bits
+ * agree, and the interrupt that keeps it so */
+static void initialize(const ticker_data_t *const data) {
+    ticker_event_queue_t *queue = data->queue;
+    if (queue->initialized) {
+        return;
+    }
     data->interface->init();
 
+    __disable_irq();
+    if (!queue->initialized) {
+        queue->tick_last_read = data->interface->read();
+        queue->present_time = queue->tick_last_read;
+        queue->initialized = 1;
+        schedule_interrupt(data);
+    }
+    __enable_irq();
+}
+
+void ticker_set_handler(const ticker_data_t *const data, ticker_event_handler handler) {
+    initialize(data);
+
     data->queue->event_handler = handler;
 }
 
 void ticker_irq_handler(const ticker_data_t *const data) {
     data->interface->clear_interrupt();
+    data->queue->interrupts++;
 
     /* Go through all the pending TimerEvents */
     while (1) {
-        if (data->queue->head == NULL) {
-            // There are no more TimerEvents left, so disable matches.
-            data->interface->disable_interrupt();
-            return;
-        }
+        __disable_irq();
+        update_present_time(data);
 
-        if ((int)(data->queue->head->timestamp - data->interface->read()) <= 0) {
+        ticker_event_t *p = data->queue->head;
+        if ((p != NULL) && (p->timestamp <= data->queue->present_time)) {
             // This event was in the past:
             //      point to the following one and execute its handler
-            ticker_event_t *p = data->queue->head;
-            data->queue->head = data->queue->head->next;
+            data->queue->head = p->next;
+            data->queue->events++;
+            __enable_irq();
             if (data->queue->event_handler != NULL) {
                 (*data->queue->event_handler)(p->id); // NOTE: the handler can set new events
             }
             /* Note: We continue back to examining the head because calling the
              * event handler may have altered the chain of pending events. */
         } else {
-            // This event and the following ones in the list are in the future:
-            //      set it as next interrupt and return
-            data->interface->set_interrupt(data->queue->head->timestamp);
+            // This event and the following ones in the list are in the future,
+            // or there are none: set the next interrupt and return
+            schedule_interrupt(data);
+            __enable_irq();
             return;
         }
     }
 }
 
 void ticker_insert_event(const ticker_data_t *const data, ticker_event_t *obj, timestamp_t timestamp, uint32_t id) {
+    us_timestamp_t now = ticker_read_us(data);
+
+    /* The nearest time with the low bits of timestamp, which may be in the
+     * past but not before the ticker started */
+    int64_t time = (int64_t)now + (int32_t)(timestamp - (timestamp_t)now);
+    ticker_insert_event_us64(data, obj, (time < 0) ? 0 : (us_timestamp_t)time, 0, id);
+}
+
+void ticker_insert_event_us64(const ticker_data_t *const data, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t slack, uint32_t id) {
+    initialize(data);
+
     /* disable interrupts for the duration of the function */
     __disable_irq();
 
     // initialise our data
     obj->timestamp = timestamp;
+    obj->slack = slack;
     obj->id = id;
 
     /* Go through the list until we either reach the end, or find
@@ -67,22 +143,25 @@ void ticker_insert_event(const ticker_data_t *const data, ticker_event_t *obj, t
     ticker_event_t *prev = NULL, *p = data->queue->head;
     while (p != NULL) {
         /* check if we come before p */
-        if ((int)(timestamp - p->timestamp) < 0) {
+        if (timestamp < p->timestamp) {
             break;
         }
         /* go to the next element */
         prev = p;
         p = p->next;
     }
+    /* if we're at the end p will be NULL, which is correct */
+    obj->next = p;
     /* if prev is NULL we're at the head */
     if (prev == NULL) {
         data->queue->head = obj;
-        data->interface->set_interrupt(timestamp);
     } else {
         prev->next = obj;
     }
-    /* if we're at the end p will be NULL, which is correct */
-    obj->next = p;
+    /* the interrupt set for the events already there may be too late */
+    if (timestamp + slack < data->queue->next_interrupt) {
+        schedule_interrupt(data);
+    }
 
     __enable_irq();
 }
@@ -94,11 +173,7 @@ void ticker_remove_event(const ticker_data_t *const data, ticker_event_t *obj) {
     if (data->queue->head == obj) {
         // first in the list, so just drop me
         data->queue->head = obj->next;
-        if (data->queue->head == NULL) {
-            data->interface->disable_interrupt();
-        } else {
-            data->interface->set_interrupt(data->queue->head->timestamp);
-        }
+        schedule_interrupt(data);
     } else {
         // find the object before me, then drop me
         ticker_event_t* p = data->queue->head;
@@ -119,6 +194,25 @@ timestamp_t ticker_read(const ticker_data_t *const data)
     return data->interface->read();
 }
 
+us_timestamp_t ticker_read_us(const ticker_data_t *const data)
+{
+    ticker_event_queue_t *queue = data->queue;
+    uint32_t sequence;
+    us_timestamp_t time;
+
+    initialize(data);
+
+    /* Updates are made with interrupts disabled, so an update can only have
+     * happened between the reads if the sequence changed */
+    do {
+        sequence = queue->sequence;
+        time = queue->present_time;
+        time += (uint32_t)(data->interface->read() - queue->tick_last_read);
+    } while (sequence != queue->sequence);
+
+    return time;
+}
+
 int ticker_get_next_timestamp(const ticker_data_t *const data, timestamp_t *timestamp)
 {
     int ret = 0;
@@ -126,7 +220,7 @@ int ticker_get_next_timestamp(const ticker_data_t *const data, timestamp_t *time
     /* if head is NULL, there are no pending events */
     __disable_irq();
     if (data->queue->head != NULL) {
-        *timestamp = data->queue->head->timestamp;
+        *timestamp = (timestamp_t)data->queue->head->timestamp;
         ret = 1;
     }
     __enable_irq();
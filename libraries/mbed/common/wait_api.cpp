@@ -0,0 +1,110 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "wait_api.h"
+#include "us_ticker_api.h"
+#include "sleep_api.h"
+#include "TimerEvent.h"
+#include "toolchain.h"
+#include "cmsis.h"
+
+/* Waits longer than WAIT_SPIN_US plus the time it takes to wake up from
+ * sleep are slept, or left to other threads with an RTOS, and spun only
+ * for the end, so that they are as accurate as a spin.
+ */
+#ifndef WAIT_SPIN_US
+#define WAIT_SPIN_US    100
+#endif
+
+using namespace mbed;
+
+namespace {
+
+class Wakeup : public TimerEvent {
+public:
+    Wakeup(timestamp_t timestamp) : fired(false) {
+        insert(timestamp);
+    }
+
+    volatile bool fired;
+
+protected:
+    virtual void handler() {
+        fired = true;
+    }
+};
+
+/* How late the return from sleep was lately, from the ticker interrupt to
+ * the wait; rises at once and falls slowly, so that one slow wake up
+ * doesn't make every wait spin */
+uint32_t wake_us = WAIT_SPIN_US;
+
+// Where the wait can't block on an interrupt, it spins
+bool can_block(void) {
+#if defined(__CORTEX_M)
+    return (__get_IPSR() == 0) && (__get_PRIMASK() == 0);
+#else
+    return false;
+#endif
+}
+
+void sleep_until(uint32_t timestamp) {
+    Wakeup wakeup(timestamp);
+
+    /* the interrupt stays pending over the test, so it can't be missed; the
+     * time is tested too, in case the wake up was already due */
+    __disable_irq();
+    while (!wakeup.fired && ((int32_t)(timestamp - us_ticker_read()) > 0)) {
+        sleep();
+        __enable_irq();
+        __disable_irq();
+    }
+    __enable_irq();
+
+    uint32_t late = us_ticker_read() - timestamp;
+    if (late > wake_us) {
+        wake_us = late;
+    } else {
+        wake_us -= (wake_us - late) / 8;
+    }
+}
+
+}
+
+extern "C" {
+
+WEAK int wait_thread_us(uint32_t us) {
+    return 0;
+}
+
+void wait(float s) {
+    wait_us(s * 1000000.0f);
+}
+
+void wait_ms(int ms) {
+    wait_us(ms * 1000);
+}
+
+void wait_us(int us) {
+    uint32_t start = us_ticker_read();
+    if ((us > (int)(wake_us + WAIT_SPIN_US)) && can_block()) {
+        if (!wait_thread_us(us - WAIT_SPIN_US)) {
+            sleep_until(start + us - wake_us);
+        }
+    }
+    while ((us_ticker_read() - start) < (uint32_t)us);
+}
+
+}
@@ -17,6 +17,8 @@
 #define MBED_ANALOGIN_API_H
 
 #include "device.h"
+#include "dma_api.h"
+#include "buffer.h"
 
 #if DEVICE_ANALOGIN
 
@@ -30,6 +32,50 @@ void     analogin_init    (analogin_t *obj, PinName pin);
 float    analogin_read    (analogin_t *obj);
 uint16_t analogin_read_u16(analogin_t *obj);
 
+#if DEVICE_ANALOGIN_ASYNCH
+
+/** Start reading samples at a fixed rate into a buffer
+ *
+ * Each sample is a value as returned by analogin_read_u16. Only one read runs
+ * at a time on a target.
+ *
+ * @param[in] obj        The analogin object to sample
+ * @param[in] buffer     The buffer for the samples
+ * @param[in] length     The number of samples in the buffer
+ * @param[in] rate       The samples per second
+ * @param[in] continuous Non-zero to fill the buffer over and over until aborted
+ * @param[in] handler    Analogin interrupt handler
+ * @param[in] event      The logical OR of the SAMPLE_EVENT events to be registered
+ * @param[in] hint       A suggestion for how to use DMA with this read
+ * @return 0 if the read started, -1 if a read is running, the rate is more than
+ *         the ADC converts or the ADC of the pin can't be read this way
+ */
+int analogin_read_asynch(analogin_t *obj, uint16_t *buffer, size_t length, uint32_t rate, int continuous, uint32_t handler, uint32_t event, DMAUsage hint);
+
+/** The asynchronous IRQ handler
+ *
+ * Clears the interrupt and stops a read that's complete and not continuous,
+ * or that overran.
+ * @param[in] obj The analogin object which holds the read
+ * @return the registered events that occurred or 0
+ */
+uint32_t analogin_irq_handler_asynch(analogin_t *obj);
+
+/** Check if a read of this analogin is running
+ *
+ * @param[in] obj The analogin object to check
+ * @return non-zero if a read of obj is running or zero if not
+ */
+uint8_t analogin_active(analogin_t *obj);
+
+/** Abort a read, if obj holds the running one
+ *
+ * @param[in] obj The analogin object which holds the read
+ */
+void analogin_abort_asynch(analogin_t *obj);
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,4 +27,11 @@ typedef struct buffer_s {
     uint8_t  width;  /**< The buffer unit width (8, 16, 32, 64), used for proper *buffer casting */
 } buffer_t;
 
+/** Events of the transfer of a buffer of samples at a fixed rate
+ */
+#define SAMPLE_EVENT_HALF_COMPLETE (1 << 1) /**< the first half of the buffer is done */
+#define SAMPLE_EVENT_COMPLETE      (1 << 2) /**< the whole buffer is done */
+#define SAMPLE_EVENT_OVERRUN       (1 << 3) /**< samples were lost, the transfer is stopped */
+#define SAMPLE_EVENT_ALL           (SAMPLE_EVENT_HALF_COMPLETE | SAMPLE_EVENT_COMPLETE | SAMPLE_EVENT_OVERRUN)
+
 #endif
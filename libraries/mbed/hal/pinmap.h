@@ -28,6 +28,16 @@ typedef struct {
     int function;
 } PinMap;
 
+/* The entries of a PinMap array by PinName, from the first pin in it
+ * (entry + 1, 0 for the pins it doesn't have), generated into the
+ * PeripheralPins.c of the targets by workspace_tools/pinmap_index.py */
+typedef struct {
+    const PinMap *map;
+    const uint8_t *entry;
+    int first;
+    int count;
+} PinMapIndex;
+
 void pin_function(PinName pin, int function);
 void pin_mode    (PinName pin, PinMode mode);
 
@@ -38,6 +48,10 @@ void     pinmap_pinout    (PinName pin, const PinMap *map);
 uint32_t pinmap_find_peripheral(PinName pin, const PinMap* map);
 uint32_t pinmap_find_function(PinName pin, const PinMap* map);
 
+/* The indexes of the target's PinMap arrays, ending with a NULL map; the
+ * arrays without one are scanned */
+const PinMapIndex *pinmap_index(void);
+
 #ifdef __cplusplus
 }
 #endif
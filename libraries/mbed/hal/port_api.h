@@ -28,6 +28,10 @@ typedef struct port_s port_t;
 
 PinName port_pin(PortName port, int pin_n);
 
+/* The port of pin, and its bit in the port as the result, or -1 on targets
+ * that don't implement it (the default is weak) */
+int pin_port(PinName pin, PortName *port);
+
 void port_init (port_t *obj, PortName port, int mask, PinDirection dir);
 void port_mode (port_t *obj, PinMode mode);
 void port_dir  (port_t *obj, PinDirection dir);
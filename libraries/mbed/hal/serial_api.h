@@ -26,7 +26,7 @@
 #define SERIAL_EVENT_RX_SHIFT (8)
 
 #define SERIAL_EVENT_TX_MASK (0x00FC)
-#define SERIAL_EVENT_RX_MASK (0x3F00)
+#define SERIAL_EVENT_RX_MASK (0xFF00)
 
 #define SERIAL_EVENT_ERROR (1 << 1)
 
@@ -53,6 +53,9 @@
 #define SERIAL_EVENT_RX_ALL             (SERIAL_EVENT_RX_OVERFLOW | SERIAL_EVENT_RX_PARITY_ERROR | \
                                          SERIAL_EVENT_RX_FRAMING_ERROR | SERIAL_EVENT_RX_OVERRUN_ERROR | \
                                          SERIAL_EVENT_RX_COMPLETE | SERIAL_EVENT_RX_CHARACTER_MATCH)
+/* Continuous reception only, where SERIAL_EVENT_RX_COMPLETE is the end of the buffer */
+#define SERIAL_EVENT_RX_HALF_FULL       (1 << (SERIAL_EVENT_RX_SHIFT + 6))
+#define SERIAL_EVENT_RX_IDLE            (1 << (SERIAL_EVENT_RX_SHIFT + 7))
 /**@}*/
 
 #define SERIAL_RESERVED_CHAR_MATCH (255)
@@ -289,6 +292,32 @@ void serial_tx_abort_asynch(serial_t *obj);
  */
 void serial_rx_abort_asynch(serial_t *obj);
 
+#if DEVICE_SERIAL_ASYNCH_CIRCULAR
+
+/** Begin continuous RX into a circular buffer, which the receiver goes back
+ *  to the start of at its end and doesn't stop until aborted by
+ *  serial_rx_abort_asynch. serial_irq_handler_asynch returns
+ *  SERIAL_EVENT_RX_HALF_FULL and SERIAL_EVENT_RX_COMPLETE as the receiver
+ *  passes the middle and the end of the buffer, SERIAL_EVENT_RX_IDLE when
+ *  the line goes idle after a character and the error events.
+ *
+ * @param obj        The serial object
+ * @param rx         The buffer for receiving
+ * @param rx_length  The length of the buffer in bytes
+ * @param handler    The serial handler
+ * @param hint       A suggestion for how to use DMA with this transfer
+ */
+void serial_rx_circular_asynch(serial_t *obj, void *rx, size_t rx_length, uint32_t handler, DMAUsage hint);
+
+/** The position in the circular buffer the receiver writes next
+ *
+ * @param obj The serial object
+ * @return The index in the buffer
+ */
+int serial_rx_circular_position(serial_t *obj);
+
+#endif
+
 /**@}*/
 
 #endif
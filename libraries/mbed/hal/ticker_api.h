@@ -20,10 +20,18 @@
 
 typedef uint32_t timestamp_t;
 
+/** A timestamp extended to 64 bits, which doesn't wrap
+ */
+typedef uint64_t us_timestamp_t;
+
 /** Ticker's event structure
+ *
+ * An event may be handled up to slack microseconds after its timestamp, so
+ * that events close together are handled in one interrupt.
  */
 typedef struct ticker_event_s {
-    timestamp_t            timestamp; /**< Event's timestamp */
+    us_timestamp_t         timestamp; /**< Event's timestamp */
+    uint32_t               slack;     /**< How late the event may be handled */
     uint32_t               id;        /**< TimerEvent object */
     struct ticker_event_s *next;      /**< Next event in the queue */
 } ticker_event_t;
@@ -41,12 +49,30 @@ typedef struct {
 } ticker_interface_t;
 
 /** Tickers events queue structure
+ *
+ * The 64-bit time is present_time at the ticker read tick_last_read. It is
+ * updated from the ticker interrupt, which is never set more than
+ * TICKER_MAX_DELTA ahead so that the ticker can't wrap unnoticed. sequence
+ * changes with each update, for the time to be read without disabling
+ * interrupts.
  */
 typedef struct {
-    ticker_event_handler event_handler; /**< Event handler */
-    ticker_event_t *head;               /**< A pointer to head */
+    ticker_event_handler event_handler;     /**< Event handler */
+    ticker_event_t *head;                   /**< A pointer to head */
+    volatile us_timestamp_t present_time;   /**< The 64-bit time at tick_last_read */
+    volatile uint32_t tick_last_read;       /**< The ticker read present_time was updated at */
+    volatile uint32_t sequence;             /**< Changed by each update of present_time */
+    uint8_t initialized;                    /**< Set once present_time is started */
+    us_timestamp_t next_interrupt;          /**< The time the interrupt is set for */
+    uint32_t interrupts;                    /**< Interrupts handled */
+    uint32_t events;                        /**< Events handled */
 } ticker_event_queue_t;
 
+/** The longest time the ticker interrupt is set ahead, less than half the
+ *  range of timestamp_t
+ */
+#define TICKER_MAX_DELTA 0x70000000UL
+
 /** Tickers data structure
  */
 typedef struct {
@@ -79,6 +105,9 @@ void ticker_irq_handler(const ticker_data_t *const data);
 void ticker_remove_event(const ticker_data_t *const data, ticker_event_t *obj);
 
 /** Insert an event from the queue
+ *
+ * The timestamp is taken as the nearest time with these low 32 bits, so it
+ * must be within 35 minutes of the present time.
  *
  * @param data      The ticker's data
  * @param obj       The event's queue to be removed
@@ -87,6 +116,19 @@ void ticker_remove_event(const ticker_data_t *const data, ticker_event_t *obj);
  */
 void ticker_insert_event(const ticker_data_t *const data, ticker_event_t *obj, timestamp_t timestamp, uint32_t id);
 
+/** Insert an event from the queue, at any time
+ *
+ * The interrupt is set for the earliest time an event must be handled by,
+ * its timestamp plus its slack, and handles all the events due by then.
+ *
+ * @param data      The ticker's data
+ * @param obj       The event's queue to be removed
+ * @param timestamp The event's 64-bit timestamp, as returned by ticker_read_us
+ * @param slack     How many microseconds late the event may be handled
+ * @param id        The event object
+ */
+void ticker_insert_event_us64(const ticker_data_t *const data, ticker_event_t *obj, us_timestamp_t timestamp, uint32_t slack, uint32_t id);
+
 /** Read the current ticker's timestamp
  *
  * @param data The ticker's data
@@ -94,6 +136,16 @@ void ticker_insert_event(const ticker_data_t *const data, ticker_event_t *obj, t
  */
 timestamp_t ticker_read(const ticker_data_t *const data);
 
+/** Read the current ticker's timestamp extended to 64 bits
+ *
+ * The low 32 bits are those of ticker_read. Safe to call from any context,
+ * without disabling interrupts.
+ *
+ * @param data The ticker's data
+ * @return The current 64-bit timestamp
+ */
+us_timestamp_t ticker_read_us(const ticker_data_t *const data);
+
 /** Read the next event's timestamp
  *
  * @param data The ticker's data
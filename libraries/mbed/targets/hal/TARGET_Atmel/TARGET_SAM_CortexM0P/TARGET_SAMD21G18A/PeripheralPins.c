@@ -240,5 +240,53 @@ const struct pwm_pin_channel pwn_pins[] = {
     {NC  , NC   , NC}
 };
 
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[40] = {
+    1, 2, 5, 6, 7, 8, 11, 12, 13, 14, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    9, 10, 0, 0, 0, 0, 3, 4,
+};
+
+static const uint8_t PinMap_DAC_index[1] = {
+    1,
+};
+
+static const uint8_t PinMap_SERCOM_PAD_index[56] = {
+    1, 2, 0, 0, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 0, 0, 0, 0, 25, 26,
+    0, 0, 27, 28, 0, 0, 0, 0, 29, 30, 31, 32, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 33, 34,
+};
+
+static const uint8_t PinMap_SERCOM_PADEx_index[18] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+    17, 18,
+};
+
+static const uint8_t PinMap_PWM_index[44] = {
+    1, 2, 0, 0, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 0, 0, 0, 0, 25, 26,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 27, 28,
+};
 
+static const uint8_t PinMap_EXTINT_index[56] = {
+    2, 4, 6, 8, 11, 13, 15, 18, 0, 23, 25, 28, 31, 33, 35, 36,
+    1, 3, 5, 9, 12, 14, 16, 19, 32, 34, 0, 37, 21, 0, 26, 29,
+    0, 0, 7, 10, 0, 0, 0, 0, 22, 24, 27, 30, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 17, 20,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 2, 40},
+    {PinMap_DAC, PinMap_DAC_index, 2, 1},
+    {PinMap_SERCOM_PAD, PinMap_SERCOM_PAD_index, 0, 56},
+    {PinMap_SERCOM_PADEx, PinMap_SERCOM_PADEx_index, 8, 18},
+    {PinMap_PWM, PinMap_PWM_index, 0, 44},
+    {PinMap_EXTINT, PinMap_EXTINT_index, 0, 56},
+    {0, 0, 0, 0}
+};
 
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
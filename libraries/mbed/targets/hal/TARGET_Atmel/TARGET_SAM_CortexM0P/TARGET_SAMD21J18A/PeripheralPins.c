@@ -282,5 +282,54 @@ const struct pwm_pin_channel pwn_pins[] = {
     {NC  , NC   , NC}
 };
 
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[40] = {
+    1, 2, 5, 6, 7, 8, 17, 18, 19, 20, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 10,
+    11, 12, 13, 14, 15, 16, 3, 4,
+};
+
+static const uint8_t PinMap_DAC_index[1] = {
+    1,
+};
+
+static const uint8_t PinMap_SERCOM_PAD_index[64] = {
+    1, 2, 0, 0, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 0, 0, 0, 0, 25, 26,
+    27, 28, 29, 30, 0, 0, 0, 0, 31, 32, 33, 34, 35, 36, 37, 38,
+    39, 40, 0, 0, 0, 0, 41, 42, 0, 0, 0, 0, 0, 0, 43, 44,
+};
+
+static const uint8_t PinMap_SERCOM_PADEx_index[18] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+    17, 18,
+};
+
+static const uint8_t PinMap_PWM_index[64] = {
+    1, 2, 0, 0, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 0, 0, 0, 0, 25, 26,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 27, 28, 29, 30, 0, 0,
+    31, 32, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 33, 34,
+};
 
+static const uint8_t PinMap_EXTINT_index[64] = {
+    4, 8, 10, 12, 15, 18, 21, 25, 0, 31, 33, 36, 39, 42, 47, 48,
+    1, 5, 9, 13, 16, 19, 22, 26, 40, 43, 0, 49, 29, 0, 34, 37,
+    2, 6, 11, 14, 17, 20, 23, 27, 30, 32, 35, 38, 41, 44, 45, 50,
+    3, 7, 0, 0, 0, 0, 24, 28, 0, 0, 0, 0, 0, 0, 46, 51,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 2, 40},
+    {PinMap_DAC, PinMap_DAC_index, 2, 1},
+    {PinMap_SERCOM_PAD, PinMap_SERCOM_PAD_index, 0, 64},
+    {PinMap_SERCOM_PADEx, PinMap_SERCOM_PADEx_index, 8, 18},
+    {PinMap_PWM, PinMap_PWM_index, 0, 64},
+    {PinMap_EXTINT, PinMap_EXTINT_index, 0, 64},
+    {0, 0, 0, 0}
+};
 
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
@@ -309,5 +309,56 @@ const struct pwm_pin_channel pwn_pins[] = {
     {NC  , NC   , NC}
 };
 
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[40] = {
+    1, 2, 5, 6, 7, 8, 17, 18, 19, 20, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 10,
+    11, 12, 13, 14, 15, 16, 3, 4,
+};
+
+static const uint8_t PinMap_DAC_index[4] = {
+    1, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SERCOM_PAD_index[64] = {
+    10, 12, 0, 0, 1, 3, 5, 7, 2, 4, 6, 8, 17, 18, 19, 20,
+    9, 11, 14, 16, 24, 26, 21, 23, 25, 27, 0, 22, 0, 0, 13, 15,
+    42, 44, 38, 40, 0, 0, 0, 0, 28, 30, 33, 36, 29, 31, 34, 37,
+    39, 41, 0, 0, 0, 0, 43, 45, 0, 0, 0, 0, 0, 0, 35, 32,
+};
+
+static const uint8_t PinMap_SERCOM_PADEx_index[56] = {
+    1, 2, 3, 4, 9, 10, 11, 12, 5, 6, 7, 8, 15, 17, 13, 14,
+    16, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 20, 19,
+};
+
+static const uint8_t PinMap_PWM_index[64] = {
+    43, 46, 0, 0, 1, 5, 29, 32, 2, 6, 9, 11, 21, 25, 16, 17,
+    4, 8, 10, 12, 23, 27, 13, 18, 36, 39, 0, 0, 0, 0, 31, 34,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 14, 19, 24, 28, 0, 0,
+    15, 20, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 7,
+};
 
+static const uint8_t PinMap_EXTINT_index[64] = {
+    4, 8, 9, 12, 15, 18, 21, 25, 0, 30, 32, 35, 38, 41, 46, 50,
+    1, 5, 10, 13, 16, 19, 22, 26, 39, 42, 0, 47, 0, 0, 33, 36,
+    2, 6, 11, 14, 17, 20, 23, 27, 29, 31, 34, 37, 40, 43, 44, 48,
+    3, 7, 0, 0, 0, 0, 24, 28, 0, 0, 0, 0, 0, 0, 45, 49,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 2, 40},
+    {PinMap_DAC, PinMap_DAC_index, 2, 4},
+    {PinMap_SERCOM_PAD, PinMap_SERCOM_PAD_index, 0, 64},
+    {PinMap_SERCOM_PADEx, PinMap_SERCOM_PADEx_index, 8, 56},
+    {PinMap_PWM, PinMap_PWM_index, 0, 64},
+    {PinMap_EXTINT, PinMap_EXTINT_index, 0, 64},
+    {0, 0, 0, 0}
+};
 
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
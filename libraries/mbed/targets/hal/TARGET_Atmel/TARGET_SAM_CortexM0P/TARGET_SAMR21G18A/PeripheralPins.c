@@ -221,5 +221,51 @@ const struct pwm_pin_channel pwn_pins[] = {
     {(PinName) NC  ,(PWMName) NC   ,(uint8_t) NC}
 };
 
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[38] = {
+    3, 4, 5, 6, 10, 11, 12, 13, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 8, 9,
+    0, 0, 0, 0, 1, 2,
+};
+
+static const uint8_t PinMap_SERCOM_PAD_index[84] = {
+    1, 2, 0, 0, 3, 4, 5, 6, 7, 8, 0, 0, 9, 10, 11, 12,
+    13, 14, 15, 16, 0, 0, 17, 18, 19, 20, 0, 21, 22, 0, 23, 24,
+    0, 0, 25, 26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 27, 28, 0, 0, 0, 0, 0, 0, 29, 30,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 31, 32,
+};
+
+static const uint8_t PinMap_SERCOM_PADEx_index[18] = {
+    1, 2, 0, 0, 0, 0, 0, 0, 3, 4, 5, 6, 0, 0, 7, 8,
+    9, 10,
+};
 
+static const uint8_t PinMap_PWM_index[64] = {
+    1, 2, 0, 0, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 0, 0,
+    13, 14, 15, 16, 17, 0, 18, 19, 20, 21, 0, 0, 0, 0, 22, 23,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    24, 25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 26, 27,
+};
+
+static const uint8_t PinMap_EXTINT_index[64] = {
+    4, 7, 0, 0, 12, 14, 15, 18, 0, 23, 26, 28, 29, 31, 35, 36,
+    1, 5, 8, 10, 13, 0, 16, 19, 30, 32, 0, 37, 21, 0, 25, 27,
+    2, 0, 9, 11, 0, 0, 0, 0, 22, 24, 0, 0, 0, 0, 33, 38,
+    3, 6, 0, 0, 0, 0, 17, 20, 0, 0, 0, 0, 0, 0, 34, 39,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 4, 38},
+    {PinMap_SERCOM_PAD, PinMap_SERCOM_PAD_index, 0, 84},
+    {PinMap_SERCOM_PADEx, PinMap_SERCOM_PADEx_index, 8, 18},
+    {PinMap_PWM, PinMap_PWM_index, 0, 64},
+    {PinMap_EXTINT, PinMap_EXTINT_index, 0, 64},
+    {0, 0, 0, 0}
+};
 
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
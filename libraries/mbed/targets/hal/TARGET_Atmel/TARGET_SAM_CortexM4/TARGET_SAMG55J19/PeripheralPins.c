@@ -193,3 +193,93 @@ const PinMap PinMap_PWM_IO_Line[] = {
 
 
 
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[19] = {
+    1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5,
+    6, 7, 8,
+};
+
+static const uint8_t PinMap_UART_TX_index[40] = {
+    1, 0, 0, 2, 0, 0, 0, 3, 0, 0, 4, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 0, 0, 6, 0, 0,
+    7, 0, 0, 0, 0, 8, 0, 9,
+};
+
+static const uint8_t PinMap_UART_RX_index[40] = {
+    1, 2, 0, 0, 0, 3, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 6, 7, 0,
+    0, 0, 0, 0, 0, 8, 0, 9,
+};
+
+static const uint8_t PinMap_UART_CTS_index[36] = {
+    1, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0,
+    0, 4, 0, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0,
+    0, 0, 0, 7,
+};
+
+static const uint8_t PinMap_UART_RTS_index[33] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 3, 0,
+    4, 0, 0, 5, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0,
+    7,
+};
+
+static const uint8_t PinMap_SPI_SCLK_index[32] = {
+    7, 3, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 0, 2, 0, 9,
+    0, 0, 1, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5,
+};
+
+static const uint8_t PinMap_SPI_MOSI_index[40] = {
+    4, 0, 0, 3, 0, 0, 0, 1, 0, 0, 7, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 0, 0, 0, 8, 0, 0,
+    2, 0, 0, 0, 0, 5, 0, 6,
+};
+
+static const uint8_t PinMap_SPI_MISO_index[40] = {
+    4, 3, 0, 0, 0, 1, 0, 0, 7, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 10, 0, 0, 0, 0, 0, 8, 2, 0,
+    0, 0, 0, 0, 0, 5, 0, 6,
+};
+
+static const uint8_t PinMap_I2C_SDA_index[40] = {
+    4, 0, 0, 3, 0, 0, 0, 1, 0, 0, 8, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 11, 0, 0, 0, 9, 0, 0,
+    2, 0, 0, 0, 0, 5, 0, 6,
+};
+
+static const uint8_t PinMap_I2C_SCL_index[40] = {
+    4, 3, 0, 0, 0, 1, 0, 0, 7, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 10, 0, 0, 0, 0, 0, 8, 2, 0,
+    0, 0, 0, 0, 0, 5, 0, 6,
+};
+
+static const uint8_t PinMap_PWM_index[24] = {
+    1, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    5, 0, 0, 0, 0, 3, 6, 2,
+};
+
+static const uint8_t PinMap_PWM_IO_Line_index[24] = {
+    1, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    5, 0, 0, 0, 0, 3, 6, 2,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 17, 19},
+    {PinMap_UART_TX, PinMap_UART_TX_index, 3, 40},
+    {PinMap_UART_RX, PinMap_UART_RX_index, 4, 40},
+    {PinMap_UART_CTS, PinMap_UART_CTS_index, 11, 36},
+    {PinMap_UART_RTS, PinMap_UART_RTS_index, 15, 33},
+    {PinMap_SPI_SCLK, PinMap_SPI_SCLK_index, 14, 32},
+    {PinMap_SPI_MOSI, PinMap_SPI_MOSI_index, 3, 40},
+    {PinMap_SPI_MISO, PinMap_SPI_MISO_index, 4, 40},
+    {PinMap_I2C_SDA, PinMap_I2C_SDA_index, 3, 40},
+    {PinMap_I2C_SCL, PinMap_I2C_SCL_index, 4, 40},
+    {PinMap_PWM, PinMap_PWM_index, 0, 24},
+    {PinMap_PWM_IO_Line, PinMap_PWM_IO_Line_index, 0, 24},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
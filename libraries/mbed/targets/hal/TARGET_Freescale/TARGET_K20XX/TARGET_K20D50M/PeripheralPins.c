@@ -118,3 +118,23 @@ const PinMap PinMap_PWM[] = {
 
     {NC , NC    , 0}
 };
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_I2C_SDA_index[9] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_I2C_SCL_index[9] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_I2C_SDA, PinMap_I2C_SDA_index, 4100, 9},
+    {PinMap_I2C_SCL, PinMap_I2C_SCL_index, 4096, 9},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
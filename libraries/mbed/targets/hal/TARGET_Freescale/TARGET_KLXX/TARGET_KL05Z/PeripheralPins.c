@@ -121,3 +121,45 @@ const PinMap PinMap_PWM[] = {
     {PTB13, PWM_8,  2}, // PTB13 , TPM1 CH1
     {NC   , NC,     0}
 };
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_DAC_index[1] = {
+    1,
+};
+
+static const uint8_t PinMap_UART_TX_index[9] = {
+    1, 0, 0, 0, 2, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_UART_RX_index[13] = {
+    1, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_SPI_SCLK_index[69] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_SSEL_index[57] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_DAC, PinMap_DAC_index, 4100, 1},
+    {PinMap_UART_TX, PinMap_UART_TX_index, 4100, 9},
+    {PinMap_UART_RX, PinMap_UART_RX_index, 4100, 13},
+    {PinMap_SPI_SCLK, PinMap_SPI_SCLK_index, 4096, 69},
+    {PinMap_SPI_SSEL, PinMap_SPI_SSEL_index, 20, 57},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
@@ -182,3 +182,18 @@ const PinMap PinMap_PWM[] = {
     {PTE31, PWM_5,  3}, // PTE31, TPM0 CH4
     {NC   , NC,     0}
 };
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_DAC_index[1] = {
+    1,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_DAC, PinMap_DAC_index, 16504, 1},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
@@ -104,3 +104,70 @@ const PinMap PinMap_PWM[] = {
 
     {NC, NC, 0}
 };
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[13] = {
+    1, 2, 3, 4, 5, 6, 0, 0, 0, 0, 0, 7, 8,
+};
+
+static const uint8_t PinMap_I2C_SDA_index[1] = {
+    1,
+};
+
+static const uint8_t PinMap_I2C_SCL_index[1] = {
+    1,
+};
+
+static const uint8_t PinMap_UART_TX_index[1] = {
+    1,
+};
+
+static const uint8_t PinMap_UART_RX_index[1] = {
+    1,
+};
+
+static const uint8_t PinMap_SPI_SCLK_index[42] = {
+    1, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_SPI_MOSI_index[13] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_MISO_index[15] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_SSEL_index[50] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 2,
+};
+
+static const uint8_t PinMap_PWM_index[47] = {
+    9, 0, 0, 0, 0, 0, 0, 1, 2, 3, 10, 0, 11, 12, 13, 14,
+    0, 7, 8, 0, 5, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 11, 13},
+    {PinMap_I2C_SDA, PinMap_I2C_SDA_index, 5, 1},
+    {PinMap_I2C_SCL, PinMap_I2C_SCL_index, 4, 1},
+    {PinMap_UART_TX, PinMap_UART_TX_index, 19, 1},
+    {PinMap_UART_RX, PinMap_UART_RX_index, 18, 1},
+    {PinMap_SPI_SCLK, PinMap_SPI_SCLK_index, 6, 42},
+    {PinMap_SPI_MOSI, PinMap_SPI_MOSI_index, 9, 13},
+    {PinMap_SPI_MISO, PinMap_SPI_MISO_index, 8, 15},
+    {PinMap_SPI_SSEL, PinMap_SPI_SSEL_index, 2, 50},
+    {PinMap_PWM, PinMap_PWM_index, 1, 47},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
@@ -21,6 +21,12 @@ PinName port_pin(PortName port, int pin_n) {
     return (PinName)(LPC_GPIO0_BASE + ((port << PORT_SHIFT) | pin_n));
 }
 
+int pin_port(PinName pin, PortName *port) {
+    int pin_number = pin - P0_0;
+    *port = (PortName)(pin_number >> PORT_SHIFT);
+    return pin_number & ((1 << PORT_SHIFT) - 1);
+}
+
 void port_init(port_t *obj, PortName port, int mask, PinDirection dir) {
     obj->port = port;
     obj->mask = mask;
@@ -63,7 +69,12 @@ void port_dir(port_t *obj, PinDirection dir) {
 }
 
 void port_write(port_t *obj, int value) {
+    // FIOSET then FIOCLR would show the pins set before the others are cleared,
+    // a single write of FIOPIN doesn't but mustn't lose a change from an interrupt
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
     *obj->reg_out = (*obj->reg_in & ~obj->mask) | (value & obj->mask);
+    __set_PRIMASK(primask);
 }
 
 int port_read(port_t *obj) {
@@ -149,3 +149,73 @@ const PinMap PinMap_SPI_SSEL[] = {
     {PB_12, SPI_2, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_NOPULL, GPIO_AF0_SPI2)},
     {NC,    NC,    0}
 };
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[38] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 0, 0, 0, 0, 0, 0, 0, 0,
+    9, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    11, 12, 13, 14, 15, 16,
+};
+
+static const uint8_t PinMap_I2C_SDA_index[5] = {
+    1, 0, 2, 0, 3,
+};
+
+static const uint8_t PinMap_I2C_SCL_index[5] = {
+    1, 0, 2, 0, 3,
+};
+
+static const uint8_t PinMap_PWM_index[38] = {
+    1, 0, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 4, 5, 0, 0,
+    6, 7, 8, 9, 10, 11, 0, 0, 0, 0, 12, 13, 0, 0, 0, 0,
+    0, 0, 14, 15, 16, 17,
+};
+
+static const uint8_t PinMap_UART_TX_index[21] = {
+    1, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_UART_RX_index[21] = {
+    1, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 3, 0, 0, 0,
+    0, 0, 0, 0, 4,
+};
+
+static const uint8_t PinMap_SPI_MOSI_index[25] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_SPI_MISO_index[25] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_SPI_SCLK_index[25] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_SPI_SSEL_index[25] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 3,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 0, 38},
+    {PinMap_I2C_SDA, PinMap_I2C_SDA_index, 23, 5},
+    {PinMap_I2C_SCL, PinMap_I2C_SCL_index, 22, 5},
+    {PinMap_PWM, PinMap_PWM_index, 4, 38},
+    {PinMap_UART_TX, PinMap_UART_TX_index, 2, 21},
+    {PinMap_UART_RX, PinMap_UART_RX_index, 3, 21},
+    {PinMap_SPI_MOSI, PinMap_SPI_MOSI_index, 7, 25},
+    {PinMap_SPI_MISO, PinMap_SPI_MISO_index, 6, 25},
+    {PinMap_SPI_SCLK, PinMap_SPI_SCLK_index, 5, 25},
+    {PinMap_SPI_SSEL, PinMap_SPI_SSEL_index, 4, 25},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
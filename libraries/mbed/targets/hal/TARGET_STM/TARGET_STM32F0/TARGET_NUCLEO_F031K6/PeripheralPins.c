@@ -140,3 +140,66 @@ const PinMap PinMap_SPI_SSEL[] = {
 //  {PA_15, SPI_1, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_NOPULL, GPIO_AF0_SPI1)},
     {NC,    NC,    0}
 };
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[18] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 0, 0, 0, 0, 0, 0, 0, 0,
+    9, 10,
+};
+
+static const uint8_t PinMap_I2C_SDA_index[14] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_I2C_SCL_index[14] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_PWM_index[20] = {
+    1, 0, 2, 3, 4, 5, 6, 7, 0, 0, 0, 0, 8, 9, 0, 0,
+    10, 11, 12, 13,
+};
+
+static const uint8_t PinMap_UART_TX_index[22] = {
+    1, 2, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 4,
+};
+
+static const uint8_t PinMap_UART_RX_index[14] = {
+    1, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_SPI_MOSI_index[15] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_MISO_index[15] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_SCLK_index[15] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_SSEL_index[1] = {
+    1,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 0, 18},
+    {PinMap_I2C_SDA, PinMap_I2C_SDA_index, 10, 14},
+    {PinMap_I2C_SCL, PinMap_I2C_SCL_index, 9, 14},
+    {PinMap_PWM, PinMap_PWM_index, 4, 20},
+    {PinMap_UART_TX, PinMap_UART_TX_index, 1, 22},
+    {PinMap_UART_RX, PinMap_UART_RX_index, 10, 14},
+    {PinMap_SPI_MOSI, PinMap_SPI_MOSI_index, 7, 15},
+    {PinMap_SPI_MISO, PinMap_SPI_MISO_index, 6, 15},
+    {PinMap_SPI_SCLK, PinMap_SPI_SCLK_index, 5, 15},
+    {PinMap_SPI_SSEL, PinMap_SPI_SSEL_index, 4, 1},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
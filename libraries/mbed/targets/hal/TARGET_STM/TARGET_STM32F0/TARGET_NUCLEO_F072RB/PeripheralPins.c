@@ -196,3 +196,80 @@ const PinMap PinMap_SPI_SSEL[] = {
     {PB_12, SPI_2, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_PULLUP, GPIO_AF0_SPI2)},
     {NC,    NC,    0}
 };
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[38] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 0, 0, 0, 0, 0, 0, 0, 0,
+    9, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    11, 12, 13, 14, 15, 16,
+};
+
+static const uint8_t PinMap_DAC_index[2] = {
+    1, 2,
+};
+
+static const uint8_t PinMap_I2C_SDA_index[8] = {
+    1, 0, 2, 0, 3, 0, 0, 4,
+};
+
+static const uint8_t PinMap_I2C_SCL_index[8] = {
+    1, 0, 2, 0, 3, 0, 0, 4,
+};
+
+static const uint8_t PinMap_PWM_index[41] = {
+    1, 2, 3, 4, 0, 5, 6, 7, 8, 9, 10, 0, 0, 0, 0, 11,
+    12, 0, 0, 13, 14, 15, 16, 17, 18, 0, 0, 0, 19, 20, 21, 0,
+    0, 0, 0, 0, 0, 22, 23, 24, 25,
+};
+
+static const uint8_t PinMap_UART_TX_index[43] = {
+    1, 0, 2, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4, 0,
+    0, 0, 0, 0, 0, 0, 5, 0, 0, 0, 6, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 7, 0, 0, 0, 0, 0, 8,
+};
+
+static const uint8_t PinMap_UART_RX_index[43] = {
+    1, 0, 2, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4, 0,
+    0, 0, 0, 0, 0, 0, 5, 0, 0, 0, 6, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 7, 0, 0, 0, 0, 0, 8,
+};
+
+static const uint8_t PinMap_SPI_MOSI_index[29] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 4,
+};
+
+static const uint8_t PinMap_SPI_MISO_index[29] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 4,
+};
+
+static const uint8_t PinMap_SPI_SCLK_index[25] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    0, 0, 0, 0, 0, 3, 0, 0, 4,
+};
+
+static const uint8_t PinMap_SPI_SSEL_index[25] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 3, 0, 0, 4,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 0, 38},
+    {PinMap_DAC, PinMap_DAC_index, 4, 2},
+    {PinMap_I2C_SDA, PinMap_I2C_SDA_index, 23, 8},
+    {PinMap_I2C_SCL, PinMap_I2C_SCL_index, 22, 8},
+    {PinMap_PWM, PinMap_PWM_index, 1, 41},
+    {PinMap_UART_TX, PinMap_UART_TX_index, 0, 43},
+    {PinMap_UART_RX, PinMap_UART_RX_index, 1, 43},
+    {PinMap_SPI_MOSI, PinMap_SPI_MOSI_index, 7, 29},
+    {PinMap_SPI_MISO, PinMap_SPI_MISO_index, 6, 29},
+    {PinMap_SPI_SCLK, PinMap_SPI_SCLK_index, 5, 25},
+    {PinMap_SPI_SSEL, PinMap_SPI_SSEL_index, 4, 25},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
@@ -204,3 +204,97 @@ const PinMap PinMap_SPI_SSEL[] = {
     {PF_0,  SPI_2, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_PULLUP, GPIO_AF5_SPI2)},
     {NC,    NC,    0}
 };
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[36] = {
+    1, 2, 3, 4, 5, 0, 6, 7, 0, 0, 0, 0, 0, 0, 0, 0,
+    8, 9, 0, 0, 0, 0, 0, 0, 0, 0, 0, 10, 0, 11, 0, 0,
+    12, 13, 14, 15,
+};
+
+static const uint8_t PinMap_DAC_index[1] = {
+    1,
+};
+
+static const uint8_t PinMap_I2C_SDA_index[71] = {
+    1, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 3, 0, 4, 0, 5,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 6,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 7,
+};
+
+static const uint8_t PinMap_I2C_SCL_index[74] = {
+    1, 2, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 4, 0,
+    5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 6,
+};
+
+static const uint8_t PinMap_PWM_index[80] = {
+    1, 2, 3, 0, 0, 4, 5, 6, 7, 8, 9, 10, 11, 0, 0, 12,
+    13, 0, 0, 14, 15, 16, 17, 18, 19, 0, 0, 0, 20, 21, 22, 23,
+    24, 25, 26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 27, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 28,
+};
+
+static const uint8_t PinMap_UART_TX_index[41] = {
+    1, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 3, 0, 0, 0,
+    0, 4, 0, 0, 5, 0, 0, 6, 7, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 8, 0, 0, 0, 0, 0, 9,
+};
+
+static const uint8_t PinMap_UART_RX_index[41] = {
+    1, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 3, 0, 0, 0,
+    0, 4, 0, 0, 5, 6, 0, 0, 7, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 8, 0, 0, 0, 0, 0, 9,
+};
+
+static const uint8_t PinMap_SPI_MOSI_index[34] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 4,
+};
+
+static const uint8_t PinMap_SPI_MISO_index[34] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 4,
+};
+
+static const uint8_t PinMap_SPI_SCLK_index[63] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4,
+};
+
+static const uint8_t PinMap_SPI_SSEL_index[77] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 0, 36},
+    {PinMap_DAC, PinMap_DAC_index, 4, 1},
+    {PinMap_I2C_SDA, PinMap_I2C_SDA_index, 10, 71},
+    {PinMap_I2C_SCL, PinMap_I2C_SCL_index, 8, 74},
+    {PinMap_PWM, PinMap_PWM_index, 1, 80},
+    {PinMap_UART_TX, PinMap_UART_TX_index, 2, 41},
+    {PinMap_UART_RX, PinMap_UART_RX_index, 3, 41},
+    {PinMap_SPI_MOSI, PinMap_SPI_MOSI_index, 11, 34},
+    {PinMap_SPI_MISO, PinMap_SPI_MISO_index, 10, 34},
+    {PinMap_SPI_SCLK, PinMap_SPI_SCLK_index, 19, 63},
+    {PinMap_SPI_SSEL, PinMap_SPI_SSEL_index, 4, 77},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
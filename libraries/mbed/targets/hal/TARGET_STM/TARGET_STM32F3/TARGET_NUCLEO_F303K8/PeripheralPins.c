@@ -169,3 +169,75 @@ const PinMap PinMap_SPI_SSEL[] = {
     {PA_15, SPI_1, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_PULLUP, GPIO_AF5_SPI1)},
     {NC,    NC,    0}
 };
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[18] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 0, 0, 0, 0, 0, 0, 0, 0,
+    9, 10,
+};
+
+static const uint8_t PinMap_DAC_index[3] = {
+    1, 2, 3,
+};
+
+static const uint8_t PinMap_I2C_SDA_index[10] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_I2C_SCL_index[8] = {
+    1, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_PWM_index[80] = {
+    1, 2, 3, 4, 0, 5, 6, 7, 8, 9, 10, 11, 12, 0, 0, 13,
+    14, 0, 0, 15, 16, 17, 18, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 19,
+};
+
+static const uint8_t PinMap_UART_TX_index[21] = {
+    1, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 3, 0, 0, 0,
+    0, 4, 0, 0, 5,
+};
+
+static const uint8_t PinMap_UART_RX_index[21] = {
+    1, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 3, 0, 0, 0,
+    0, 4, 0, 0, 5,
+};
+
+static const uint8_t PinMap_SPI_MOSI_index[15] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_MISO_index[15] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_SCLK_index[15] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_SSEL_index[12] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 0, 18},
+    {PinMap_DAC, PinMap_DAC_index, 4, 3},
+    {PinMap_I2C_SDA, PinMap_I2C_SDA_index, 14, 10},
+    {PinMap_I2C_SCL, PinMap_I2C_SCL_index, 15, 8},
+    {PinMap_PWM, PinMap_PWM_index, 1, 80},
+    {PinMap_UART_TX, PinMap_UART_TX_index, 2, 21},
+    {PinMap_UART_RX, PinMap_UART_RX_index, 3, 21},
+    {PinMap_SPI_MOSI, PinMap_SPI_MOSI_index, 7, 15},
+    {PinMap_SPI_MISO, PinMap_SPI_MISO_index, 6, 15},
+    {PinMap_SPI_SCLK, PinMap_SPI_SCLK_index, 5, 15},
+    {PinMap_SPI_SSEL, PinMap_SPI_SSEL_index, 4, 12},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
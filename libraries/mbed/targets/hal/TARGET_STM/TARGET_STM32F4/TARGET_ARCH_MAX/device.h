@@ -37,6 +37,7 @@
 #define DEVICE_INTERRUPTIN      1
 
 #define DEVICE_ANALOGIN         1
+#define DEVICE_ANALOGIN_ASYNCH  1
 #define DEVICE_ANALOGOUT        1 
 
 #define DEVICE_SERIAL           1
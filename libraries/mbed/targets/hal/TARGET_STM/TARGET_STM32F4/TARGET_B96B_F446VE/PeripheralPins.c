@@ -309,3 +309,123 @@ const PinMap PinMap_CAN_TD[] = {
     {NC,    NC,    0}
 };
 
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[38] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 0, 0, 0, 0, 0, 0, 0, 0,
+    9, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    11, 12, 13, 14, 15, 16,
+};
+
+static const uint8_t PinMap_DAC_index[2] = {
+    1, 2,
+};
+
+static const uint8_t PinMap_I2C_SDA_index[26] = {
+    1, 2, 0, 0, 3, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 5, 0, 0, 6,
+};
+
+static const uint8_t PinMap_I2C_SCL_index[19] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    3, 0, 4,
+};
+
+static const uint8_t PinMap_PWM_index[79] = {
+    1, 2, 3, 4, 0, 5, 6, 7, 8, 9, 10, 11, 0, 0, 0, 12,
+    13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 0, 0, 24, 25, 26,
+    0, 0, 0, 0, 0, 0, 27, 28, 29, 30, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 31, 32, 33, 34,
+    0, 0, 0, 0, 0, 35, 36, 0, 37, 38, 39, 40, 41, 42, 43,
+};
+
+static const uint8_t PinMap_UART_TX_index[73] = {
+    1, 0, 2, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 4, 0, 0, 0, 5, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 6, 0, 0, 0, 7, 0, 8, 0, 0, 0,
+    0, 0, 0, 0, 0, 9, 0, 0, 10, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 11,
+};
+
+static const uint8_t PinMap_UART_RX_index[71] = {
+    1, 0, 2, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 5, 0, 6, 0, 0, 0, 7, 0, 0, 0, 0, 0,
+    0, 8, 0, 0, 0, 9, 0, 0, 10, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 11,
+};
+
+static const uint8_t PinMap_UART_RTS_index[52] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 4,
+};
+
+static const uint8_t PinMap_UART_CTS_index[6] = {
+    1, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_MOSI_index[72] = {
+    2, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 4, 0, 0, 5, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 8, 0, 7, 0, 0, 0,
+    0, 0, 0, 0, 0, 9, 0, 0, 0, 1, 0, 0, 0, 0, 0, 10,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 11,
+    0, 0, 0, 0, 0, 0, 0, 12,
+};
+
+static const uint8_t PinMap_SPI_MISO_index[72] = {
+    2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 0, 0, 5, 0, 0, 0,
+    0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7,
+    0, 0, 0, 0, 0, 0, 0, 8,
+};
+
+static const uint8_t PinMap_SPI_SCLK_index[72] = {
+    2, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0,
+    0, 0, 0, 0, 0, 5, 0, 0, 6, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 7, 0, 0, 8, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 10,
+};
+
+static const uint8_t PinMap_SPI_SSEL_index[72] = {
+    2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 4, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    6, 0, 0, 0, 0, 0, 0, 7,
+};
+
+static const uint8_t PinMap_CAN_RD_index[1] = {
+    1,
+};
+
+static const uint8_t PinMap_CAN_TD_index[1] = {
+    1,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 0, 38},
+    {PinMap_DAC, PinMap_DAC_index, 4, 2},
+    {PinMap_I2C_SDA, PinMap_I2C_SDA_index, 19, 26},
+    {PinMap_I2C_SCL, PinMap_I2C_SCL_index, 8, 19},
+    {PinMap_PWM, PinMap_PWM_index, 0, 79},
+    {PinMap_UART_TX, PinMap_UART_TX_index, 0, 73},
+    {PinMap_UART_RX, PinMap_UART_RX_index, 1, 71},
+    {PinMap_UART_RTS, PinMap_UART_RTS_index, 1, 52},
+    {PinMap_UART_CTS, PinMap_UART_CTS_index, 11, 6},
+    {PinMap_SPI_MOSI, PinMap_SPI_MOSI_index, 7, 72},
+    {PinMap_SPI_MISO, PinMap_SPI_MISO_index, 6, 72},
+    {PinMap_SPI_SCLK, PinMap_SPI_SCLK_index, 5, 72},
+    {PinMap_SPI_SSEL, PinMap_SPI_SSEL_index, 4, 72},
+    {PinMap_CAN_RD, PinMap_CAN_RD_index, 48, 1},
+    {PinMap_CAN_TD, PinMap_CAN_TD_index, 49, 1},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
@@ -37,11 +37,13 @@
 #define DEVICE_INTERRUPTIN      1
 
 #define DEVICE_ANALOGIN         1
+#define DEVICE_ANALOGIN_ASYNCH  1
 #define DEVICE_ANALOGOUT        1
 
 #define DEVICE_SERIAL            1
 #define DEVICE_SERIAL_ASYNCH     1
 #define DEVICE_SERIAL_ASYNCH_DMA 1
+#define DEVICE_SERIAL_ASYNCH_CIRCULAR 1
 #define DEVICE_SERIAL_FC         1
 
 #define DEVICE_I2C              1
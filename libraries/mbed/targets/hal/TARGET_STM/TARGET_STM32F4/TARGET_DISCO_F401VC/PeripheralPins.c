@@ -188,3 +188,80 @@ const PinMap PinMap_SPI_SSEL[] = {
     {PB_12, SPI_2, STM_PIN_DATA(STM_MODE_AF_PP, GPIO_NOPULL, GPIO_AF5_SPI2)},
     {NC,    NC,    0}
 };
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[38] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 0, 0, 0, 0, 0, 0, 0, 0,
+    9, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    11, 12, 13, 14, 15, 16,
+};
+
+static const uint8_t PinMap_I2C_SDA_index[23] = {
+    1, 2, 0, 0, 3, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 5,
+};
+
+static const uint8_t PinMap_I2C_SCL_index[19] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    3, 0, 4,
+};
+
+static const uint8_t PinMap_PWM_index[42] = {
+    1, 2, 3, 4, 0, 5, 6, 7, 8, 9, 10, 11, 0, 0, 0, 12,
+    13, 14, 0, 15, 16, 17, 18, 19, 20, 21, 22, 0, 0, 23, 24, 25,
+    0, 0, 0, 0, 0, 0, 26, 27, 28, 29,
+};
+
+static const uint8_t PinMap_UART_TX_index[37] = {
+    1, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 5,
+};
+
+static const uint8_t PinMap_UART_RX_index[37] = {
+    1, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 5,
+};
+
+static const uint8_t PinMap_SPI_MOSI_index[38] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 4, 0, 0, 0,
+    0, 0, 0, 0, 0, 5,
+};
+
+static const uint8_t PinMap_SPI_MISO_index[38] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 4, 0, 0, 0,
+    0, 0, 0, 0, 0, 5,
+};
+
+static const uint8_t PinMap_SPI_SCLK_index[38] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    0, 0, 0, 0, 0, 3, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 5,
+};
+
+static const uint8_t PinMap_SPI_SSEL_index[25] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 3, 0, 0, 4,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 0, 38},
+    {PinMap_I2C_SDA, PinMap_I2C_SDA_index, 19, 23},
+    {PinMap_I2C_SCL, PinMap_I2C_SCL_index, 8, 19},
+    {PinMap_PWM, PinMap_PWM_index, 0, 42},
+    {PinMap_UART_TX, PinMap_UART_TX_index, 2, 37},
+    {PinMap_UART_RX, PinMap_UART_RX_index, 3, 37},
+    {PinMap_SPI_MOSI, PinMap_SPI_MOSI_index, 7, 38},
+    {PinMap_SPI_MISO, PinMap_SPI_MISO_index, 6, 38},
+    {PinMap_SPI_SCLK, PinMap_SPI_SCLK_index, 5, 38},
+    {PinMap_SPI_SSEL, PinMap_SPI_SSEL_index, 4, 25},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
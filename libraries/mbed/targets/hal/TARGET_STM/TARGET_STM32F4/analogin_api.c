@@ -38,6 +38,11 @@
 
 ADC_HandleTypeDef AdcHandle;
 
+#if DEVICE_ANALOGIN_ASYNCH
+// The AnalogIn whose background read has the ADC, or NULL
+static analogin_t *async_owner;
+#endif
+
 void analogin_init(analogin_t *obj, PinName pin)
 {
 #if defined(ADC1)
@@ -96,11 +101,11 @@ void analogin_init(analogin_t *obj, PinName pin)
     }
 }
 
-static inline uint16_t adc_read(analogin_t *obj)
+static int adc_config_channel(ADC_HandleTypeDef *handle, analogin_t *obj)
 {
     ADC_ChannelConfTypeDef sConfig = {0};
 
-    AdcHandle.Instance = (ADC_TypeDef *)(obj->adc);
+    handle->Instance = (ADC_TypeDef *)(obj->adc);
 
     // Configure ADC channel
     sConfig.Rank         = 1;
@@ -160,7 +165,21 @@ static inline uint16_t adc_read(analogin_t *obj)
             return 0;
     }
 
-    HAL_ADC_ConfigChannel(&AdcHandle, &sConfig);
+    HAL_ADC_ConfigChannel(handle, &sConfig);
+    return 1;
+}
+
+static inline uint16_t adc_read(analogin_t *obj)
+{
+#if DEVICE_ANALOGIN_ASYNCH
+    // The ADC belongs to the background read until it is over
+    if ((async_owner != NULL) && (async_owner->adc == obj->adc)) {
+        return 0;
+    }
+#endif
+    if (!adc_config_channel(&AdcHandle, obj)) {
+        return 0;
+    }
 
     HAL_ADC_Start(&AdcHandle); // Start conversion
 
@@ -186,4 +205,191 @@ float analogin_read(analogin_t *obj)
     return (float)value * (1.0f / (float)0xFFF); // 12 bits range
 }
 
+#if DEVICE_ANALOGIN_ASYNCH
+
+/* Conversions triggered by the update events of TIM3 and moved to the
+ * buffer by DMA, one AnalogIn at a time, through a handle of their own so
+ * that analogin_read of the other ADC carries on. PwmOut can't be used on
+ * the TIM3 channels meanwhile. */
+static ADC_HandleTypeDef AsyncHandle;
+static DMA_HandleTypeDef DmaHandle;
+static TIM_HandleTypeDef TrigHandle;
+static int async_continuous;
+static uint32_t async_event;
+
+// ADC cycles per conversion, with the 3 cycle sampling time
+#define ADC_CONVERSION_CYCLES   15
+
+static void adc_set_trigger(uint32_t edge, uint32_t trigger, uint32_t align, uint32_t dma_requests)
+{
+    AsyncHandle.Init.ExternalTrigConvEdge  = edge;
+    AsyncHandle.Init.ExternalTrigConv      = trigger;
+    AsyncHandle.Init.DataAlign             = align;
+    AsyncHandle.Init.DMAContinuousRequests = dma_requests;
+    if (HAL_ADC_Init(&AsyncHandle) != HAL_OK) {
+        error("Cannot initialize ADC\n");
+    }
+}
+
+static uint32_t trigger_clock(void)
+{
+    RCC_ClkInitTypeDef RCC_ClkInitStruct;
+    uint32_t latency;
+
+    // TIMxCLK = PCLKx when the APB prescaler = 1 else TIMxCLK = 2 * PCLKx
+    HAL_RCC_GetClockConfig(&RCC_ClkInitStruct, &latency);
+    uint32_t clock = HAL_RCC_GetPCLK1Freq();
+    if (RCC_ClkInitStruct.APB1CLKDivider != RCC_HCLK_DIV1) {
+        clock *= 2;
+    }
+    return clock;
+}
+
+static void trigger_start(uint32_t rate)
+{
+    __TIM3_CLK_ENABLE();
+
+    // 16-bit counter, prescaled for the low rates
+    uint32_t ticks = trigger_clock() / rate;
+    uint32_t prescaler = ticks / 0x10000;
+    TrigHandle.Instance = TIM3;
+    TrigHandle.Init.Prescaler     = prescaler;
+    TrigHandle.Init.Period        = ticks / (prescaler + 1) - 1;
+    TrigHandle.Init.ClockDivision = 0;
+    TrigHandle.Init.CounterMode   = TIM_COUNTERMODE_UP;
+    HAL_TIM_Base_Init(&TrigHandle);
+
+    TIM_MasterConfigTypeDef master;
+    master.MasterOutputTrigger = TIM_TRGO_UPDATE;
+    master.MasterSlaveMode     = TIM_MASTERSLAVEMODE_DISABLE;
+    HAL_TIMEx_MasterConfigSynchronization(&TrigHandle, &master);
+
+    HAL_TIM_Base_Start(&TrigHandle);
+}
+
+static IRQn_Type dma_irq(void)
+{
+    return (DmaHandle.Instance == DMA2_Stream0) ? DMA2_Stream0_IRQn : DMA2_Stream1_IRQn;
+}
+
+int analogin_read_asynch(analogin_t *obj, uint16_t *buffer, size_t length, uint32_t rate, int continuous, uint32_t handler, uint32_t event, DMAUsage hint)
+{
+    (void)hint;
+
+    if (async_owner != NULL) {
+        return -1;
+    }
+
+    // The ADC clock is PCLK2 / 2, and TIM3 needs two ticks per period at least
+    if ((rate > HAL_RCC_GetPCLK2Freq() / 2 / ADC_CONVERSION_CYCLES) || (rate > trigger_clock() / 2)) {
+        return -1;
+    }
+
+    // ADC1 on DMA2 stream 0 channel 0, ADC3 on DMA2 stream 1 channel 2
+    if (obj->adc == ADC_1) {
+        DmaHandle.Instance = DMA2_Stream0;
+        DmaHandle.Init.Channel = DMA_CHANNEL_0;
+#if defined(ADC3)
+    } else if (obj->adc == ADC_3) {
+        DmaHandle.Instance = DMA2_Stream1;
+        DmaHandle.Init.Channel = DMA_CHANNEL_2;
+#endif
+    } else {
+        // only ADC1 and ADC3 have their DMA stream set up
+        return -1;
+    }
+
+    async_owner = obj;
+    async_continuous = continuous;
+    async_event = event;
+
+    __DMA2_CLK_ENABLE();
+    DmaHandle.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+    DmaHandle.Init.PeriphInc           = DMA_PINC_DISABLE;
+    DmaHandle.Init.MemInc              = DMA_MINC_ENABLE;
+    DmaHandle.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    DmaHandle.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+    DmaHandle.Init.Mode                = continuous ? DMA_CIRCULAR : DMA_NORMAL;
+    DmaHandle.Init.Priority            = DMA_PRIORITY_HIGH;
+    DmaHandle.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+    DmaHandle.Init.FIFOThreshold       = DMA_FIFO_THRESHOLD_HALFFULL;
+    DmaHandle.Init.MemBurst            = DMA_MBURST_SINGLE;
+    DmaHandle.Init.PeriphBurst         = DMA_PBURST_SINGLE;
+    HAL_DMA_DeInit(&DmaHandle);
+    HAL_DMA_Init(&DmaHandle);
+
+    // Left aligned, the samples are read_u16() values as they are
+    AsyncHandle = AdcHandle;
+    AsyncHandle.Instance = (ADC_TypeDef *)(obj->adc);
+    __HAL_LINKDMA(&AsyncHandle, DMA_Handle, DmaHandle);
+    adc_set_trigger(ADC_EXTERNALTRIGCONVEDGE_RISING, ADC_EXTERNALTRIGCONV_T3_TRGO,
+                    ADC_DATAALIGN_LEFT, continuous ? ENABLE : DISABLE);
+    adc_config_channel(&AsyncHandle, obj);
+
+    // The overrun of the ADC and the events of the DMA stream come to the same handler
+    NVIC_SetVector(dma_irq(), handler);
+    NVIC_EnableIRQ(dma_irq());
+    NVIC_SetVector(ADC_IRQn, handler);
+    NVIC_EnableIRQ(ADC_IRQn);
+
+    HAL_ADC_Start_DMA(&AsyncHandle, (uint32_t *)buffer, length);
+    __HAL_DMA_DISABLE_IT(&DmaHandle, DMA_IT_FE);
+
+    trigger_start(rate);
+    return 0;
+}
+
+uint32_t analogin_irq_handler_asynch(analogin_t *obj)
+{
+    uint32_t event = 0;
+
+    if (__HAL_DMA_GET_FLAG(&DmaHandle, __HAL_DMA_GET_TE_FLAG_INDEX(&DmaHandle) | __HAL_DMA_GET_DME_FLAG_INDEX(&DmaHandle)) ||
+        (AsyncHandle.Instance->SR & ADC_SR_OVR)) {
+        analogin_abort_asynch(obj);
+        return SAMPLE_EVENT_OVERRUN & async_event;
+    }
+    if (__HAL_DMA_GET_FLAG(&DmaHandle, __HAL_DMA_GET_HT_FLAG_INDEX(&DmaHandle))) {
+        __HAL_DMA_CLEAR_FLAG(&DmaHandle, __HAL_DMA_GET_HT_FLAG_INDEX(&DmaHandle));
+        event |= SAMPLE_EVENT_HALF_COMPLETE;
+    }
+    if (__HAL_DMA_GET_FLAG(&DmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(&DmaHandle))) {
+        __HAL_DMA_CLEAR_FLAG(&DmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(&DmaHandle));
+        event |= SAMPLE_EVENT_COMPLETE;
+        if (!async_continuous) {
+            analogin_abort_asynch(obj);
+        }
+    }
+    __HAL_DMA_CLEAR_FLAG(&DmaHandle, __HAL_DMA_GET_FE_FLAG_INDEX(&DmaHandle));
+
+    return event & async_event;
+}
+
+uint8_t analogin_active(analogin_t *obj)
+{
+    return (obj != NULL) && (async_owner == obj);
+}
+
+void analogin_abort_asynch(analogin_t *obj)
+{
+    if (!analogin_active(obj)) {
+        return;
+    }
+
+    HAL_TIM_Base_Stop(&TrigHandle);
+    NVIC_DisableIRQ(ADC_IRQn);
+    NVIC_DisableIRQ(dma_irq());
+
+    HAL_ADC_Stop_DMA(&AsyncHandle);
+    __HAL_DMA_CLEAR_FLAG(&DmaHandle, __HAL_DMA_GET_TC_FLAG_INDEX(&DmaHandle) | __HAL_DMA_GET_HT_FLAG_INDEX(&DmaHandle) |
+                                     __HAL_DMA_GET_TE_FLAG_INDEX(&DmaHandle) | __HAL_DMA_GET_DME_FLAG_INDEX(&DmaHandle) |
+                                     __HAL_DMA_GET_FE_FLAG_INDEX(&DmaHandle));
+    __HAL_ADC_CLEAR_FLAG(&AsyncHandle, ADC_FLAG_OVR);
+
+    // Back to the software started conversions of analogin_read
+    adc_set_trigger(ADC_EXTERNALTRIGCONVEDGE_NONE, ADC_EXTERNALTRIGCONV_T1_CC1, ADC_DATAALIGN_RIGHT, DISABLE);
+    async_owner = NULL;
+}
+
+#endif
+
 #endif
@@ -31,6 +31,7 @@
 #include "pinmap.h"
 #include "gpio_api.h"
 #include "mbed_error.h"
+#include <stddef.h>
 
 #if DEVICE_PORTIN || DEVICE_PORTOUT
 
@@ -43,6 +44,12 @@ PinName port_pin(PortName port, int pin_n)
     return (PinName)(pin_n + (port << 4));
 }
 
+int pin_port(PinName pin, PortName *port)
+{
+    *port = (PortName)STM_PORT(pin);
+    return STM_PIN(pin);
+}
+
 void port_init(port_t *obj, PortName port, int mask, PinDirection dir)
 {
     uint32_t port_index = (uint32_t)port;
@@ -88,7 +95,9 @@ void port_mode(port_t *obj, PinMode mode)
 
 void port_write(port_t *obj, int value)
 {
-    *obj->reg_out = (*obj->reg_out & ~obj->mask) | (value & obj->mask);
+    // BSRR sets and resets the pins in one write, without a read-modify-write of ODR
+    GPIO_TypeDef *gpio = (GPIO_TypeDef *)((uint32_t)obj->reg_out - offsetof(GPIO_TypeDef, ODR));
+    gpio->BSRR = (value & obj->mask) | ((~value & obj->mask) << 16);
 }
 
 int port_read(port_t *obj)
@@ -1388,6 +1388,85 @@ void serial_rx_asynch(serial_t *obj, void *rx, size_t rx_length, uint8_t rx_widt
     return;
 }
 
+#if DEVICE_SERIAL_ASYNCH_CIRCULAR
+
+/** Begin continuous RX into a circular buffer, with a circular DMA stream
+ *  raising the half and full interrupts and the idle line interrupt of
+ *  the UART
+ *
+ * @param obj        The serial object
+ * @param rx         The buffer for receiving
+ * @param rx_length  The length of the buffer in bytes
+ * @param handler    The serial handler
+ * @param hint       A suggestion for how to use DMA with this transfer
+ */
+void serial_rx_circular_asynch(serial_t *obj, void *rx, size_t rx_length, uint32_t handler, DMAUsage hint)
+{
+    // DMA is always used
+    (void) hint;
+
+    /* Sanity check arguments */
+    MBED_ASSERT(obj);
+    MBED_ASSERT(rx != (void*)0);
+
+    h_serial_rx_enable_event(obj, SERIAL_EVENT_RX_ALL | SERIAL_EVENT_RX_HALF_FULL | SERIAL_EVENT_RX_IDLE, 0);
+    h_serial_rx_enable_event(obj, SERIAL_EVENT_RX_ALL | SERIAL_EVENT_RX_HALF_FULL | SERIAL_EVENT_RX_IDLE, 1);
+    h_serial_rx_buffer_set(obj, rx, rx_length, 8);
+
+    IRQn_Type irqn = h_serial_get_irq_index(obj);
+    NVIC_ClearPendingIRQ(irqn);
+    NVIC_DisableIRQ(irqn);
+    NVIC_SetPriority(irqn, 0);
+    NVIC_SetVector(irqn, (uint32_t)handler);
+    NVIC_EnableIRQ(irqn);
+
+    irqn = h_serial_rx_get_irqdma_index(obj);
+    NVIC_ClearPendingIRQ(irqn);
+    NVIC_DisableIRQ(irqn);
+    NVIC_SetPriority(irqn, 1);
+    NVIC_SetVector(irqn, (uint32_t)handler);
+    NVIC_EnableIRQ(irqn);
+
+    UART_HandleTypeDef *handle = &UartHandle[SERIAL_OBJ(index)];
+    // flush current data + error flags
+    __HAL_UART_CLEAR_PEFLAG(handle);
+
+    // the stream goes back to the start of the buffer and never completes
+    handle->hdmarx->Init.Mode = DMA_CIRCULAR;
+    HAL_DMA_Init(handle->hdmarx);
+    MBED_UART_Receive_DMA(handle, (uint8_t*)rx, rx_length);
+    __HAL_DMA_ENABLE_IT(handle->hdmarx, DMA_IT_HT);
+
+    /* Enable the UART Idle line and Error Interrupts: (Frame error, noise error, overrun error) */
+    __HAL_UART_ENABLE_IT(handle, UART_IT_IDLE);
+    __HAL_UART_ENABLE_IT(handle, UART_IT_ERR);
+
+    DEBUG_PRINTF("UART%u: Rx circular: 0=(%u) %x\n", obj->serial.module+1, rx_length, HAL_UART_GetState(handle));
+}
+
+/** The position in the circular buffer the receiver writes next
+ *
+ * @param obj The serial object
+ * @return The index in the buffer
+ */
+int serial_rx_circular_position(serial_t *obj)
+{
+    UART_HandleTypeDef *handle = &UartHandle[SERIAL_OBJ(index)];
+    uint32_t remaining = __HAL_DMA_GET_COUNTER(handle->hdmarx);
+
+    return (obj->rx_buff.length - remaining) % obj->rx_buff.length;
+}
+
+/** Check whether the receiver of a UART is in circular mode
+ */
+static int h_serial_rx_circular(UART_HandleTypeDef *handle)
+{
+    return ((handle->Instance->CR3 & USART_CR3_DMAR) != 0) &&
+           ((handle->hdmarx->Instance->CR & DMA_SxCR_CIRC) != 0);
+}
+
+#endif
+
 /** Attempts to determine if the serial peripheral is already in use for TX
  *
  * @param obj The serial object
@@ -1426,6 +1505,18 @@ int serial_irq_handler_asynch(serial_t *obj)
 
   // Irq handler is common to Tx and Rx
     UART_HandleTypeDef *handle = &UartHandle[SERIAL_OBJ(index)];
+#if DEVICE_SERIAL_ASYNCH_CIRCULAR
+    int circular = h_serial_rx_circular(handle);
+    if (circular) {
+        DMA_HandleTypeDef *hdma = handle->hdmarx;
+        if (__HAL_DMA_GET_FLAG(hdma, __HAL_DMA_GET_HT_FLAG_INDEX(hdma)) != RESET) {
+            return_event |= SERIAL_EVENT_RX_HALF_FULL & SERIAL_OBJ(events);
+        }
+        if (__HAL_DMA_GET_FLAG(hdma, __HAL_DMA_GET_TC_FLAG_INDEX(hdma)) != RESET) {
+            return_event |= SERIAL_EVENT_RX_COMPLETE & SERIAL_OBJ(events);
+        }
+    }
+#endif
 #if DEVICE_SERIAL_ASYNCH_DMA
     if ((handle->Instance->CR3 & USART_CR3_DMAT) !=0) {
         // call dma tx interrupt
@@ -1437,6 +1528,20 @@ int serial_irq_handler_asynch(serial_t *obj)
     }
 #endif
     HAL_UART_IRQHandler(handle);
+#if DEVICE_SERIAL_ASYNCH_CIRCULAR
+    if (circular) {
+        // errors don't stop the circular receiver, which the HAL takes for stopped
+        if (handle->State == HAL_UART_STATE_READY) {
+            handle->State = HAL_UART_STATE_BUSY_RX;
+        } else if (handle->State == HAL_UART_STATE_BUSY_TX) {
+            handle->State = HAL_UART_STATE_BUSY_TX_RX;
+        }
+        if (__HAL_UART_GET_FLAG(handle, UART_FLAG_IDLE) != RESET) {
+            __HAL_UART_CLEAR_IDLEFLAG(handle);
+            return_event |= SERIAL_EVENT_RX_IDLE & SERIAL_OBJ(events);
+        }
+    }
+#endif
   // TX PART:
     if (__HAL_UART_GET_FLAG(handle, UART_FLAG_TC) != RESET) {
         __HAL_UART_CLEAR_FLAG(handle, UART_FLAG_TC);
@@ -1463,6 +1568,14 @@ int serial_irq_handler_asynch(serial_t *obj)
         return_event |= SERIAL_EVENT_RX_OVERRUN_ERROR & SERIAL_OBJ(events);
     }
 
+#if DEVICE_SERIAL_ASYNCH_CIRCULAR
+    if (circular) {
+        // the position is read by serial_rx_circular_position
+        handle->ErrorCode = HAL_UART_ERROR_NONE;
+        return return_event;
+    }
+#endif
+
     //RX PART
     // increment rx_buff.pos
     if (handle->RxXferSize !=0) {
@@ -1516,6 +1629,17 @@ void serial_tx_abort_asynch(serial_t *obj)
 void serial_rx_abort_asynch(serial_t *obj)
 {
     UART_HandleTypeDef *handle = &UartHandle[SERIAL_OBJ(index)];
+#if DEVICE_SERIAL_ASYNCH_CIRCULAR
+    if (h_serial_rx_circular(handle)) {
+        // stop the stream and leave it set up for single transfers
+        __HAL_UART_DISABLE_IT(handle, UART_IT_IDLE);
+        handle->Instance->CR3 &= (uint32_t)~((uint32_t)USART_CR3_DMAR);
+        __HAL_DMA_DISABLE(handle->hdmarx);
+        handle->hdmarx->Init.Mode = DMA_NORMAL;
+        HAL_DMA_Init(handle->hdmarx);
+        __HAL_UNLOCK(handle->hdmarx);
+    }
+#endif
     __HAL_UART_DISABLE_IT(handle, UART_IT_RXNE);
     // clear flags
     __HAL_UART_CLEAR_PEFLAG(handle);
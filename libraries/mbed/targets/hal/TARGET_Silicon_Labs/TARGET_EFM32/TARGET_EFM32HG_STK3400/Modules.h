@@ -38,5 +38,6 @@
 #define MODULES_SIZE_PWMOUT    1
 #define MODULES_SIZE_SERIAL    3
 #define TRANSACTION_QUEUE_SIZE_SPI   0
+#define TRANSACTION_QUEUE_SIZE_I2C   0
 
 #endif
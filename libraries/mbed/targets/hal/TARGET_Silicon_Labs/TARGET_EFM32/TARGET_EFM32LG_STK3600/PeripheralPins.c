@@ -232,3 +232,100 @@ const PinMap PinMap_UART_RX[] = {
     /* Not connected */
     {NC  , NC   , NC}
 };
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[8] = {
+    1, 2, 3, 4, 5, 6, 7, 8,
+};
+
+static const uint8_t PinMap_DAC_index[2] = {
+    1, 2,
+};
+
+static const uint8_t PinMap_I2C_SCL_index[81] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 0, 0, 0, 0,
+    5, 0, 0, 0, 8, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 4, 0,
+    10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 0, 0,
+    6,
+};
+
+static const uint8_t PinMap_I2C_SDA_index[81] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 0, 0, 0, 0,
+    5, 0, 0, 0, 8, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 4, 0,
+    10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 0, 0,
+    6,
+};
+
+static const uint8_t PinMap_PWM_index[3] = {
+    1, 2, 3,
+};
+
+static const uint8_t PinMap_SPI_MOSI_index[56] = {
+    8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 7,
+    0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 5, 0, 0,
+    0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 2, 0, 0, 1,
+};
+
+static const uint8_t PinMap_SPI_MISO_index[56] = {
+    8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0, 7,
+    0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 5, 0, 0,
+    0, 0, 6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 2, 0, 0, 0, 0, 1,
+};
+
+static const uint8_t PinMap_SPI_CLK_index[60] = {
+    8, 0, 0, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 7,
+    0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    2, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 6,
+};
+
+static const uint8_t PinMap_SPI_CS_index[60] = {
+    8, 0, 0, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 7,
+    0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+    0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 6,
+};
+
+static const uint8_t PinMap_UART_TX_index[86] = {
+    22, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 15, 0,
+    0, 0, 10, 0, 4, 0, 0, 0, 17, 0, 0, 11, 0, 14, 0, 0,
+    0, 21, 0, 0, 0, 0, 8, 0, 0, 0, 0, 12, 0, 0, 0, 16,
+    0, 0, 13, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 5, 0, 0,
+    0, 0, 7, 0, 0, 6, 0, 0, 9, 18, 0, 19, 0, 20, 0, 0,
+    0, 1, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_UART_RX_index[92] = {
+    20, 0, 0, 0, 0, 0, 22, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 15, 0, 0, 0, 10, 0, 4, 0, 0, 0, 17, 0,
+    0, 11, 0, 14, 0, 0, 0, 21, 0, 0, 8, 0, 0, 0, 0, 0,
+    0, 12, 0, 0, 0, 16, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 2, 0, 5, 0, 0, 7, 0, 0, 0, 0, 6, 9, 0, 0, 18,
+    0, 19, 0, 0, 0, 0, 0, 1, 0, 0, 0, 3,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 48, 8},
+    {PinMap_DAC, PinMap_DAC_index, 27, 2},
+    {PinMap_I2C_SCL, PinMap_I2C_SCL_index, 1, 81},
+    {PinMap_I2C_SDA, PinMap_I2C_SDA_index, 0, 81},
+    {PinMap_PWM, PinMap_PWM_index, 12, 3},
+    {PinMap_SPI_MOSI, PinMap_SPI_MOSI_index, 19, 56},
+    {PinMap_SPI_MISO, PinMap_SPI_MISO_index, 20, 56},
+    {PinMap_SPI_CLK, PinMap_SPI_CLK_index, 21, 60},
+    {PinMap_SPI_CS, PinMap_SPI_CS_index, 22, 60},
+    {PinMap_UART_TX, PinMap_UART_TX_index, 5, 86},
+    {PinMap_UART_RX, PinMap_UART_RX_index, 0, 92},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
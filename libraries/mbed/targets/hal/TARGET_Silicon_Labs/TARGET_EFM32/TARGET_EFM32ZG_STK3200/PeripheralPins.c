@@ -131,3 +131,85 @@ const PinMap PinMap_UART_RX[] = {
     /* Not connected */
     {NC  , NC   , NC}
 };
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[4] = {
+    1, 2, 3, 4,
+};
+
+static const uint8_t PinMap_I2C_SCL_index[81] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 0, 0,
+    4,
+};
+
+static const uint8_t PinMap_I2C_SDA_index[81] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 0, 0,
+    4,
+};
+
+static const uint8_t PinMap_PWM_index[3] = {
+    1, 2, 3,
+};
+
+static const uint8_t PinMap_SPI_MOSI_index[24] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_MISO_index[22] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_CLK_index[25] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_CS_index[23] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_UART_TX_index[54] = {
+    4, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 2, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 5, 0, 6,
+};
+
+static const uint8_t PinMap_UART_RX_index[82] = {
+    6, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 0,
+    0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 3, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 5,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 52, 4},
+    {PinMap_I2C_SCL, PinMap_I2C_SCL_index, 1, 81},
+    {PinMap_I2C_SDA, PinMap_I2C_SDA_index, 0, 81},
+    {PinMap_PWM, PinMap_PWM_index, 0, 3},
+    {PinMap_SPI_MOSI, PinMap_SPI_MOSI_index, 32, 24},
+    {PinMap_SPI_MISO, PinMap_SPI_MISO_index, 33, 22},
+    {PinMap_SPI_CLK, PinMap_SPI_CLK_index, 23, 25},
+    {PinMap_SPI_CS, PinMap_SPI_CS_index, 24, 23},
+    {PinMap_UART_TX, PinMap_UART_TX_index, 29, 54},
+    {PinMap_UART_RX, PinMap_UART_RX_index, 0, 82},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
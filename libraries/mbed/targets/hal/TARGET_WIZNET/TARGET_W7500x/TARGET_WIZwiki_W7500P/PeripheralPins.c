@@ -130,3 +130,79 @@ const PinMap PinMap_PWM[] = {
     {NC   , NC   , WIZ_PIN_DATA(WIZ_MODE_AF, WIZ_GPIO_NOPULL, Px_AFSR_AF0)}
 };
 
+
+/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it
+ * again after changing the arrays above. */
+static const uint8_t PinMap_ADC_index[8] = {
+    8, 7, 6, 5, 4, 3, 2, 1,
+};
+
+static const uint8_t PinMap_UART_TX_index[30] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_UART_RX_index[30] = {
+    1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_I2C_SDA_index[36] = {
+    4, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3,
+    0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_I2C_SCL_index[36] = {
+    4, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3,
+    0, 0, 0, 2,
+};
+
+static const uint8_t PinMap_SPI_SCLK_index[40] = {
+    1, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_SPI_MOSI_index[40] = {
+    1, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_SPI_MISO_index[40] = {
+    1, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_SPI_SSEL_index[40] = {
+    1, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 2, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 3,
+};
+
+static const uint8_t PinMap_PWM_index[43] = {
+    1, 2, 0, 0, 0, 3, 0, 4, 5, 6, 7, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    8, 0, 9, 0, 10, 11, 0, 0, 12, 0, 13,
+};
+
+static const PinMapIndex PinMap_index[] = {
+    {PinMap_ADC, PinMap_ADC_index, 40, 8},
+    {PinMap_UART_TX, PinMap_UART_TX_index, 13, 30},
+    {PinMap_UART_RX, PinMap_UART_RX_index, 14, 30},
+    {PinMap_I2C_SDA, PinMap_I2C_SDA_index, 6, 36},
+    {PinMap_I2C_SCL, PinMap_I2C_SCL_index, 5, 36},
+    {PinMap_SPI_SCLK, PinMap_SPI_SCLK_index, 6, 40},
+    {PinMap_SPI_MOSI, PinMap_SPI_MOSI_index, 8, 40},
+    {PinMap_SPI_MISO, PinMap_SPI_MISO_index, 7, 40},
+    {PinMap_SPI_SSEL, PinMap_SPI_SSEL_index, 5, 40},
+    {PinMap_PWM, PinMap_PWM_index, 0, 43},
+    {0, 0, 0, 0}
+};
+
+const PinMapIndex *pinmap_index(void) {
+    return PinMap_index;
+}
@@ -1,24 +1,78 @@
 #include "HTTPHeader.h"
-#include <stdlib.h>    
-using std::map;
+#include <cctype>
+#include <cstring>
 using std::string;
 
 HTTPHeader::HTTPHeader():
 _status(HTTP_ERROR),
-_fields()
+_status_code(0),
+_content_length(-1),
+_chunked(false),
+_keep_alive(false),
+_fields_len(0)
 {
 }
 
 std::string HTTPHeader::getField(const std::string& name)
 {
-    map<string,string>::iterator itor = _fields.find(name);
-    if(itor == _fields.end())
+    const char* value = findField(name.c_str());
+    if(value == NULL)
         return string();
-    return itor->second;
+    return string(value);
+}
+
+const char* HTTPHeader::findField(const char* name) const
+{
+    int i = 0;
+    while(i < _fields_len)
+    {
+        const char* field = &_fields[i];
+        const char* value = field + std::strlen(field) + 1;
+
+        const char* a = field;
+        const char* b = name;
+        while(*a && std::tolower((unsigned char)*a) == std::tolower((unsigned char)*b))
+        {
+            a++;
+            b++;
+        }
+        if(*a == '\0' && *b == '\0')
+            return value;
+
+        i = (value - _fields) + std::strlen(value) + 1;
+    }
+    return NULL;
 }
 
 int HTTPHeader::getBodyLength()
 {
-    return atoi(getField("Content-Length").c_str());
+    return _chunked ? -1 : _content_length;
 }
 
+int HTTPHeader::getStatusCode() const
+{
+    return _status_code;
+}
+
+bool HTTPHeader::isChunked() const
+{
+    return _chunked;
+}
+
+bool HTTPHeader::isKeepAlive() const
+{
+    return _keep_alive;
+}
+
+void HTTPHeader::addField(const char* name, const char* value)
+{
+    int name_len = std::strlen(name) + 1;
+    int value_len = std::strlen(value) + 1;
+    if(_fields_len + name_len + value_len > HTTP_HEADER_FIELDS_SIZE)
+        return;
+
+    std::memcpy(&_fields[_fields_len], name, name_len);
+    _fields_len += name_len;
+    std::memcpy(&_fields[_fields_len], value, value_len);
+    _fields_len += value_len;
+}
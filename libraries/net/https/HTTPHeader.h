@@ -2,27 +2,61 @@
 #define HTTPHEADER_H
 
 #include <string>
-#include <map>
+
+/** Room for the header fields of a response, as "name\0value\0" pairs.
+    Fields that don't fit are dropped, the ones HTTPResponseParser needs
+    (Content-Length, Transfer-Encoding, Connection) are always interpreted. */
+#ifndef HTTP_HEADER_FIELDS_SIZE
+#define HTTP_HEADER_FIELDS_SIZE 256
+#endif
 
 enum HTTPStatus { HTTP_OK, HTTP_ERROR };
 
 class HTTPSClient;
+class HTTPResponseParser;
 
 class HTTPHeader
 {
     friend class HTTPSClient;
+    friend class HTTPResponseParser;
 
     public :
-    
+
         HTTPHeader();
-        
-        std::string getField(const std::string& name);  
+
+        std::string getField(const std::string& name);
+
+        /** Look up a header field, names are case insensitive
+        \return the value of the field, or NULL if the response didn't have it
+        */
+        const char* findField(const char* name) const;
+
+        /** Length of the body
+        \return the Content-Length of the response, or -1 if the length isn't known
+        in advance (chunked body, or a body that ends when the server closes)
+        */
         int getBodyLength();
-        
+
+        /** Status code of the response, 0 if no status line was received */
+        int getStatusCode() const;
+
+        /** Check if the body uses Transfer-Encoding: chunked */
+        bool isChunked() const;
+
+        /** Check if the server keeps the connection open after this response */
+        bool isKeepAlive() const;
+
     private :
-    
+
+        void addField(const char* name, const char* value);
+
         HTTPStatus _status;
-        std::map<std::string, std::string> _fields;
+        int _status_code;
+        int _content_length;
+        bool _chunked;
+        bool _keep_alive;
+        int _fields_len;
+        char _fields[HTTP_HEADER_FIELDS_SIZE];
 };
 
 
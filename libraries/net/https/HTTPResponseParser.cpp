@@ -0,0 +1,272 @@
+#include "HTTPResponseParser.h"
+#include <cctype>
+#include <cstring>
+#include <cstdlib>
+
+using std::memcpy;
+
+namespace {
+
+bool same_name(const char *a, const char *b)
+{
+    while (*a && std::tolower((unsigned char)*a) == std::tolower((unsigned char)*b)) {
+        a++;
+        b++;
+    }
+    return *a == '\0' && *b == '\0';
+}
+
+// Case insensitive search of a token in a header value such as "Keep-Alive, Upgrade"
+bool has_token(const char *value, const char *token)
+{
+    int len = std::strlen(token);
+    for (; *value; value++) {
+        int i = 0;
+        while (i < len && std::tolower((unsigned char)value[i]) == token[i])
+            i++;
+        if (i == len)
+            return true;
+    }
+    return false;
+}
+
+}
+
+HTTPResponseParser::HTTPResponseParser() :
+        _header(NULL),
+        _state(STATE_ERROR),
+        _remaining(0),
+        _until_close(false),
+        _line_len(0) {
+}
+
+void HTTPResponseParser::reset(HTTPHeader *header) {
+    *header = HTTPHeader();
+    _header = header;
+    _state = STATE_STATUS;
+    _remaining = 0;
+    _until_close = false;
+    _line_len = 0;
+}
+
+int HTTPResponseParser::parse(const char *data, int len, char *body, int body_len, int *body_read) {
+    int i = 0;
+    *body_read = 0;
+
+    while (i < len && _state != STATE_DONE && _state != STATE_ERROR) {
+        if (_state == STATE_BODY || _state == STATE_CHUNK_DATA) {
+            // Body bytes are copied in blocks, not looked at one by one
+            int n = len - i;
+            if (!_until_close && (uint32_t)n > _remaining)
+                n = _remaining;
+            if (n > body_len - *body_read)
+                n = body_len - *body_read;
+            if (n <= 0)
+                break;
+
+            memcpy(body + *body_read, data + i, n);
+            *body_read += n;
+            i += n;
+            bodyConsumed(n);
+            continue;
+        }
+
+        char c = data[i++];
+        if (c != '\n') {
+            if (_line_len < HTTP_LINE_MAX - 1)
+                _line[_line_len++] = c;
+            continue;
+        }
+
+        if (_line_len > 0 && _line[_line_len - 1] == '\r')
+            _line_len--;
+        _line[_line_len] = '\0';
+        parseLine();
+        _line_len = 0;
+    }
+
+    return i;
+}
+
+int HTTPResponseParser::bodyDirect() const {
+    if (_state != STATE_BODY && _state != STATE_CHUNK_DATA)
+        return 0;
+    if (_until_close || _remaining > 0x7fffffff)
+        return 0x7fffffff;
+    return _remaining;
+}
+
+void HTTPResponseParser::bodyConsumed(int len) {
+    if (_until_close)
+        return;
+
+    _remaining -= len;
+    if (_remaining == 0)
+        _state = (_state == STATE_BODY) ? STATE_DONE : STATE_CHUNK_END;
+}
+
+void HTTPResponseParser::connectionClosed() {
+    if (_state == STATE_BODY && _until_close)
+        _state = STATE_DONE;
+    else if (_state != STATE_DONE)
+        _state = STATE_ERROR;
+}
+
+bool HTTPResponseParser::headerDone() const {
+    return _state > STATE_HEADER && _state != STATE_ERROR;
+}
+
+bool HTTPResponseParser::done() const {
+    return _state == STATE_DONE;
+}
+
+bool HTTPResponseParser::failed() const {
+    return _state == STATE_ERROR;
+}
+
+void HTTPResponseParser::parseLine() {
+    switch (_state) {
+        case STATE_STATUS:
+            parseStatus();
+            break;
+
+        case STATE_HEADER:
+            if (_line_len == 0)
+                startBody();
+            else
+                parseField();
+            break;
+
+        case STATE_CHUNK_SIZE:
+            parseChunkSize();
+            break;
+
+        case STATE_CHUNK_END:
+            // The CRLF that closes the chunk data
+            _state = (_line_len == 0) ? STATE_CHUNK_SIZE : STATE_ERROR;
+            break;
+
+        case STATE_TRAILER:
+            // Trailer fields are skipped, an empty line ends the response
+            if (_line_len == 0)
+                _state = STATE_DONE;
+            break;
+
+        default:
+            break;
+    }
+}
+
+// "HTTP/1.1 200 OK"
+void HTTPResponseParser::parseStatus() {
+    const char *p = _line;
+    if (std::strncmp(p, "HTTP/", 5) != 0 || !std::isdigit((unsigned char)p[5]) ||
+        p[6] != '.' || !std::isdigit((unsigned char)p[7])) {
+        _state = STATE_ERROR;
+        return;
+    }
+    int version = (p[5] - '0') * 10 + (p[7] - '0');
+
+    p += 8;
+    while (*p == ' ')
+        p++;
+    int code = 0;
+    for (int i = 0; i < 3; i++, p++) {
+        if (!std::isdigit((unsigned char)*p)) {
+            _state = STATE_ERROR;
+            return;
+        }
+        code = code * 10 + (*p - '0');
+    }
+
+    _header->_status_code = code;
+    _header->_status = (code == 200) ? HTTP_OK : HTTP_ERROR;
+    // HTTP/1.1 connections are persistent unless the server says otherwise
+    _header->_keep_alive = (version >= 11);
+    _state = STATE_HEADER;
+}
+
+// "Name: value"
+void HTTPResponseParser::parseField() {
+    char *sep = std::strchr(_line, ':');
+    if (sep == NULL)
+        return;
+
+    char *name_end = sep;
+    while (name_end > _line && (name_end[-1] == ' ' || name_end[-1] == '\t'))
+        name_end--;
+    *name_end = '\0';
+
+    char *value = sep + 1;
+    while (*value == ' ' || *value == '\t')
+        value++;
+    char *value_end = _line + _line_len;
+    while (value_end > value && (value_end[-1] == ' ' || value_end[-1] == '\t'))
+        value_end--;
+    *value_end = '\0';
+
+    if (same_name(_line, "Content-Length")) {
+        _header->_content_length = std::strtoul(value, NULL, 10);
+    } else if (same_name(_line, "Transfer-Encoding")) {
+        _header->_chunked = has_token(value, "chunked");
+    } else if (same_name(_line, "Connection")) {
+        if (has_token(value, "close"))
+            _header->_keep_alive = false;
+        else if (has_token(value, "keep-alive"))
+            _header->_keep_alive = true;
+    }
+
+    _header->addField(_line, value);
+}
+
+void HTTPResponseParser::startBody() {
+    int code = _header->_status_code;
+
+    if (code >= 100 && code < 200) {
+        // Interim response (100 Continue), the real one follows
+        reset(_header);
+        return;
+    }
+
+    if (code == 204 || code == 304) {
+        _state = STATE_DONE;
+    } else if (_header->_chunked) {
+        _state = STATE_CHUNK_SIZE;
+    } else if (_header->_content_length >= 0) {
+        _remaining = _header->_content_length;
+        _state = (_remaining > 0) ? STATE_BODY : STATE_DONE;
+    } else {
+        // No length: the body runs until the server closes the connection
+        _until_close = true;
+        _header->_keep_alive = false;
+        _state = STATE_BODY;
+    }
+}
+
+// "1a2b;extension"
+void HTTPResponseParser::parseChunkSize() {
+    uint32_t size = 0;
+    int digits = 0;
+    const char *p = _line;
+
+    for (; std::isxdigit((unsigned char)*p); p++, digits++) {
+        if (size > 0x0fffffff) {
+            _state = STATE_ERROR;
+            return;
+        }
+        int c = std::tolower((unsigned char)*p);
+        size = (size << 4) | (std::isdigit(c) ? c - '0' : c - 'a' + 10);
+    }
+
+    if (digits == 0 || (*p != '\0' && *p != ';' && *p != ' ')) {
+        _state = STATE_ERROR;
+        return;
+    }
+
+    if (size == 0) {
+        _state = STATE_TRAILER;
+    } else {
+        _remaining = size;
+        _state = STATE_CHUNK_DATA;
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef HTTPRESPONSEPARSER_H
+#define HTTPRESPONSEPARSER_H
+
+#include <stdint.h>
+#include "HTTPHeader.h"
+
+/** Longest status, header or chunk size line kept, longer lines are truncated */
+#ifndef HTTP_LINE_MAX
+#define HTTP_LINE_MAX 256
+#endif
+
+/**
+Incremental HTTP/1.1 response parser
+
+The parser is fed with whatever the transport returns, in pieces of any size.
+It doesn't allocate: header fields go to the HTTPHeader given to reset(), body
+bytes are copied to the caller's buffer, and chunked bodies are decoded on the
+fly. Bytes that come after the end of the response are left unconsumed.
+*/
+class HTTPResponseParser
+{
+public:
+    HTTPResponseParser();
+
+    /** Start parsing a new response
+    \param header Receives the status and the header fields, must outlive the response.
+    */
+    void reset(HTTPHeader *header);
+
+    /** Parse the next piece of the response
+    \param data Received bytes.
+    \param len Number of received bytes.
+    \param body Buffer for the body, can be NULL to stop at the end of the header.
+    \param body_len Size of the body buffer.
+    \param body_read Set to the number of body bytes written to body.
+    \return the number of bytes of data consumed, which is less than len if the
+    body buffer is full or the response is complete.
+    */
+    int parse(const char *data, int len, char *body, int body_len, int *body_read);
+
+    /** Number of body bytes that may be read straight from the transport into
+    the caller's buffer, without going through parse(). This is the rest of the
+    body or of the current chunk, 0 while the parser expects anything else.
+    */
+    int bodyDirect() const;
+
+    /** Account for len bytes read straight into the caller's buffer
+    \param len Number of bytes, up to bodyDirect().
+    */
+    void bodyConsumed(int len);
+
+    /** The transport was closed by the peer, this ends a body without length */
+    void connectionClosed();
+
+    /** Check if the status line and all header fields were parsed */
+    bool headerDone() const;
+
+    /** Check if the whole response, including the body, was parsed */
+    bool done() const;
+
+    /** Check if the response was malformed or cut short */
+    bool failed() const;
+
+private:
+    enum State {
+        STATE_STATUS,
+        STATE_HEADER,
+        STATE_BODY,
+        STATE_CHUNK_SIZE,
+        STATE_CHUNK_DATA,
+        STATE_CHUNK_END,
+        STATE_TRAILER,
+        STATE_DONE,
+        STATE_ERROR
+    };
+
+    void parseLine();
+    void parseStatus();
+    void parseField();
+    void startBody();
+    void parseChunkSize();
+
+    HTTPHeader *_header;
+    State _state;
+    uint32_t _remaining;
+    bool _until_close;
+    int _line_len;
+    char _line[HTTP_LINE_MAX];
+};
+
+#endif
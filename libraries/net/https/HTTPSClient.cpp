@@ -7,28 +7,34 @@
 #include <stdio.h>
 
 using std::memset;
-using std::memcpy;    
-using std::string;
-
-const static int HTTPS_PORT = 443;
-char buf[256];
+using std::memcpy;
+using std::memmove;
 
 HTTPSClient::HTTPSClient() :
         _is_connected(false),
+        _is_resumed(false),
+        _in_response(false),
         _ssl_ctx(),
         _ssl(),
-        _host() {
+        _response(),
+        _parser(),
+        _rx_start(0),
+        _rx_end(0) {
+    _host[0] = '\0';
 }
 
 HTTPSClient::~HTTPSClient() {
     close();
 }
 
-int HTTPSClient::connect(const char* host) {
+int HTTPSClient::connect(const char* host, int port) {
+    if (strlen(host) >= sizeof(_host))
+        return -1;
+    
     if (init_socket(SOCK_STREAM) < 0)
         return -1;
     
-    if (set_address(host, HTTPS_PORT) != 0)
+    if (set_address(host, port) != 0)
         return -1;
     
     if (lwip_connect(_sock_fd, (const struct sockaddr *) &_remoteHost, sizeof(_remoteHost)) < 0) {
@@ -41,19 +47,42 @@ int HTTPSClient::connect(const char* host) {
 
     _ssl.ssl_ctx = &_ssl_ctx;
     
-    if(ssl_client_new(&_ssl, _sock_fd, NULL, 0) == NULL)
+    // The context only lives as long as this connection, so a session kept
+    // in the shared cache is handed back to it before the handshake
+    uint8_t session_id[SSL_SESSION_ID_SIZE];
+    uint8_t sess_id_size = 0;
+    uint8_t master_secret[SSL_SECRET_SIZE];
+    bool cached = HTTPSSessionCache::lookup(host, port, session_id, &sess_id_size, master_secret);
+    if (cached && ssl_ctx_add_session(&_ssl_ctx, session_id, sess_id_size, master_secret) != SSL_OK)
+        cached = false;
+    memset(master_secret, 0, sizeof(master_secret));
+    
+    if(ssl_client_new(&_ssl, _sock_fd, cached ? session_id : NULL, sess_id_size) == NULL)
     {
-        close();
+        ssl_ctx_free(&_ssl_ctx);
+        Socket::close();
         return -1;
     }
     if(_ssl.hs_status != SSL_OK)
     {
-        close();
+        // Don't offer a session the server just failed to resume again
+        if (cached)
+            HTTPSSessionCache::remove(host, port);
+        ssl_ctx_free(&_ssl_ctx);
+        Socket::close();
         return -1;
     }
     
+    // A resumed session keeps the lifetime it had when it was negotiated
+    _is_resumed = (_ssl.flag & SSL_SESSION_RESUME) != 0;
+    if (!_is_resumed)
+        HTTPSSessionCache::store(host, port, ssl_get_session_id(&_ssl),
+                                 ssl_get_session_id_size(&_ssl), ssl_get_master_secret(&_ssl));
+    
     _is_connected = true;
-    _host = host;
+    _in_response = false;
+    _rx_start = _rx_end = 0;
+    strcpy(_host, host);
     return 0;
 }
 
@@ -61,97 +90,163 @@ bool HTTPSClient::is_connected(void) {
     return _is_connected;
 }
 
-int HTTPSClient::send(char* data, int length) {
+bool HTTPSClient::is_resumed(void) {
+    return _is_resumed;
+}
+
+int HTTPSClient::send(const char* data, int length) {
     if ((_sock_fd < 0) || !_is_connected)
         return -1;
             
-    return ssl_write(&_ssl, (uint8_t*)data, length);
+    return ssl_write(&_ssl, (const uint8_t*)data, length);
 }
 
+// Returns the number of decrypted bytes read, -1 if the connection is gone
+static int receive(SSL *ssl, uint8_t *data, int len)
+{
+    int ret;
+    
+    // 0 comes back for records that don't carry application data
+    do
+    {
+        ret = ssl_read(ssl, data, len);
+    }while(ret == 0 && ssl->hs_status != SSL_ERROR_DEAD);
+    
+    return (ret > 0) ? ret : -1;
+}
 
+// Reads whatever the current record holds into the receive buffer
+int HTTPSClient::fill_buffer()
+{
+    if(_rx_start == _rx_end)
+    {
+        _rx_start = _rx_end = 0;
+    }
+    else if(_rx_end == sizeof(_rx_buf))
+    {
+        memmove(_rx_buf, &_rx_buf[_rx_start], _rx_end - _rx_start);
+        _rx_end -= _rx_start;
+        _rx_start = 0;
+    }
+    
+    int ret = receive(&_ssl, (uint8_t*)&_rx_buf[_rx_end], sizeof(_rx_buf) - _rx_end);
+    if(ret < 0)
+        return -1;
+    
+    _rx_end += ret;
+    return ret;
+}
 
-HTTPHeader HTTPSClient::get(char *request)
+HTTPHeader HTTPSClient::get(const char *path)
 {
     if((_sock_fd < 0) || !_is_connected)
         return HTTPHeader();
+    
+    // The previous response must be read to its end before the connection is reused
+    if(_in_response && !skip_body())
+        return HTTPHeader();
+    if(!_is_connected)
+        return HTTPHeader();
         
-    sprintf(buf, "GET %s HTTP/1.1\r\nHost: %s\r\n\r\n", request, _host.c_str());
-    printf("buf=%s\n", buf);
-    if(send(buf, strlen(buf)) != strlen(buf))
+    char request[HTTPS_REQUEST_MAX];
+    int len = snprintf(request, sizeof(request), "GET %s HTTP/1.1\r\nHost: %s\r\n\r\n", path, _host);
+    if(len < 0 || len >= (int)sizeof(request))
+        return HTTPHeader();
+    if(send(request, len) != len)
         return HTTPHeader();
-    printf("Finished sending request\n");
-    return read_header();
-}
-
-
-HTTPHeader HTTPSClient::read_header()
-{
-    _ssl.bm_read_index = 0;
-    _ssl.bm_index = 0;
-    HTTPHeader hdr;
-    if(read_line())
-        return hdr;
-    
-    int status;
-    
-    if(sscanf(buf, "HTTP/%*d.%*d %d %*s", &status) == -1)
-        return hdr;
     
-    if(status == 200)
-        hdr._status = HTTP_OK;
-   if(read_line())
-        return hdr;
-    do
+    _parser.reset(&_response);
+    _in_response = true;
+    while(!_parser.headerDone())
     {
-        string tmp(buf);
-        std::size_t sep = tmp.find(':');
-        string name = tmp.substr(0, sep);
-        string value = tmp.substr(sep+2, tmp.size());
-        hdr._fields[name] = value;
-        if(read_line())
-            return hdr;
-    }while(strlen(buf));
-    
-    return hdr;
+        if(_rx_start == _rx_end && fill_buffer() < 0)
+            _parser.connectionClosed();
+        
+        int body_read;
+        _rx_start += _parser.parse(&_rx_buf[_rx_start], _rx_end - _rx_start, NULL, 0, &body_read);
+        if(_parser.failed())
+        {
+            close();
+            return HTTPHeader();
+        }
+    }
+    
+    if(_parser.done())
+        end_response();
+    return _response;
 }
 
-uint8_t HTTPSClient::read_line()
+int HTTPSClient::read(char *data, int len)
 {
-    int index = 0;
-    do
+    if(!_in_response)
+        return 0;
+    
+    int total = 0;
+    while(total < len && !_parser.done() && !_parser.failed())
     {
-        if(ssl_read(&_ssl, (uint8_t*)(&buf[index]), 1) != 1)
+        if(_rx_start == _rx_end)
         {
-            return 1;
+            // Return what we have rather than wait for the next record
+            if(total > 0)
+                break;
+            
+            int direct = _parser.bodyDirect();
+            if(direct > 0)
+            {
+                // Nothing buffered, the body goes straight to the caller's buffer
+                if(direct > len)
+                    direct = len;
+                int ret = receive(&_ssl, (uint8_t*)data, direct);
+                if(ret < 0)
+                {
+                    _parser.connectionClosed();
+                    break;
+                }
+                _parser.bodyConsumed(ret);
+                total += ret;
+                continue;
+            }
+            
+            if(fill_buffer() < 0)
+            {
+                _parser.connectionClosed();
+                break;
+            }
         }
-        index++;
-    }while(buf[index-1] != '\r' && index < 256);
-    ssl_read(&_ssl, (uint8_t*)(&buf[index-1]), 1);  // skip '\n'
-    buf[index-1] = '\0';
+        
+        int body_read;
+        _rx_start += _parser.parse(&_rx_buf[_rx_start], _rx_end - _rx_start, data + total, len - total, &body_read);
+        total += body_read;
+    }
     
-    return 0;
+    if(_parser.failed())
+    {
+        close();
+        return -1;
+    }
+    if(_parser.done())
+        end_response();
+    return total;
 }
 
-// -1:error
-// otherwise return nb of characters read. Cannot be > than len
-int HTTPSClient::read(char *data, int len)
+// Reads and drops the rest of the body, returns false on error
+bool HTTPSClient::skip_body()
 {
-    return ssl_read(&_ssl, (uint8_t*)data, len);
+    char discard[64];
+    int ret;
+    
+    while((ret = read(discard, sizeof(discard))) > 0)
+        ;
+    return ret == 0;
 }
-/*
-    0    : must close connection
-    -1   : error
-    else : get data
 
-int HTTPSClient::receive(char* data, int length) {
-    if ((_sock_fd < 0) || !_is_connected)
-        return -1;
-  
-    if(read_record(&_ssl) < 0)
-        return -1;
-    return process_data(&_ssl, (uint8_t*)data, length);
+void HTTPSClient::end_response()
+{
+    _in_response = false;
+    if(!_response.isKeepAlive())
+        close();
 }
-*/
+
 void HTTPSClient::close()
 {
     if(!_is_connected)
@@ -159,5 +254,7 @@ void HTTPSClient::close()
     ssl_ctx_free(_ssl.ssl_ctx);
     Socket::close();
     _is_connected = false;
-    _host.clear();
+    _in_response = false;
+    _rx_start = _rx_end = 0;
+    _host[0] = '\0';
 }
@@ -5,52 +5,95 @@
 #include "Socket/Endpoint.h"
 #include "axTLS/ssl/ssl.h"
 #include "HTTPHeader.h"
+#include "HTTPResponseParser.h"
+#include "HTTPSSessionCache.h"
+
+#define HTTPS_PORT 443
+
+/** Decrypted data is read from axTLS into this buffer, as much as a record
+    holds at a time, and the response is parsed from there. */
+#ifndef HTTPS_RX_BUFFER_SIZE
+#define HTTPS_RX_BUFFER_SIZE 512
+#endif
+
+/** Longest request line and Host field sent by get() */
+#ifndef HTTPS_REQUEST_MAX
+#define HTTPS_REQUEST_MAX 256
+#endif
 
 /**
 TCP socket connection
 */
 class HTTPSClient : public Socket, public Endpoint {
-    
+
 public:
     /** TCP socket connection
     */
     HTTPSClient();
-    
-    
+
+
     virtual ~HTTPSClient();
-    
+
     /** Connects this TCP socket to the server
     \param host The host to connect to. It can either be an IP Address or a hostname that will be resolved with DNS.
     \param port The host's port to connect to.
     \return 0 on success, -1 on failure.
+
+    If a TLS session negotiated earlier with the same host and port is still in
+    HTTPSSessionCache, it is offered to the server for resumption.
     */
-    int connect(const char* host);
-    
+    int connect(const char* host, int port = HTTPS_PORT);
+
+    /** Check if the last handshake resumed a cached TLS session
+    \return true if the session was resumed, false if a full handshake was done.
+    */
+    bool is_resumed(void);
+
     /** Check if the socket is connected
     \return true if connected, false otherwise.
     */
     bool is_connected(void);
-    
-    // Returns the size of the body
-    HTTPHeader get(char *path);
-    
+
+    /** Send a GET request and read the header of the response
+    \param path The path of the resource, starting with '/'.
+    \return the header of the response, with an HTTP_ERROR status if the request failed.
+
+    The connection stays open after the response if the server allows it, so
+    several requests can be sent one after the other. Whatever is left of the
+    previous body is read and dropped first.
+    */
+    HTTPHeader get(const char *path);
+
+    /** Read the body of the response to the last get()
+    \param data Buffer for the body, the chunked transfer coding is removed.
+    \param len Size of the buffer.
+    \return the number of bytes read, 0 at the end of the body, -1 on error.
+    */
     int read(char *data, int len);
 
 
     void close();
-    
+
 private:
 
 
-    int send(char* data, int length);
-    
-    uint8_t read_line();
-    HTTPHeader read_header();
+    int send(const char* data, int length);
+
+    int fill_buffer();
+    bool skip_body();
+    void end_response();
 
     bool _is_connected;
+    bool _is_resumed;
+    bool _in_response;
     SSL_CTX _ssl_ctx;
     SSL _ssl;
-    std::string _host;
+    char _host[HTTPS_SESSION_HOST_MAX];
+    HTTPHeader _response;
+    HTTPResponseParser _parser;
+    int _rx_start;
+    int _rx_end;
+    char _rx_buf[HTTPS_RX_BUFFER_SIZE];
 };
 
 #endif
@@ -0,0 +1,141 @@
+#include "HTTPSSessionCache.h"
+#include "Mutex.h"
+#include <cstring>
+
+using std::memset;
+using std::memcpy;
+using std::strcmp;
+using std::strlen;
+
+HTTPSSessionCache::Entry HTTPSSessionCache::_entries[HTTPS_SESSION_CACHE_SIZE];
+int HTTPSSessionCache::_capacity = HTTPS_SESSION_CACHE_SIZE;
+int HTTPSSessionCache::_lifetime = HTTPS_SESSION_LIFETIME;
+uint32_t HTTPSSessionCache::_use_counter = 0;
+HTTPSSessionCache::Stats HTTPSSessionCache::_stats;
+
+static rtos::Mutex cache_mutex;
+
+void HTTPSSessionCache::set_capacity(int capacity) {
+    if (capacity < 0)
+        capacity = 0;
+    if (capacity > HTTPS_SESSION_CACHE_SIZE)
+        capacity = HTTPS_SESSION_CACHE_SIZE;
+
+    cache_mutex.lock();
+    for (int i = capacity; i < _capacity; i++)
+        erase(&_entries[i]);
+    _capacity = capacity;
+    cache_mutex.unlock();
+}
+
+void HTTPSSessionCache::set_lifetime(int seconds) {
+    cache_mutex.lock();
+    _lifetime = seconds;
+    cache_mutex.unlock();
+}
+
+bool HTTPSSessionCache::lookup(const char *host, int port, uint8_t *session_id,
+                               uint8_t *sess_id_size, uint8_t *master_secret) {
+    bool found = false;
+
+    cache_mutex.lock();
+    Entry *entry = find(host, port);
+    if (entry != NULL && expired(entry, time(NULL))) {
+        erase(entry);
+        entry = NULL;
+    }
+    if (entry != NULL) {
+        memcpy(session_id, entry->session_id, entry->sess_id_size);
+        *sess_id_size = entry->sess_id_size;
+        memcpy(master_secret, entry->master_secret, SSL_SECRET_SIZE);
+        entry->last_used = ++_use_counter;
+        _stats.hits++;
+        found = true;
+    } else {
+        _stats.misses++;
+    }
+    cache_mutex.unlock();
+
+    return found;
+}
+
+void HTTPSSessionCache::store(const char *host, int port, const uint8_t *session_id,
+                              uint8_t sess_id_size, const uint8_t *master_secret) {
+    if (sess_id_size == 0 || sess_id_size > SSL_SESSION_ID_SIZE || master_secret == NULL)
+        return;
+    if (strlen(host) >= HTTPS_SESSION_HOST_MAX)
+        return;
+
+    cache_mutex.lock();
+    Entry *entry = find(host, port);
+    if (entry == NULL) {
+        // Take a free slot, otherwise the least recently used one
+        for (int i = 0; i < _capacity; i++) {
+            if (_entries[i].sess_id_size == 0) {
+                entry = &_entries[i];
+                break;
+            }
+            if (entry == NULL || _entries[i].last_used < entry->last_used)
+                entry = &_entries[i];
+        }
+        if (entry != NULL && entry->sess_id_size != 0)
+            _stats.evictions++;
+    }
+    if (entry != NULL) {
+        std::strcpy(entry->host, host);
+        entry->port = port;
+        memcpy(entry->session_id, session_id, sess_id_size);
+        entry->sess_id_size = sess_id_size;
+        memcpy(entry->master_secret, master_secret, SSL_SECRET_SIZE);
+        entry->created = time(NULL);
+        entry->last_used = ++_use_counter;
+        _stats.stores++;
+    }
+    cache_mutex.unlock();
+}
+
+void HTTPSSessionCache::remove(const char *host, int port) {
+    cache_mutex.lock();
+    Entry *entry = find(host, port);
+    if (entry != NULL)
+        erase(entry);
+    cache_mutex.unlock();
+}
+
+void HTTPSSessionCache::clear() {
+    cache_mutex.lock();
+    for (int i = 0; i < HTTPS_SESSION_CACHE_SIZE; i++)
+        erase(&_entries[i]);
+    cache_mutex.unlock();
+}
+
+void HTTPSSessionCache::get_stats(Stats *stats) {
+    cache_mutex.lock();
+    *stats = _stats;
+    cache_mutex.unlock();
+}
+
+void HTTPSSessionCache::reset_stats() {
+    cache_mutex.lock();
+    memset(&_stats, 0, sizeof(_stats));
+    cache_mutex.unlock();
+}
+
+HTTPSSessionCache::Entry *HTTPSSessionCache::find(const char *host, int port) {
+    for (int i = 0; i < _capacity; i++) {
+        Entry *entry = &_entries[i];
+        if (entry->sess_id_size != 0 && entry->port == port && strcmp(entry->host, host) == 0)
+            return entry;
+    }
+    return NULL;
+}
+
+void HTTPSSessionCache::erase(Entry *entry) {
+    // Don't leave the master secret behind in RAM
+    memset(entry, 0, sizeof(*entry));
+}
+
+bool HTTPSSessionCache::expired(const Entry *entry, time_t now) {
+    // A clock that went backwards (RTC set after the session was stored) also expires the entry
+    return (now < entry->created) || (now - entry->created >= _lifetime);
+}
@@ -0,0 +1,100 @@
+#ifndef HTTPSSESSIONCACHE_H
+#define HTTPSSESSIONCACHE_H
+
+#include <stdint.h>
+#include <time.h>
+#include "axTLS/ssl/ssl.h"
+
+/** Maximum number of TLS sessions kept by the client session cache */
+#ifndef HTTPS_SESSION_CACHE_SIZE
+#define HTTPS_SESSION_CACHE_SIZE    4
+#endif
+
+/** Default lifetime of a cached TLS session, in seconds */
+#ifndef HTTPS_SESSION_LIFETIME
+#define HTTPS_SESSION_LIFETIME      3600
+#endif
+
+/** Longest host name that can be used as a cache key */
+#define HTTPS_SESSION_HOST_MAX      64
+
+/**
+Client side cache of TLS sessions, keyed by host:port.
+
+The cache is shared by all HTTPSClient instances: once a full handshake with
+a server has completed, the next connection to the same host and port offers
+the cached session id so that the server can resume it, skipping the RSA key
+exchange. Entries expire after the configured lifetime; the age of an entry
+is measured with time(), so on targets without a running RTC entries only
+leave the cache when they are replaced or refused by the server.
+*/
+class HTTPSSessionCache {
+
+public:
+    struct Stats {
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t stores;
+        uint32_t evictions;
+    };
+
+    /** Set the number of sessions kept in the cache
+    \param capacity Number of sessions, at most HTTPS_SESSION_CACHE_SIZE. 0 disables the cache.
+    */
+    static void set_capacity(int capacity);
+
+    /** Set the time a session is kept in the cache
+    \param seconds Lifetime of a session, in seconds.
+    */
+    static void set_lifetime(int seconds);
+
+    /** Look up the session negotiated with a server
+    \param host The host name used to connect to the server.
+    \param port The port of the server.
+    \param session_id Receives the session id (SSL_SESSION_ID_SIZE bytes).
+    \param sess_id_size Receives the size of the session id.
+    \param master_secret Receives the master secret (SSL_SECRET_SIZE bytes).
+    \return true if a session was found, false otherwise.
+    */
+    static bool lookup(const char *host, int port, uint8_t *session_id,
+                       uint8_t *sess_id_size, uint8_t *master_secret);
+
+    /** Store the session negotiated with a server, replacing the least recently used entry if the cache is full
+    */
+    static void store(const char *host, int port, const uint8_t *session_id,
+                      uint8_t sess_id_size, const uint8_t *master_secret);
+
+    /** Remove the session of a server from the cache
+    */
+    static void remove(const char *host, int port);
+
+    /** Remove all sessions from the cache
+    */
+    static void clear();
+
+    static void get_stats(Stats *stats);
+    static void reset_stats();
+
+private:
+    struct Entry {
+        char host[HTTPS_SESSION_HOST_MAX];
+        int port;
+        uint8_t session_id[SSL_SESSION_ID_SIZE];
+        uint8_t sess_id_size;
+        uint8_t master_secret[SSL_SECRET_SIZE];
+        time_t created;
+        uint32_t last_used;
+    };
+
+    static Entry *find(const char *host, int port);
+    static void erase(Entry *entry);
+    static bool expired(const Entry *entry, time_t now);
+
+    static Entry _entries[HTTPS_SESSION_CACHE_SIZE];
+    static int _capacity;
+    static int _lifetime;
+    static uint32_t _use_counter;
+    static Stats _stats;
+};
+
+#endif
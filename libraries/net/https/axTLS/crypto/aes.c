@@ -29,13 +29,16 @@
  */
 
 /**
- * AES implementation - this is a small code version. There are much faster
- * versions around but they are much larger in size (i.e. they use large 
- * submix tables).
+ * AES implementation. The default build uses one 1kB table per direction
+ * (T-tables, the other three are rotations which are free on ARM), which
+ * does a round in 16 lookups. With CONFIG_AES_CONSTANT_TIME the tables are
+ * replaced by a bitsliced S-box so that no memory access depends on the key
+ * or the data, at the cost of a slower cipher.
  */
 
 #include <string.h>
 //#include "os_port.h"
+#include "config.h"
 #include "crypto.h"
 #include <lwip/def.h>
 
@@ -76,6 +79,7 @@
             (f8)^=rot2(f4), \
             (f8)^rot1(f9))
 
+#ifndef CONFIG_AES_CONSTANT_TIME
 /*
  * AES S-box
  */
@@ -154,6 +158,148 @@ static const uint8_t aes_isbox[256] =
     0xe1,0x69,0x14,0x63,0x55,0x21,0x0c,0x7d
 };
 
+/*
+ * T-tables: te0 is MixColumn applied to the S-box, td0 is InvMixColumn
+ * applied to the inverse S-box. The other columns are byte rotations.
+ */
+static const uint32_t aes_te0[256] =
+{
+    0xc66363a5, 0xf87c7c84, 0xee777799, 0xf67b7b8d,
+    0xfff2f20d, 0xd66b6bbd, 0xde6f6fb1, 0x91c5c554,
+    0x60303050, 0x02010103, 0xce6767a9, 0x562b2b7d,
+    0xe7fefe19, 0xb5d7d762, 0x4dababe6, 0xec76769a,
+    0x8fcaca45, 0x1f82829d, 0x89c9c940, 0xfa7d7d87,
+    0xeffafa15, 0xb25959eb, 0x8e4747c9, 0xfbf0f00b,
+    0x41adadec, 0xb3d4d467, 0x5fa2a2fd, 0x45afafea,
+    0x239c9cbf, 0x53a4a4f7, 0xe4727296, 0x9bc0c05b,
+    0x75b7b7c2, 0xe1fdfd1c, 0x3d9393ae, 0x4c26266a,
+    0x6c36365a, 0x7e3f3f41, 0xf5f7f702, 0x83cccc4f,
+    0x6834345c, 0x51a5a5f4, 0xd1e5e534, 0xf9f1f108,
+    0xe2717193, 0xabd8d873, 0x62313153, 0x2a15153f,
+    0x0804040c, 0x95c7c752, 0x46232365, 0x9dc3c35e,
+    0x30181828, 0x379696a1, 0x0a05050f, 0x2f9a9ab5,
+    0x0e070709, 0x24121236, 0x1b80809b, 0xdfe2e23d,
+    0xcdebeb26, 0x4e272769, 0x7fb2b2cd, 0xea75759f,
+    0x1209091b, 0x1d83839e, 0x582c2c74, 0x341a1a2e,
+    0x361b1b2d, 0xdc6e6eb2, 0xb45a5aee, 0x5ba0a0fb,
+    0xa45252f6, 0x763b3b4d, 0xb7d6d661, 0x7db3b3ce,
+    0x5229297b, 0xdde3e33e, 0x5e2f2f71, 0x13848497,
+    0xa65353f5, 0xb9d1d168, 0x00000000, 0xc1eded2c,
+    0x40202060, 0xe3fcfc1f, 0x79b1b1c8, 0xb65b5bed,
+    0xd46a6abe, 0x8dcbcb46, 0x67bebed9, 0x7239394b,
+    0x944a4ade, 0x984c4cd4, 0xb05858e8, 0x85cfcf4a,
+    0xbbd0d06b, 0xc5efef2a, 0x4faaaae5, 0xedfbfb16,
+    0x864343c5, 0x9a4d4dd7, 0x66333355, 0x11858594,
+    0x8a4545cf, 0xe9f9f910, 0x04020206, 0xfe7f7f81,
+    0xa05050f0, 0x783c3c44, 0x259f9fba, 0x4ba8a8e3,
+    0xa25151f3, 0x5da3a3fe, 0x804040c0, 0x058f8f8a,
+    0x3f9292ad, 0x219d9dbc, 0x70383848, 0xf1f5f504,
+    0x63bcbcdf, 0x77b6b6c1, 0xafdada75, 0x42212163,
+    0x20101030, 0xe5ffff1a, 0xfdf3f30e, 0xbfd2d26d,
+    0x81cdcd4c, 0x180c0c14, 0x26131335, 0xc3ecec2f,
+    0xbe5f5fe1, 0x359797a2, 0x884444cc, 0x2e171739,
+    0x93c4c457, 0x55a7a7f2, 0xfc7e7e82, 0x7a3d3d47,
+    0xc86464ac, 0xba5d5de7, 0x3219192b, 0xe6737395,
+    0xc06060a0, 0x19818198, 0x9e4f4fd1, 0xa3dcdc7f,
+    0x44222266, 0x542a2a7e, 0x3b9090ab, 0x0b888883,
+    0x8c4646ca, 0xc7eeee29, 0x6bb8b8d3, 0x2814143c,
+    0xa7dede79, 0xbc5e5ee2, 0x160b0b1d, 0xaddbdb76,
+    0xdbe0e03b, 0x64323256, 0x743a3a4e, 0x140a0a1e,
+    0x924949db, 0x0c06060a, 0x4824246c, 0xb85c5ce4,
+    0x9fc2c25d, 0xbdd3d36e, 0x43acacef, 0xc46262a6,
+    0x399191a8, 0x319595a4, 0xd3e4e437, 0xf279798b,
+    0xd5e7e732, 0x8bc8c843, 0x6e373759, 0xda6d6db7,
+    0x018d8d8c, 0xb1d5d564, 0x9c4e4ed2, 0x49a9a9e0,
+    0xd86c6cb4, 0xac5656fa, 0xf3f4f407, 0xcfeaea25,
+    0xca6565af, 0xf47a7a8e, 0x47aeaee9, 0x10080818,
+    0x6fbabad5, 0xf0787888, 0x4a25256f, 0x5c2e2e72,
+    0x381c1c24, 0x57a6a6f1, 0x73b4b4c7, 0x97c6c651,
+    0xcbe8e823, 0xa1dddd7c, 0xe874749c, 0x3e1f1f21,
+    0x964b4bdd, 0x61bdbddc, 0x0d8b8b86, 0x0f8a8a85,
+    0xe0707090, 0x7c3e3e42, 0x71b5b5c4, 0xcc6666aa,
+    0x904848d8, 0x06030305, 0xf7f6f601, 0x1c0e0e12,
+    0xc26161a3, 0x6a35355f, 0xae5757f9, 0x69b9b9d0,
+    0x17868691, 0x99c1c158, 0x3a1d1d27, 0x279e9eb9,
+    0xd9e1e138, 0xebf8f813, 0x2b9898b3, 0x22111133,
+    0xd26969bb, 0xa9d9d970, 0x078e8e89, 0x339494a7,
+    0x2d9b9bb6, 0x3c1e1e22, 0x15878792, 0xc9e9e920,
+    0x87cece49, 0xaa5555ff, 0x50282878, 0xa5dfdf7a,
+    0x038c8c8f, 0x59a1a1f8, 0x09898980, 0x1a0d0d17,
+    0x65bfbfda, 0xd7e6e631, 0x844242c6, 0xd06868b8,
+    0x824141c3, 0x299999b0, 0x5a2d2d77, 0x1e0f0f11,
+    0x7bb0b0cb, 0xa85454fc, 0x6dbbbbd6, 0x2c16163a,
+};
+
+static const uint32_t aes_td0[256] =
+{
+    0x51f4a750, 0x7e416553, 0x1a17a4c3, 0x3a275e96,
+    0x3bab6bcb, 0x1f9d45f1, 0xacfa58ab, 0x4be30393,
+    0x2030fa55, 0xad766df6, 0x88cc7691, 0xf5024c25,
+    0x4fe5d7fc, 0xc52acbd7, 0x26354480, 0xb562a38f,
+    0xdeb15a49, 0x25ba1b67, 0x45ea0e98, 0x5dfec0e1,
+    0xc32f7502, 0x814cf012, 0x8d4697a3, 0x6bd3f9c6,
+    0x038f5fe7, 0x15929c95, 0xbf6d7aeb, 0x955259da,
+    0xd4be832d, 0x587421d3, 0x49e06929, 0x8ec9c844,
+    0x75c2896a, 0xf48e7978, 0x99583e6b, 0x27b971dd,
+    0xbee14fb6, 0xf088ad17, 0xc920ac66, 0x7dce3ab4,
+    0x63df4a18, 0xe51a3182, 0x97513360, 0x62537f45,
+    0xb16477e0, 0xbb6bae84, 0xfe81a01c, 0xf9082b94,
+    0x70486858, 0x8f45fd19, 0x94de6c87, 0x527bf8b7,
+    0xab73d323, 0x724b02e2, 0xe31f8f57, 0x6655ab2a,
+    0xb2eb2807, 0x2fb5c203, 0x86c57b9a, 0xd33708a5,
+    0x302887f2, 0x23bfa5b2, 0x02036aba, 0xed16825c,
+    0x8acf1c2b, 0xa779b492, 0xf307f2f0, 0x4e69e2a1,
+    0x65daf4cd, 0x0605bed5, 0xd134621f, 0xc4a6fe8a,
+    0x342e539d, 0xa2f355a0, 0x058ae132, 0xa4f6eb75,
+    0x0b83ec39, 0x4060efaa, 0x5e719f06, 0xbd6e1051,
+    0x3e218af9, 0x96dd063d, 0xdd3e05ae, 0x4de6bd46,
+    0x91548db5, 0x71c45d05, 0x0406d46f, 0x605015ff,
+    0x1998fb24, 0xd6bde997, 0x894043cc, 0x67d99e77,
+    0xb0e842bd, 0x07898b88, 0xe7195b38, 0x79c8eedb,
+    0xa17c0a47, 0x7c420fe9, 0xf8841ec9, 0x00000000,
+    0x09808683, 0x322bed48, 0x1e1170ac, 0x6c5a724e,
+    0xfd0efffb, 0x0f853856, 0x3daed51e, 0x362d3927,
+    0x0a0fd964, 0x685ca621, 0x9b5b54d1, 0x24362e3a,
+    0x0c0a67b1, 0x9357e70f, 0xb4ee96d2, 0x1b9b919e,
+    0x80c0c54f, 0x61dc20a2, 0x5a774b69, 0x1c121a16,
+    0xe293ba0a, 0xc0a02ae5, 0x3c22e043, 0x121b171d,
+    0x0e090d0b, 0xf28bc7ad, 0x2db6a8b9, 0x141ea9c8,
+    0x57f11985, 0xaf75074c, 0xee99ddbb, 0xa37f60fd,
+    0xf701269f, 0x5c72f5bc, 0x44663bc5, 0x5bfb7e34,
+    0x8b432976, 0xcb23c6dc, 0xb6edfc68, 0xb8e4f163,
+    0xd731dcca, 0x42638510, 0x13972240, 0x84c61120,
+    0x854a247d, 0xd2bb3df8, 0xaef93211, 0xc729a16d,
+    0x1d9e2f4b, 0xdcb230f3, 0x0d8652ec, 0x77c1e3d0,
+    0x2bb3166c, 0xa970b999, 0x119448fa, 0x47e96422,
+    0xa8fc8cc4, 0xa0f03f1a, 0x567d2cd8, 0x223390ef,
+    0x87494ec7, 0xd938d1c1, 0x8ccaa2fe, 0x98d40b36,
+    0xa6f581cf, 0xa57ade28, 0xdab78e26, 0x3fadbfa4,
+    0x2c3a9de4, 0x5078920d, 0x6a5fcc9b, 0x547e4662,
+    0xf68d13c2, 0x90d8b8e8, 0x2e39f75e, 0x82c3aff5,
+    0x9f5d80be, 0x69d0937c, 0x6fd52da9, 0xcf2512b3,
+    0xc8ac993b, 0x10187da7, 0xe89c636e, 0xdb3bbb7b,
+    0xcd267809, 0x6e5918f4, 0xec9ab701, 0x834f9aa8,
+    0xe6956e65, 0xaaffe67e, 0x21bccf08, 0xef15e8e6,
+    0xbae79bd9, 0x4a6f36ce, 0xea9f09d4, 0x29b07cd6,
+    0x31a4b2af, 0x2a3f2331, 0xc6a59430, 0x35a266c0,
+    0x744ebc37, 0xfc82caa6, 0xe090d0b0, 0x33a7d815,
+    0xf104984a, 0x41ecdaf7, 0x7fcd500e, 0x1791f62f,
+    0x764dd68d, 0x43efb04d, 0xccaa4d54, 0xe49604df,
+    0x9ed1b5e3, 0x4c6a881b, 0xc12c1fb8, 0x4665517f,
+    0x9d5eea04, 0x018c355d, 0xfa877473, 0xfb0b412e,
+    0xb3671d5a, 0x92dbd252, 0xe9105633, 0x6dd64713,
+    0x9ad7618c, 0x37a10c7a, 0x59f8148e, 0xeb133c89,
+    0xcea927ee, 0xb761c935, 0xe11ce5ed, 0x7a47b13c,
+    0x9cd2df59, 0x55f2733f, 0x1814ce79, 0x73c737bf,
+    0x53f7cdea, 0x5ffdaa5b, 0xdf3d6f14, 0x7844db86,
+    0xcaaff381, 0xb968c43e, 0x3824342c, 0xc2a3405f,
+    0x161dc372, 0xbce2250c, 0x283c498b, 0xff0d9541,
+    0x39a80171, 0x080cb3de, 0xd8b4e49c, 0x6456c190,
+    0x7bcb8461, 0xd532b670, 0x486c5c74, 0xd0b85742,
+};
+
+#endif
+
 static const unsigned char Rcon[30]=
 {
     0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80,
@@ -163,16 +309,283 @@ static const unsigned char Rcon[30]=
 };
 
 /* ----- static functions ----- */
-static void AES_encrypt(const AES_CTX *ctx, uint32_t *data);
 static void AES_decrypt(const AES_CTX *ctx, uint32_t *data);
+static uint32_t aes_sub_word(uint32_t w);
+
+#ifdef CONFIG_AES_CONSTANT_TIME
+/*
+ * Bitsliced S-box (Boyar and Peralta's circuit). The eight words hold one
+ * bit of every byte each, q[0] being the least significant bit plane, so the
+ * whole state goes through the S-box with a fixed sequence of logic
+ * operations.
+ */
+static void aes_bitslice_sbox(uint32_t *q)
+{
+    uint32_t x0, x1, x2, x3, x4, x5, x6, x7;
+    uint32_t y1, y2, y3, y4, y5, y6, y7, y8, y9;
+    uint32_t y10, y11, y12, y13, y14, y15, y16, y17, y18, y19;
+    uint32_t y20, y21;
+    uint32_t z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+    uint32_t z10, z11, z12, z13, z14, z15, z16, z17;
+    uint32_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+    uint32_t t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+    uint32_t t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+    uint32_t t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+    uint32_t t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+    uint32_t t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+    uint32_t t60, t61, t62, t63, t64, t65, t66, t67;
+    uint32_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = q[7];
+    x1 = q[6];
+    x2 = q[5];
+    x3 = q[4];
+    x4 = q[3];
+    x5 = q[2];
+    x6 = q[1];
+    x7 = q[0];
+
+    /* top linear transformation */
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    /* non-linear section */
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    /* bottom linear transformation */
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+/*
+ * Inverse of the affine transformation of the S-box, on bit planes.
+ * b'[i] = b[i+2] ^ b[i+5] ^ b[i+7] ^ 0x05[i]
+ */
+static void aes_bitslice_inv_affine(uint32_t *q)
+{
+    uint32_t t[8];
+    int i;
+
+    for (i = 0; i < 8; i++)
+        t[i] = q[(i+2)&7] ^ q[(i+5)&7] ^ q[(i+7)&7];
+
+    t[0] = ~t[0];
+    t[2] = ~t[2];
+    memcpy(q, t, sizeof(t));
+}
+
+/*
+ * Transpose the 8x8 bit matrix made of the eight bytes of x, this turns
+ * bytes into bit planes and back again.
+ */
+static uint64_t aes_transpose8(uint64_t x)
+{
+    uint64_t t;
+
+    t = (x ^ (x >> 7)) & 0x00aa00aa00aa00aaULL;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000cccc0000ccccULL;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0ULL;
+    x ^= t ^ (t << 28);
+    return x;
+}
+
+/*
+ * Move the 16 bytes of the state (four big-endian column words) into eight
+ * bit planes of 16 bits and back again.
+ */
+static void aes_ortho(const uint32_t *s, uint32_t *q)
+{
+    uint64_t x0 = aes_transpose8(((uint64_t)s[0] << 32) | s[1]);
+    uint64_t x1 = aes_transpose8(((uint64_t)s[2] << 32) | s[3]);
+    int b;
+
+    for (b = 0; b < 8; b++)
+        q[b] = ((uint32_t)(x0 >> (8*b)) & 0xff) |
+               (((uint32_t)(x1 >> (8*b)) & 0xff) << 8);
+}
+
+static void aes_unortho(const uint32_t *q, uint32_t *s)
+{
+    uint64_t x0 = 0, x1 = 0;
+    int b;
+
+    for (b = 0; b < 8; b++)
+    {
+        x0 |= (uint64_t)(q[b] & 0xff) << (8*b);
+        x1 |= (uint64_t)((q[b] >> 8) & 0xff) << (8*b);
+    }
+
+    x0 = aes_transpose8(x0);
+    x1 = aes_transpose8(x1);
+    s[0] = (uint32_t)(x0 >> 32);
+    s[1] = (uint32_t)x0;
+    s[2] = (uint32_t)(x1 >> 32);
+    s[3] = (uint32_t)x1;
+}
+
+static void aes_sub_bytes(uint32_t *s)
+{
+    uint32_t q[8];
+
+    aes_ortho(s, q);
+    aes_bitslice_sbox(q);
+    aes_unortho(q, s);
+}
 
-/* Perform doubling in Galois Field GF(2^8) using the irreducible polynomial
-   x^8+x^4+x^3+x+1 */
-static unsigned char AES_xtime(uint32_t x)
+static void aes_inv_sub_bytes(uint32_t *s)
 {
-    return (x&0x80) ? (x<<1)^0x1b : x<<1;
+    uint32_t q[8];
+
+    /* S^-1(y) = A^-1(S(A^-1(y))) where A is the affine part of S */
+    aes_ortho(s, q);
+    aes_bitslice_inv_affine(q);
+    aes_bitslice_sbox(q);
+    aes_bitslice_inv_affine(q);
+    aes_unortho(q, s);
 }
 
+static uint32_t aes_sub_word(uint32_t w)
+{
+    uint32_t s[4];
+
+    s[0] = w;
+    s[1] = s[2] = s[3] = 0;
+    aes_sub_bytes(s);
+    return s[0];
+}
+#else
+static uint32_t aes_sub_word(uint32_t w)
+{
+    return ((uint32_t)aes_sbox[(w>>24)     ]<<24)|
+           ((uint32_t)aes_sbox[(w>>16)&0xff]<<16)|
+           ((uint32_t)aes_sbox[(w>> 8)&0xff]<< 8)|
+           ((uint32_t)aes_sbox[(w    )&0xff]    );
+}
+#endif
+
 /**
  * Set up AES with the key/iv and cipher size.
  */
@@ -180,7 +593,7 @@ void AES_set_key(AES_CTX *ctx, const uint8_t *key,
         const uint8_t *iv, AES_MODE mode)
 {
     int i, ii;
-    uint32_t *W, tmp, tmp2;
+    uint32_t *W, tmp;
     const unsigned char *ip;
     int words;
 
@@ -224,28 +637,19 @@ void AES_set_key(AES_CTX *ctx, const uint8_t *key,
 
         if ((i % words) == 0)
         {
-            tmp2 =(uint32_t)aes_sbox[(tmp    )&0xff]<< 8;
-            tmp2|=(uint32_t)aes_sbox[(tmp>> 8)&0xff]<<16;
-            tmp2|=(uint32_t)aes_sbox[(tmp>>16)&0xff]<<24;
-            tmp2|=(uint32_t)aes_sbox[(tmp>>24)     ];
-            tmp=tmp2^(((unsigned int)*ip)<<24);
+            tmp = aes_sub_word(rot3(tmp))^(((unsigned int)*ip)<<24);
             ip++;
         }
 
         if ((words == 8) && ((i % words) == 4))
-        {
-            tmp2 =(uint32_t)aes_sbox[(tmp    )&0xff]    ;
-            tmp2|=(uint32_t)aes_sbox[(tmp>> 8)&0xff]<< 8;
-            tmp2|=(uint32_t)aes_sbox[(tmp>>16)&0xff]<<16;
-            tmp2|=(uint32_t)aes_sbox[(tmp>>24)     ]<<24;
-            tmp=tmp2;
-        }
+            tmp = aes_sub_word(tmp);
 
         W[i]=W[i-words]^tmp;
     }
 
     /* copy the iv across */
-    memcpy(ctx->iv, iv, 16);
+    if (iv)
+        memcpy(ctx->iv, iv, 16);
 }
 
 /**
@@ -350,17 +754,61 @@ void AES_cbc_decrypt(AES_CTX *ctx, const uint8_t *msg, uint8_t *out, int length)
 
 }
 
+/**
+ * Encrypt or decrypt a byte sequence in counter mode. The iv holds the
+ * 128 bit big-endian counter block, which is incremented for every block.
+ * The length only needs to be a multiple of the block size if more data
+ * follows in a later call, the rest of a partial block is thrown away.
+ */
+void AES_ctr_encrypt(AES_CTX *ctx, const uint8_t *msg, uint8_t *out, int length)
+{
+    int i;
+    uint32_t ctr[4], ks[4];
+
+    memcpy(ctr, ctx->iv, AES_IV_SIZE);
+    for (i = 0; i < 4; i++)
+        ctr[i] = ntohl(ctr[i]);
+
+    while (length > 0)
+    {
+        uint8_t ks_8[AES_BLOCKSIZE];
+        int n = length < AES_BLOCKSIZE ? length : AES_BLOCKSIZE;
+
+        for (i = 0; i < 4; i++)
+            ks[i] = ctr[i];
+
+        AES_encrypt(ctx, ks);
+
+        for (i = 0; i < 4; i++)
+            ks[i] = htonl(ks[i]);
+
+        memcpy(ks_8, ks, AES_BLOCKSIZE);
+        for (i = 0; i < n; i++)
+            out[i] = msg[i] ^ ks_8[i];
+
+        /* increment the counter block */
+        for (i = 3; i >= 0 && ++ctr[i] == 0; i--)
+            ;
+
+        msg += n;
+        out += n;
+        length -= n;
+    }
+
+    for (i = 0; i < 4; i++)
+        ctr[i] = htonl(ctr[i]);
+    memcpy(ctx->iv, ctr, AES_IV_SIZE);
+}
+
+#ifdef CONFIG_AES_CONSTANT_TIME
 /**
  * Encrypt a single block (16 bytes) of data
  */
-static void AES_encrypt(const AES_CTX *ctx, uint32_t *data)
+void AES_encrypt(const AES_CTX *ctx, uint32_t *data)
 {
-    /* To make this code smaller, generate the sbox entries on the fly.
-     * This will have a really heavy effect upon performance.
-     */
     uint32_t tmp[4];
-    uint32_t tmp1, old_a0, a0, a1, a2, a3, row;
-    int curr_rnd;
+    uint32_t t, m2;
+    int curr_rnd, row;
     int rounds = ctx->rounds; 
     const uint32_t *k = ctx->ks;
 
@@ -368,33 +816,29 @@ static void AES_encrypt(const AES_CTX *ctx, uint32_t *data)
     for (row = 0; row < 4; row++)
         data[row] ^= *(k++);
 
-    /* Encrypt one block. */
     for (curr_rnd = 0; curr_rnd < rounds; curr_rnd++)
     {
-        /* Perform ByteSub and ShiftRow operations together */
+        aes_sub_bytes(data);
+
+        /* ShiftRow */
         for (row = 0; row < 4; row++)
         {
-            a0 = (uint32_t)aes_sbox[(data[row%4]>>24)&0xFF];
-            a1 = (uint32_t)aes_sbox[(data[(row+1)%4]>>16)&0xFF];
-            a2 = (uint32_t)aes_sbox[(data[(row+2)%4]>>8)&0xFF]; 
-            a3 = (uint32_t)aes_sbox[(data[(row+3)%4])&0xFF];
+            tmp[row] = (data[row      ]&0xff000000)|
+                       (data[(row+1)&3]&0x00ff0000)|
+                       (data[(row+2)&3]&0x0000ff00)|
+                       (data[(row+3)&3]&0x000000ff);
+        }
 
-            /* Perform MixColumn iff not last round */
-            if (curr_rnd < (rounds - 1))
+        /* Perform MixColumn iff not last round */
+        if (curr_rnd < (rounds - 1))
+        {
+            for (row = 0; row < 4; row++)
             {
-                tmp1 = a0 ^ a1 ^ a2 ^ a3;
-                old_a0 = a0;
-                a0 ^= tmp1 ^ AES_xtime(a0 ^ a1);
-                a1 ^= tmp1 ^ AES_xtime(a1 ^ a2);
-                a2 ^= tmp1 ^ AES_xtime(a2 ^ a3);
-                a3 ^= tmp1 ^ AES_xtime(a3 ^ old_a0);
+                m2 = mul2(tmp[row], t);
+                tmp[row] = m2^rot3(tmp[row]^m2)^rot2(tmp[row])^rot1(tmp[row]);
             }
-
-            tmp[row] = ((a0 << 24) | (a1 << 16) | (a2 << 8) | a3);
         }
 
-        /* KeyAddition - note that it is vital that this loop is separate from
-           the MixColumn operation, which must be atomic...*/ 
         for (row = 0; row < 4; row++)
             data[row] = tmp[row] ^ *(k++);
     }
@@ -406,55 +850,145 @@ static void AES_encrypt(const AES_CTX *ctx, uint32_t *data)
 static void AES_decrypt(const AES_CTX *ctx, uint32_t *data)
 { 
     uint32_t tmp[4];
-    uint32_t xt0,xt1,xt2,xt3,xt4,xt5,xt6;
-    uint32_t a0, a1, a2, a3, row;
-    int curr_rnd;
+    uint32_t t1, t2, t3, t4;
+    int curr_rnd, row;
     int rounds = ctx->rounds;
     const uint32_t *k = ctx->ks + ((rounds+1)*4);
+
     /* pre-round key addition */
     for (row=4; row > 0;row--)
         data[row-1] ^= *(--k);
 
-    /* Decrypt one block */
     for (curr_rnd = 0; curr_rnd < rounds; curr_rnd++)
     {
+        aes_inv_sub_bytes(data);
 
-        /* Perform ByteSub and ShiftRow operations together */
-        for (row = 4; row > 0; row--)
+        /* InvShiftRow */
+        for (row = 0; row < 4; row++)
         {
+            tmp[row] = (data[row      ]&0xff000000)|
+                       (data[(row+3)&3]&0x00ff0000)|
+                       (data[(row+2)&3]&0x0000ff00)|
+                       (data[(row+1)&3]&0x000000ff);
+        }
 
-            a0 = aes_isbox[(data[(row+3)%4]>>24)&0xFF];
-            a1 = aes_isbox[(data[(row+2)%4]>>16)&0xFF];
-            a2 = aes_isbox[(data[(row+1)%4]>>8)&0xFF];
-            a3 = aes_isbox[(data[row%4])&0xFF];
-
-            /* Perform MixColumn iff not last round */
-            if (curr_rnd<(rounds-1))
-            {
-                /* The MDS cofefficients (0x09, 0x0B, 0x0D, 0x0E)
-                   are quite large compared to encryption; this 
-                   operation slows decryption down noticeably. */
-                xt0 = AES_xtime(a0^a1);
-                xt1 = AES_xtime(a1^a2);
-                xt2 = AES_xtime(a2^a3);
-                xt3 = AES_xtime(a3^a0);
-                xt4 = AES_xtime(xt0^xt1);
-                xt5 = AES_xtime(xt1^xt2);
-                xt6 = AES_xtime(xt4^xt5);
-
-                xt0 ^= a1^a2^a3^xt4^xt6;
-                xt1 ^= a0^a2^a3^xt5^xt6;
-                xt2 ^= a0^a1^a3^xt4^xt6;
-                xt3 ^= a0^a1^a2^xt5^xt6;
-                tmp[row-1] = ((xt0<<24)|(xt1<<16)|(xt2<<8)|xt3);
-            }
-            else
-                tmp[row-1] = ((a0<<24)|(a1<<16)|(a2<<8)|a3);
+        /* Perform InvMixColumn iff not last round */
+        if (curr_rnd < (rounds - 1))
+        {
+            for (row = 0; row < 4; row++)
+                tmp[row] = inv_mix_col(tmp[row],t1,t2,t3,t4);
         }
 
         for (row = 4; row > 0; row--)
             data[row-1] = tmp[row-1] ^ *(--k);
     }
 }
+#else
+#define TE0(x)  (aes_te0[x])
+#define TE1(x)  rot1(aes_te0[x])
+#define TE2(x)  rot2(aes_te0[x])
+#define TE3(x)  rot3(aes_te0[x])
+#define TD0(x)  (aes_td0[x])
+#define TD1(x)  rot1(aes_td0[x])
+#define TD2(x)  rot2(aes_td0[x])
+#define TD3(x)  rot3(aes_td0[x])
+
+/**
+ * Encrypt a single block (16 bytes) of data
+ */
+void AES_encrypt(const AES_CTX *ctx, uint32_t *data)
+{
+    uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+    int curr_rnd;
+    const uint32_t *k = ctx->ks;
+
+    /* Pre-round key addition */
+    s0 = data[0] ^ k[0];
+    s1 = data[1] ^ k[1];
+    s2 = data[2] ^ k[2];
+    s3 = data[3] ^ k[3];
+
+    /* ByteSub, ShiftRow and MixColumn all come out of the tables */
+    for (curr_rnd = ctx->rounds - 1; curr_rnd > 0; curr_rnd--)
+    {
+        k += 4;
+        t0 = TE0(s0>>24)^TE1((s1>>16)&0xff)^TE2((s2>>8)&0xff)^TE3(s3&0xff)^k[0];
+        t1 = TE0(s1>>24)^TE1((s2>>16)&0xff)^TE2((s3>>8)&0xff)^TE3(s0&0xff)^k[1];
+        t2 = TE0(s2>>24)^TE1((s3>>16)&0xff)^TE2((s0>>8)&0xff)^TE3(s1&0xff)^k[2];
+        t3 = TE0(s3>>24)^TE1((s0>>16)&0xff)^TE2((s1>>8)&0xff)^TE3(s2&0xff)^k[3];
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    /* last round has no MixColumn */
+    k += 4;
+    data[0] = (((uint32_t)aes_sbox[s0>>24]<<24)|
+            ((uint32_t)aes_sbox[(s1>>16)&0xff]<<16)|
+            ((uint32_t)aes_sbox[(s2>>8)&0xff]<<8)|
+            ((uint32_t)aes_sbox[s3&0xff]))^k[0];
+    data[1] = (((uint32_t)aes_sbox[s1>>24]<<24)|
+            ((uint32_t)aes_sbox[(s2>>16)&0xff]<<16)|
+            ((uint32_t)aes_sbox[(s3>>8)&0xff]<<8)|
+            ((uint32_t)aes_sbox[s0&0xff]))^k[1];
+    data[2] = (((uint32_t)aes_sbox[s2>>24]<<24)|
+            ((uint32_t)aes_sbox[(s3>>16)&0xff]<<16)|
+            ((uint32_t)aes_sbox[(s0>>8)&0xff]<<8)|
+            ((uint32_t)aes_sbox[s1&0xff]))^k[2];
+    data[3] = (((uint32_t)aes_sbox[s3>>24]<<24)|
+            ((uint32_t)aes_sbox[(s0>>16)&0xff]<<16)|
+            ((uint32_t)aes_sbox[(s1>>8)&0xff]<<8)|
+            ((uint32_t)aes_sbox[s2&0xff]))^k[3];
+}
+
+/**
+ * Decrypt a single block (16 bytes) of data
+ */
+static void AES_decrypt(const AES_CTX *ctx, uint32_t *data)
+{ 
+    uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+    int curr_rnd;
+    const uint32_t *k = ctx->ks + (ctx->rounds*4);
+
+    /* pre-round key addition */
+    s0 = data[0] ^ k[0];
+    s1 = data[1] ^ k[1];
+    s2 = data[2] ^ k[2];
+    s3 = data[3] ^ k[3];
+
+    /* the round keys were put through InvMixColumn by AES_convert_key() */
+    for (curr_rnd = ctx->rounds - 1; curr_rnd > 0; curr_rnd--)
+    {
+        k -= 4;
+        t0 = TD0(s0>>24)^TD1((s3>>16)&0xff)^TD2((s2>>8)&0xff)^TD3(s1&0xff)^k[0];
+        t1 = TD0(s1>>24)^TD1((s0>>16)&0xff)^TD2((s3>>8)&0xff)^TD3(s2&0xff)^k[1];
+        t2 = TD0(s2>>24)^TD1((s1>>16)&0xff)^TD2((s0>>8)&0xff)^TD3(s3&0xff)^k[2];
+        t3 = TD0(s3>>24)^TD1((s2>>16)&0xff)^TD2((s1>>8)&0xff)^TD3(s0&0xff)^k[3];
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    k -= 4;
+    data[0] = (((uint32_t)aes_isbox[s0>>24]<<24)|
+            ((uint32_t)aes_isbox[(s3>>16)&0xff]<<16)|
+            ((uint32_t)aes_isbox[(s2>>8)&0xff]<<8)|
+            ((uint32_t)aes_isbox[s1&0xff]))^k[0];
+    data[1] = (((uint32_t)aes_isbox[s1>>24]<<24)|
+            ((uint32_t)aes_isbox[(s0>>16)&0xff]<<16)|
+            ((uint32_t)aes_isbox[(s3>>8)&0xff]<<8)|
+            ((uint32_t)aes_isbox[s2&0xff]))^k[1];
+    data[2] = (((uint32_t)aes_isbox[s2>>24]<<24)|
+            ((uint32_t)aes_isbox[(s1>>16)&0xff]<<16)|
+            ((uint32_t)aes_isbox[(s0>>8)&0xff]<<8)|
+            ((uint32_t)aes_isbox[s3&0xff]))^k[2];
+    data[3] = (((uint32_t)aes_isbox[s3>>24]<<24)|
+            ((uint32_t)aes_isbox[(s2>>16)&0xff]<<16)|
+            ((uint32_t)aes_isbox[(s1>>8)&0xff]<<8)|
+            ((uint32_t)aes_isbox[s0&0xff]))^k[3];
+}
+#endif
 
 #endif
@@ -47,6 +47,7 @@
  * - Squaring
  * - Sliding window exponentiation
  * - Chinese Remainder Theorem (implemented in rsa.c).
+ * - A fixed-size Montgomery engine for the exponentiation (bigint_mont.c).
  *
  * All the algorithms used are pretty standard, and designed for different
  * data bus sizes. Negative numbers are not dealt with at all, so a subtraction
@@ -67,6 +68,9 @@
 #include <time.h>
 #include "os_port.h"
 #include "bigint.h"
+#ifdef CONFIG_BIGINT_FIXED_MONT
+#include "bigint_mont.h"
+#endif
 
 #define V1      v->comps[v->size-1]                 /**< v1 for division */
 #define V2      v->comps[v->size-2]                 /**< v2 for division */
@@ -84,6 +88,10 @@ static bigint *comp_right_shift(bigint *biR, int num_shifts);
 static bigint *comp_left_shift(bigint *biR, int num_shifts);
 #endif
 
+#ifdef CONFIG_BIGINT_FIXED_MONT
+static bigint *fixed_mont_power(BI_CTX *ctx, bigint *bi, bigint *biexp);
+#endif
+
 #ifdef CONFIG_BIGINT_CHECK_ON
 static void check(const bigint *bi);
 #else
@@ -130,6 +138,9 @@ void bi_terminate(BI_CTX *ctx)
     }
 
     bi_clear_cache(ctx);
+#ifdef CONFIG_BIGINT_FIXED_MONT
+    free(ctx->mont_table);
+#endif
     free(ctx);
 }
 
@@ -775,6 +786,22 @@ void bi_set_mod(BI_CTX *ctx, bigint *bim, int mod_offset)
             bi_clone(ctx, ctx->bi_radix), k*2-1), ctx->bi_mod[mod_offset], 0);
     bi_permanent(ctx->bi_mu[mod_offset]);
 #endif
+
+#ifdef CONFIG_BIGINT_FIXED_MONT
+    /* even or too large moduli stay with the generic code */
+    ctx->mont[mod_offset] = NULL;
+    if (k <= MONT_MAX_COMPS && (bim->comps[0] & 1))
+    {
+        MONT_CTX *mont = (MONT_CTX *)malloc(sizeof(MONT_CTX) + 
+                            MONT_STORAGE_COMPS(k)*COMP_BYTE_SIZE);
+
+        /* without the memory the generic code does the exponentiations */
+        if (mont != NULL && mont_init(mont, (comp *)(mont+1), bim->comps, k) == 0)
+            ctx->mont[mod_offset] = mont;
+        else
+            free(mont);
+    }
+#endif
 }
 
 /**
@@ -798,6 +825,10 @@ void bi_free_mod(BI_CTX *ctx, int mod_offset)
 #endif
     bi_depermanent(ctx->bi_normalised_mod[mod_offset]); 
     bi_free(ctx, ctx->bi_normalised_mod[mod_offset]);
+#ifdef CONFIG_BIGINT_FIXED_MONT
+    free(ctx->mont[mod_offset]);
+    ctx->mont[mod_offset] = NULL;
+#endif
 }
 
 /** 
@@ -1346,9 +1377,23 @@ static void precompute_slide_window(BI_CTX *ctx, int window, bigint *g1)
  */
 bigint *bi_mod_power(BI_CTX *ctx, bigint *bi, bigint *biexp)
 {
-    int i = find_max_exp_index(biexp), j, window_size = 1;
-    bigint *biR = int_to_bi(ctx, 1);
+    int i, j, window_size = 1;
+    bigint *biR;
 
+#ifdef CONFIG_BIGINT_FIXED_MONT
+    if (ctx->mont[ctx->mod_offset] && 
+                bi->size <= 2*ctx->mont[ctx->mod_offset]->n)
+    {
+        biR = fixed_mont_power(ctx, bi, biexp);
+
+        /* no memory for its window table, so do without the engine */
+        if (biR != NULL)
+            return biR;
+    }
+#endif
+
+    i = find_max_exp_index(biexp);
+    biR = int_to_bi(ctx, 1);
 
 #if defined(CONFIG_BIGINT_MONTGOMERY)
     uint8_t mod_offset = ctx->mod_offset;
@@ -1472,6 +1517,47 @@ bigint *bi_mod_power2(BI_CTX *ctx, bigint *bi, bigint *bim, bigint *biexp)
 }
 #endif
 
+#ifdef CONFIG_BIGINT_FIXED_MONT
+/**
+ * Perform a modular exponentiation with the fixed-size Montgomery engine.
+ * The only allocation is the result (and the window table the first time it
+ * is needed, it is kept by the context).
+ * @return The result, or NULL (leaving bi and biexp alone) if there is no
+ * memory for the window table.
+ */
+static bigint *fixed_mont_power(BI_CTX *ctx, bigint *bi, bigint *biexp)
+{
+    const MONT_CTX *mont = ctx->mont[ctx->mod_offset];
+    int entries = mont_table_entries(biexp->comps, biexp->size);
+    bigint *biR;
+
+    check(bi);
+    check(biexp);
+
+    if (ctx->mont_table_size < entries*mont->n)
+    {
+        free(ctx->mont_table);
+        ctx->mont_table_size = entries*mont->n;
+        ctx->mont_table = (comp *)malloc(
+                            ctx->mont_table_size*COMP_BYTE_SIZE);
+
+        if (ctx->mont_table == NULL)
+        {
+            ctx->mont_table_size = 0;
+            return NULL;
+        }
+    }
+
+    biR = alloc(ctx, mont->n);
+    mont_mod_exp(mont, biR->comps, bi->comps, bi->size, 
+            biexp->comps, biexp->size, ctx->mont_table, entries);
+
+    bi_free(ctx, bi);
+    bi_free(ctx, biexp);
+    return trim(biR);
+}
+#endif
+
 #ifdef CONFIG_BIGINT_CRT
 /**
  * @brief Use the Chinese Remainder Theorem to quickly perform RSA decrypts.
@@ -93,6 +93,10 @@ struct _bigint
 
 typedef struct _bigint bigint;  /**< An alias for _bigint */
 
+#ifdef CONFIG_BIGINT_FIXED_MONT
+struct _mont_ctx;               /**< See bigint_mont.h */
+#endif
+
 /**
  * Maintains the state of the cache, and a number of variables used in 
  * reduction.
@@ -112,6 +116,11 @@ typedef struct /**< A big integer "session" context. */
     bigint *bi_mu[BIGINT_NUM_MODS];         /**< Storage for mu */
 #endif
     bigint *bi_normalised_mod[BIGINT_NUM_MODS]; /**< Normalised mod storage. */
+#ifdef CONFIG_BIGINT_FIXED_MONT
+    struct _mont_ctx *mont[BIGINT_NUM_MODS]; /**< Fixed-size engine constants */
+    comp *mont_table;           /**< Sliding-window table of the engine. */
+    int mont_table_size;        /**< Size of the table, in components. */
+#endif
     bigint **g;                 /**< Used by sliding-window. */
     int window;                 /**< The size of the sliding window */
     int active_count;           /**< Number of active bigints. */
@@ -0,0 +1,419 @@
+/**
+ * @defgroup bigint_mont Fixed-size Montgomery engine
+ * @brief Modular exponentiation on fixed-size component arrays.
+ *
+ * This engine is used by bi_mod_power() for every modulus that fits in
+ * CONFIG_BIGINT_MONT_MAX_BITS. Unlike the generic bigint code, it never
+ * allocates: all the intermediate results live on the stack, and the
+ * sliding-window table is provided by the caller. It does:
+ * - Montgomery multiplication (separated operand scanning), with a dedicated
+ *   squaring that computes each cross product only once.
+ * - Left-to-right sliding-window exponentiation.
+ *
+ * The inner loop (r += a*b) is written in Thumb-2 assembly when built with
+ * GCC for an ARMv7-M core (UMLAL) or an ARMv7E-M core (UMAAL), otherwise in
+ * portable C.
+ *
+ * Like the rest of the library, the code is not constant time.
+ * @{
+ */
+
+#include <string.h>
+#include "os_port.h"
+#include "bigint_mont.h"
+
+/**
+ * r[0..n-1] += a[0..n-1] * b, returns the carry out of r[n-1]. n must be > 0.
+ */
+#if defined(__GNUC__) && !defined(__CC_ARM) && defined(__thumb2__) && \
+    (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__))
+static comp mul_add(comp *r, const comp *a, int n, comp b)
+{
+    comp c = 0, ai, lo;
+#if defined(__ARM_ARCH_7EM__)
+    /* UMAAL: lo:c = ai*b + lo + c, can't overflow */
+    __asm__ volatile (
+        "1:                                 \n\t"
+        "ldr    %[ai], [%[a]], #4           \n\t"
+        "ldr    %[lo], [%[r]]               \n\t"
+        "umaal  %[lo], %[c], %[ai], %[b]    \n\t"
+        "str    %[lo], [%[r]], #4           \n\t"
+        "subs   %[n], %[n], #1              \n\t"
+        "bne    1b                          \n\t"
+        : [c] "+r" (c), [a] "+r" (a), [r] "+r" (r), [n] "+r" (n),
+          [ai] "=&r" (ai), [lo] "=&r" (lo)
+        : [b] "r" (b)
+        : "cc", "memory");
+#else
+    /* No UMAAL on ARMv7-M: add the carry first, then UMLAL */
+    comp hi;
+    __asm__ volatile (
+        "1:                                 \n\t"
+        "ldr    %[ai], [%[a]], #4           \n\t"
+        "ldr    %[lo], [%[r]]               \n\t"
+        "movs   %[hi], #0                   \n\t"
+        "adds   %[lo], %[lo], %[c]          \n\t"
+        "adc    %[hi], %[hi], #0            \n\t"
+        "umlal  %[lo], %[hi], %[ai], %[b]   \n\t"
+        "str    %[lo], [%[r]], #4           \n\t"
+        "mov    %[c], %[hi]                 \n\t"
+        "subs   %[n], %[n], #1              \n\t"
+        "bne    1b                          \n\t"
+        : [c] "+r" (c), [a] "+r" (a), [r] "+r" (r), [n] "+r" (n),
+          [ai] "=&r" (ai), [lo] "=&r" (lo), [hi] "=&r" (hi)
+        : [b] "r" (b)
+        : "cc", "memory");
+#endif
+    return c;
+}
+#else
+static comp mul_add(comp *r, const comp *a, int n, comp b)
+{
+    comp c = 0;
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        long_comp t = (long_comp)a[i]*b + r[i] + c;
+        r[i] = (comp)t;
+        c = (comp)(t >> COMP_BIT_SIZE);
+    }
+
+    return c;
+}
+#endif
+
+/**
+ * r = a - b, returns the borrow.
+ */
+static comp sub_n(comp *r, const comp *a, const comp *b, int n)
+{
+    comp borrow = 0;
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        long_comp t = (long_comp)a[i] - b[i] - borrow;
+        r[i] = (comp)t;
+        borrow = (comp)(t >> COMP_BIT_SIZE) & 1;
+    }
+
+    return borrow;
+}
+
+/**
+ * r = a + b, returns the carry.
+ */
+static comp add_n(comp *r, const comp *a, const comp *b, int n)
+{
+    comp carry = 0;
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        long_comp t = (long_comp)a[i] + b[i] + carry;
+        r[i] = (comp)t;
+        carry = (comp)(t >> COMP_BIT_SIZE);
+    }
+
+    return carry;
+}
+
+static int cmp_n(const comp *a, const comp *b, int n)
+{
+    while (n-- > 0)
+    {
+        if (a[n] != b[n])
+            return a[n] > b[n] ? 1 : -1;
+    }
+
+    return 0;
+}
+
+/**
+ * r = (carry*R + a) mod m, given that the value is less than 2m.
+ */
+static void final_sub(const MONT_CTX *mont, comp *r, const comp *a, comp carry)
+{
+    if (carry || cmp_n(a, mont->m, mont->n) >= 0)
+        sub_n(r, a, mont->m, mont->n);
+    else if (r != a)
+        memcpy(r, a, mont->n*COMP_BYTE_SIZE);
+}
+
+/**
+ * r = t*R^-1 mod m, t has 2n components and must be less than m*R. t is
+ * destroyed.
+ */
+static void mont_reduce(const MONT_CTX *mont, comp *r, comp *t)
+{
+    const int n = mont->n;
+    comp top = 0;
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        comp q = t[i]*mont->m0_inv;     /* makes t[i] zero */
+        comp c = mul_add(&t[i], mont->m, n, q);
+        long_comp s = (long_comp)t[i+n] + c + top;
+        t[i+n] = (comp)s;
+        top = (comp)(s >> COMP_BIT_SIZE);
+    }
+
+    final_sub(mont, r, &t[n], top);
+}
+
+/**
+ * @brief Montgomery multiplication: r = a*b*R^-1 mod m.
+ *
+ * One of a and b must be less than m, the other less than R. r may be the
+ * same as a or b.
+ */
+void mont_mul(const MONT_CTX *mont, comp *r, const comp *a, const comp *b)
+{
+    const int n = mont->n;
+    comp t[2*MONT_MAX_COMPS];
+    int i;
+
+    memset(t, 0, 2*n*COMP_BYTE_SIZE);
+
+    for (i = 0; i < n; i++)
+        t[i+n] = mul_add(&t[i], a, n, b[i]);
+
+    mont_reduce(mont, r, t);
+}
+
+/**
+ * r = a*a*R^-1 mod m. The cross products a[i]*a[j] (i < j) are computed once
+ * and doubled, which saves almost half of the multiplications.
+ */
+static void mont_sqr(const MONT_CTX *mont, comp *r, const comp *a)
+{
+    const int n = mont->n;
+    comp t[2*MONT_MAX_COMPS];
+    comp carry = 0;
+    int i;
+
+    memset(t, 0, 2*n*COMP_BYTE_SIZE);
+
+    for (i = 0; i < n-1; i++)
+        t[i+n] = mul_add(&t[2*i+1], &a[i+1], n-i-1, a[i]);
+
+    /* double the cross products */
+    for (i = 0; i < 2*n; i++)
+    {
+        comp top = t[i] >> (COMP_BIT_SIZE-1);
+        t[i] = (t[i] << 1) | carry;
+        carry = top;
+    }
+
+    /* and add the squares */
+    carry = 0;
+    for (i = 0; i < n; i++)
+    {
+        long_comp sq = (long_comp)a[i]*a[i];
+        long_comp s = (long_comp)t[2*i] + (comp)sq + carry;
+        t[2*i] = (comp)s;
+        s = (long_comp)t[2*i+1] + (comp)(sq >> COMP_BIT_SIZE) +
+                                            (comp)(s >> COMP_BIT_SIZE);
+        t[2*i+1] = (comp)s;
+        carry = (comp)(s >> COMP_BIT_SIZE);
+    }
+
+    mont_reduce(mont, r, t);
+}
+
+/**
+ * @brief Set up the Montgomery constants for a modulus.
+ *
+ * This is the expensive part (2*32*n modular doublings), so it should only be
+ * done once per modulus.
+ * @param mont [out] The context to set up.
+ * @param storage [in] MONT_STORAGE_COMPS(n) components that must stay valid
+ * as long as the context is used.
+ * @param m [in] The modulus, which must be odd and greater than 1.
+ * @param n [in] The number of components of m, at most MONT_MAX_COMPS.
+ * @return 0 on success, -1 if the modulus can't be handled.
+ */
+int mont_init(MONT_CTX *mont, comp *storage, const comp *m, int n)
+{
+    comp inv;
+    int i;
+
+    if (n <= 0 || n > MONT_MAX_COMPS || (m[0] & 1) == 0 ||
+                                                (n == 1 && m[0] == 1))
+        return -1;
+
+    mont->n = n;
+    mont->m = storage;
+    mont->rr = storage + n;
+    mont->rrr = storage + 2*n;
+    memcpy(mont->m, m, n*COMP_BYTE_SIZE);
+
+    /* Newton iteration, each step doubles the number of correct bits */
+    inv = m[0];                         /* correct to 3 bits */
+    for (i = 0; i < 4; i++)
+        inv *= 2 - m[0]*inv;
+
+    mont->m0_inv = (comp)(0 - inv);
+
+    /* R^2 mod m, by doubling 1 */
+    memset(mont->rr, 0, n*COMP_BYTE_SIZE);
+    mont->rr[0] = 1;
+
+    for (i = 0; i < 2*COMP_BIT_SIZE*n; i++)
+    {
+        comp carry = add_n(mont->rr, mont->rr, mont->rr, n);
+        final_sub(mont, mont->rr, mont->rr, carry);
+    }
+
+    mont_mul(mont, mont->rrr, mont->rr, mont->rr);
+    return 0;
+}
+
+/**
+ * Sliding window size for an exponent, see HAC table 14.16.
+ */
+static int window_size(int exp_bits, int table_entries)
+{
+    int w;
+
+    if (exp_bits > 671)
+        w = 6;
+    else if (exp_bits > 239)
+        w = 5;
+    else if (exp_bits > 79)
+        w = 4;
+    else if (exp_bits > 23)
+        w = 3;
+    else
+        w = 1;
+
+    while (w > 1 && (1 << (w-1)) > table_entries)
+        w--;
+
+    return w;
+}
+
+static int exp_bit(const comp *e, int i)
+{
+    return (e[i/COMP_BIT_SIZE] >> (i % COMP_BIT_SIZE)) & 1;
+}
+
+/**
+ * @brief Modular exponentiation: r = x^e mod m.
+ *
+ * @param mont [in] The Montgomery context of m.
+ * @param r [out] The result, n components.
+ * @param x [in] The base, at most 2n components. It doesn't need to be
+ * reduced.
+ * @param x_len [in] The number of components of x.
+ * @param e [in] The exponent.
+ * @param e_len [in] The number of components of e.
+ * @param table [in] Scratch space for the sliding window, table_entries*n
+ * components.
+ * @param table_entries [in] The number of entries of the table. The window is
+ * shrunk to fit, one entry means plain square and multiply.
+ */
+void mont_mod_exp(const MONT_CTX *mont, comp *r,
+        const comp *x, int x_len, const comp *e, int e_len,
+        comp *table, int table_entries)
+{
+    const int n = mont->n;
+    comp acc[MONT_MAX_COMPS];
+    comp tmp[MONT_MAX_COMPS];
+    int i, j, w, bits, started = 0;
+
+    /* convert x to Montgomery form: x0*R^2*R^-1 + x1*R^3*R^-1 */
+    memset(tmp, 0, n*COMP_BYTE_SIZE);
+    memcpy(tmp, x, (x_len < n ? x_len : n)*COMP_BYTE_SIZE);
+    mont_mul(mont, table, tmp, mont->rr);
+
+    if (x_len > n)
+    {
+        memset(tmp, 0, n*COMP_BYTE_SIZE);
+        memcpy(tmp, &x[n], (x_len-n)*COMP_BYTE_SIZE);
+        mont_mul(mont, tmp, tmp, mont->rrr);
+        final_sub(mont, table, table, add_n(table, table, tmp, n));
+    }
+
+    for (bits = e_len*COMP_BIT_SIZE; bits > 0 && !exp_bit(e, bits-1); bits--);
+
+    /* the odd powers x, x^3, x^5 ... */
+    w = window_size(bits, table_entries);
+    if (w > 1)
+    {
+        mont_sqr(mont, tmp, table);
+
+        for (i = 1; i < (1 << (w-1)); i++)
+            mont_mul(mont, &table[i*n], &table[(i-1)*n], tmp);
+    }
+
+    i = bits-1;
+    while (i >= 0)
+    {
+        int l, part_exp = 0;
+
+        if (!exp_bit(e, i))
+        {
+            if (started)
+                mont_sqr(mont, acc, acc);
+
+            i--;
+            continue;
+        }
+
+        /* the longest window ending on a one */
+        l = i-w+1;
+        if (l < 0)
+            l = 0;
+
+        while (!exp_bit(e, l))
+            l++;
+
+        for (j = i; j >= l; j--)
+        {
+            part_exp = (part_exp << 1) | exp_bit(e, j);
+
+            if (started)
+                mont_sqr(mont, acc, acc);
+        }
+
+        if (started)
+            mont_mul(mont, acc, acc, &table[(part_exp >> 1)*n]);
+        else
+        {
+            memcpy(acc, &table[(part_exp >> 1)*n], n*COMP_BYTE_SIZE);
+            started = 1;
+        }
+
+        i = l-1;
+    }
+
+    /* back from Montgomery form, x^0 is 1 */
+    memset(tmp, 0, n*COMP_BYTE_SIZE);
+    tmp[0] = 1;
+
+    if (started)
+        mont_mul(mont, r, acc, tmp);
+    else
+        final_sub(mont, r, tmp, 0);
+}
+
+/**
+ * @brief The number of window table entries worth using for an exponent.
+ * @param e [in] The exponent.
+ * @param e_len [in] The number of components of e.
+ * @return The number of entries, at most MONT_TABLE_ENTRIES.
+ */
+int mont_table_entries(const comp *e, int e_len)
+{
+    int bits;
+
+    for (bits = e_len*COMP_BIT_SIZE; bits > 0 && !exp_bit(e, bits-1); bits--);
+    return 1 << (window_size(bits, MONT_TABLE_ENTRIES)-1);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,55 @@
+#ifndef BIGINT_MONT_HEADER
+#define BIGINT_MONT_HEADER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "bigint_impl.h"
+
+#if COMP_BIT_SIZE != 32
+#error "The fixed-size Montgomery engine needs CONFIG_INTEGER_32BIT"
+#endif
+
+/** Largest modulus handled by the engine. Bigger ones use bi_mod_power(). */
+#ifndef CONFIG_BIGINT_MONT_MAX_BITS
+#define CONFIG_BIGINT_MONT_MAX_BITS     2048
+#endif
+
+/** Largest sliding window, the window table holds 2^(n-1) entries. */
+#ifndef CONFIG_BIGINT_MONT_WINDOW_MAX
+#define CONFIG_BIGINT_MONT_WINDOW_MAX   5
+#endif
+
+#define MONT_MAX_COMPS      (CONFIG_BIGINT_MONT_MAX_BITS/COMP_BIT_SIZE)
+#define MONT_TABLE_ENTRIES  (1 << (CONFIG_BIGINT_MONT_WINDOW_MAX-1))
+
+/**
+ * Constants for Montgomery multiplication modulo an odd m of n components,
+ * with R = 2^(32*n). All numbers are little-endian component arrays of n
+ * components, the three arrays live in storage provided by the caller.
+ */
+typedef struct _mont_ctx
+{
+    int n;                  /**< Number of components of the modulus. */
+    comp m0_inv;            /**< -m^-1 mod 2^32 */
+    comp *m;                /**< The modulus. */
+    comp *rr;               /**< R^2 mod m */
+    comp *rrr;              /**< R^3 mod m */
+} MONT_CTX;
+
+/** Number of components of storage needed by mont_init() */
+#define MONT_STORAGE_COMPS(n)   (3*(n))
+
+int mont_init(MONT_CTX *mont, comp *storage, const comp *m, int n);
+void mont_mul(const MONT_CTX *mont, comp *r, const comp *a, const comp *b);
+void mont_mod_exp(const MONT_CTX *mont, comp *r,
+        const comp *x, int x_len, const comp *e, int e_len,
+        comp *table, int table_entries);
+int mont_table_entries(const comp *e, int e_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
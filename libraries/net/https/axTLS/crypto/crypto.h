@@ -85,7 +85,30 @@ void AES_set_key(AES_CTX *ctx, const uint8_t *key,
 void AES_cbc_encrypt(AES_CTX *ctx, const uint8_t *msg, 
         uint8_t *out, int length);
 void AES_cbc_decrypt(AES_CTX *ks, const uint8_t *in, uint8_t *out, int length);
+void AES_ctr_encrypt(AES_CTX *ctx, const uint8_t *msg, 
+        uint8_t *out, int length);
 void AES_convert_key(AES_CTX *ctx);
+void AES_encrypt(const AES_CTX *ctx, uint32_t *data);
+
+/**************************************************************************
+ * AES-GCM declarations 
+ **************************************************************************/
+
+#define AES_GCM_TAG_SIZE        16
+
+typedef struct
+{
+    AES_CTX aes;
+    uint64_t hl[16], hh[16];    /* multiples of the hash key, per nibble */
+} AES_GCM_CTX;
+
+void AES_GCM_set_key(AES_GCM_CTX *ctx, const uint8_t *key, AES_MODE mode);
+void AES_GCM_encrypt(AES_GCM_CTX *ctx, const uint8_t *iv, int iv_len,
+        const uint8_t *aad, int aad_len,
+        const uint8_t *msg, uint8_t *out, int length, uint8_t *tag);
+int AES_GCM_decrypt(AES_GCM_CTX *ctx, const uint8_t *iv, int iv_len,
+        const uint8_t *aad, int aad_len,
+        const uint8_t *msg, uint8_t *out, int length, const uint8_t *tag);
 
 /**************************************************************************
  * RC4 declarations 
@@ -0,0 +1,300 @@
+/**
+ * AES-GCM (NIST SP 800-38D). GHASH uses Shoup's 4-bit tables, 256 bytes per
+ * key, unless CONFIG_AES_CONSTANT_TIME is set in which case the product is
+ * computed bit by bit with masks, so that the hash key and the data do not
+ * select any memory access.
+ */
+
+#include <string.h>
+#include "config.h"
+#include "crypto.h"
+
+/* all commented out in skeleton mode */
+#ifndef CONFIG_SSL_SKELETON_MODE
+
+#define GET_UINT64(b)   (((uint64_t)(b)[0]<<56)|((uint64_t)(b)[1]<<48)|   \
+                         ((uint64_t)(b)[2]<<40)|((uint64_t)(b)[3]<<32)|   \
+                         ((uint64_t)(b)[4]<<24)|((uint64_t)(b)[5]<<16)|   \
+                         ((uint64_t)(b)[6]<< 8)|((uint64_t)(b)[7]))
+
+static void put_uint64(uint8_t *b, uint64_t v)
+{
+    int i;
+
+    for (i = 7; i >= 0; i--)
+    {
+        b[i] = (uint8_t)v;
+        v >>= 8;
+    }
+}
+
+static void put_uint32(uint8_t *b, uint32_t v)
+{
+    b[0] = v >> 24;
+    b[1] = v >> 16;
+    b[2] = v >> 8;
+    b[3] = v;
+}
+
+/* Encrypt one block of bytes with the raw cipher */
+static void gcm_encrypt_block(const AES_CTX *aes, const uint8_t *in, uint8_t *out)
+{
+    uint32_t data[4];
+    int i;
+
+    for (i = 0; i < 4; i++)
+        data[i] = ((uint32_t)in[4*i]<<24)|((uint32_t)in[4*i+1]<<16)|
+                  ((uint32_t)in[4*i+2]<<8)|((uint32_t)in[4*i+3]);
+
+    AES_encrypt(aes, data);
+
+    for (i = 0; i < 4; i++)
+        put_uint32(&out[4*i], data[i]);
+}
+
+#ifdef CONFIG_AES_CONSTANT_TIME
+/* x = x * H in GF(2^128), H is kept in hh[8]/hl[8] */
+static void gcm_mult(const AES_GCM_CTX *ctx, uint8_t *x)
+{
+    uint64_t vh = ctx->hh[8], vl = ctx->hl[8];
+    uint64_t zh = 0, zl = 0, mask;
+    int i;
+
+    for (i = 0; i < 128; i++)
+    {
+        mask = 0 - (uint64_t)((x[i>>3] >> (7 - (i&7))) & 1);
+        zh ^= vh & mask;
+        zl ^= vl & mask;
+
+        /* V = V * x, with the bit reflected reduction polynomial */
+        mask = 0 - (vl & 1);
+        vl = (vh << 63) | (vl >> 1);
+        vh = (vh >> 1) ^ (0xe100000000000000ULL & mask);
+    }
+
+    put_uint64(x, zh);
+    put_uint64(x + 8, zl);
+}
+#else
+/* reduction of the four bits shifted out of the product */
+static const uint16_t gcm_last4[16] =
+{
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
+/* x = x * H in GF(2^128), four bits at a time */
+static void gcm_mult(const AES_GCM_CTX *ctx, uint8_t *x)
+{
+    int i;
+    uint8_t lo, hi, rem;
+    uint64_t zh, zl;
+
+    lo = x[15] & 0xf;
+    zh = ctx->hh[lo];
+    zl = ctx->hl[lo];
+
+    for (i = 15; i >= 0; i--)
+    {
+        lo = x[i] & 0xf;
+        hi = (x[i] >> 4) & 0xf;
+
+        if (i != 15)
+        {
+            rem = (uint8_t)zl & 0xf;
+            zl = (zh << 60) | (zl >> 4);
+            zh = (zh >> 4) ^ ((uint64_t)gcm_last4[rem] << 48);
+            zh ^= ctx->hh[lo];
+            zl ^= ctx->hl[lo];
+        }
+
+        rem = (uint8_t)zl & 0xf;
+        zl = (zh << 60) | (zl >> 4);
+        zh = (zh >> 4) ^ ((uint64_t)gcm_last4[rem] << 48);
+        zh ^= ctx->hh[hi];
+        zl ^= ctx->hl[hi];
+    }
+
+    put_uint64(x, zh);
+    put_uint64(x + 8, zl);
+}
+#endif
+
+/* Absorb data into the GHASH state y, the last block is zero padded */
+static void gcm_ghash(const AES_GCM_CTX *ctx, uint8_t *y,
+        const uint8_t *data, int length)
+{
+    int i, n;
+
+    while (length > 0)
+    {
+        n = length < AES_BLOCKSIZE ? length : AES_BLOCKSIZE;
+
+        for (i = 0; i < n; i++)
+            y[i] ^= data[i];
+
+        gcm_mult(ctx, y);
+        data += n;
+        length -= n;
+    }
+}
+
+/* Counter mode with the 32 bit increment of GCM, ctr is updated */
+static void gcm_ctr(const AES_GCM_CTX *ctx, uint8_t *ctr,
+        const uint8_t *msg, uint8_t *out, int length)
+{
+    uint8_t ks[AES_BLOCKSIZE];
+    int i, n;
+
+    while (length > 0)
+    {
+        n = length < AES_BLOCKSIZE ? length : AES_BLOCKSIZE;
+
+        for (i = 15; i >= 12 && ++ctr[i] == 0; i--)
+            ;
+
+        gcm_encrypt_block(&ctx->aes, ctr, ks);
+
+        for (i = 0; i < n; i++)
+            out[i] = msg[i] ^ ks[i];
+
+        msg += n;
+        out += n;
+        length -= n;
+    }
+}
+
+/* Work out the pre-counter block J0 from the iv */
+static void gcm_start(const AES_GCM_CTX *ctx, const uint8_t *iv, int iv_len,
+        uint8_t *j0)
+{
+    uint8_t len_block[AES_BLOCKSIZE];
+
+    memset(j0, 0, AES_BLOCKSIZE);
+
+    if (iv_len == 12)
+    {
+        memcpy(j0, iv, 12);
+        j0[15] = 1;
+    }
+    else
+    {
+        gcm_ghash(ctx, j0, iv, iv_len);
+        memset(len_block, 0, 8);
+        put_uint64(len_block + 8, (uint64_t)iv_len*8);
+        gcm_ghash(ctx, j0, len_block, AES_BLOCKSIZE);
+    }
+}
+
+/* The tag is E(K, J0) xor GHASH(aad || c || lengths) */
+static void gcm_tag(const AES_GCM_CTX *ctx, const uint8_t *j0,
+        const uint8_t *aad, int aad_len, const uint8_t *c, int length,
+        uint8_t *tag)
+{
+    uint8_t y[AES_BLOCKSIZE], len_block[AES_BLOCKSIZE];
+    int i;
+
+    memset(y, 0, sizeof(y));
+    gcm_ghash(ctx, y, aad, aad_len);
+    gcm_ghash(ctx, y, c, length);
+    put_uint64(len_block, (uint64_t)aad_len*8);
+    put_uint64(len_block + 8, (uint64_t)length*8);
+    gcm_ghash(ctx, y, len_block, AES_BLOCKSIZE);
+
+    gcm_encrypt_block(&ctx->aes, j0, tag);
+
+    for (i = 0; i < AES_GCM_TAG_SIZE; i++)
+        tag[i] ^= y[i];
+}
+
+/**
+ * Set up AES-GCM with a key, this also works out the hash key H = E(K, 0).
+ */
+void AES_GCM_set_key(AES_GCM_CTX *ctx, const uint8_t *key, AES_MODE mode)
+{
+    uint8_t h[AES_BLOCKSIZE];
+    uint64_t vh, vl;
+
+    memset(ctx, 0, sizeof(AES_GCM_CTX));
+    AES_set_key(&ctx->aes, key, NULL, mode);
+    memset(h, 0, sizeof(h));
+    gcm_encrypt_block(&ctx->aes, h, h);
+
+    vh = GET_UINT64(h);
+    vl = GET_UINT64(h + 8);
+
+    /* index 8 is H itself (the nibble 1000 is x^0 in GCM's bit order) */
+    ctx->hh[8] = vh;
+    ctx->hl[8] = vl;
+
+#ifndef CONFIG_AES_CONSTANT_TIME
+    {
+        int i, j;
+
+        for (i = 4; i > 0; i >>= 1)
+        {
+            uint64_t t = (vl & 1) * 0xe1000000U;
+            vl = (vh << 63) | (vl >> 1);
+            vh = (vh >> 1) ^ (t << 32);
+            ctx->hl[i] = vl;
+            ctx->hh[i] = vh;
+        }
+
+        for (i = 2; i <= 8; i *= 2)
+        {
+            for (j = 1; j < i; j++)
+            {
+                ctx->hh[i+j] = ctx->hh[i] ^ ctx->hh[j];
+                ctx->hl[i+j] = ctx->hl[i] ^ ctx->hl[j];
+            }
+        }
+    }
+#endif
+
+    memset(h, 0, sizeof(h));
+}
+
+/**
+ * Encrypt length bytes of msg and authenticate them together with aad. The
+ * 16 byte tag is written to tag. msg and out may be the same buffer.
+ */
+void AES_GCM_encrypt(AES_GCM_CTX *ctx, const uint8_t *iv, int iv_len,
+        const uint8_t *aad, int aad_len,
+        const uint8_t *msg, uint8_t *out, int length, uint8_t *tag)
+{
+    uint8_t j0[AES_BLOCKSIZE], ctr[AES_BLOCKSIZE];
+
+    gcm_start(ctx, iv, iv_len, j0);
+    memcpy(ctr, j0, AES_BLOCKSIZE);
+    gcm_ctr(ctx, ctr, msg, out, length);
+    gcm_tag(ctx, j0, aad, aad_len, out, length, tag);
+}
+
+/**
+ * Check the tag and decrypt length bytes of msg. Returns 0 on success. If the
+ * tag doesn't match -1 is returned and nothing is written to out.
+ */
+int AES_GCM_decrypt(AES_GCM_CTX *ctx, const uint8_t *iv, int iv_len,
+        const uint8_t *aad, int aad_len,
+        const uint8_t *msg, uint8_t *out, int length, const uint8_t *tag)
+{
+    uint8_t j0[AES_BLOCKSIZE], ctr[AES_BLOCKSIZE], check[AES_GCM_TAG_SIZE];
+    uint8_t diff = 0;
+    int i;
+
+    gcm_start(ctx, iv, iv_len, j0);
+    gcm_tag(ctx, j0, aad, aad_len, msg, length, check);
+
+    /* don't give away how much of the tag was right */
+    for (i = 0; i < AES_GCM_TAG_SIZE; i++)
+        diff |= check[i] ^ tag[i];
+
+    if (diff)
+        return -1;
+
+    memcpy(ctr, j0, AES_BLOCKSIZE);
+    gcm_ctr(ctx, ctr, msg, out, length);
+    return 0;
+}
+
+#endif
@@ -9,6 +9,21 @@
 #define CONFIG_BIGINT_BARRETT 1
 #define CONFIG_BIGINT_CRT 1
 #define CONFIG_INTEGER_32BIT 1
+#define CONFIG_BIGINT_FIXED_MONT 1
+
+/*
+ * AES Options
+ */
+#undef CONFIG_AES_CONSTANT_TIME
+
+/*
+ * Record Buffer Options
+ * A peer that ignores the max_fragment_length extension may still send
+ * records of up to 16384 bytes. Each of those is read into a buffer taken
+ * from the heap for as long as the record is in flight.
+ */
+#define CONFIG_SSL_RECORD_POOL_SIZE 2
+#define CONFIG_SSL_MAX_FRAGMENT_LENGTH 2048
 
 /*
  * SSL Library
@@ -13,6 +13,25 @@ extern "C" {
 #define SSL_CTX_LOCK(A)             //pthread_mutex_lock(&A)
 #define SSL_CTX_UNLOCK(A)           //pthread_mutex_unlock(&A)
 
+/* the record buffer pool is shared by every connection; each lock keeps
+ * whether the interrupts were masked in a local of its own, declared with
+ * SSL_POOL_DECL_LOCK, and unlocking only enables them if they weren't */
+#ifdef MBED
+#include "cmsis.h"
+#if defined(__CORTEX_M)
+#define SSL_IRQ_MASKED()            __get_PRIMASK()
+#else
+#define SSL_IRQ_MASKED()            (__get_CPSR() & 0x80)
+#endif
+#define SSL_POOL_DECL_LOCK(M)       uint32_t M
+#define SSL_POOL_LOCK(M)            do { M = SSL_IRQ_MASKED(); __disable_irq(); } while (0)
+#define SSL_POOL_UNLOCK(M)          do { if (!(M)) __enable_irq(); } while (0)
+#else
+#define SSL_POOL_DECL_LOCK(M)
+#define SSL_POOL_LOCK(M)
+#define SSL_POOL_UNLOCK(M)
+#endif
+
 #define malloc(A)       ax_malloc(A, __FILE__, __LINE__)
 #ifndef realloc
 #define realloc(A,B)    ax_realloc(A,B, __FILE__, __LINE__)
@@ -103,6 +103,8 @@ extern "C" {
 #define SSL_ERROR_NO_CERT_DEFINED               -272
 #define SSL_ERROR_NO_CLIENT_RENOG               -273
 #define SSL_ERROR_NOT_SUPPORTED                 -274
+#define SSL_ERROR_NO_BUFFER                     -275
+#define SSL_ERROR_RECORD_OVERFLOW               -276
 #define SSL_X509_OFFSET                         -512
 #define SSL_X509_ERROR(A)                       (SSL_X509_OFFSET+A)
 
@@ -114,6 +116,7 @@ extern "C" {
 #define SSL_ALERT_CLOSE_NOTIFY                  0
 #define SSL_ALERT_UNEXPECTED_MESSAGE            10
 #define SSL_ALERT_BAD_RECORD_MAC                20
+#define SSL_ALERT_RECORD_OVERFLOW               22
 #define SSL_ALERT_HANDSHAKE_FAILURE             40
 #define SSL_ALERT_BAD_CERTIFICATE               42
 #define SSL_ALERT_ILLEGAL_PARAMETER             47
@@ -317,6 +320,36 @@ EXP_FUNC const uint8_t * STDCALL ssl_get_session_id(const SSL *ssl);
  */
 EXP_FUNC uint8_t STDCALL ssl_get_session_id_size(const SSL *ssl);
 
+/**
+ * @brief Add a previously negotiated session to the session cache of a
+ * context.
+ *
+ * A client can then offer this session for resumption by passing the same
+ * session id to ssl_client_new(). The context must have been created with
+ * room for at least one session.
+ * @param ssl_ctx [in] The client/server context.
+ * @param session_id [in] The session id, as returned by ssl_get_session_id().
+ * @param sess_id_size [in] The size of the session id.
+ * @param master_secret [in] The 48 byte master secret of the session, as
+ * returned by ssl_get_master_secret().
+ * @return SSL_OK if the session was added, SSL_ERROR_INVALID_SESSION if the
+ * session id is invalid or the cache of the context is full, SSL_NOT_OK if
+ * there was no memory for it.
+ */
+EXP_FUNC int STDCALL ssl_ctx_add_session(SSL_CTX *ssl_ctx, 
+        const uint8_t *session_id, uint8_t sess_id_size,
+        const uint8_t *master_secret);
+
+/**
+ * @brief Get the master secret of the session used by a handshake.
+ *
+ * This is only available once the handshake has completed and the context
+ * keeps a session cache.
+ * @param ssl [in] An SSL object reference.
+ * @return The 48 byte master secret, or NULL if there is no session.
+ */
+EXP_FUNC const uint8_t * STDCALL ssl_get_master_secret(const SSL *ssl);
+
 /**
  * @brief Return the cipher id (in the SSL form).
  * @param ssl [in] An SSL object reference.
@@ -336,6 +369,33 @@ EXP_FUNC uint8_t STDCALL ssl_get_cipher_id(const SSL *ssl);
  */
 EXP_FUNC int STDCALL ssl_handshake_status(const SSL *ssl);
 
+/**
+ * @brief Usage of the record buffer pool.
+ */
+typedef struct
+{
+    int size;           /**< Buffers in the pool */
+    int in_use;         /**< Buffers borrowed right now */
+    int peak;           /**< Most buffers borrowed at the same time */
+    int exhausted;      /**< Buffers taken from the heap, the pool was empty */
+    int oversize;       /**< Records too big for a buffer, read into the heap */
+} SSL_RECORD_POOL_STATS;
+
+/**
+ * @brief Get the usage of the record buffer pool.
+ *
+ * Connections share CONFIG_SSL_RECORD_POOL_SIZE buffers of 
+ * CONFIG_SSL_MAX_FRAGMENT_LENGTH bytes plus overhead. A connection holds one
+ * during the handshake and while a record is being sent or read, so the pool
+ * is sized for the records in flight rather than for the connections. When
+ * it is empty buffers are allocated from the heap; a peak above the size of
+ * the pool means it is too small. A record bigger than a buffer, from a
+ * peer that ignored the max_fragment_length extension, gets one of its own
+ * from the heap while it is read.
+ * @param stats [out] The pool usage since startup.
+ */
+EXP_FUNC void STDCALL ssl_record_pool_stats(SSL_RECORD_POOL_STATS *stats);
+
 /**
  * @brief Retrieve various parameters about the axTLS engine.
  * @param offset [in] The configuration offset. It will be one of the following:
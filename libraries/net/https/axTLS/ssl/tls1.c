@@ -60,6 +60,9 @@ static int set_key_block(SSL *ssl, int is_write);
 static int verify_digest(SSL *ssl, int mode, const uint8_t *buf, int read_len);
 static void *crypt_new(SSL *ssl, uint8_t *key, uint8_t *iv, int is_decrypt);
 static int send_raw_packet(SSL *ssl, uint8_t protocol);
+static int read_record_data(SSL *ssl, uint8_t *buf, int size);
+static int read_app_data(SSL *ssl);
+static void record_buf_release(SSL *ssl);
 
 /**
  * The server will pick the cipher based on the order that the order that the
@@ -260,6 +263,9 @@ EXP_FUNC void STDCALL ssl_free(SSL *ssl)
     if (!IS_SET_SSL_FLAG(SSL_SENT_CLOSE_NOTIFY))
       send_alert(ssl, SSL_ALERT_CLOSE_NOTIFY);
 
+    ssl->bm_read_index = 0;
+    record_buf_return(ssl);
+
     ssl_ctx = ssl->ssl_ctx;
 
     SSL_CTX_LOCK(ssl_ctx->mutex);
@@ -542,6 +548,130 @@ static const cipher_info_t *get_cipher_info(uint8_t cipher)
     return NULL;  /* error */
 }
 
+/*
+ * The record buffers are shared by all the connections. A connection borrows
+ * one for the whole handshake, while it sends a record, and from the moment
+ * it reads a record until the plaintext has been read by the application.
+ * When they are all taken, buffers come from the heap instead.
+ */
+static uint8_t record_pool[CONFIG_SSL_RECORD_POOL_SIZE][BM_ALL_DATA_SIZE];
+static uint8_t record_pool_used[CONFIG_SSL_RECORD_POOL_SIZE];
+static SSL_RECORD_POOL_STATS record_pool_stats =
+    { CONFIG_SSL_RECORD_POOL_SIZE };
+
+/**
+ * Borrow a record buffer from the pool, if the connection has none.
+ */
+int record_buf_borrow(SSL *ssl)
+{
+    int i;
+    SSL_POOL_DECL_LOCK(masked);
+
+    if (ssl->bm_all_data)
+        return SSL_OK;
+
+    SSL_POOL_LOCK(masked);
+    for (i = 0; i < CONFIG_SSL_RECORD_POOL_SIZE; i++)
+    {
+        if (!record_pool_used[i])
+        {
+            record_pool_used[i] = 1;
+            ssl->bm_all_data = record_pool[i];
+
+            if (++record_pool_stats.in_use > record_pool_stats.peak)
+                record_pool_stats.peak = record_pool_stats.in_use;
+            break;
+        }
+    }
+
+    SSL_POOL_UNLOCK(masked);
+
+    if (ssl->bm_all_data == NULL)
+    {
+        if ((ssl->bm_all_data = (uint8_t *)malloc(BM_ALL_DATA_SIZE)) == NULL)
+            return SSL_ERROR_NO_BUFFER;
+
+        SSL_POOL_LOCK(masked);
+        record_pool_stats.exhausted++;
+        if (++record_pool_stats.in_use > record_pool_stats.peak)
+            record_pool_stats.peak = record_pool_stats.in_use;
+        SSL_POOL_UNLOCK(masked);
+    }
+
+    ssl->bm_data = ssl->bm_all_data + BM_RECORD_OFFSET;
+    ssl->bm_index = 0;
+    return SSL_OK;
+}
+
+/**
+ * Give the record buffer back to the pool, whatever is left in it.
+ */
+void record_buf_return(SSL *ssl)
+{
+    int pooled;
+    SSL_POOL_DECL_LOCK(masked);
+
+    if (ssl->bm_all_data == NULL)
+        return;
+
+    pooled = ssl->bm_all_data >= record_pool[0] && 
+            ssl->bm_all_data < record_pool[CONFIG_SSL_RECORD_POOL_SIZE];
+    if (!pooled)
+        free(ssl->bm_all_data);
+
+    SSL_POOL_LOCK(masked);
+    if (pooled)
+        record_pool_used[(ssl->bm_all_data - record_pool[0])/BM_ALL_DATA_SIZE] = 0;
+    record_pool_stats.in_use--;
+    SSL_POOL_UNLOCK(masked);
+
+    ssl->bm_all_data = NULL;
+    ssl->bm_data = NULL;
+}
+
+/**
+ * Give the record buffer back once the handshake is over and the
+ * application has read all the plaintext.
+ */
+static void record_buf_release(SSL *ssl)
+{
+    if (ssl->dc == NULL && ssl->bm_read_index == 0)
+        record_buf_return(ssl);
+}
+
+/**
+ * Swap the record buffer for one from the heap that takes a whole record
+ * of RT_MAX_RECORD_LENGTH bytes. It is freed when the record has been read.
+ */
+static int record_buf_grow(SSL *ssl)
+{
+    uint8_t *buf;
+    SSL_POOL_DECL_LOCK(masked);
+
+    if ((buf = (uint8_t *)malloc(BM_RECORD_OFFSET+BM_FULL_DATA_SIZE)) == NULL)
+        return SSL_ERROR_NO_BUFFER;
+
+    record_buf_return(ssl);
+    ssl->bm_all_data = buf;
+    ssl->bm_data = buf + BM_RECORD_OFFSET;
+
+    SSL_POOL_LOCK(masked);
+    record_pool_stats.oversize++;
+    if (++record_pool_stats.in_use > record_pool_stats.peak)
+        record_pool_stats.peak = record_pool_stats.in_use;
+    SSL_POOL_UNLOCK(masked);
+    return SSL_OK;
+}
+
+EXP_FUNC void STDCALL ssl_record_pool_stats(SSL_RECORD_POOL_STATS *stats)
+{
+    SSL_POOL_DECL_LOCK(masked);
+
+    SSL_POOL_LOCK(masked);
+    *stats = record_pool_stats;
+    SSL_POOL_UNLOCK(masked);
+}
+
 /*
  * Get a new ssl context for a new connection.
  */
@@ -549,10 +679,12 @@ SSL *ssl_new(SSL *ssl, int client_fd)
 {
     SSL_CTX* ssl_ctx = ssl->ssl_ctx;
     ssl->need_bytes = SSL_RECORD_SIZE;      /* need a record */
-    ssl->client_fd = 0;
+    ssl->client_fd = client_fd;
     ssl->flag = SSL_NEED_RECORD;
-    ssl->bm_data = ssl->bm_all_data + BM_RECORD_OFFSET; 
+    ssl->bm_all_data = NULL;                /* borrowed when needed */
+    ssl->bm_data = NULL;
     ssl->bm_read_index = 0;
+    ssl->bm_read_offset = 0;
     ssl->hs_status = SSL_NOT_OK;            /* not connected */
 #ifdef CONFIG_ENABLE_VERIFICATION
     ssl->ca_cert_ctx = ssl_ctx->ca_cert_ctx;
@@ -988,8 +1120,7 @@ static int send_raw_packet(SSL *ssl, uint8_t protocol)
     /* block and wait for it */
     if (lwip_select(FD_SETSIZE, NULL, &wfds, NULL, NULL) < 0)
         return SSL_ERROR_CONN_LOST;
-            
-    SET_SSL_FLAG(SSL_NEED_RECORD);  /* reset for next time */
+
     ssl->bm_index = 0;
 
     if (protocol != PT_APP_PROTOCOL_DATA)  
@@ -1007,11 +1138,23 @@ static int send_raw_packet(SSL *ssl, uint8_t protocol)
 int send_packet(SSL *ssl, uint8_t protocol, const uint8_t *in, int length)
 {
     int ret, msg_length = 0;
+    uint8_t *rx_data = NULL;
 
     /* if our state is bad, don't bother */
     if (ssl->hs_status == SSL_ERROR_DEAD)
         return SSL_ERROR_CONN_LOST;
 
+    /* plaintext that hasn't been read yet stays where it is, the record
+       goes out through another buffer */
+    if (ssl->bm_read_index)
+    {
+        rx_data = ssl->bm_all_data;
+        ssl->bm_all_data = NULL;
+    }
+
+    if ((ret = record_buf_borrow(ssl)) != SSL_OK)
+        goto error;
+
     if (in) /* has the buffer already been initialised? */
     {
         memcpy(ssl->bm_data, in, length);
@@ -1069,11 +1212,9 @@ int send_packet(SSL *ssl, uint8_t protocol, const uint8_t *in, int length)
                         ssl->cipher_info->iv_size)
         {
             uint8_t iv_size = ssl->cipher_info->iv_size;
-            uint8_t *t_buf = alloca(msg_length + iv_size);
-            memcpy(t_buf + iv_size, ssl->bm_data, msg_length);
-            get_random(iv_size, t_buf);
+            memmove(ssl->bm_data + iv_size, ssl->bm_data, msg_length);
+            get_random(iv_size, ssl->bm_data);
             msg_length += iv_size;
-            memcpy(ssl->bm_data, t_buf, msg_length);
         }
 
         /* now encrypt the packet */
@@ -1091,10 +1232,22 @@ int send_packet(SSL *ssl, uint8_t protocol, const uint8_t *in, int length)
     }
 
     ssl->bm_index = msg_length;
-    if ((ret = send_raw_packet(ssl, protocol)) <= 0)
-        return ret;
+    if ((ret = send_raw_packet(ssl, protocol)) > 0)
+        ret = length;   /* just return what we wanted to send */
+
+error:
+    if (rx_data)
+    {
+        record_buf_return(ssl);
+        ssl->bm_all_data = rx_data;
+        ssl->bm_data = rx_data + BM_RECORD_OFFSET;
+    }
+    else
+    {
+        record_buf_release(ssl);
+    }
 
-    return length;  /* just return what we wanted to send */
+    return ret;
 }
 
 /**
@@ -1289,26 +1442,34 @@ int read_record(SSL *ssl)
     return SSL_OK;
 }
 
+/**
+ * Decrypt a whole record in place, check its MAC and remove the explicit IV,
+ * the MAC and the padding.
+ * @return the length of the plaintext at buf, or an error.
+ */
 int basic_decrypt(SSL *ssl, uint8_t *buf, int len)
 {
-   if (IS_SET_SSL_FLAG(SSL_RX_ENCRYPTED))
+    if (IS_SET_SSL_FLAG(SSL_RX_ENCRYPTED))
     {
         ssl->cipher_info->decrypt(ssl->decrypt_ctx, buf, buf, len);
 
         if (ssl->version >= SSL_PROTOCOL_VERSION1_1 &&
                         ssl->cipher_info->iv_size)
         {
-            buf += ssl->cipher_info->iv_size;
-            ssl->need_bytes -= ssl->cipher_info->iv_size;
+            if (len < ssl->cipher_info->iv_size)
+                return SSL_ERROR_INVALID_PROT_MSG;
+
+            len -= ssl->cipher_info->iv_size;
+            memmove(buf, buf + ssl->cipher_info->iv_size, len);
         }
-        if(ssl->record_type != PT_APP_PROTOCOL_DATA)
-            len = verify_digest(ssl, 
-                    IS_SET_SSL_FLAG(SSL_IS_CLIENT) ? SSL_CLIENT_READ : SSL_SERVER_READ, buf, len);
+
+        len = verify_digest(ssl, 
+                IS_SET_SSL_FLAG(SSL_IS_CLIENT) ? SSL_CLIENT_READ : SSL_SERVER_READ, buf, len);
 
         /* does the hmac work? */
-        if (ssl->need_bytes < 0)
+        if (len < 0)
         {
-            return ssl->need_bytes;
+            return len;
         }
 
         DISPLAY_BYTES(ssl, "decrypted", buf, len);
@@ -1317,14 +1478,69 @@ int basic_decrypt(SSL *ssl, uint8_t *buf, int len)
     return len;
 }
 
+/**
+ * Read the rest of the current record into buf and decrypt it.
+ * @return the length of the plaintext at buf, or an error.
+ */
+static int read_record_data(SSL *ssl, uint8_t *buf, int size)
+{
+    int len = ssl->need_bytes, ret;
+
+    if (len > size)
+        return SSL_ERROR_INVALID_PROT_MSG;
+
+    if (len && (ret = basic_read2(ssl, buf, len)) != len)
+        return ret < 0 ? ret : SSL_ERROR_CONN_LOST;
+
+    ssl->need_bytes = 0;
+    SET_SSL_FLAG(SSL_NEED_RECORD);
+    return basic_decrypt(ssl, buf, len);
+}
+
+/**
+ * Read an application data record into the record buffer and check its MAC.
+ * A record bigger than the buffer, from a peer that ignored the
+ * max_fragment_length extension, is read into a buffer from the heap. One
+ * bigger than TLS allows ends the connection.
+ * @return the length of the plaintext, or an error.
+ */
+static int read_app_data(SSL *ssl)
+{
+    int ret, size = BM_DATA_SIZE;
+
+    ssl->bm_read_offset = 0;
+    ssl->bm_read_index = 0;
+
+    if (ssl->need_bytes > BM_DATA_SIZE)
+    {
+        if (ssl->need_bytes > BM_FULL_DATA_SIZE)
+        {
+            send_alert(ssl, SSL_ERROR_RECORD_OVERFLOW);
+            return SSL_ERROR_RECORD_OVERFLOW;
+        }
+
+        if ((ret = record_buf_grow(ssl)) != SSL_OK)
+            return ret;
+        size = BM_FULL_DATA_SIZE;
+    }
+
+    if ((ret = read_record_data(ssl, ssl->bm_data, size)) > 0)
+        ssl->bm_read_index = ret;
+    return ret;
+}
+
 int ssl_read(SSL *ssl, uint8_t *in_data, int len)
 {
+    int ret;
+
     if(len <= 0 || in_data == NULL)
         return 0;
    
-    if(IS_SET_SSL_FLAG(SSL_NEED_RECORD))
+    /* what is left of the last record comes first */
+    if(ssl->bm_read_index == 0 && IS_SET_SSL_FLAG(SSL_NEED_RECORD))
     {
-        read_record(ssl);
+        if ((ret = read_record(ssl)) < 0)
+            return ret;
     }
    
     return process_data(ssl, in_data, len);
@@ -1332,6 +1548,19 @@ int ssl_read(SSL *ssl, uint8_t *in_data, int len)
 
 int process_data(SSL* ssl, uint8_t *in_data, int len)
 {
+    int ret;
+
+    /* application data that fits in the caller's buffer is decrypted there
+       and doesn't need a record buffer */
+    if (ssl->record_type == PT_APP_PROTOCOL_DATA && in_data && 
+            ssl->bm_read_index == 0 && ssl->need_bytes <= len)
+    {
+        return read_record_data(ssl, in_data, len);
+    }
+
+    if ((ret = record_buf_borrow(ssl)) != SSL_OK)
+        return ret;
+
     /* The main part of the SSL packet */
     switch (ssl->record_type)
     {
@@ -1340,96 +1569,66 @@ int process_data(SSL* ssl, uint8_t *in_data, int len)
             if (ssl->dc != NULL)
             {
                 ssl->dc->bm_proc_index = 0;
-                int ret = do_handshake(ssl, NULL, 0);
-                SET_SSL_FLAG(SSL_NEED_RECORD);
-                return ret;
+                ret = do_handshake(ssl, NULL, 0);
             }
             else /* no client renegotiation allowed */
             {
-                SET_SSL_FLAG(SSL_NEED_RECORD);
-                return SSL_ERROR_NO_CLIENT_RENOG;              
+                ret = SSL_ERROR_NO_CLIENT_RENOG;              
             }
 
+            SET_SSL_FLAG(SSL_NEED_RECORD);
+            break;
+
         case PT_CHANGE_CIPHER_SPEC:
         
-            if(basic_read2(ssl, ssl->bm_data, ssl->need_bytes) != ssl->need_bytes)
-                return -1;
-            ssl->need_bytes = basic_decrypt(ssl, ssl->bm_data, ssl->need_bytes);
-            if(ssl->need_bytes < 0)
-                return -1;
+            if ((ret = read_record_data(ssl, ssl->bm_data, BM_DATA_SIZE)) < 0)
+                break;
 
             if (ssl->next_state != HS_FINISHED)
             {
-                return SSL_ERROR_INVALID_HANDSHAKE;
+                ret = SSL_ERROR_INVALID_HANDSHAKE;
+                break;
             }
 
             /* all encrypted from now on */
             SET_SSL_FLAG(SSL_RX_ENCRYPTED);
             if (set_key_block(ssl, 0) < 0)
             {
-                return SSL_ERROR_INVALID_HANDSHAKE;
+                ret = SSL_ERROR_INVALID_HANDSHAKE;
+                break;
             }
             
             memset(ssl->read_sequence, 0, 8);
-            SET_SSL_FLAG(SSL_NEED_RECORD);
+            ret = SSL_OK;
             break;
 
         case PT_APP_PROTOCOL_DATA:
-            if(len <= 0)
-                return 0;
-            if(ssl->need_bytes == 0)
-                return 0;
-            if (in_data)
-            {
-                uint16_t index = ssl->bm_index % 2048;
-                if(ssl->bm_read_index == 0)
-                {
-                    int read_len = len;
-                    if(read_len > 2048-index)
-                        read_len = 2048-index;
-                    if(read_len > ssl->need_bytes)
-                        read_len = ssl->need_bytes;
-                    read_len -= read_len % AES_BLOCKSIZE;
-
-                    if(read_len <= 0)
-                        read_len = AES_BLOCKSIZE;
-                    if(ssl->need_bytes < AES_BLOCKSIZE)
-                        read_len = AES_BLOCKSIZE;
-                    int ret = basic_read2(ssl, ssl->bm_all_data + index, read_len);
-                    if(ret != read_len)
-                        return 0;
-                    
-                    ssl->bm_read_index = basic_decrypt(ssl, ssl->bm_all_data + index, read_len);
-                    ssl->need_bytes -= ssl->bm_read_index;
-                    if(ssl->need_bytes == 0)
-                    {
-                        ssl->bm_read_index = 0;
-                        SET_SSL_FLAG(SSL_NEED_RECORD);
-                        return ssl_read(ssl, in_data, len);
-                    }
-                }
-                if(len > ssl->bm_read_index)
-                    len = ssl->bm_read_index;
-                memcpy(in_data, ssl->bm_all_data+index, len);
-                ssl->bm_index += len;
-                ssl->bm_read_index -= len;
-                
-                if(ssl->need_bytes == 0)
-                    SET_SSL_FLAG(SSL_NEED_RECORD);
-                if(ssl->bm_index >= 2048)
-                    ssl->bm_index = 0;
-                return len;
-            }
-            return 0;
+            ret = 0;
+            if (in_data == NULL || len <= 0)
+                break;
+
+            if (ssl->bm_read_index == 0 && (ret = read_app_data(ssl)) <= 0)
+                break;
+
+            if (len > ssl->bm_read_index)
+                len = ssl->bm_read_index;
+
+            memcpy(in_data, &ssl->bm_data[ssl->bm_read_offset], len);
+            ssl->bm_read_offset += len;
+            ssl->bm_read_index -= len;
+            ret = len;
+            break;
             
         case PT_ALERT_PROTOCOL:
-            if(basic_read2(ssl, ssl->bm_data, ssl->need_bytes) != ssl->need_bytes)
-                return -1;
-            ssl->need_bytes = basic_decrypt(ssl, ssl->bm_data, ssl->need_bytes);
-            if(ssl->need_bytes < 0)
-                return -1; 
-            
-            SET_SSL_FLAG(SSL_NEED_RECORD);
+
+            if ((ret = read_record_data(ssl, ssl->bm_data, BM_DATA_SIZE)) < 0)
+                break;
+
+            if (ret < 2)
+            {
+                ret = SSL_ERROR_INVALID_PROT_MSG;
+                break;
+            }
 
             /* return the alert # with alert bit set */
             if(ssl->bm_data[0] == SSL_ALERT_TYPE_WARNING &&
@@ -1437,21 +1636,23 @@ int process_data(SSL* ssl, uint8_t *in_data, int len)
             {
                 send_alert(ssl, SSL_ALERT_CLOSE_NOTIFY);
                 SET_SSL_FLAG(SSL_SENT_CLOSE_NOTIFY);
-                return SSL_CLOSE_NOTIFY;
+                ret = SSL_CLOSE_NOTIFY;
             }
             else 
             {
-                int ret = -ssl->bm_data[1];
+                ret = -ssl->bm_data[1];
                 DISPLAY_ALERT(ssl, -ret);
-                return ret;
             }
+            break;
 
         default:
-            return SSL_ERROR_INVALID_PROT_MSG;
-
+            ret = SSL_ERROR_INVALID_PROT_MSG;
+            break;
     }
-}
 
+    record_buf_release(ssl);
+    return ret;
+}
 
 /**
  * Do some basic checking of data and then perform the appropriate handshaking.
@@ -1461,11 +1662,8 @@ static int do_handshake(SSL *ssl, uint8_t *buf, int read_len)
     uint8_t hs_hdr[SSL_HS_HDR_SIZE];
     if (IS_SET_SSL_FLAG(SSL_RX_ENCRYPTED))
     {
-        if(basic_read2(ssl, ssl->bm_data, ssl->need_bytes) != ssl->need_bytes)
-            return -1;
-        ssl->need_bytes = basic_decrypt(ssl, ssl->bm_data, ssl->need_bytes);
-        if(ssl->need_bytes < 0)
-            return -1; 
+        if ((read_len = read_record_data(ssl, ssl->bm_data, BM_DATA_SIZE)) < 0)
+            return read_len;
         buf = ssl->bm_data;
     }
     else
@@ -1506,6 +1704,8 @@ static int do_handshake(SSL *ssl, uint8_t *buf, int read_len)
     {
         if(hs_len != 0 && handshake_type != HS_CERTIFICATE)
         {
+            if(hs_len > BM_DATA_SIZE)
+                return SSL_ERROR_INVALID_HANDSHAKE;
             if(basic_read2(ssl, ssl->bm_data, hs_len) != hs_len)
                 return -1;
             hs_len = basic_decrypt(ssl, ssl->bm_data, hs_len);
@@ -1634,6 +1834,10 @@ int send_alert(SSL *ssl, int error_code)
             alert_num = SSL_ALERT_BAD_CERTIFICATE;
             break;
 
+        case SSL_ERROR_RECORD_OVERFLOW:
+            alert_num = SSL_ALERT_RECORD_OVERFLOW;
+            break;
+
         case SSL_ERROR_NO_CLIENT_RENOG:
             alert_num = SSL_ALERT_NO_RENEGOTIATION;
             break;
@@ -1852,6 +2056,55 @@ void kill_ssl_session(SSL_SESSION **ssl_sessions, SSL *ssl)
 
     SSL_CTX_UNLOCK(ssl->ssl_ctx->mutex);
 }
+
+/*
+ * Seed the session cache of a context with a session that was negotiated
+ * earlier, possibly on another context, so that a client can offer it for
+ * resumption.
+ */
+EXP_FUNC int STDCALL ssl_ctx_add_session(SSL_CTX *ssl_ctx, 
+        const uint8_t *session_id, uint8_t sess_id_size,
+        const uint8_t *master_secret)
+{
+    int i;
+    int ret = SSL_ERROR_INVALID_SESSION;
+
+    if (sess_id_size == 0 || sess_id_size > SSL_SESSION_ID_SIZE)
+        return ret;
+
+    SSL_CTX_LOCK(ssl_ctx->mutex);
+
+    for (i = 0; i < ssl_ctx->num_sessions; i++)
+    {
+        if (ssl_ctx->ssl_sessions[i] == NULL)
+        {
+            SSL_SESSION *sess = (SSL_SESSION *)calloc(1, sizeof(SSL_SESSION));
+            if (sess == NULL)
+            {
+                ret = SSL_NOT_OK;
+                break;
+            }
+
+            sess->conn_time = time(NULL);
+            memcpy(sess->session_id, session_id, sess_id_size);
+            memcpy(sess->master_secret, master_secret, SSL_SECRET_SIZE);
+            ssl_ctx->ssl_sessions[i] = sess;
+            ret = SSL_OK;
+            break;
+        }
+    }
+
+    SSL_CTX_UNLOCK(ssl_ctx->mutex);
+    return ret;
+}
+
+/*
+ * Get the master secret of the session used by a handshake.
+ */
+EXP_FUNC const uint8_t * STDCALL ssl_get_master_secret(const SSL *ssl)
+{
+    return ssl->session ? ssl->session->master_secret : NULL;
+}
 #endif /* CONFIG_SSL_SKELETON_MODE */
 
 /*
@@ -1978,7 +2231,7 @@ int process_certificate(SSL *ssl, X509_CTX **x509_ctx)
         add_packet(ssl, cert_hdr, 3);
 
         cert_size = (cert_hdr[1]<<8) + cert_hdr[2];
-        if(cert_size > RT_MAX_PLAIN_LENGTH)
+        if(cert_size > BM_DATA_SIZE)
         {
             ret = SSL_NOT_OK;
             return ret;
@@ -2199,6 +2452,14 @@ EXP_FUNC void STDCALL ssl_display_error(int error_code)
             printf("Option not supported");
             break;
 
+        case SSL_ERROR_NO_BUFFER:
+            printf("no record buffer");
+            break;
+
+        case SSL_ERROR_RECORD_OVERFLOW:
+            printf("record too big for the buffer");
+            break;
+
         default:
             printf("undefined as yet - %d", error_code);
             break;
@@ -76,10 +76,28 @@ extern "C" {
 #define IS_SET_SSL_FLAG(A)          (ssl->flag & A)
 
 #define MAX_KEY_BYTE_SIZE           512     /* for a 4096 bit key */
-#define RT_MAX_PLAIN_LENGTH         2048//16384
-#define RT_EXTRA                    512//1024
+#define RT_MAX_PLAIN_LENGTH         CONFIG_SSL_MAX_FRAGMENT_LENGTH
+#define RT_EXTRA                    512     /* header, IV, MAC and padding */
 #define BM_RECORD_OFFSET            5
-#define BM_ALL_DATA_SIZE            (RT_MAX_PLAIN_LENGTH+RT_EXTRA-BM_RECORD_OFFSET)
+#define BM_ALL_DATA_SIZE            (RT_MAX_PLAIN_LENGTH+RT_EXTRA)
+#define BM_DATA_SIZE                (BM_ALL_DATA_SIZE-BM_RECORD_OFFSET)
+#define RT_MAX_RECORD_LENGTH        16384   /* what a peer may send regardless */
+#define BM_FULL_DATA_SIZE           (RT_MAX_RECORD_LENGTH+RT_EXTRA-BM_RECORD_OFFSET)
+
+/* max_fragment_length asked for in the client hello (RFC 6066) */
+#if RT_MAX_PLAIN_LENGTH == 512
+#define RT_MAX_FRAGMENT_CODE        1
+#elif RT_MAX_PLAIN_LENGTH == 1024
+#define RT_MAX_FRAGMENT_CODE        2
+#elif RT_MAX_PLAIN_LENGTH == 2048
+#define RT_MAX_FRAGMENT_CODE        3
+#elif RT_MAX_PLAIN_LENGTH == 4096
+#define RT_MAX_FRAGMENT_CODE        4
+#elif RT_MAX_PLAIN_LENGTH == 16384
+#define RT_MAX_FRAGMENT_CODE        0       /* the default, no extension */
+#else
+#error "CONFIG_SSL_MAX_FRAGMENT_LENGTH must be 512, 1024, 2048, 4096 or 16384"
+#endif
 
 #ifdef CONFIG_SSL_SKELETON_MODE
 #define NUM_PROTOCOLS               1
@@ -178,10 +196,11 @@ struct _SSL
     const cipher_info_t *cipher_info;
     void *encrypt_ctx;
     void *decrypt_ctx;
-    uint8_t bm_all_data[RT_MAX_PLAIN_LENGTH];
+    uint8_t *bm_all_data;       /* borrowed from the record pool */
     uint8_t *bm_data;
     uint16_t bm_index;
-    uint16_t bm_read_index;
+    uint16_t bm_read_index;     /* plaintext not read yet */
+    uint16_t bm_read_offset;    /* where it starts in bm_data */
     struct _SSL *next;                  /* doubly linked list */
     struct _SSL *prev;
     struct _SSL_CTX *ssl_ctx;           /* back reference to a clnt/svr ctx */
@@ -236,6 +255,8 @@ extern const uint8_t ssl_prot_prefs[NUM_PROTOCOLS];
 SSL *ssl_new(SSL *ssl, int client_fd);
 void disposable_new(SSL *ssl);
 void disposable_free(SSL *ssl);
+int record_buf_borrow(SSL *ssl);
+void record_buf_return(SSL *ssl);
 int send_packet(SSL *ssl, uint8_t protocol, 
         const uint8_t *in, int length);
 int do_svr_handshake(SSL *ssl, int handshake_type, uint8_t *buf, int hs_len);
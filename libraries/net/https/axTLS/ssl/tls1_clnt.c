@@ -144,6 +144,13 @@ int do_client_connect(SSL *ssl)
 {
     int ret = SSL_OK;
 
+    /* the handshake keeps a record buffer until it's over */
+    if ((ret = record_buf_borrow(ssl)) != SSL_OK)
+    {
+        ssl->hs_status = ret;
+        return ret;
+    }
+
     send_client_hello(ssl);                 /* send the client hello */
     ssl->bm_read_index = 0;
     ssl->next_state = HS_SERVER_HELLO;
@@ -180,6 +187,9 @@ static int compute_size_send_client_hello(SSL *ssl)
     for (i = 0; i < NUM_PROTOCOLS; i++)
         size += 2;
     size += 2;
+#if RT_MAX_FRAGMENT_CODE
+    size += 7;
+#endif
     return size+BM_RECORD_OFFSET;
 }
 
@@ -235,6 +245,18 @@ static int send_client_hello(SSL *ssl)
 
     buf[offset++] = 1;              /* no compression */
     buf[offset++] = 0;
+
+#if RT_MAX_FRAGMENT_CODE
+    /* ask for records that fit in the record buffers */
+    buf[offset++] = 0;              /* extensions length */
+    buf[offset++] = 5;
+    buf[offset++] = 0;              /* max_fragment_length */
+    buf[offset++] = 1;
+    buf[offset++] = 0;
+    buf[offset++] = 1;
+    buf[offset++] = RT_MAX_FRAGMENT_CODE;
+#endif
+
     buf[3] = offset - 4;            /* handshake size */
 
     return send_packet(ssl, PT_HANDSHAKE_PROTOCOL, NULL, offset);
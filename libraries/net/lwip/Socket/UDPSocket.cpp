@@ -92,3 +92,62 @@ int UDPSocket::receiveFrom(Endpoint &remote, char *buffer, int length) {
     socklen_t remoteHostLen = sizeof(remote._remoteHost);
     return lwip_recvfrom(_sock_fd, buffer, length, 0, (struct sockaddr*) &remote._remoteHost, &remoteHostLen);
 }
+
+// -1 if unsuccessful, else number of packets written
+int UDPSocket::sendToBatch(Endpoint *remotes, char **packets, int *lengths, int count, bool zero_copy) {
+    if (_sock_fd < 0)
+        return -1;
+    
+    if (!_blocking) {
+        TimeInterval timeout(_timeout);
+        if (wait_writable(timeout) != 0)
+            return 0;
+    }
+    
+    int flags = (zero_copy) ? (MSG_ZEROCOPY) : (0);
+    int sent = 0;
+    while (sent < count) {
+        struct lwip_mmsghdr msgs[LWIP_MMSG_BATCH];
+        int n = (count - sent < LWIP_MMSG_BATCH) ? (count - sent) : (LWIP_MMSG_BATCH);
+        for (int i = 0; i < n; i++) {
+            msgs[i].addr = &remotes[sent + i]._remoteHost;
+            msgs[i].data = packets[sent + i];
+            msgs[i].len  = lengths[sent + i];
+        }
+        int ret = lwip_sendmmsg(_sock_fd, msgs, n, flags);
+        if (ret < 0)
+            return (sent > 0) ? (sent) : (-1);
+        sent += ret;
+        if (ret < n)
+            break;
+    }
+    return sent;
+}
+
+// -1 if unsuccessful, else number of packets received
+int UDPSocket::receiveFromBatch(Endpoint *remotes, char **buffers, int *lengths, int count) {
+    if (_sock_fd < 0)
+        return -1;
+    
+    if (!_blocking) {
+        TimeInterval timeout(_timeout);
+        if (wait_readable(timeout) != 0)
+            return 0;
+    }
+    
+    if (count > LWIP_MMSG_BATCH)
+        count = LWIP_MMSG_BATCH;
+    
+    struct lwip_mmsghdr msgs[LWIP_MMSG_BATCH];
+    for (int i = 0; i < count; i++) {
+        remotes[i].reset_address();
+        msgs[i].addr = &remotes[i]._remoteHost;
+        msgs[i].data = buffers[i];
+        msgs[i].len  = lengths[i];
+    }
+    int ret = lwip_recvmmsg(_sock_fd, msgs, count, 0);
+    for (int i = 0; i < ret; i++) {
+        lengths[i] = msgs[i].len;
+    }
+    return ret;
+}
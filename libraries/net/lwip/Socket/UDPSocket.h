@@ -70,6 +70,29 @@ public:
     \return the number of received bytes on success (>=0) or -1 on failure
     */
     int receiveFrom(Endpoint &remote, char *buffer, int length);
+    
+    /** Send several packets, handing them to the network stack in batches
+        of LWIP_MMSG_BATCH per tcpip thread round-trip
+    \param remotes  Array of count remote endpoints, one per packet
+    \param packets  Array of count packets to be sent
+    \param lengths  Array of count packet lengths
+    \param count    The number of packets to be sent
+    \param zero_copy If true, the stack references the packet buffers instead of
+           copying them; they must not be modified until sendToBatch returns
+    \return the number of sent packets on success (>=0) or -1 on failure
+    */
+    int sendToBatch(Endpoint *remotes, char **packets, int *lengths, int count, bool zero_copy=false);
+    
+    /** Receive several packets in one call. Waits for the first packet, then
+        collects any further packets already queued on the socket without waiting
+    \param remotes  Array of count endpoints, filled with the sender of each packet
+    \param buffers  Array of count buffers for storing the incoming packets. If a packet
+           is too long to fit in its buffer, excess bytes are discarded
+    \param lengths  Array of count buffer lengths, updated with the received packet lengths
+    \param count    The number of buffers
+    \return the number of received packets on success (>=0) or -1 on failure
+    */
+    int receiveFromBatch(Endpoint *remotes, char **buffers, int *lengths, int count);
 };
 
 #endif
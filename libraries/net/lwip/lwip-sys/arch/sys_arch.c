@@ -21,6 +21,7 @@
 #include "mbed_error.h"
 #include "mbed_interface.h"
 #include "us_ticker_api.h"
+#include "irq_profile.h"
 
 /* lwIP includes. */
 #include "lwip/opt.h"
@@ -67,6 +68,18 @@ u32_t sys_now(void) {
 /* CMSIS-RTOS implementation of the lwip operating system abstraction */
 #include "arch/sys_arch.h"
 
+#if LWIP_SYS_ARCH_COUNTERS
+static sys_arch_counters_t sys_arch_counters;
+#define SYS_ARCH_COUNT(x)   (sys_arch_counters.x++)
+#else
+#define SYS_ARCH_COUNT(x)
+#endif
+
+#if SYS_ARCH_PROTECT_USE_BASEPRI && defined(CMSIS_OS_RTX)
+/* RTX internal: queue a semaphore release for the PendSV handler */
+extern void isr_sem_send(void *semaphore);
+#endif
+
 /*---------------------------------------------------------------------------*
  * Routine:  sys_mbox_new
  *---------------------------------------------------------------------------*
@@ -117,6 +130,7 @@ void sys_mbox_free(sys_mbox_t *mbox) {
  *      void *msg              -- Pointer to data to post
  *---------------------------------------------------------------------------*/
 void sys_mbox_post(sys_mbox_t *mbox, void *msg) {
+    SYS_ARCH_COUNT(mbox_posts);
     if (osMessagePut(mbox->id, (uint32_t)msg, osWaitForever) != osOK)
         error("sys_mbox_post error\n");
 }
@@ -135,6 +149,7 @@ void sys_mbox_post(sys_mbox_t *mbox, void *msg) {
  *                                  if not.
  *---------------------------------------------------------------------------*/
 err_t sys_mbox_trypost(sys_mbox_t *mbox, void *msg) {
+    SYS_ARCH_COUNT(mbox_posts);
     osStatus status = osMessagePut(mbox->id, (uint32_t)msg, 0);
     return (status == osOK) ? (ERR_OK) : (ERR_MEM);
 }
@@ -251,6 +266,11 @@ err_t sys_sem_new(sys_sem_t *sem, u8_t count) {
 u32_t sys_arch_sem_wait(sys_sem_t *sem, u32_t timeout) {
     u32_t start = us_ticker_read();
     
+#if LWIP_SYS_ARCH_COUNTERS
+    if (osSemaphoreWait(sem->id, 0) > 0)
+        return 0;
+    SYS_ARCH_COUNT(sem_blocks);
+#endif
     if (osSemaphoreWait(sem->id, (timeout != 0)?(timeout):(osWaitForever)) < 1)
         return SYS_ARCH_TIMEOUT;
     
@@ -266,6 +286,16 @@ u32_t sys_arch_sem_wait(sys_sem_t *sem, u32_t timeout) {
  *      sys_sem_t sem           -- Semaphore to signal
  *---------------------------------------------------------------------------*/
 void sys_sem_signal(sys_sem_t *data) {
+#if SYS_ARCH_PROTECT_USE_BASEPRI && defined(CMSIS_OS_RTX)
+    /* Inside sys_arch_protect() (e.g. lwIP's event_callback) an SVC could
+     * switch to the woken thread while BASEPRI is still raised. Queue the
+     * release the way an ISR does: RTX applies it from PendSV as soon as
+     * the protection is dropped. */
+    if ((__get_IPSR() == 0) && (__get_BASEPRI() != 0)) {
+        isr_sem_send(data->id);
+        return;
+    }
+#endif
     if (osSemaphoreRelease(data->id) != osOK)
         mbed_die(); /* Can be called by ISR do not use printf */
 }
@@ -281,6 +311,9 @@ void sys_sem_signal(sys_sem_t *data) {
 void sys_sem_free(sys_sem_t *sem) {}
 
 /** Create a new mutex
+ * RTX mutexes implement priority inheritance, so a low priority thread
+ * holding the tcpip core lock (LWIP_TCPIP_CORE_LOCKING) is boosted while a
+ * higher priority thread waits for it.
  * @param mutex pointer to the mutex to create
  * @return a new mutex */
 err_t sys_mutex_new(sys_mutex_t *mutex) {
@@ -302,6 +335,11 @@ err_t sys_mutex_new(sys_mutex_t *mutex) {
 /** Lock a mutex
  * @param mutex the mutex to lock */
 void sys_mutex_lock(sys_mutex_t *mutex) {
+#if LWIP_SYS_ARCH_COUNTERS
+    if (osMutexWait(mutex->id, 0) == osOK)
+        return;
+    SYS_ARCH_COUNT(mutex_blocks);
+#endif
     if (osMutexWait(mutex->id, osWaitForever) != osOK)
         error("sys_mutex_lock error\n");
 }
@@ -323,14 +361,18 @@ void sys_mutex_free(sys_mutex_t *mutex) {}
  * Description:
  *      Initialize sys arch
  *---------------------------------------------------------------------------*/
+#if !SYS_ARCH_PROTECT_USE_BASEPRI
 osMutexId lwip_sys_mutex;
 osMutexDef(lwip_sys_mutex);
+#endif
 
 void sys_init(void) {
     us_ticker_read(); // Init sys tick
+#if !SYS_ARCH_PROTECT_USE_BASEPRI
     lwip_sys_mutex = osMutexCreate(osMutex(lwip_sys_mutex));
     if (lwip_sys_mutex == NULL)
         error("sys_init error\n");
+#endif
 }
 
 /*---------------------------------------------------------------------------*
@@ -345,6 +387,52 @@ u32_t sys_jiffies(void) {
     return jiffies;
 }
 
+#if SYS_ARCH_PROTECT_USE_BASEPRI
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_protect
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Raises BASEPRI to LWIP_SYS_ARCH_PROTECT_PRIO, masking the RTX
+ *      scheduler (SysTick/PendSV) and any interrupt at or below that
+ *      priority while higher priority interrupts keep running. Nested calls
+ *      never lower the current mask.
+ * Outputs:
+ *      sys_prot_t              -- BASEPRI on entry
+ *---------------------------------------------------------------------------*/
+sys_prot_t sys_arch_protect(void) {
+    uint32_t basepri = __get_BASEPRI();
+    if ((basepri == 0) || (basepri > LWIP_SYS_ARCH_PROTECT_PRIO)) {
+#if (__CORTEX_M == 0x07)
+        /* Cortex-M7 r0p1 erratum 837070: MSR BASEPRI needs interrupts off */
+        __disable_irq();
+        __set_BASEPRI(LWIP_SYS_ARCH_PROTECT_PRIO);
+        __enable_irq();
+#else
+        __set_BASEPRI(LWIP_SYS_ARCH_PROTECT_PRIO);
+#endif
+        if (basepri == 0) {
+            IRQ_PROFILE_BASEPRI_ENTER();
+        }
+    }
+    return (sys_prot_t) basepri;
+}
+
+/*---------------------------------------------------------------------------*
+ * Routine:  sys_arch_unprotect
+ *---------------------------------------------------------------------------*
+ * Description:
+ *      Restores the BASEPRI value returned by the matching
+ *      sys_arch_protect().
+ * Inputs:
+ *      sys_prot_t              -- BASEPRI on entry of sys_arch_protect()
+ *---------------------------------------------------------------------------*/
+void sys_arch_unprotect(sys_prot_t p) {
+    if (p == 0) {
+        IRQ_PROFILE_BASEPRI_EXIT();
+    }
+    __set_BASEPRI(p);
+}
+#else
 /*---------------------------------------------------------------------------*
  * Routine:  sys_arch_protect
  *---------------------------------------------------------------------------*
@@ -385,6 +473,17 @@ void sys_arch_unprotect(sys_prot_t p) {
     if (osMutexRelease(lwip_sys_mutex) != osOK)
         error("sys_arch_unprotect error\n");
 }
+#endif
+
+#if LWIP_SYS_ARCH_COUNTERS
+void sys_arch_counters_get(sys_arch_counters_t *counters) {
+    *counters = sys_arch_counters;
+}
+
+void sys_arch_counters_reset(void) {
+    memset(&sys_arch_counters, 0, sizeof(sys_arch_counters));
+}
+#endif
 
 u32_t sys_now(void) {
     return us_ticker_read() / 1000;
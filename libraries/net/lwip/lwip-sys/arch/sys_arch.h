@@ -21,6 +21,7 @@
 #include "lwip/opt.h"
 
 #if NO_SYS == 0
+#include "cmsis.h"
 #include "cmsis_os.h"
 
 // === SEMAPHORE ===
@@ -82,7 +83,52 @@ typedef sys_thread_data_t* sys_thread_t;
 #define SYS_DEFAULT_THREAD_STACK_DEPTH      DEFAULT_STACK_SIZE
 
 // === PROTECTION ===
+// On Cortex-M3/M4/M7 SYS_ARCH_PROTECT can raise BASEPRI instead of taking a
+// mutex. __CORTEX_M comes from the device header cmsis.h included above, so
+// that every file agrees on sys_prot_t. Only the lowest priority level
+// (SysTick/PendSV, i.e. the RTX scheduler) is masked by default, every
+// other interrupt stays enabled.
+#ifndef LWIP_SYS_ARCH_PROTECT_BASEPRI
+#define LWIP_SYS_ARCH_PROTECT_BASEPRI   LWIP_TCPIP_CORE_LOCKING
+#endif
+
+#if LWIP_SYS_ARCH_PROTECT_BASEPRI && defined(__CORTEX_M) && (__CORTEX_M >= 0x03)
+#define SYS_ARCH_PROTECT_USE_BASEPRI    1
+
+#ifndef LWIP_SYS_ARCH_PROTECT_PRIO
+#define LWIP_SYS_ARCH_PROTECT_PRIO      ((((1 << __NVIC_PRIO_BITS) - 1) << (8 - __NVIC_PRIO_BITS)) & 0xFF)
+#endif
+
+typedef uint32_t sys_prot_t;    // BASEPRI on entry
+#else
+#define SYS_ARCH_PROTECT_USE_BASEPRI    0
+
 typedef int sys_prot_t;
+#endif
+
+// === COUNTERS ===
+// Cheap instrumentation of the calls that make a thread give up the CPU,
+// used to compare message passing and core locking modes
+#ifndef LWIP_SYS_ARCH_COUNTERS
+#define LWIP_SYS_ARCH_COUNTERS          0
+#endif
+
+#if LWIP_SYS_ARCH_COUNTERS
+typedef struct {
+    u32_t mbox_posts;       // messages posted (e.g. to the tcpip thread)
+    u32_t sem_blocks;       // sys_arch_sem_wait calls that had to block
+    u32_t mutex_blocks;     // sys_mutex_lock calls that had to block
+} sys_arch_counters_t;
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+void sys_arch_counters_get(sys_arch_counters_t *counters);
+void sys_arch_counters_reset(void);
+#ifdef  __cplusplus
+}
+#endif
+#endif
 
 #else
 #ifdef  __cplusplus
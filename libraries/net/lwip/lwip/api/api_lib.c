@@ -572,6 +572,40 @@ netconn_send(struct netconn *conn, struct netbuf *buf)
   return err;
 }
 
+/**
+ * Send several netbufs over a UDP or RAW netconn with a single message to
+ * the tcpip thread. Sending stops at the first netbuf that fails.
+ *
+ * @param conn the UDP or RAW netconn over which to send data
+ * @param bufs array of count netbufs containing the data (and the remote
+ *        address/port, if not connected) to send
+ * @param count number of netbufs in bufs
+ * @param sent the number of netbufs actually sent is stored here (may be NULL)
+ * @return ERR_OK if all data was sent, the error of the first failing netbuf otherwise
+ */
+err_t
+netconn_sendm(struct netconn *conn, struct netbuf *bufs, u16_t count, u16_t *sent)
+{
+  struct api_msg msg;
+  err_t err;
+
+  LWIP_ERROR("netconn_sendm: invalid conn",  (conn != NULL), return ERR_ARG;);
+
+  LWIP_DEBUGF(API_LIB_DEBUG, ("netconn_sendm: sending %"U16_F" netbufs\n", count));
+  msg.function = do_sendm;
+  msg.msg.conn = conn;
+  msg.msg.msg.bm.bufs = bufs;
+  msg.msg.msg.bm.count = count;
+  msg.msg.msg.bm.sent = 0;
+  err = TCPIP_APIMSG(&msg);
+  if (sent != NULL) {
+    *sent = msg.msg.msg.bm.sent;
+  }
+
+  NETCONN_SET_SAFE_ERR(conn, err);
+  return err;
+}
+
 /**
  * Send data over a TCP netconn.
  *
@@ -1097,52 +1097,88 @@ do_listen(struct api_msg_msg *msg)
 #endif /* LWIP_TCP */
 
 /**
- * Send some data on a RAW or UDP pcb contained in a netconn
- * Called from netconn_send
+ * Send one netbuf on the RAW or UDP pcb of a netconn
+ * Called from do_send and do_sendm
  *
- * @param msg the api_msg_msg pointing to the connection
+ * @param conn the netconn to send on
+ * @param buf the netbuf to send
+ * @return ERR_OK if the netbuf was sent, any other err_t on error
  */
-void
-do_send(struct api_msg_msg *msg)
+static err_t
+do_send_netbuf(struct netconn *conn, struct netbuf *buf)
 {
-  if (ERR_IS_FATAL(msg->conn->last_err)) {
-    msg->err = msg->conn->last_err;
-  } else {
-    msg->err = ERR_CONN;
-    if (msg->conn->pcb.tcp != NULL) {
-      switch (NETCONNTYPE_GROUP(msg->conn->type)) {
+  err_t err;
+
+  if (ERR_IS_FATAL(conn->last_err)) {
+    return conn->last_err;
+  }
+  err = ERR_CONN;
+  if (conn->pcb.tcp != NULL) {
+    switch (NETCONNTYPE_GROUP(conn->type)) {
 #if LWIP_RAW
-      case NETCONN_RAW:
-        if (ip_addr_isany(&msg->msg.b->addr)) {
-          msg->err = raw_send(msg->conn->pcb.raw, msg->msg.b->p);
-        } else {
-          msg->err = raw_sendto(msg->conn->pcb.raw, msg->msg.b->p, &msg->msg.b->addr);
-        }
-        break;
+    case NETCONN_RAW:
+      if (ip_addr_isany(&buf->addr)) {
+        err = raw_send(conn->pcb.raw, buf->p);
+      } else {
+        err = raw_sendto(conn->pcb.raw, buf->p, &buf->addr);
+      }
+      break;
 #endif
 #if LWIP_UDP
-      case NETCONN_UDP:
+    case NETCONN_UDP:
 #if LWIP_CHECKSUM_ON_COPY
-        if (ip_addr_isany(&msg->msg.b->addr)) {
-          msg->err = udp_send_chksum(msg->conn->pcb.udp, msg->msg.b->p,
-            msg->msg.b->flags & NETBUF_FLAG_CHKSUM, msg->msg.b->toport_chksum);
-        } else {
-          msg->err = udp_sendto_chksum(msg->conn->pcb.udp, msg->msg.b->p,
-            &msg->msg.b->addr, msg->msg.b->port,
-            msg->msg.b->flags & NETBUF_FLAG_CHKSUM, msg->msg.b->toport_chksum);
-        }
+      if (ip_addr_isany(&buf->addr)) {
+        err = udp_send_chksum(conn->pcb.udp, buf->p,
+          buf->flags & NETBUF_FLAG_CHKSUM, buf->toport_chksum);
+      } else {
+        err = udp_sendto_chksum(conn->pcb.udp, buf->p,
+          &buf->addr, buf->port,
+          buf->flags & NETBUF_FLAG_CHKSUM, buf->toport_chksum);
+      }
 #else /* LWIP_CHECKSUM_ON_COPY */
-        if (ip_addr_isany(&msg->msg.b->addr)) {
-          msg->err = udp_send(msg->conn->pcb.udp, msg->msg.b->p);
-        } else {
-          msg->err = udp_sendto(msg->conn->pcb.udp, msg->msg.b->p, &msg->msg.b->addr, msg->msg.b->port);
-        }
+      if (ip_addr_isany(&buf->addr)) {
+        err = udp_send(conn->pcb.udp, buf->p);
+      } else {
+        err = udp_sendto(conn->pcb.udp, buf->p, &buf->addr, buf->port);
+      }
 #endif /* LWIP_CHECKSUM_ON_COPY */
-        break;
+      break;
 #endif /* LWIP_UDP */
-      default:
-        break;
-      }
+    default:
+      break;
+    }
+  }
+  return err;
+}
+
+/**
+ * Send some data on a RAW or UDP pcb contained in a netconn
+ * Called from netconn_send
+ *
+ * @param msg the api_msg_msg pointing to the connection
+ */
+void
+do_send(struct api_msg_msg *msg)
+{
+  msg->err = do_send_netbuf(msg->conn, msg->msg.b);
+  TCPIP_APIMSG_ACK(msg);
+}
+
+/**
+ * Send an array of netbufs on a RAW or UDP pcb contained in a netconn,
+ * stopping at the first one that fails.
+ * Called from netconn_sendm
+ *
+ * @param msg the api_msg_msg pointing to the connection
+ */
+void
+do_sendm(struct api_msg_msg *msg)
+{
+  msg->err = ERR_OK;
+  for (msg->msg.bm.sent = 0; msg->msg.bm.sent < msg->msg.bm.count; msg->msg.bm.sent++) {
+    msg->err = do_send_netbuf(msg->conn, &msg->msg.bm.bufs[msg->msg.bm.sent]);
+    if (msg->err != ERR_OK) {
+      break;
     }
   }
   TCPIP_APIMSG_ACK(msg);
@@ -847,7 +847,7 @@ lwip_sendto(int s, const void *data, size_t size, int flags,
         inet_addr_to_ipaddr_p(remote_addr, &to_in->sin_addr);
         remote_port = ntohs(to_in->sin_port);
       } else {
-        remote_addr = &sock->conn->pcb.raw->remote_ip;
+        remote_addr = &sock->conn->pcb.ip->remote_ip;
         if (sock->conn->type == NETCONN_RAW) {
           remote_port = 0;
         } else {
@@ -856,9 +856,12 @@ lwip_sendto(int s, const void *data, size_t size, int flags,
       }
 
       LOCK_TCPIP_CORE();
+#if LWIP_RAW
       if (sock->conn->type == NETCONN_RAW) {
         err = sock->conn->last_err = raw_sendto(sock->conn->pcb.raw, p, remote_addr);
-      } else {
+      } else
+#endif /* LWIP_RAW */
+      {
 #if LWIP_UDP
 #if LWIP_CHECKSUM_ON_COPY && LWIP_NETIF_TX_SINGLE_PBUF
         err = sock->conn->last_err = udp_sendto_chksum(sock->conn->pcb.udp, p,
@@ -931,6 +934,188 @@ lwip_sendto(int s, const void *data, size_t size, int flags,
   return (err == ERR_OK ? short_size : -1);
 }
 
+/**
+ * Prepare one netbuf for lwip_sendmmsg(): either copy the payload into
+ * stack memory (computing the checksum on the way, if enabled) or, with
+ * MSG_ZEROCOPY, make the netbuf reference the caller's buffer.
+ */
+static err_t
+lwip_mmsg_fill(struct lwip_sock *sock, struct netbuf *buf, const void *data, u16_t len, int flags)
+{
+  if (flags & MSG_ZEROCOPY) {
+    return netbuf_ref(buf, data, len);
+  }
+  if (netbuf_alloc(buf, len) == NULL) {
+    return ERR_MEM;
+  }
+#if LWIP_CHECKSUM_ON_COPY
+  if (sock->conn->type != NETCONN_RAW) {
+    u16_t chksum = LWIP_CHKSUM_COPY(buf->p->payload, data, len);
+    netbuf_set_chksum(buf, chksum);
+    return ERR_OK;
+  }
+#else /* LWIP_CHECKSUM_ON_COPY */
+  LWIP_UNUSED_ARG(sock);
+#endif /* LWIP_CHECKSUM_ON_COPY */
+  return netbuf_take(buf, data, len);
+}
+
+/**
+ * Send several datagrams on a UDP (or RAW) socket. Up to LWIP_MMSG_BATCH
+ * datagrams are handed to the tcpip thread per message, so a whole batch
+ * costs a single round-trip instead of one per datagram.
+ *
+ * With MSG_ZEROCOPY the payloads are referenced (PBUF_REF) instead of
+ * copied; they must not be modified until lwip_sendmmsg() returns.
+ *
+ * A datagram longer than 0xffff bytes stops the batch, failing with
+ * EMSGSIZE if it is the first one.
+ *
+ * @return the number of datagrams sent (stops at the first failure), or -1
+ *         if not even the first datagram could be sent
+ */
+int
+lwip_sendmmsg(int s, struct lwip_mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+  struct lwip_sock *sock;
+  struct netbuf bufs[LWIP_MMSG_BATCH];
+  struct lwip_mmsghdr *m;
+  unsigned int done = 0;
+  u16_t i, count, sent;
+  err_t err = ERR_OK;
+  err_t send_err;
+  int too_long = 0;
+
+  LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_sendmmsg(%d, vlen=%u, flags=0x%x)\n", s, vlen, flags));
+  sock = get_socket(s);
+  if (!sock) {
+    return -1;
+  }
+
+  if (sock->conn->type == NETCONN_TCP) {
+    sock_set_errno(sock, err_to_errno(ERR_ARG));
+    return -1;
+  }
+
+  while ((done < vlen) && (err == ERR_OK)) {
+    count = (u16_t)LWIP_MIN(vlen - done, LWIP_MMSG_BATCH);
+    for (i = 0; i < count; i++) {
+      m = &msgvec[done + i];
+      if (m->len > 0xffff) {
+        /* a datagram's length must fit in u16_t; send the ones before it */
+        too_long = 1;
+        err = ERR_VAL;
+        break;
+      }
+      bufs[i].p = bufs[i].ptr = NULL;
+#if LWIP_CHECKSUM_ON_COPY
+      bufs[i].flags = 0;
+#endif /* LWIP_CHECKSUM_ON_COPY */
+      if (m->addr != NULL) {
+        inet_addr_to_ipaddr(&bufs[i].addr, &m->addr->sin_addr);
+        netbuf_fromport(&bufs[i]) = ntohs(m->addr->sin_port);
+      } else {
+        ip_addr_set_any(&bufs[i].addr);
+        netbuf_fromport(&bufs[i]) = 0;
+      }
+      err = lwip_mmsg_fill(sock, &bufs[i], m->data, (u16_t)m->len, flags);
+      if (err != ERR_OK) {
+        /* send what has been prepared so far */
+        netbuf_free(&bufs[i]);
+        break;
+      }
+    }
+
+    sent = 0;
+    if (i > 0) {
+      send_err = netconn_sendm(sock->conn, bufs, i, &sent);
+      if (err == ERR_OK) {
+        err = send_err;
+      }
+    }
+    done += sent;
+
+    while (i > 0) {
+      netbuf_free(&bufs[--i]);
+    }
+  }
+
+  if ((done > 0) || (err == ERR_OK)) {
+    sock_set_errno(sock, 0);
+    return (int)done;
+  }
+  sock_set_errno(sock, too_long ? EMSGSIZE : err_to_errno(err));
+  return -1;
+}
+
+/**
+ * Receive several datagrams from a UDP (or RAW) socket. Blocks (unless the
+ * socket is non-blocking or MSG_DONTWAIT is given) until the first datagram
+ * is available, then drains whatever else is already queued on the socket
+ * without blocking again. Datagrams larger than their buffer are truncated.
+ *
+ * @return the number of datagrams received, or -1 on error/EWOULDBLOCK
+ */
+int
+lwip_recvmmsg(int s, struct lwip_mmsghdr *msgvec, unsigned int vlen, int flags)
+{
+  struct lwip_sock *sock;
+  struct netbuf *buf;
+  struct lwip_mmsghdr *m;
+  unsigned int i;
+  err_t err = ERR_OK;
+
+  LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recvmmsg(%d, vlen=%u, flags=0x%x)\n", s, vlen, flags));
+  sock = get_socket(s);
+  if (!sock) {
+    return -1;
+  }
+
+  if (netconn_type(sock->conn) == NETCONN_TCP) {
+    sock_set_errno(sock, err_to_errno(ERR_ARG));
+    return -1;
+  }
+
+  for (i = 0; i < vlen; i++) {
+    if (sock->lastdata) {
+      /* left over from a previous MSG_PEEK */
+      buf = (struct netbuf *)sock->lastdata;
+      sock->lastdata = NULL;
+      sock->lastoffset = 0;
+    } else {
+      if (((i > 0) || (flags & MSG_DONTWAIT) || netconn_is_nonblocking(sock->conn)) &&
+          (sock->rcvevent <= 0)) {
+        if (i == 0) {
+          err = ERR_WOULDBLOCK;
+        }
+        break;
+      }
+      err = netconn_recv(sock->conn, &buf);
+      if (err != ERR_OK) {
+        break;
+      }
+    }
+
+    m = &msgvec[i];
+    m->len = pbuf_copy_partial(buf->p, m->data, (u16_t)LWIP_MIN(m->len, buf->p->tot_len), 0);
+    if (m->addr != NULL) {
+      memset(m->addr, 0, sizeof(*m->addr));
+      m->addr->sin_len = sizeof(*m->addr);
+      m->addr->sin_family = AF_INET;
+      m->addr->sin_port = htons(netbuf_fromport(buf));
+      inet_addr_from_ipaddr(&m->addr->sin_addr, netbuf_fromaddr(buf));
+    }
+    netbuf_delete(buf);
+  }
+
+  if (i > 0) {
+    sock_set_errno(sock, 0);
+    return (int)i;
+  }
+  sock_set_errno(sock, err_to_errno(err));
+  return -1;
+}
+
 int
 lwip_socket(int domain, int type, int protocol)
 {
@@ -69,6 +69,12 @@ struct api_msg_msg {
   union {
     /** used for do_send */
     struct netbuf *b;
+    /** used for do_sendm */
+    struct {
+      struct netbuf *bufs;
+      u16_t count;
+      u16_t sent;
+    } bm;
     /** used for do_newconn */
     struct {
       u8_t proto;
@@ -149,6 +155,7 @@ void do_connect         ( struct api_msg_msg *msg);
 void do_disconnect      ( struct api_msg_msg *msg);
 void do_listen          ( struct api_msg_msg *msg);
 void do_send            ( struct api_msg_msg *msg);
+void do_sendm           ( struct api_msg_msg *msg);
 void do_recv            ( struct api_msg_msg *msg);
 void do_write           ( struct api_msg_msg *msg);
 void do_getaddr         ( struct api_msg_msg *msg);
@@ -1427,6 +1427,15 @@
 #define RECV_BUFSIZE_DEFAULT            INT_MAX
 #endif
 
+/**
+ * LWIP_MMSG_BATCH: Maximum number of datagrams lwip_sendmmsg() hands to the
+ * tcpip thread in a single message. Larger vectors are split into several
+ * batches. Each batch places LWIP_MMSG_BATCH netbufs on the caller's stack.
+ */
+#ifndef LWIP_MMSG_BATCH
+#define LWIP_MMSG_BATCH                 8
+#endif
+
 /**
  * SO_REUSE==1: Enable SO_REUSEADDR option.
  */
@@ -132,6 +132,16 @@ struct linger {
 #define MSG_OOB        0x04    /* Unimplemented: Requests out-of-band data. The significance and semantics of out-of-band data are protocol-specific */
 #define MSG_DONTWAIT   0x08    /* Nonblocking i/o for this operation only */
 #define MSG_MORE       0x10    /* Sender will send more */
+#define MSG_ZEROCOPY   0x20    /* lwip_sendmmsg: reference the caller's buffers instead of copying them */
+
+/*
+ * Datagram descriptor for lwip_sendmmsg() and lwip_recvmmsg().
+ */
+struct lwip_mmsghdr {
+  struct sockaddr_in *addr;   /* destination (send) or source (receive), may be NULL */
+  void               *data;   /* datagram payload */
+  size_t              len;    /* send: payload length (up to 0xffff), receive: buffer size in, datagram length out */
+};
 
 
 /*
@@ -333,6 +343,8 @@ int lwip_recvfrom(int s, void *mem, size_t len, int flags,
 int lwip_send(int s, const void *dataptr, size_t size, int flags);
 int lwip_sendto(int s, const void *dataptr, size_t size, int flags,
     const struct sockaddr *to, socklen_t tolen);
+int lwip_sendmmsg(int s, struct lwip_mmsghdr *msgvec, unsigned int vlen, int flags);
+int lwip_recvmmsg(int s, struct lwip_mmsghdr *msgvec, unsigned int vlen, int flags);
 int lwip_socket(int domain, int type, int protocol);
 int lwip_write(int s, const void *dataptr, size_t size);
 int lwip_select(int maxfdp1, fd_set *readset, fd_set *writeset, fd_set *exceptset,
@@ -40,6 +40,13 @@
 #define TCPIP_THREAD_STACKSIZE      1024
 #define TCPIP_THREAD_PRIO           (osPriorityNormal)
 
+// Core locking: application threads run netconn/socket calls directly under
+// the (priority inheriting) core mutex instead of posting them to the tcpip
+// thread. Build with -DLWIP_TCPIP_CORE_LOCKING=1 to enable.
+#ifndef LWIP_TCPIP_CORE_LOCKING
+#define LWIP_TCPIP_CORE_LOCKING     0
+#endif
+
 #define DEFAULT_THREAD_STACKSIZE    512
 
 #define MEMP_NUM_SYS_TIMEOUT        16
@@ -25,6 +25,8 @@ Arguments::Arguments(const char* rqs) {
     obj_name = NULL;
     method_name = NULL;
     argc = 0;
+    binary = false;
+    overrun = false;
 
     // This copy can be removed if we can assume the request string is
     // persistent and writable for the duration of the call
@@ -54,6 +56,42 @@ Arguments::Arguments(const char* rqs) {
     index = -1;
 }
 
+Arguments::Arguments(const uint8_t* args, uint32_t length) {
+    obj_name = NULL;
+    method_name = NULL;
+    argc = 0;
+    index = -1;
+    binary = true;
+    overrun = false;
+    pos = 0;
+    size = (length < sizeof(request)) ? length : sizeof(request);
+
+    // Keep the copy so that string arguments stay valid for the call
+    memcpy(request, args, size);
+    if (size > 0) {
+        argc = (uint8_t)request[0];
+        pos = 1;
+    }
+}
+
+// Returns the next n bytes of a binary request, NULL past the end
+const char* Arguments::binary_arg(uint32_t n) {
+    if (pos + n > size) {
+        overrun = true;
+        pos = size;
+        return NULL;
+    }
+    const char *arg = &request[pos];
+    pos += n;
+    return arg;
+}
+
+uint32_t Arguments::binary_word(void) {
+    const uint8_t *p = (const uint8_t *)binary_arg(4);
+    if (p == NULL) return 0;
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
 char* Arguments::search_arg(char **arg, char *p, char next_sep) {
     char *s = p;
     while (true) {
@@ -70,72 +108,169 @@ char* Arguments::search_arg(char **arg, char *p, char next_sep) {
 
 template<> PinName Arguments::getArg<PinName>(void) {
     index++;
+    if (binary) return (PinName)binary_word();
     return parse_pins(argv[index]);
 }
 
 template<> int Arguments::getArg<int>(void) {
     index++;
+    if (binary) return (int)binary_word();
     char *pEnd;
     return strtol(argv[index], &pEnd, 10);
 }
 
 template<> const char* Arguments::getArg<const char*>(void) {
     index++;
+    if (binary) {
+        // NUL terminated in the request
+        const char *s = &request[pos];
+        const char *nul = (const char *)memchr(s, '\0', size - pos);
+        if (nul == NULL) {
+            binary_arg(size - pos + 1);
+            return "";
+        }
+        binary_arg(nul - s + 1);
+        return s;
+    }
     return argv[index];
 }
 
 template<> char Arguments::getArg<char>(void) {
     index++;
+    if (binary) {
+        const char *c = binary_arg(1);
+        return (c == NULL) ? 0 : *c;
+    }
     return *argv[index];
 }
 
 template<> double Arguments::getArg<double>(void) {
     index++;
+    if (binary) {
+        double d = 0;
+        const char *p = binary_arg(sizeof(d));
+        if (p != NULL) memcpy(&d, p, sizeof(d));
+        return d;
+    }
     return atof(argv[index]);
 }
 
 template<> float Arguments::getArg<float>(void) {
     index++;
+    if (binary) {
+        float f = 0;
+        const char *p = binary_arg(sizeof(f));
+        if (p != NULL) memcpy(&f, p, sizeof(f));
+        return f;
+    }
     return atof(argv[index]);
 }
 
 Reply::Reply(char* r) {
     first = true;
+    dropped = false;
+    binary = false;
+    stream = NULL;
+    *r = '\0';
+    reply = r;
+    start = r;
+    end = r + RPC_MAX_STRING - 1;
+}
+
+Reply::Reply(char* r, uint32_t size, ReplyStream *stream) {
+    first = true;
+    dropped = false;
+    binary = false;
+    this->stream = stream;
     *r = '\0';
     reply = r;
+    start = r;
+    end = r + size - 1;
+}
+
+Reply::Reply(uint8_t* r, uint32_t size) {
+    first = true;
+    dropped = false;
+    binary = true;
+    stream = NULL;
+    reply = (char *)r;
+    start = reply;
+    end = reply + size;
+}
+
+// Values that don't fit are dropped whole
+void Reply::put_binary(const void *data, uint32_t n) {
+    if (reply + n > end) {
+        dropped = true;
+        return;
+    }
+    memcpy(reply, data, n);
+    reply += n;
+}
+
+// Text that doesn't fit goes to the stream, or is truncated without one
+void Reply::put_text(const char *s, uint32_t n) {
+    while (n > 0) {
+        if (reply == end) {
+            if (stream == NULL) {
+                dropped = true;
+                break;
+            }
+            stream->putReply(start, reply - start);
+            reply = start;
+        }
+        uint32_t room = end - reply;
+        uint32_t len = (n < room) ? n : room;
+        memcpy(reply, s, len);
+        reply += len;
+        s += len;
+        n -= len;
+    }
+    *reply = '\0';
 }
 
 void Reply::separator(void) {
     if (first) {
         first = false;
     } else {
-        *reply = ' '; reply++;
+        put_text(" ", 1);
     }
 }
 
 template<> void Reply::putData<const char*>(const char* s) {
+    if (binary) { put_binary(s, strlen(s) + 1); return; }
     separator();
-    reply += sprintf(reply, "%s", s);
+    put_text(s, strlen(s));
 }
 
 template<> void Reply::putData<char*>(char* s) {
+    if (binary) { put_binary(s, strlen(s) + 1); return; }
     separator();
-    reply += sprintf(reply, "%s", s);
+    put_text(s, strlen(s));
 }
 
 template<> void Reply::putData<char>(char c) {
+    if (binary) { put_binary(&c, 1); return; }
     separator();
-    reply += sprintf(reply, "%c", c);
+    put_text(&c, 1);
 }
 
 template<> void Reply::putData<int>(int v) {
+    if (binary) {
+        uint8_t b[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+        put_binary(b, 4);
+        return;
+    }
+    char text[12];
     separator();
-    reply += sprintf(reply, "%d", v);
+    put_text(text, sprintf(text, "%d", v));
 }
 
 template<> void Reply::putData<float>(float f) {
+    if (binary) { put_binary(&f, sizeof(f)); return; }
+    char text[32];
     separator();
-    reply += sprintf(reply, "%.17g", f);
+    put_text(text, sprintf(text, "%.17g", f));
 }
 
 } // namespace mbed
@@ -28,9 +28,19 @@ class Arguments {
 public:
     Arguments(const char* rqs);
 
+    /* Arguments of a binary request: the argument count followed by
+     * the values, see RPC::call_binary for their encoding.
+     */
+    Arguments(const uint8_t* args, uint32_t length);
+
     template<typename Arg>
     Arg   getArg(void);
 
+    /* Function valid
+     *  false if a binary request was shorter than its arguments
+     */
+    bool valid(void) { return !overrun; }
+
     char *obj_name;
     char *method_name;
 
@@ -43,19 +53,67 @@ private:
     char  request[RPC_MAX_STRING];
     int index;
     char* search_arg(char **arg, char *p, char next_sep);
+
+    bool binary;
+    bool overrun;
+    uint32_t pos;
+    uint32_t size;
+    const char* binary_arg(uint32_t n);
+    uint32_t binary_word(void);
+};
+
+/* Class ReplyStream
+ *  Takes the text of a Reply as it is built, once it no longer fits in
+ *  the buffer of the Reply.
+ */
+class ReplyStream {
+public:
+    virtual ~ReplyStream() {}
+    virtual void putReply(const char *data, uint32_t length) = 0;
 };
 
 class Reply {
 public:
+    /* Text reply in r, truncated at RPC_MAX_STRING - 1 characters, see
+     * truncated()
+     */
     Reply(char* r);
 
+    /* Text reply built in r, which is given to stream each time its size
+     * is reached, so that long replies aren't truncated. The end of the
+     * reply is left in r, length() characters.
+     */
+    Reply(char* r, uint32_t size, ReplyStream *stream);
+
+    /* Reply to a binary request: the values are encoded as the
+     * arguments of a binary request, up to size bytes.
+     */
+    Reply(uint8_t* r, uint32_t size);
+
     template<typename Data>
     void putData(Data d);
 
+    /* Function length
+     *  The number of bytes written so far
+     */
+    uint32_t length(void) { return reply - start; }
+
+    /* Function truncated
+     *  True if text was cut off, or values dropped, for lack of room
+     */
+    bool truncated(void) { return dropped; }
+
 private:
     void separator(void);
+    void put_binary(const void *data, uint32_t n);
+    void put_text(const char *s, uint32_t n);
+    ReplyStream *stream;
     bool first;
+    bool binary;
+    bool dropped;
     char* reply;
+    char* start;
+    char* end;
 };
 
 
@@ -0,0 +1,143 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "RPCPipe.h"
+
+namespace mbed {
+
+RPCPipe::RPCPipe() {
+    _line_length = 0;
+    _overlong = false;
+    _out_length = 0;
+}
+
+void RPCPipe::receive(const char *data, uint32_t length) {
+    for (uint32_t i = 0; i < length; i++) {
+        char c = data[i];
+        if ((c == '\n') || (c == '\r')) {
+            if (_line_length > 0) {
+                call_line();
+            }
+            _line_length = 0;
+            _overlong = false;
+        } else if (_line_length < sizeof(_line) - 1) {
+            _line[_line_length++] = c;
+        } else {
+            _overlong = true;
+        }
+    }
+
+    // the replies of everything received so far go out together
+    flush();
+}
+
+void RPCPipe::call_line(void) {
+    _line[_line_length] = '\0';
+
+    /* The id, up to the first space */
+    char *request = _line;
+    uint32_t id_length = 0;
+    if (*request != '/') {
+        while ((*request != ' ') && (*request != '\0')) {
+            request++;
+        }
+        id_length = request - _line;
+        while (*request == ' ') {
+            request++;
+        }
+    }
+    bool valid = !_overlong && (*request == '/');
+
+    /* The values are streamed after the id, which is still all in _out
+     * if the call fails since nothing was written after it */
+    uint32_t header = 0;
+    if (id_length > 0) {
+        _line[id_length] = ' ';
+        header = id_length + 1;
+    }
+    put(_line, header);
+    uint32_t mark = _out_length - header;
+
+    char text[RPC_MAX_STRING];
+    Reply r(text, sizeof(text), this);
+    if (valid && RPC::call(request, &r)) {
+        put(text, r.length());
+        put("\n", 1);
+    } else {
+        _out_length = mark;
+        put(_line, id_length);
+        put("!\n", 2);
+    }
+}
+
+void RPCPipe::putReply(const char *data, uint32_t length) {
+    put(data, length);
+}
+
+void RPCPipe::put(const char *data, uint32_t length) {
+    if (_out_length + length > sizeof(_out)) {
+        flush();
+    }
+    if (length > sizeof(_out)) {
+        write(data, length);
+        return;
+    }
+    memcpy(&_out[_out_length], data, length);
+    _out_length += length;
+}
+
+void RPCPipe::flush(void) {
+    if (_out_length > 0) {
+        write(_out, _out_length);
+        _out_length = 0;
+    }
+}
+
+RPCSerial::RPCSerial(Serial &serial) : _serial(serial) {
+    _rx_head = 0;
+    _rx_tail = 0;
+    _serial.attach(this, &RPCSerial::rx_irq);
+}
+
+// Bytes that don't fit are dropped, the client keeps few enough requests in flight
+void RPCSerial::rx_irq(void) {
+    while (_serial.readable()) {
+        char c = _serial.getc();
+        uint32_t next = (_rx_head + 1) % sizeof(_rx);
+        if (next != _rx_tail) {
+            _rx[_rx_head] = c;
+            _rx_head = next;
+        }
+    }
+}
+
+void RPCSerial::poll(void) {
+    uint32_t head = _rx_head;
+    uint32_t tail = _rx_tail;
+    if (head == tail) return;
+
+    /* Up to the end of the buffer, the rest on the next poll */
+    uint32_t end = (head > tail) ? head : sizeof(_rx);
+    receive(&_rx[tail], end - tail);
+    _rx_tail = end % sizeof(_rx);
+}
+
+void RPCSerial::write(const char *data, uint32_t length) {
+    for (uint32_t i = 0; i < length; i++) {
+        _serial.putc(data[i]);
+    }
+}
+
+} // namespace mbed
@@ -0,0 +1,112 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RPCPIPE_H
+#define RPCPIPE_H
+
+#include "rpc.h"
+
+namespace mbed {
+
+/* Macro RPC_PIPE_BUFFER_SIZE
+ *  Size of the buffer the replies are collected in before being written
+ *  out together, and of the receive buffer of RPCSerial.
+ */
+#ifndef RPC_PIPE_BUFFER_SIZE
+#define RPC_PIPE_BUFFER_SIZE    512
+#endif
+
+/* Class RPCPipe
+ *  Calls the RPC requests of a byte stream as they arrive, without
+ *  waiting for the replies to be read, and writes the replies of all the
+ *  requests received together in one write.
+ *
+ *  Request: <id> /obj/method arg1 ... argN\n
+ *  Reply:   <id> <values>\n or, if there's no such method, <id>!\n
+ *
+ *  The id is any word chosen by the client and comes back unchanged, so
+ *  that many requests can be in flight. Replies come in the order of the
+ *  requests and are never truncated. Requests without an id, starting
+ *  with '/', get replies without one as with RPC::call.
+ */
+class RPCPipe : public ReplyStream {
+public:
+    RPCPipe();
+
+    /* Function receive
+     *  Call the requests completed by data and write out their replies.
+     *  A request may be split over several calls.
+     */
+    void receive(const char *data, uint32_t length);
+
+    virtual void putReply(const char *data, uint32_t length);
+
+protected:
+    /* Function write
+     *  Send replies to the client, implemented by the transport
+     */
+    virtual void write(const char *data, uint32_t length) = 0;
+
+private:
+    void call_line(void);
+    void put(const char *data, uint32_t length);
+    void flush(void);
+
+    char _line[RPC_MAX_STRING];
+    uint32_t _line_length;
+    bool _overlong;
+
+    char _out[RPC_PIPE_BUFFER_SIZE];
+    uint32_t _out_length;
+};
+
+/* Class RPCSerial
+ *  An RPCPipe on a serial port. Received bytes are buffered from the
+ *  receive interrupt and the requests are called by poll().
+ *
+ * Example
+ * > Serial pc(USBTX, USBRX);
+ * > RPCSerial rpc(pc);
+ * >
+ * > int main() {
+ * >     while (true) {
+ * >         rpc.poll();
+ * >     }
+ * > }
+ */
+class RPCSerial : public RPCPipe {
+public:
+    RPCSerial(Serial &serial);
+
+    /* Function poll
+     *  Call the requests received so far, from the main loop
+     */
+    void poll(void);
+
+protected:
+    virtual void write(const char *data, uint32_t length);
+
+private:
+    void rx_irq(void);
+
+    Serial &_serial;
+    char _rx[RPC_PIPE_BUFFER_SIZE];
+    volatile uint32_t _rx_head;
+    volatile uint32_t _rx_tail;
+};
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,69 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef RPCSOCKET_H
+#define RPCSOCKET_H
+
+#include "RPCPipe.h"
+#include "TCPSocketConnection.h"
+
+namespace mbed {
+
+/* Class RPCSocket
+ *  An RPCPipe on a TCP connection. Only in this header so that the RPC
+ *  library doesn't need the network libraries unless it is included.
+ *
+ * Example
+ * > TCPSocketServer server;
+ * > server.bind(RPC_PORT);
+ * > server.listen();
+ * > TCPSocketConnection client;
+ * > server.accept(client);
+ * > RPCSocket rpc(client);
+ * > while (rpc.poll(1000));
+ */
+class RPCSocket : public RPCPipe {
+public:
+    RPCSocket(TCPSocketConnection &socket) : _socket(socket) {}
+
+    /* Function poll
+     *  Wait up to timeout ms for requests, call them and send their replies
+     *  in one write.
+     *
+     * Variables
+     *  returns - false once the connection is closed
+     */
+    bool poll(unsigned int timeout = 0) {
+        char data[RPC_PIPE_BUFFER_SIZE];
+        _socket.set_blocking(false, timeout);
+        int n = _socket.receive(data, sizeof(data));
+        if (n > 0) {
+            receive(data, n);
+        }
+        return _socket.is_connected();
+    }
+
+protected:
+    virtual void write(const char *data, uint32_t length) {
+        _socket.send_all((char *)data, length);
+    }
+
+private:
+    TCPSocketConnection &_socket;
+};
+
+} // namespace mbed
+
+#endif
@@ -21,5 +21,6 @@
 #include "RPCFunction.h"
 #include "RpcClasses.h"
 #include "Arguments.h"
+#include "RPCPipe.h"
 
 #endif
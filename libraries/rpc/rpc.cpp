@@ -19,6 +19,25 @@ using namespace std;
 
 namespace mbed {
 
+// Objects by hash of their name, chained through _bucket_next
+static RPC *_buckets[RPC_OBJECT_BUCKETS];
+
+// Methods already looked up, by the method array of the object's class and the hash of the method name
+struct rpc_method_cache_entry {
+    const rpc_method *methods;
+    uint32_t hash;
+    const rpc_method *method;
+};
+static rpc_method_cache_entry _method_cache[RPC_METHOD_CACHE_SIZE];
+
+// Methods and functions bound to the handles of binary requests
+struct rpc_binding {
+    RPC *obj;
+    rpc_method::method_caller_t method_caller;
+    void (*function_caller)(Arguments*, Reply*);
+};
+static rpc_binding _bindings[RPC_MAX_BINDINGS];
+
 RPC::RPC(const char *name) {
     _from_construct = false;
     if (name != NULL) {
@@ -31,9 +50,28 @@ RPC::RPC(const char *name) {
     // put this object at head of the list
     _next = _head;
     _head = this;
+
+    // and of its bucket
+    _hash = hash(_name);
+    RPC **bucket = &_buckets[_hash & (RPC_OBJECT_BUCKETS - 1)];
+    _bucket_next = *bucket;
+    *bucket = this;
 }
 
 RPC::~RPC() {
+    RPC **bucket = &_buckets[_hash & (RPC_OBJECT_BUCKETS - 1)];
+    while (*bucket != this) {
+        bucket = &(*bucket)->_bucket_next;
+    }
+    *bucket = _bucket_next;
+
+    for (int i = 0; i < RPC_MAX_BINDINGS; i++) {
+        if (_bindings[i].obj == this) {
+            _bindings[i].obj = NULL;
+            _bindings[i].method_caller = NULL;
+        }
+    }
+
     // remove this object from the list
     if (_head == this) { // first in the list, so just drop me
         _head = _next;
@@ -54,17 +92,113 @@ const rpc_method *RPC::get_rpc_methods() {
     return methods;
 }
 
+// FNV-1a
+uint32_t RPC::hash(const char *name) {
+    uint32_t h = 2166136261u;
+    while (*name != '\0') {
+        h ^= (uint8_t)*name++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
 RPC *RPC::lookup(const char *name) {
-    size_t len = strlen(name);
-    for (RPC *p = _head; p != NULL; p = p->_next) {
-        /* Check that p->_name matches name and is the correct length */
-        if (strncmp(p->_name, name, len) == 0 && (strlen(p->_name) == len)) {
+    uint32_t h = hash(name);
+    for (RPC *p = _buckets[h & (RPC_OBJECT_BUCKETS - 1)]; p != NULL; p = p->_bucket_next) {
+        if ((p->_hash == h) && (strcmp(p->_name, name) == 0)) {
             return p;
         }
     }
     return NULL;
 }
 
+rpc_class *RPC::find_class(const char *name, uint32_t h) {
+    for (rpc_class *q = _classes; q != NULL; q = q->next) {
+        /* Classes that were not added with add_rpc_class, like RPC itself */
+        if (q->hash == 0) {
+            q->hash = hash(q->name);
+        }
+        if ((q->hash == h) && (strcmp(q->name, name) == 0)) {
+            return q;
+        }
+    }
+    return NULL;
+}
+
+const rpc_method *RPC::find_method(RPC *p, const char *name) {
+    const rpc_method *methods = p->get_rpc_methods();
+    uint32_t h = hash(name);
+    rpc_method_cache_entry *e = &_method_cache[(h ^ ((uintptr_t)methods >> 2)) & (RPC_METHOD_CACHE_SIZE - 1)];
+
+    if ((e->methods == methods) && (e->hash == h) && (strcmp(e->method->name, name) == 0)) {
+        return e->method;
+    }
+
+    /* Look through the methods and those of the superclasses */
+    const rpc_method *cur_method = methods;
+    while (true) {
+        for (; cur_method->name != NULL; cur_method++) {
+            if (strcmp(cur_method->name, name) == 0) {
+                e->methods = methods;
+                e->hash = h;
+                e->method = cur_method;
+                return cur_method;
+            }
+        }
+
+        if (cur_method->super != 0) {
+            cur_method = cur_method->super(p);
+        } else {
+            return NULL;
+        }
+    }
+}
+
+int RPC::bind(const char *obj_name, const char *method_name) {
+    rpc_binding b = { lookup(obj_name), NULL, NULL };
+
+    if (b.obj != NULL) {
+        const rpc_method *m = find_method(b.obj, method_name);
+        if (m == NULL) return -1;
+        b.method_caller = m->method_caller;
+    } else {
+        const rpc_class *c = find_class(obj_name, hash(obj_name));
+        if (c == NULL) return -1;
+        for (const rpc_function *f = c->static_functions; f->name != NULL; f++) {
+            if (strcmp(f->name, method_name) == 0) {
+                b.function_caller = f->function_caller;
+                break;
+            }
+        }
+        if (b.function_caller == NULL) return -1;
+    }
+
+    /* The same method keeps its handle */
+    int free_handle = -1;
+    for (int i = 0; i < RPC_MAX_BINDINGS; i++) {
+        if ((_bindings[i].method_caller == NULL) && (_bindings[i].function_caller == NULL)) {
+            if (free_handle < 0) free_handle = i;
+        } else if ((_bindings[i].obj == b.obj) && (_bindings[i].method_caller == b.method_caller)
+                   && (_bindings[i].function_caller == b.function_caller)) {
+            return i;
+        }
+    }
+    if (free_handle >= 0) {
+        _bindings[free_handle] = b;
+    }
+    return free_handle;
+}
+
+void RPC::bind_handle(Arguments *args, Reply *result) {
+    if (args->argc < 2) {
+        result->putData<int>(-1);
+        return;
+    }
+    const char *obj_name = args->getArg<const char*>();
+    const char *method_name = args->getArg<const char*>();
+    result->putData<int>(bind(obj_name, method_name));
+}
+
 void RPC::delete_self() {
     delete[] _name;
     if (_from_construct) {
@@ -95,20 +229,26 @@ void RPC::clear(Arguments*, Reply*) {
 const rpc_function RPC::_RPC_funcs[] = {
     {"clear", &RPC::clear },
     { "objects", &RPC::list_objs },
+    { "bind", &RPC::bind_handle },
     RPC_METHOD_END
 };
 
-rpc_class RPC::_RPC_class = { "RPC", _RPC_funcs, NULL };
+rpc_class RPC::_RPC_class = { "RPC", _RPC_funcs, NULL, 0 };
 
 RPC *RPC::_head = NULL;
 
 rpc_class *RPC::_classes = &_RPC_class;
 
 bool RPC::call(const char *request, char *reply) {
+    Reply r(reply);
+    return call(request, &r) && !r.truncated();
+}
+
+bool RPC::call(const char *request, Reply *result) {
     if (request == NULL) return false;
 
     Arguments args(request);
-    Reply r(reply);
+    Reply &r = *result;
 
     /* If there's no name print object and class names to result */
     if (args.obj_name == NULL) {
@@ -124,11 +264,9 @@ bool RPC::call(const char *request, char *reply) {
     /* First try matching an instance */
     RPC *p = lookup(args.obj_name);
     if (p != NULL) {
-        /* Get the list of methods we support */
-        const rpc_method *cur_method = p->get_rpc_methods();
-
         /* When there's no method print method names to result */
         if (args.method_name == NULL) {
+            const rpc_method *cur_method = p->get_rpc_methods();
             while (true) {
                 for (; cur_method->name != NULL; cur_method++) {
                     r.putData<const char*>(cur_method->name);
@@ -143,49 +281,72 @@ bool RPC::call(const char *request, char *reply) {
             }
         }
 
-        /* Look through the methods for the one whose name matches */
-        while (true) {
-            for (; cur_method->name != NULL; cur_method++) {
-                if (strcmp(cur_method->name, args.method_name) == 0) {
-                    (cur_method->method_caller)(p, &args, &r);
-                    return true;
-                }
-            }
-
-            if (cur_method->super != 0) {
-                cur_method = cur_method->super(p);
-            } else {
-                /* end of methods and no match */
-                return false;
-            }
-
+        const rpc_method *m = find_method(p, args.method_name);
+        if (m == NULL) {
+            /* end of methods and no match */
+            return false;
         }
+        (m->method_caller)(p, &args, &r);
+        return true;
     }
 
     /* Then try a class */
-    for (const rpc_class *q = _classes; q != NULL; q = q->next) {
-        if (strcmp(q->name, args.obj_name) == 0) {
-            /* Matched the class name, so get its functions */
-            const rpc_function *cur_func = q->static_functions;
-            if (args.method_name == NULL) {
-                for (; cur_func->name != NULL; cur_func++) {
-                    r.putData<const char*>(cur_func->name);
-                }
-                return true;
-            } else {
-                /* Otherwise call the appropriate function */
-                for (; cur_func->name != NULL; cur_func++) {
-                    if (strcmp(cur_func->name, args.method_name) == 0) {
-                        (cur_func->function_caller)(&args, &r);
-                        return true;
-                    }
+    const rpc_class *q = find_class(args.obj_name, hash(args.obj_name));
+    if (q != NULL) {
+        /* Matched the class name, so get its functions */
+        const rpc_function *cur_func = q->static_functions;
+        if (args.method_name == NULL) {
+            for (; cur_func->name != NULL; cur_func++) {
+                r.putData<const char*>(cur_func->name);
+            }
+            return true;
+        } else {
+            /* Otherwise call the appropriate function */
+            for (; cur_func->name != NULL; cur_func++) {
+                if (strcmp(cur_func->name, args.method_name) == 0) {
+                    (cur_func->function_caller)(&args, &r);
+                    return true;
                 }
-                return false;
             }
+            return false;
         }
     }
 
     return false;
 }
 
+bool RPC::call_binary(const uint8_t *request, uint8_t *reply) {
+    if ((request == NULL) || (request[0] != RPC_BINARY_START)) return false;
+
+    uint32_t length = request[1];
+    uint8_t status = RPC_BINARY_OK;
+    Reply r(&reply[3], RPC_MAX_STRING - 3);
+
+    if ((length < 2) || (length + 2 > RPC_MAX_STRING)) {
+        status = RPC_BINARY_BAD_ARGS;
+    } else if ((request[2] >= RPC_MAX_BINDINGS) ||
+               ((_bindings[request[2]].method_caller == NULL) && (_bindings[request[2]].function_caller == NULL))) {
+        status = RPC_BINARY_BAD_HANDLE;
+    } else {
+        const rpc_binding *b = &_bindings[request[2]];
+        Arguments args(&request[3], length - 1);
+        if (b->method_caller != NULL) {
+            (b->method_caller)(b->obj, &args, &r);
+        } else {
+            (b->function_caller)(&args, &r);
+        }
+        /* The call went ahead with 0 for the missing arguments */
+        if (!args.valid()) {
+            status = RPC_BINARY_BAD_ARGS;
+        } else if (r.truncated()) {
+            status = RPC_BINARY_TRUNCATED;
+        }
+    }
+
+    reply[0] = RPC_BINARY_START;
+    reply[1] = 1 + r.length();
+    reply[2] = status;
+    return true;
+}
+
 } // namespace mbed
@@ -23,6 +23,36 @@ namespace mbed {
 
 #define RPC_MAX_STRING      128
 
+/* Macro RPC_OBJECT_BUCKETS
+ *  Size of the hash table objects are looked up in by name, a power of 2.
+ */
+#ifndef RPC_OBJECT_BUCKETS
+#define RPC_OBJECT_BUCKETS      16
+#endif
+
+/* Macro RPC_METHOD_CACHE_SIZE
+ *  Number of methods remembered once looked up by name, a power of 2.
+ */
+#ifndef RPC_METHOD_CACHE_SIZE
+#define RPC_METHOD_CACHE_SIZE   32
+#endif
+
+/* Macro RPC_MAX_BINDINGS
+ *  Number of methods that can be bound to a handle for binary requests.
+ */
+#ifndef RPC_MAX_BINDINGS
+#define RPC_MAX_BINDINGS        32
+#endif
+
+/* First byte of a binary request or reply, never the '/' of a text request */
+#define RPC_BINARY_START        0xA5
+
+/* Status of a binary reply */
+#define RPC_BINARY_OK           0
+#define RPC_BINARY_BAD_HANDLE   1
+#define RPC_BINARY_BAD_ARGS     2
+#define RPC_BINARY_TRUNCATED    3   /* values that didn't fit were dropped */
+
 struct rpc_function {
     const char *name;
     void (*function_caller)(Arguments*, Reply*);
@@ -32,6 +62,7 @@ struct rpc_class {
     const char *name;
     const rpc_function *static_functions;
     struct rpc_class *next;
+    uint32_t hash;  /* of the name, set by RPC::add_rpc_class */
 };
 
 /* Class RPC
@@ -64,8 +95,53 @@ public:
      */
     virtual const struct rpc_method *get_rpc_methods();
 
+    /* Function call
+     *  Call a method, or list objects, classes or methods, from a text
+     *  request.
+     *
+     * Variables
+     *  buf - the request, e.g. "/led1/write 1"
+     *  result - filled with the reply, RPC_MAX_STRING bytes
+     *  returns - false if the request failed, or if the reply was cut off
+     *            at RPC_MAX_STRING - 1 characters
+     */
     static bool call(const char *buf, char *result);
 
+    /* Function call
+     *  As above, with the values written to result, which may stream
+     *  them out instead of truncating them at RPC_MAX_STRING.
+     */
+    static bool call(const char *buf, Reply *result);
+
+    /* Function bind
+     *  Bind a method of an object, or a static function of a class,
+     *  to a handle for call_binary. Also available as "/RPC/bind obj method".
+     *
+     * Variables
+     *  obj_name - the name of the object or class
+     *  method_name - the name of the method or function
+     *  returns - the handle, -1 if there is no such method or no free handle
+     */
+    static int bind(const char *obj_name, const char *method_name);
+
+    /* Function call_binary
+     *  Call a bound method from a binary request, which skips the name
+     *  lookups and the text conversions of call.
+     *
+     *  Request: RPC_BINARY_START, length of what follows, handle,
+     *           argument count, arguments
+     *  Reply:   RPC_BINARY_START, length of what follows, status, values
+     *
+     *  Arguments and values are little endian: int and PinName on 4
+     *  bytes, float on 4, double on 8, char on 1, strings NUL terminated.
+     *
+     * Variables
+     *  request - the request, up to RPC_MAX_STRING bytes
+     *  reply - filled with the reply, RPC_MAX_STRING bytes
+     *  returns - false if the request is not a binary request
+     */
+    static bool call_binary(const uint8_t *request, uint8_t *reply);
+
     /* Function lookup
      *  Lookup and return the object that has the given name.
      *
@@ -83,6 +159,14 @@ protected:
 private:
     static rpc_class *_classes;
 
+    uint32_t _hash;
+    RPC *_bucket_next;
+
+    static uint32_t hash(const char *name);
+    static rpc_class *find_class(const char *name, uint32_t h);
+    static const rpc_method *find_method(RPC *p, const char *name);
+    static void bind_handle(Arguments *args, Reply *result);
+
     static const rpc_function _RPC_funcs[];
     static rpc_class _RPC_class;
 
@@ -99,6 +183,7 @@ public:
     template<class C>
     static void add_rpc_class() {
         rpc_class *c = C::get_rpc_class();
+        c->hash = hash(c->name);
         c->next = _classes;
         _classes = c;
     }
@@ -21,6 +21,8 @@
  */
 
 #include "rtos_idle.h"
+#include "cmsis_os.h"
+#include "wait_api.h"
 
 static void default_idle_hook(void)
 {
@@ -49,3 +51,18 @@ void rtos_idle_loop(void)
         idle_hook_fptr();
     }
 }
+
+/* Lets wait() and friends block the calling thread instead of spinning.
+ * It replaces the weak default of wait_api.cpp from here, as the idle
+ * thread of RTX links this file into every RTOS program.
+ * With the RTX tick of 1 ms, osDelay(ms) returns between ms - 1 and ms
+ * milliseconds later, so it never runs past the end of the wait. */
+int wait_thread_us(uint32_t us)
+{
+    uint32_t ms = us / 1000;
+    if ((ms == 0) || !osKernelRunning()) {
+        return 0;
+    }
+    // osErrorISR from an interrupt handler, which has to spin
+    return osDelay(ms) == osEventTimeout;
+}
@@ -0,0 +1,90 @@
+#include "mbed.h"
+#include "test_env.h"
+
+#if !DEVICE_ANALOGIN
+  #error [NOT_SUPPORTED] AnalogIn not supported
+#endif
+
+/* Reads A0 in the background at RATE into a double buffer, and plays a duty
+ * cycle sequence on LED1, measuring the jitter of the buffer events and the
+ * CPU time left to the main loop meanwhile. */
+#define RATE            10000
+#define SAMPLES         256
+#define HALVES          40
+#define MAX_JITTER_US   100
+
+AnalogIn in(A0);
+PwmOut led(LED1);
+
+uint16_t samples[SAMPLES];
+float duty[SAMPLES];
+
+Timer timer;
+volatile int halves = 0;
+volatile int last_us = 0;
+volatile int max_jitter_us = 0;
+
+void buffer_event(int event) {
+    int now = timer.read_us();
+    if (halves > 0) {
+        int jitter = now - last_us - (SAMPLES / 2) * 1000000 / RATE;
+        if (jitter < 0) {
+            jitter = -jitter;
+        }
+        if (jitter > max_jitter_us) {
+            max_jitter_us = jitter;
+        }
+    }
+    last_us = now;
+    halves++;
+}
+
+void nothing(int event) {
+}
+
+// Main loop iterations in a fixed time, as a measure of the CPU time left
+int idle_loops(void) {
+    int loops = 0;
+    Timer t;
+    t.start();
+    while (t.read_ms() < 100) {
+        loops++;
+    }
+    return loops;
+}
+
+int load_percent(int idle, int busy) {
+    return (idle - busy) * 100 / idle;
+}
+
+int main() {
+    MBED_HOSTTEST_TIMEOUT(20);
+    MBED_HOSTTEST_SELECT(default_auto);
+    MBED_HOSTTEST_DESCRIPTION(AnalogIn and PwmOut background transfers);
+    MBED_HOSTTEST_START("MBED_A28");
+
+    bool result = true;
+    int idle = idle_loops();
+
+    timer.start();
+    if (in.read_async(samples, SAMPLES, RATE, buffer_event, SAMPLE_EVENT_HALF_COMPLETE | SAMPLE_EVENT_COMPLETE, true) != 0) {
+        printf("Cannot start reading\r\n");
+        MBED_HOSTTEST_RESULT(false);
+    }
+    int reading = idle_loops();
+    while (halves < HALVES);
+    in.abort_read();
+    printf("AnalogIn %d Hz: max jitter %d us, CPU load %d%%\r\n", RATE, max_jitter_us, load_percent(idle, reading));
+    result = result && (max_jitter_us < MAX_JITTER_US);
+
+    for (int i = 0; i < SAMPLES; i++) {
+        duty[i] = (float)i / SAMPLES;
+    }
+    led.period_us(50);
+    led.write_async(duty, SAMPLES, RATE, nothing, SAMPLE_EVENT_COMPLETE, true);
+    int writing = idle_loops();
+    led.abort_write();
+    printf("PwmOut %d Hz: CPU load %d%%\r\n", RATE, load_percent(idle, writing));
+
+    MBED_HOSTTEST_RESULT(result);
+}
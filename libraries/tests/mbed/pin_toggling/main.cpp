@@ -2,13 +2,26 @@
 
 #if defined(TARGET_SAMR21G18A) || defined(TARGET_SAMD21J18A) || defined(TARGET_SAMD21G18A) || defined(TARGET_SAML21J18A)
 DigitalOut out(PB02);
-if defined(TARGET_SAMG55J19)
+#elif defined(TARGET_SAMG55J19)
 DigitalOut out(PA17);
 #else
 DigitalOut out(p5);
 #endif
 
+BusOut bus(LED1, LED2, LED3, LED4);
+
+#define BUS_UPDATES 100000
+
 int main() {
+    // written a port at a time on targets that group the bus pins by port
+    Timer t;
+    t.start();
+    for (int i = 0; i < BUS_UPDATES; i++) {
+        bus = i;
+    }
+    t.stop();
+    printf("BusOut: %d updates/s\r\n", (int)(BUS_UPDATES / t.read()));
+
     while (true) {
         out = 1;
         out = 0;
@@ -0,0 +1,143 @@
+#include "mbed.h"
+#include "FATFileSystem.h"
+#include "BufferedFileHandle.h"
+#include "test_env.h"
+
+namespace {
+const uint32_t SECTORS = 256;   // f_mkfs wants 128 at least
+const int RECORDS = 400;
+const int RECORD_SIZE = 40;
+const char *filename = "/ram/log.txt";
+Timer timer;
+}
+
+/* A FAT volume in RAM, with the sectors only allocated once written, which
+ * counts the sectors read and written */
+class RamFileSystem : public FATFileSystem {
+public:
+    RamFileSystem(const char *name) : FATFileSystem(name), sectors_read(0), sectors_written(0) {
+        memset(sectors, 0, sizeof(sectors));
+    }
+
+    virtual int disk_read(uint8_t *buffer, uint32_t sector, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++, buffer += 512) {
+            if (sectors[sector + i] == NULL) {
+                memset(buffer, 0, 512);
+            } else {
+                memcpy(buffer, sectors[sector + i], 512);
+            }
+        }
+        sectors_read += count;
+        return 0;
+    }
+
+    virtual int disk_write(const uint8_t *buffer, uint32_t sector, uint32_t count) {
+        for (uint32_t i = 0; i < count; i++, buffer += 512) {
+            if (sectors[sector + i] == NULL) {
+                sectors[sector + i] = (uint8_t *)malloc(512);
+                if (sectors[sector + i] == NULL) {
+                    return 1;
+                }
+            }
+            memcpy(sectors[sector + i], buffer, 512);
+        }
+        sectors_written += count;
+        return 0;
+    }
+
+    virtual uint32_t disk_sectors() {
+        return SECTORS;
+    }
+
+    uint32_t sectors_read;
+    uint32_t sectors_written;
+
+private:
+    uint8_t *sectors[SECTORS];
+};
+
+RamFileSystem ram("ram");
+
+void record(char *line, int i) {
+    sprintf(line, "%08d,%08d,%021d\n", i, i * 7, i * 13);
+}
+
+// Writes the records one call each, as a stream with no stdio buffer would, then reads them back
+bool test_records(size_t buffer_size) {
+    char line[RECORD_SIZE + 1], in[RECORD_SIZE + 1];
+    char name[32];
+
+    ram.set_buffer_size(buffer_size);
+    BufferedFileHandle::reset_total_stats();
+    ram.sectors_read = ram.sectors_written = 0;
+
+    FILE *f = fopen(filename, "w");
+    if (f == NULL) {
+        printf("File '%s' not opened\r\n", filename);
+        return false;
+    }
+    setvbuf(f, NULL, _IONBF, 0);
+    timer.reset();
+    timer.start();
+    for (int i = 0; i < RECORDS; i++) {
+        record(line, i);
+        if (fwrite(line, 1, RECORD_SIZE, f) != RECORD_SIZE) {
+            printf("Write error!\r\n");
+            fclose(f);
+            return false;
+        }
+    }
+    fclose(f);
+    timer.stop();
+    int write_us = timer.read_us();
+    uint32_t written = ram.sectors_written;
+
+    f = fopen(filename, "r");
+    if (f == NULL) {
+        printf("File '%s' not opened\r\n", filename);
+        return false;
+    }
+    setvbuf(f, NULL, _IONBF, 0);
+    bool result = true;
+    timer.reset();
+    timer.start();
+    for (int i = 0; i < RECORDS; i++) {
+        record(line, i);
+        if ((fread(in, 1, RECORD_SIZE, f) != RECORD_SIZE) || (memcmp(in, line, RECORD_SIZE) != 0)) {
+            printf("Record %d read back wrong\r\n", i);
+            result = false;
+            break;
+        }
+    }
+    fclose(f);
+    timer.stop();
+    int read_us = timer.read_us();
+
+    const BufferedFileStats &stats = BufferedFileHandle::total_stats();
+    printf("Buffer %4d: %d records written in %d us (%lu sectors), read in %d us (%lu sectors), %lu of %lu calls on the files saved\r\n",
+           (int)buffer_size, RECORDS, write_us, (unsigned long)written, read_us, (unsigned long)ram.sectors_read,
+           (unsigned long)(stats.reads + stats.writes - stats.device_reads - stats.device_writes),
+           (unsigned long)(stats.reads + stats.writes));
+    sprintf(name, "write_records_per_s_%d", (int)buffer_size);
+    notify_performance_coefficient(name, RECORDS * 1000000.0 / (write_us ? write_us : 1));
+    sprintf(name, "read_records_per_s_%d", (int)buffer_size);
+    notify_performance_coefficient(name, RECORDS * 1000000.0 / (read_us ? read_us : 1));
+    return result;
+}
+
+int main() {
+    MBED_HOSTTEST_TIMEOUT(20);
+    MBED_HOSTTEST_SELECT(default_auto);
+    MBED_HOSTTEST_DESCRIPTION(RAM disk buffered FileHandle speed);
+    MBED_HOSTTEST_START("PERF_4");
+
+    bool result = (ram.format() == 0);
+    if (!result) {
+        printf("Format failed\r\n");
+    }
+    const size_t sizes[] = {0, 512, 2048};
+    for (unsigned i = 0; result && (i < sizeof(sizes) / sizeof(sizes[0])); i++) {
+        result = test_records(sizes[i]);
+    }
+    MBED_HOSTTEST_RESULT(result);
+}
@@ -0,0 +1,53 @@
+#include "mbed.h"
+#include "test_env.h"
+
+DigitalOut led(LED1);
+
+namespace {
+    const int WAITS_US[] = {10, 100, 1000, 10000, 100000};
+    const int REPEATS = 10;
+}
+
+void print_char(char c = '*')
+{
+    printf("%c", c);
+    fflush(stdout);
+}
+
+// The worst error of repeated waits, as measured by a Timer
+int wait_error_us(int us)
+{
+    Timer timer;
+    int worst = 0;
+    for (int i = 0; i < REPEATS; i++) {
+        timer.reset();
+        timer.start();
+        wait_us(us);
+        timer.stop();
+        int error = timer.read_us() - us;
+        if (abs(error) > abs(worst)) {
+            worst = error;
+        }
+    }
+    return worst;
+}
+
+int main()
+{
+    MBED_HOSTTEST_TIMEOUT(20);
+    MBED_HOSTTEST_SELECT(wait_us_auto);
+    MBED_HOSTTEST_DESCRIPTION(Wait accuracy);
+    MBED_HOSTTEST_START("MBED_A29");
+
+    for (unsigned i = 0; i < sizeof(WAITS_US) / sizeof(WAITS_US[0]); i++) {
+        char name[32];
+        sprintf(name, "wait_%d_error_us", WAITS_US[i]);
+        notify_performance_coefficient(name, wait_error_us(WAITS_US[i]));
+    }
+
+    while (true) {
+        wait(1.0);
+        led = !led; // Blink
+        print_char();
+    }
+}
@@ -0,0 +1,106 @@
+#include "mbed.h"
+#include "rtos.h"
+#include "EthernetInterface.h"
+#include "lwip/sys.h"
+
+/**
+* Per-call latency of the lwIP socket API, to compare the default message
+* passing mode with LWIP_TCPIP_CORE_LOCKING. Build the library once without
+* and once with -DLWIP_TCPIP_CORE_LOCKING=1 (add -DLWIP_SYS_ARCH_COUNTERS=1
+* to also count blocking waits, i.e. context switches) and compare:
+*
+* make.py -m K64F -t GCC_ARM -n NET_15 -D LWIP_SYS_ARCH_COUNTERS=1
+* make.py -m K64F -t GCC_ARM -n NET_15 -D LWIP_SYS_ARCH_COUNTERS=1 -D LWIP_TCPIP_CORE_LOCKING=1
+*/
+
+namespace {
+    const int DISCARD_PORT = 9;
+    const int CALLS = 1000;
+    const int PAYLOAD_SIZE = 32;
+}
+
+struct call_stats {
+    int mean_us;
+    int max_us;
+#if LWIP_SYS_ARCH_COUNTERS
+    sys_arch_counters_t counters;
+#endif
+};
+
+template <typename F>
+void measure(const char *name, F call) {
+    call_stats stats = {0, 0};
+    Timer timer;
+    int total_us = 0;
+
+#if LWIP_SYS_ARCH_COUNTERS
+    sys_arch_counters_reset();
+#endif
+    timer.start();
+    for (int i = 0; i < CALLS; i++) {
+        const int start = timer.read_us();
+        call();
+        const int duration = timer.read_us() - start;
+        total_us += duration;
+        stats.max_us = duration > stats.max_us ? duration : stats.max_us;
+    }
+    stats.mean_us = total_us / CALLS;
+#if LWIP_SYS_ARCH_COUNTERS
+    sys_arch_counters_get(&stats.counters);
+#endif
+
+    printf("MBED: %-12s mean %4d us  max %5d us", name, stats.mean_us, stats.max_us);
+#if LWIP_SYS_ARCH_COUNTERS
+    // Every blocking wait is a switch away from the caller and back
+    printf("  mbox posts/op %d.%02d  context switches/op %d.%02d",
+           stats.counters.mbox_posts / CALLS, (stats.counters.mbox_posts * 100 / CALLS) % 100,
+           2 * (stats.counters.sem_blocks + stats.counters.mutex_blocks) / CALLS,
+           (2 * (stats.counters.sem_blocks + stats.counters.mutex_blocks) * 100 / CALLS) % 100);
+#endif
+    printf("\r\n");
+}
+
+struct send_call {
+    UDPSocket *socket;
+    Endpoint *remote;
+    char *payload;
+    void operator()() { socket->sendTo(*remote, payload, PAYLOAD_SIZE); }
+};
+
+struct option_call {
+    UDPSocket *socket;
+    void operator()() {
+        int value;
+        socklen_t len = sizeof(value);
+        socket->get_option(SOL_SOCKET, SO_RCVTIMEO, &value, &len);
+    }
+};
+
+int main() {
+    EthernetInterface eth;
+    eth.init(); //Use DHCP
+    eth.connect();
+    printf("MBED: IP Address is %s\r\n", eth.getIPAddress());
+    printf("MBED: LWIP_TCPIP_CORE_LOCKING=%d\r\n", LWIP_TCPIP_CORE_LOCKING);
+
+    UDPSocket socket;
+    socket.init();
+    socket.set_broadcasting();
+
+    // Broadcast needs no ARP resolution, so no peer is required
+    Endpoint broadcast;
+    broadcast.set_address("255.255.255.255", DISCARD_PORT);
+    char payload[PAYLOAD_SIZE] = {0};
+
+    send_call send = { &socket, &broadcast, payload };
+    option_call option = { &socket };
+    measure("sendTo", send);
+    measure("get_option", option);
+
+    socket.close();
+    eth.disconnect();
+    printf("MBED: Done\r\n");
+    while (true) {
+        Thread::wait(1000);
+    }
+}
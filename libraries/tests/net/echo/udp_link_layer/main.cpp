@@ -30,6 +30,51 @@ namespace {
     Mutex cli_serv_mutex;
     // cli_serv_mutex.lock(); // LOCK
     // cli_serv_mutex.unlock(); // LOCK
+
+    // Datagrams/sec benchmark (sendTo vs. sendToBatch)
+    const int BENCH_DATAGRAMS = 1024;
+    const int BENCH_BATCH = 8;
+    const int BENCH_PAYLOAD = 32;
+}
+
+// Returns datagrams per second sent to the HOST using given batch size
+// (batch == 0 means one sendTo() call per datagram)
+int udp_bench(int batch, bool zero_copy)
+{
+    UDPSocket socket;
+    socket.init();
+
+    Endpoint remotes[BENCH_BATCH];
+    char payload[BENCH_BATCH][BENCH_PAYLOAD];
+    char *packets[BENCH_BATCH];
+    int lengths[BENCH_BATCH];
+    for (int i = 0; i < BENCH_BATCH; i++) {
+        remotes[i].set_address(host_address, host_port);
+        memset(payload[i], 'B', BENCH_PAYLOAD);
+        packets[i] = payload[i];
+        lengths[i] = BENCH_PAYLOAD;
+    }
+
+    Timer timer;
+    timer.start();
+    int sent = 0;
+    while (sent < BENCH_DATAGRAMS) {
+        if (batch == 0) {
+            if (socket.sendTo(remotes[0], packets[0], lengths[0]) < 0) {
+                break;
+            }
+            sent++;
+        } else {
+            int n = socket.sendToBatch(remotes, packets, lengths, batch, zero_copy);
+            if (n <= 0) {
+                break;
+            }
+            sent += n;
+        }
+    }
+    timer.stop();
+    socket.close();
+    return timer.read_us() > 0 ? (int)(sent * 1000000LL / timer.read_us()) : 0;
 }
 
 void udp_server_task(void const *argument)
@@ -141,6 +186,13 @@ int main(void)
                                 received_packets, forwarded_packets, max_queue_len);
                         client.send_all(buffer, strlen(buffer));
                         // printf("%s", buffer);
+                    } else if (strncmp(buffer, "bench", 5) == 0 && host_port != 0) {
+                        const int single_dps = udp_bench(0, false);
+                        const int batch_dps = udp_bench(BENCH_BATCH, false);
+                        const int zero_copy_dps = udp_bench(BENCH_BATCH, true);
+                        sprintf(buffer, "single_dps %d\nbatch_dps %d\nbatch_zero_copy_dps %d",
+                                single_dps, batch_dps, zero_copy_dps);
+                        client.send_all(buffer, strlen(buffer));
                     }
                 }
                 //if (n <= 0) break;
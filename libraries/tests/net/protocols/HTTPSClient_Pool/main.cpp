@@ -0,0 +1,125 @@
+#include "mbed.h"
+#include "test_env.h"
+#include "EthernetInterface.h"
+#include "HTTPSClient.h"
+
+namespace {
+    const int SESSIONS = 3;
+    const int ROUNDS = 4;
+    // a few records per response, read in pieces smaller than a record
+    const int BODY_LENGTH = 5000;
+    const int READ_SIZE = 100;
+
+    struct s_ip_address
+    {
+        int ip_1;
+        int ip_2;
+        int ip_3;
+        int ip_4;
+    };
+}
+
+// Reads up to len bytes of the body on a session and counts the bytes that
+// differ from what https_pool_auto serves. Returns the bytes read, -1 on error.
+int read_checked(HTTPSClient *client, int offset, int len, int *corrupt) {
+    char data[READ_SIZE];
+    int n = client->read(data, len < READ_SIZE ? len : READ_SIZE);
+    for (int i = 0; i < n; i++) {
+        if ((uint8_t)data[i] != (uint8_t)((offset + i) * 7 + 3)) {
+            (*corrupt)++;
+        }
+    }
+    return n;
+}
+
+int main() {
+    MBED_HOSTTEST_TIMEOUT(120);
+    MBED_HOSTTEST_SELECT(https_pool_auto);
+    MBED_HOSTTEST_DESCRIPTION(HTTPS sessions sharing the record buffer pool);
+    MBED_HOSTTEST_START("NET_17");
+
+    char host[32] = {0};
+    s_ip_address ip_addr = {0, 0, 0, 0};
+    int port = 0;
+
+    printf("MBED: HTTPSClient waiting for server IP and port...\r\n");
+    scanf("%d.%d.%d.%d:%d", &ip_addr.ip_1, &ip_addr.ip_2, &ip_addr.ip_3, &ip_addr.ip_4, &port);
+    printf("MBED: Address received: %d.%d.%d.%d:%d\r\n", ip_addr.ip_1, ip_addr.ip_2, ip_addr.ip_3, ip_addr.ip_4, port);
+    sprintf(host, "%d.%d.%d.%d", ip_addr.ip_1, ip_addr.ip_2, ip_addr.ip_3, ip_addr.ip_4);
+
+    EthernetInterface eth;
+    eth.init(); //Use DHCP
+    eth.connect();
+    printf("MBED: HTTPSClient IP Address is %s\r\n", eth.getIPAddress());
+
+    bool result = true;
+    HTTPSClient *clients[SESSIONS];
+    for (int s = 0; s < SESSIONS; s++) {
+        clients[s] = new HTTPSClient();
+        if (clients[s]->connect(host, port) < 0) {
+            printf("MBED: session %d unable to connect to %s:%d\r\n", s, host, port);
+            result = false;
+        }
+    }
+
+    char path[16];
+    sprintf(path, "/%d", BODY_LENGTH);
+    int corrupt = 0;
+    int got[SESSIONS];
+    for (int round = 0; round < ROUNDS && result; round++) {
+        // each request goes out while the sessions before it still have
+        // records of their responses to read
+        for (int s = 0; s < SESSIONS && result; s++) {
+            HTTPHeader header = clients[s]->get(path);
+            if (header.getStatusCode() != 200 || header.getBodyLength() != BODY_LENGTH) {
+                printf("MBED: session %d round %d: status %d, length %d\r\n",
+                       s, round, header.getStatusCode(), header.getBodyLength());
+                result = false;
+            }
+            got[s] = 0;
+            for (int i = 0; i <= s && result; i++) {
+                int n = read_checked(clients[i], got[i], BODY_LENGTH - got[i], &corrupt);
+                if (n <= 0) {
+                    result = false;
+                    break;
+                }
+                got[i] += n;
+            }
+        }
+        // then the responses are read round-robin
+        for (bool reading = true; reading && result; ) {
+            reading = false;
+            for (int s = 0; s < SESSIONS && result; s++) {
+                if (got[s] == BODY_LENGTH) {
+                    continue;
+                }
+                int n = read_checked(clients[s], got[s], BODY_LENGTH - got[s], &corrupt);
+                if (n <= 0) {
+                    printf("MBED: session %d round %d: read %d at %d\r\n", s, round, n, got[s]);
+                    result = false;
+                    break;
+                }
+                got[s] += n;
+                reading = true;
+            }
+        }
+    }
+
+    SSL_RECORD_POOL_STATS stats;
+    ssl_record_pool_stats(&stats);
+    printf("MBED: %d sessions, %d bytes corrupt, pool of %d: peak %d, exhausted %d, oversize %d\r\n",
+           SESSIONS, corrupt, stats.size, stats.peak, stats.exhausted, stats.oversize);
+    // the sessions held buffers at the same time, all of them fitted
+    result = result && (corrupt == 0) && (stats.peak >= 2) && (stats.oversize == 0);
+
+    for (int s = 0; s < SESSIONS; s++) {
+        clients[s]->close();
+        delete clients[s];
+    }
+    ssl_record_pool_stats(&stats);
+    printf("MBED: %d buffers in use after close\r\n", stats.in_use);
+    result = result && (stats.in_use == 0);
+
+    eth.disconnect();
+    MBED_HOSTTEST_RESULT(result);
+}
@@ -0,0 +1,95 @@
+#include "mbed.h"
+#include "test_env.h"
+#include "EthernetInterface.h"
+#include "HTTPSClient.h"
+
+namespace {
+    const int HANDSHAKE_LOOPS = 3;
+
+    struct s_ip_address
+    {
+        int ip_1;
+        int ip_2;
+        int ip_3;
+        int ip_4;
+    };
+}
+
+// Connects to the server, fetches the status page and returns the handshake
+// time in ms, or -1 on failure
+int timed_connect(const char *host, int port, bool expect_resumed) {
+    HTTPSClient client;
+    Timer timer;
+
+    timer.start();
+    if (client.connect(host, port) < 0) {
+        printf("MBED: HTTPSClient unable to connect to %s:%d\r\n", host, port);
+        return -1;
+    }
+    timer.stop();
+
+    if (client.is_resumed() != expect_resumed) {
+        printf("MBED: expected a %s handshake\r\n", expect_resumed ? "resumed" : "full");
+        client.close();
+        return -1;
+    }
+
+    char path[] = "/";
+    client.get(path);
+    client.close();
+    return timer.read_ms();
+}
+
+int main() {
+    MBED_HOSTTEST_TIMEOUT(120);
+    MBED_HOSTTEST_SELECT(https_resume_auto);
+    MBED_HOSTTEST_DESCRIPTION(HTTPS client session resumption);
+    MBED_HOSTTEST_START("NET_16");
+
+    char host[32] = {0};
+    s_ip_address ip_addr = {0, 0, 0, 0};
+    int port = 0;
+
+    printf("MBED: HTTPSClient waiting for server IP and port...\r\n");
+    scanf("%d.%d.%d.%d:%d", &ip_addr.ip_1, &ip_addr.ip_2, &ip_addr.ip_3, &ip_addr.ip_4, &port);
+    printf("MBED: Address received: %d.%d.%d.%d:%d\r\n", ip_addr.ip_1, ip_addr.ip_2, ip_addr.ip_3, ip_addr.ip_4, port);
+    sprintf(host, "%d.%d.%d.%d", ip_addr.ip_1, ip_addr.ip_2, ip_addr.ip_3, ip_addr.ip_4);
+
+    EthernetInterface eth;
+    eth.init(); //Use DHCP
+    eth.connect();
+    printf("MBED: HTTPSClient IP Address is %s\r\n", eth.getIPAddress());
+
+    bool result = true;
+
+    // Full handshakes: drop the cached session before each connection
+    for (int i = 0; i < HANDSHAKE_LOOPS && result; i++) {
+        HTTPSSessionCache::clear();
+        int ms = timed_connect(host, port, false);
+        if (ms < 0) {
+            result = false;
+            break;
+        }
+        printf("MBED: full handshake %d ms\r\n", ms);
+    }
+
+    // Resumed handshakes: the session stored by the last full handshake is
+    // reused by every new HTTPSClient instance
+    for (int i = 0; i < HANDSHAKE_LOOPS && result; i++) {
+        int ms = timed_connect(host, port, true);
+        if (ms < 0) {
+            result = false;
+            break;
+        }
+        printf("MBED: resumed handshake %d ms\r\n", ms);
+    }
+
+    HTTPSSessionCache::Stats stats;
+    HTTPSSessionCache::get_stats(&stats);
+    printf("MBED: session cache hits %lu, misses %lu, stores %lu, evictions %lu\r\n",
+           (unsigned long)stats.hits, (unsigned long)stats.misses,
+           (unsigned long)stats.stores, (unsigned long)stats.evictions);
+
+    eth.disconnect();
+    MBED_HOSTTEST_RESULT(result);
+}
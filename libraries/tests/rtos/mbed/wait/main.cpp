@@ -0,0 +1,79 @@
+#include "mbed.h"
+#include "test_env.h"
+#include "rtos.h"
+
+#if (defined(TARGET_STM32L053R8) || defined(TARGET_STM32L053C8)) && defined(TOOLCHAIN_GCC)
+#define STACK_SIZE DEFAULT_STACK_SIZE/2
+#elif (defined(TARGET_STM32F030R8) || defined(TARGET_STM32F070RB)) && defined(TOOLCHAIN_GCC)
+#define STACK_SIZE DEFAULT_STACK_SIZE/2
+#elif (defined(TARGET_STM32F030R8)) && defined(TOOLCHAIN_IAR)
+#define STACK_SIZE DEFAULT_STACK_SIZE/2
+#else
+#define STACK_SIZE DEFAULT_STACK_SIZE
+#endif
+
+namespace {
+    const int WAITS_US[] = {100, 1000, 10000, 100000};
+    const int REPEATS = 10;
+}
+
+DigitalOut led(LED1);
+
+// Counts in whatever CPU time the waits of the main thread leave
+volatile uint32_t counter = 0;
+
+void background_thread(void const *argument) {
+    while (true) {
+        counter++;
+    }
+}
+
+void print_char(char c = '*') {
+    printf("%c", c);
+    fflush(stdout);
+}
+
+int main() {
+    MBED_HOSTTEST_TIMEOUT(25);
+    MBED_HOSTTEST_SELECT(wait_us_auto);
+    MBED_HOSTTEST_DESCRIPTION(Wait CPU availability);
+    MBED_HOSTTEST_START("RTOS_10");
+
+    Thread thread(background_thread, NULL, osPriorityLow, STACK_SIZE);
+
+    // What the background thread counts in a second with the CPU to itself
+    Timer timer;
+    timer.start();
+    uint32_t count = counter;
+    Thread::wait(1000);
+    float counts_per_us = (float)(counter - count) / timer.read_us();
+
+    for (unsigned i = 0; i < sizeof(WAITS_US) / sizeof(WAITS_US[0]); i++) {
+        int us = WAITS_US[i];
+        int worst = 0;
+        int total = 0;
+        count = counter;
+        for (int j = 0; j < REPEATS; j++) {
+            timer.reset();
+            wait_us(us);
+            int elapsed = timer.read_us();
+            total += elapsed;
+            if (abs(elapsed - us) > abs(worst)) {
+                worst = elapsed - us;
+            }
+        }
+        float cpu_pct = 100.0f * (counter - count) / (counts_per_us * total);
+
+        char name[32];
+        sprintf(name, "wait_%d_error_us", us);
+        notify_performance_coefficient(name, worst);
+        sprintf(name, "wait_%d_cpu_pct", us);
+        notify_performance_coefficient(name, (double)cpu_pct);
+    }
+
+    while (true) {
+        wait_ms(1000);
+        led = !led; // Blink
+        print_char();
+    }
+}
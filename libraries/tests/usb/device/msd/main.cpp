@@ -0,0 +1,63 @@
+#include "mbed.h"
+#include "test_env.h"
+#include "USBMSD.h"
+
+#define RAM_DISK_BLOCKS     16
+#define RAM_DISK_BLOCK_SIZE 512
+
+// Mass storage device backed by RAM, for the host to replay SCSI commands against
+class USBMSD_RAM: public USBMSD {
+public:
+    USBMSD_RAM(): USBMSD(0x0703, 0x0105) {
+        memset(disk, 0, sizeof(disk));
+    }
+
+protected:
+    virtual int disk_read(uint8_t* data, uint64_t block, uint8_t count) {
+        memcpy(data, &disk[block * RAM_DISK_BLOCK_SIZE], count * RAM_DISK_BLOCK_SIZE);
+        return 0;
+    }
+
+    virtual int disk_write(const uint8_t* data, uint64_t block, uint8_t count) {
+        memcpy(&disk[block * RAM_DISK_BLOCK_SIZE], data, count * RAM_DISK_BLOCK_SIZE);
+        return 0;
+    }
+
+    virtual int disk_initialize() { return 0; }
+    virtual uint64_t disk_sectors() { return RAM_DISK_BLOCKS; }
+    virtual uint64_t disk_size() { return RAM_DISK_BLOCKS * RAM_DISK_BLOCK_SIZE; }
+    virtual int disk_status() { return 0; }
+
+private:
+    uint8_t disk[RAM_DISK_BLOCKS * RAM_DISK_BLOCK_SIZE];
+};
+
+USBMSD_RAM msd;
+Serial pc(USBTX, USBRX);
+
+int main() {
+    MBED_HOSTTEST_TIMEOUT(60);
+    MBED_HOSTTEST_SELECT(usb_msd_replay_auto);
+    MBED_HOSTTEST_DESCRIPTION(USB mass storage SCSI replay);
+    MBED_HOSTTEST_START("USB_8");
+
+    msd.deferDiskAccess(true);
+    if (!msd.connect(false)) {
+        printf("MBED: USB MSD connect failed\r\n");
+        MBED_HOSTTEST_RESULT(false);
+    }
+    printf("MBED: USB MSD ready\r\n");
+
+    while (true) {
+        msd.process();
+
+        // the host asks for the counters once it is done
+        if (pc.readable() && (pc.getc() == 's')) {
+            USBMSD::Stats stats;
+            msd.getStats(&stats);
+            printf("MBED: stats read %lu written %lu disk_reads %lu disk_writes %lu blocks_read %lu blocks_written %lu hits %lu stalls %lu\r\n",
+                   stats.bytes_read, stats.bytes_written, stats.disk_reads, stats.disk_writes,
+                   stats.blocks_read, stats.blocks_written, stats.read_ahead_hits, stats.stalls);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#include "mbed.h"
+#include "test_env.h"
+#include "USBSerial.h"
+
+// Commands from the host: a byte followed by a 32 bit little endian length
+#define CMD_STREAM  'S'     // send length bytes of the test pattern
+#define CMD_ECHO    'E'     // receive length bytes and send them back
+
+USBSerial serial(0x1f00, 0x2012, 0x0001, false);
+
+static uint8_t pattern(uint32_t i) {
+    return (i * 7 + 3) & 0xff;
+}
+
+static void stream(uint32_t length) {
+    uint8_t block[256];
+    uint32_t sent = 0;
+
+    while (sent < length) {
+        uint32_t n = length - sent;
+        if (n > sizeof(block))
+            n = sizeof(block);
+        for (uint32_t i = 0; i < n; i++)
+            block[i] = pattern(sent + i);
+        if (serial.write(block, n) != (ssize_t)n)
+            return;
+        sent += n;
+    }
+}
+
+static void echo(uint32_t length) {
+    // smaller than the receive buffer so that the host gets held off in between
+    uint8_t block[100];
+    uint32_t done = 0;
+
+    while (done < length) {
+        uint32_t n = length - done;
+        if (n > sizeof(block))
+            n = sizeof(block);
+        serial.read(block, n);
+        if (serial.write(block, n) != (ssize_t)n)
+            return;
+        done += n;
+    }
+}
+
+int main() {
+    MBED_HOSTTEST_TIMEOUT(60);
+    MBED_HOSTTEST_SELECT(usb_serial_throughput_auto);
+    MBED_HOSTTEST_DESCRIPTION(USB serial throughput);
+    MBED_HOSTTEST_START("USB_9");
+
+    printf("MBED: USB serial ready\r\n");
+
+    while (true) {
+        uint8_t cmd[5];
+        serial.read(cmd, sizeof(cmd));
+        uint32_t length = cmd[1] | (cmd[2] << 8) | (cmd[3] << 16) | ((uint32_t)cmd[4] << 24);
+
+        switch (cmd[0]) {
+            case CMD_STREAM:
+                stream(length);
+                break;
+            case CMD_ECHO:
+                echo(length);
+                break;
+            default:
+                break;
+        }
+    }
+}
@@ -0,0 +1,470 @@
+/* Known answer tests for the axTLS AES code: FIPS-197 appendix C for the
+ * block cipher, SP 800-38A F.2.1 and F.5.1 for CBC and CTR, and test cases
+ * 1, 4, 6 and 16 of the GCM specification (McGrew and Viega) for AES-GCM.
+ * The same vectors must pass with and without CONFIG_AES_CONSTANT_TIME.
+ * AES_speed prints the MB/s of CBC, CBC with HMAC-SHA1 as the TLS 1.0
+ * suites do, CTR and GCM, so that the modes can be compared. */
+#include "TestHarness.h"
+#include <stdio.h>
+#include <string.h>
+#include "axTLS/ssl/os_port.h"
+#include "axTLS/crypto/crypto.h"
+
+#ifdef __MBED__
+#include "mbed.h"
+#else
+#include <time.h>
+#endif
+
+namespace {
+
+// records of the largest TLS fragment this build takes, or bigger on the host
+#ifdef __MBED__
+const int SPEED_LENGTH = 2048;
+const int SPEED_BYTES = 256 * 1024;
+#else
+const int SPEED_LENGTH = 16384;
+const int SPEED_BYTES = 64 * 1024 * 1024;
+#endif
+
+#ifdef __MBED__
+Timer timer;
+
+void timer_start() {
+    timer.reset();
+    timer.start();
+}
+
+int timer_us() {
+    return timer.read_us();
+}
+#else
+clock_t started;
+
+void timer_start() {
+    started = clock();
+}
+
+int timer_us() {
+    return (int)((clock() - started) * 1000000LL / CLOCKS_PER_SEC);
+}
+#endif
+
+static const uint8_t fips_key_128[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+    0x0c, 0x0d, 0x0e, 0x0f,
+};
+
+static const uint8_t fips_key_256[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+    0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+};
+
+static const uint8_t fips_plain[] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb,
+    0xcc, 0xdd, 0xee, 0xff,
+};
+
+static const uint8_t fips_cipher_128[] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80,
+    0x70, 0xb4, 0xc5, 0x5a,
+};
+
+static const uint8_t fips_cipher_256[] = {
+    0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90,
+    0x4b, 0x49, 0x60, 0x89,
+};
+
+static const uint8_t sp_key[] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88,
+    0x09, 0xcf, 0x4f, 0x3c,
+};
+
+static const uint8_t sp_plain[] = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11,
+    0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+    0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51, 0x30, 0xc8, 0x1c, 0x46,
+    0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b,
+    0xe6, 0x6c, 0x37, 0x10,
+};
+
+static const uint8_t sp_cbc_iv[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+    0x0c, 0x0d, 0x0e, 0x0f,
+};
+
+static const uint8_t sp_cbc_cipher[] = {
+    0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b,
+    0x12, 0xe9, 0x19, 0x7d, 0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee,
+    0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2, 0x73, 0xbe, 0xd6, 0xb8,
+    0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16,
+    0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac, 0x09, 0x12, 0x0e, 0xca, 0x30,
+    0x75, 0x86, 0xe1, 0xa7,
+};
+
+static const uint8_t sp_ctr_iv[] = {
+    0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb,
+    0xfc, 0xfd, 0xfe, 0xff,
+};
+
+static const uint8_t sp_ctr_cipher[] = {
+    0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68, 0x64,
+    0x99, 0x0d, 0xb6, 0xce, 0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff,
+    0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff, 0x5a, 0xe4, 0xdf, 0x3e,
+    0xdb, 0xd5, 0xd3, 0x5e, 0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+    0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1, 0x79, 0x21, 0x70, 0xa0,
+    0xf3, 0x00, 0x9c, 0xee,
+};
+
+static const uint8_t gcm_key_128[] = {
+    0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c, 0x6d, 0x6a, 0x8f, 0x94,
+    0x67, 0x30, 0x83, 0x08,
+};
+
+static const uint8_t gcm_key_256[] = {
+    0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c, 0x6d, 0x6a, 0x8f, 0x94,
+    0x67, 0x30, 0x83, 0x08, 0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+    0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+};
+
+static const uint8_t gcm_iv[] = {
+    0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad, 0xde, 0xca, 0xf8, 0x88,
+};
+
+static const uint8_t gcm_iv_60[] = {
+    0x93, 0x13, 0x22, 0x5d, 0xf8, 0x84, 0x06, 0xe5, 0x55, 0x90, 0x9c, 0x5a,
+    0xff, 0x52, 0x69, 0xaa, 0x6a, 0x7a, 0x95, 0x38, 0x53, 0x4f, 0x7d, 0xa1,
+    0xe4, 0xc3, 0x03, 0xd2, 0xa3, 0x18, 0xa7, 0x28, 0xc3, 0xc0, 0xc9, 0x51,
+    0x56, 0x80, 0x95, 0x39, 0xfc, 0xf0, 0xe2, 0x42, 0x9a, 0x6b, 0x52, 0x54,
+    0x16, 0xae, 0xdb, 0xf5, 0xa0, 0xde, 0x6a, 0x57, 0xa6, 0x37, 0xb3, 0x9b,
+};
+
+static const uint8_t gcm_aad[] = {
+    0xfe, 0xed, 0xfa, 0xce, 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce,
+    0xde, 0xad, 0xbe, 0xef, 0xab, 0xad, 0xda, 0xd2,
+};
+
+static const uint8_t gcm_plain[] = {
+    0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5, 0xa5, 0x59, 0x09, 0xc5,
+    0xaf, 0xf5, 0x26, 0x9a, 0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda,
+    0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72, 0x1c, 0x3c, 0x0c, 0x95,
+    0x95, 0x68, 0x09, 0x53, 0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+    0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57, 0xba, 0x63, 0x7b, 0x39,
+};
+
+static const uint8_t gcm_cipher_4[] = {
+    0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24, 0x4b, 0x72, 0x21, 0xb7,
+    0x84, 0xd0, 0xd4, 0x9c, 0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0,
+    0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e, 0x21, 0xd5, 0x14, 0xb2,
+    0x54, 0x66, 0x93, 0x1c, 0x7d, 0x8f, 0x6a, 0x5a, 0xac, 0x84, 0xaa, 0x05,
+    0x1b, 0xa3, 0x0b, 0x39, 0x6a, 0x0a, 0xac, 0x97, 0x3d, 0x58, 0xe0, 0x91,
+};
+
+static const uint8_t gcm_tag_4[] = {
+    0x5b, 0xc9, 0x4f, 0xbc, 0x32, 0x21, 0xa5, 0xdb, 0x94, 0xfa, 0xe9, 0x5a,
+    0xe7, 0x12, 0x1a, 0x47,
+};
+
+static const uint8_t gcm_cipher_6[] = {
+    0x8c, 0xe2, 0x49, 0x98, 0x62, 0x56, 0x15, 0xb6, 0x03, 0xa0, 0x33, 0xac,
+    0xa1, 0x3f, 0xb8, 0x94, 0xbe, 0x91, 0x12, 0xa5, 0xc3, 0xa2, 0x11, 0xa8,
+    0xba, 0x26, 0x2a, 0x3c, 0xca, 0x7e, 0x2c, 0xa7, 0x01, 0xe4, 0xa9, 0xa4,
+    0xfb, 0xa4, 0x3c, 0x90, 0xcc, 0xdc, 0xb2, 0x81, 0xd4, 0x8c, 0x7c, 0x6f,
+    0xd6, 0x28, 0x75, 0xd2, 0xac, 0xa4, 0x17, 0x03, 0x4c, 0x34, 0xae, 0xe5,
+};
+
+static const uint8_t gcm_tag_6[] = {
+    0x61, 0x9c, 0xc5, 0xae, 0xff, 0xfe, 0x0b, 0xfa, 0x46, 0x2a, 0xf4, 0x3c,
+    0x16, 0x99, 0xd0, 0x50,
+};
+
+static const uint8_t gcm_cipher_16[] = {
+    0x52, 0x2d, 0xc1, 0xf0, 0x99, 0x56, 0x7d, 0x07, 0xf4, 0x7f, 0x37, 0xa3,
+    0x2a, 0x84, 0x42, 0x7d, 0x64, 0x3a, 0x8c, 0xdc, 0xbf, 0xe5, 0xc0, 0xc9,
+    0x75, 0x98, 0xa2, 0xbd, 0x25, 0x55, 0xd1, 0xaa, 0x8c, 0xb0, 0x8e, 0x48,
+    0x59, 0x0d, 0xbb, 0x3d, 0xa7, 0xb0, 0x8b, 0x10, 0x56, 0x82, 0x88, 0x38,
+    0xc5, 0xf6, 0x1e, 0x63, 0x93, 0xba, 0x7a, 0x0a, 0xbc, 0xc9, 0xf6, 0x62,
+};
+
+static const uint8_t gcm_tag_16[] = {
+    0x76, 0xfc, 0x6e, 0xce, 0x0f, 0x4e, 0x17, 0x68, 0xcd, 0xdf, 0x88, 0x53,
+    0xbb, 0x2d, 0x55, 0x1b,
+};
+
+static const uint8_t gcm_tag_zero[] = {
+    0x58, 0xe2, 0xfc, 0xce, 0xfa, 0x7e, 0x30, 0x61, 0x36, 0x7f, 0x1d, 0x57,
+    0xa4, 0xe7, 0x45, 0x5a,
+};
+
+}
+
+TEST_GROUP(AES_block)
+{
+    AES_CTX ctx;
+    uint8_t iv[AES_IV_SIZE];
+
+    void setup()
+    {
+        memset(iv, 0, sizeof(iv));
+    }
+};
+
+TEST(AES_block, encrypt_128)
+{
+    uint8_t out[AES_BLOCKSIZE];
+    AES_set_key(&ctx, fips_key_128, iv, AES_MODE_128);
+    AES_cbc_encrypt(&ctx, fips_plain, out, sizeof(out));
+    MEMCMP_EQUAL(fips_cipher_128, out, sizeof(out));
+}
+
+TEST(AES_block, decrypt_128)
+{
+    uint8_t out[AES_BLOCKSIZE];
+    AES_set_key(&ctx, fips_key_128, iv, AES_MODE_128);
+    AES_convert_key(&ctx);
+    AES_cbc_decrypt(&ctx, fips_cipher_128, out, sizeof(out));
+    MEMCMP_EQUAL(fips_plain, out, sizeof(out));
+}
+
+TEST(AES_block, encrypt_256)
+{
+    uint8_t out[AES_BLOCKSIZE];
+    AES_set_key(&ctx, fips_key_256, iv, AES_MODE_256);
+    AES_cbc_encrypt(&ctx, fips_plain, out, sizeof(out));
+    MEMCMP_EQUAL(fips_cipher_256, out, sizeof(out));
+}
+
+TEST(AES_block, decrypt_256)
+{
+    uint8_t out[AES_BLOCKSIZE];
+    AES_set_key(&ctx, fips_key_256, iv, AES_MODE_256);
+    AES_convert_key(&ctx);
+    AES_cbc_decrypt(&ctx, fips_cipher_256, out, sizeof(out));
+    MEMCMP_EQUAL(fips_plain, out, sizeof(out));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_GROUP(AES_modes)
+{
+    AES_CTX ctx;
+};
+
+TEST(AES_modes, cbc_encrypt_chains_iv)
+{
+    uint8_t out[sizeof(sp_plain)];
+    AES_set_key(&ctx, sp_key, sp_cbc_iv, AES_MODE_128);
+    AES_cbc_encrypt(&ctx, sp_plain, out, 32);
+    AES_cbc_encrypt(&ctx, sp_plain + 32, out + 32, 32);
+    MEMCMP_EQUAL(sp_cbc_cipher, out, sizeof(out));
+}
+
+TEST(AES_modes, cbc_decrypt)
+{
+    uint8_t out[sizeof(sp_cbc_cipher)];
+    AES_set_key(&ctx, sp_key, sp_cbc_iv, AES_MODE_128);
+    AES_convert_key(&ctx);
+    AES_cbc_decrypt(&ctx, sp_cbc_cipher, out, sizeof(out));
+    MEMCMP_EQUAL(sp_plain, out, sizeof(out));
+}
+
+TEST(AES_modes, ctr_encrypt_chains_counter)
+{
+    uint8_t out[sizeof(sp_plain)];
+    AES_set_key(&ctx, sp_key, sp_ctr_iv, AES_MODE_128);
+    AES_ctr_encrypt(&ctx, sp_plain, out, 16);
+    AES_ctr_encrypt(&ctx, sp_plain + 16, out + 16, 48);
+    MEMCMP_EQUAL(sp_ctr_cipher, out, sizeof(out));
+}
+
+TEST(AES_modes, ctr_partial_block)
+{
+    uint8_t out[sizeof(sp_ctr_cipher)];
+    AES_set_key(&ctx, sp_key, sp_ctr_iv, AES_MODE_128);
+    AES_ctr_encrypt(&ctx, sp_ctr_cipher, out, 37);
+    MEMCMP_EQUAL(sp_plain, out, 37);
+}
+
+TEST(AES_modes, ctr_counter_carries)
+{
+    const uint8_t ctr[AES_IV_SIZE] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    };
+    const uint8_t next[AES_IV_SIZE] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    };
+    uint8_t out[AES_BLOCKSIZE];
+    AES_set_key(&ctx, sp_key, ctr, AES_MODE_128);
+    AES_ctr_encrypt(&ctx, sp_plain, out, sizeof(out));
+    MEMCMP_EQUAL(next, ctx.iv, AES_IV_SIZE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_GROUP(AES_GCM)
+{
+    AES_GCM_CTX ctx;
+    uint8_t out[sizeof(gcm_plain)];
+    uint8_t tag[AES_GCM_TAG_SIZE];
+};
+
+TEST(AES_GCM, empty_message)
+{
+    const uint8_t key[16] = { 0 };
+    const uint8_t iv[12] = { 0 };
+    AES_GCM_set_key(&ctx, key, AES_MODE_128);
+    AES_GCM_encrypt(&ctx, iv, sizeof(iv), NULL, 0, NULL, NULL, 0, tag);
+    MEMCMP_EQUAL(gcm_tag_zero, tag, sizeof(tag));
+}
+
+TEST(AES_GCM, encrypt_128)
+{
+    AES_GCM_set_key(&ctx, gcm_key_128, AES_MODE_128);
+    AES_GCM_encrypt(&ctx, gcm_iv, sizeof(gcm_iv), gcm_aad, sizeof(gcm_aad),
+                    gcm_plain, out, sizeof(gcm_plain), tag);
+    MEMCMP_EQUAL(gcm_cipher_4, out, sizeof(out));
+    MEMCMP_EQUAL(gcm_tag_4, tag, sizeof(tag));
+}
+
+TEST(AES_GCM, encrypt_long_iv)
+{
+    AES_GCM_set_key(&ctx, gcm_key_128, AES_MODE_128);
+    AES_GCM_encrypt(&ctx, gcm_iv_60, sizeof(gcm_iv_60), gcm_aad, sizeof(gcm_aad),
+                    gcm_plain, out, sizeof(gcm_plain), tag);
+    MEMCMP_EQUAL(gcm_cipher_6, out, sizeof(out));
+    MEMCMP_EQUAL(gcm_tag_6, tag, sizeof(tag));
+}
+
+TEST(AES_GCM, encrypt_256)
+{
+    AES_GCM_set_key(&ctx, gcm_key_256, AES_MODE_256);
+    AES_GCM_encrypt(&ctx, gcm_iv, sizeof(gcm_iv), gcm_aad, sizeof(gcm_aad),
+                    gcm_plain, out, sizeof(gcm_plain), tag);
+    MEMCMP_EQUAL(gcm_cipher_16, out, sizeof(out));
+    MEMCMP_EQUAL(gcm_tag_16, tag, sizeof(tag));
+}
+
+TEST(AES_GCM, decrypt)
+{
+    AES_GCM_set_key(&ctx, gcm_key_128, AES_MODE_128);
+    LONGS_EQUAL(0, AES_GCM_decrypt(&ctx, gcm_iv, sizeof(gcm_iv), gcm_aad, sizeof(gcm_aad),
+                                   gcm_cipher_4, out, sizeof(gcm_cipher_4), gcm_tag_4));
+    MEMCMP_EQUAL(gcm_plain, out, sizeof(out));
+}
+
+TEST(AES_GCM, decrypt_rejects_bad_tag)
+{
+    memcpy(tag, gcm_tag_4, sizeof(tag));
+    tag[AES_GCM_TAG_SIZE-1] ^= 0x01;
+    memset(out, 0, sizeof(out));
+
+    AES_GCM_set_key(&ctx, gcm_key_128, AES_MODE_128);
+    LONGS_EQUAL(-1, AES_GCM_decrypt(&ctx, gcm_iv, sizeof(gcm_iv), gcm_aad, sizeof(gcm_aad),
+                                    gcm_cipher_4, out, sizeof(gcm_cipher_4), tag));
+
+    // Nothing is decrypted when the tag doesn't match
+    const uint8_t zero[sizeof(out)] = { 0 };
+    MEMCMP_EQUAL(zero, out, sizeof(out));
+}
+
+TEST(AES_GCM, decrypt_rejects_modified_aad)
+{
+    uint8_t aad[sizeof(gcm_aad)];
+    memcpy(aad, gcm_aad, sizeof(aad));
+    aad[0] ^= 0x80;
+
+    AES_GCM_set_key(&ctx, gcm_key_128, AES_MODE_128);
+    LONGS_EQUAL(-1, AES_GCM_decrypt(&ctx, gcm_iv, sizeof(gcm_iv), aad, sizeof(aad),
+                                    gcm_cipher_4, out, sizeof(gcm_cipher_4), gcm_tag_4));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_GROUP(AES_speed)
+{
+    uint8_t *in;
+    uint8_t *out;
+    uint8_t iv[AES_IV_SIZE];
+
+    void setup()
+    {
+        in = new uint8_t[SPEED_LENGTH];
+        out = new uint8_t[SPEED_LENGTH];
+        for (int i = 0; i < SPEED_LENGTH; i++) {
+            in[i] = (uint8_t)(i * 13 + 1);
+        }
+        memset(iv, 0, sizeof(iv));
+    }
+
+    void teardown()
+    {
+        delete[] in;
+        delete[] out;
+    }
+
+    void report(const char *mode, int us)
+    {
+        // bytes per microsecond are MB/s, kept in thousandths
+        int mb_per_s = (int)((long long)SPEED_BYTES * 1000 / (us ? us : 1));
+        printf("%-16s %d.%02d MB/s\r\n", mode, mb_per_s / 1000, mb_per_s % 1000 / 10);
+    }
+};
+
+TEST(AES_speed, modes)
+{
+    const int records = SPEED_BYTES / SPEED_LENGTH;
+    uint8_t digest[SHA1_SIZE];
+    uint8_t tag[AES_GCM_TAG_SIZE];
+    AES_CTX ctx;
+    AES_GCM_CTX *gcm = new AES_GCM_CTX;
+
+    printf("AES-128 over %d byte records:\r\n", SPEED_LENGTH);
+
+    AES_set_key(&ctx, sp_key, iv, AES_MODE_128);
+    timer_start();
+    for (int i = 0; i < records; i++) {
+        AES_cbc_encrypt(&ctx, in, out, SPEED_LENGTH);
+    }
+    report("CBC encrypt", timer_us());
+
+    AES_convert_key(&ctx);
+    timer_start();
+    for (int i = 0; i < records; i++) {
+        AES_cbc_decrypt(&ctx, in, out, SPEED_LENGTH);
+    }
+    report("CBC decrypt", timer_us());
+
+    // what a record of the AES128-SHA suites costs
+    AES_set_key(&ctx, sp_key, iv, AES_MODE_128);
+    timer_start();
+    for (int i = 0; i < records; i++) {
+        hmac_sha1(in, SPEED_LENGTH, sp_key, SHA1_SIZE, digest);
+        AES_cbc_encrypt(&ctx, in, out, SPEED_LENGTH);
+    }
+    report("CBC + HMAC-SHA1", timer_us());
+
+    AES_set_key(&ctx, sp_key, sp_ctr_iv, AES_MODE_128);
+    timer_start();
+    for (int i = 0; i < records; i++) {
+        AES_ctr_encrypt(&ctx, in, out, SPEED_LENGTH);
+    }
+    report("CTR", timer_us());
+
+    AES_GCM_set_key(gcm, gcm_key_128, AES_MODE_128);
+    timer_start();
+    for (int i = 0; i < records; i++) {
+        AES_GCM_encrypt(gcm, gcm_iv, sizeof(gcm_iv), gcm_aad, sizeof(gcm_aad),
+                        in, out, SPEED_LENGTH, tag);
+    }
+    report("GCM", timer_us());
+
+    // the last record still decrypts, so the loops weren't optimized away
+    LONGS_EQUAL(0, AES_GCM_decrypt(gcm, gcm_iv, sizeof(gcm_iv), gcm_aad, sizeof(gcm_aad),
+                                   out, out, SPEED_LENGTH, tag));
+    MEMCMP_EQUAL(in, out, SPEED_LENGTH);
+    delete gcm;
+}
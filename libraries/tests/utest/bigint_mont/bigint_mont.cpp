@@ -0,0 +1,352 @@
+/* Checks the fixed-size Montgomery engine (bigint_mont.c) against known
+ * answers and against the generic bigint code. The test vectors were
+ * generated with Python's pow(). Nothing here is mbed specific, so the same
+ * file also runs under CppUTest on a host build of axTLS. */
+#include "TestHarness.h"
+#include <string.h>
+#include "axTLS/ssl/os_port.h"
+#include "axTLS/crypto/crypto.h"
+#include "axTLS/crypto/bigint_mont.h"
+
+namespace {
+
+static const uint8_t mod_64_64[] = {
+    0x93, 0xb6, 0x4b, 0x22, 0xba, 0x0f, 0xbc, 0x6d,
+};
+
+static const uint8_t base_64_64[] = {
+    0xa6, 0x4f, 0xad, 0xaf, 0xa3, 0xe5, 0x99, 0x36,
+};
+
+static const uint8_t exp_64_64[] = {
+    0x0a, 0x5f, 0x72, 0x2a, 0xfa, 0xba, 0xf0, 0x05,
+};
+
+static const uint8_t res_64_64[] = {
+    0x61, 0x06, 0x3d, 0x7b, 0x5e, 0xe8, 0x37, 0x08,
+};
+
+static const uint8_t mod_521_521[] = {
+    0x01, 0x7e, 0x6e, 0x95, 0x6d, 0xfb, 0x98, 0xbb, 0xfb, 0x49, 0xd9, 0x84,
+    0xa7, 0xb4, 0xb7, 0x45, 0x80, 0x60, 0x22, 0xbf, 0xa0, 0x62, 0xed, 0xa1,
+    0x03, 0x7e, 0xc4, 0x3d, 0x1a, 0x26, 0x6b, 0x99, 0x3f, 0xd1, 0x83, 0x0a,
+    0x8c, 0x89, 0xa7, 0x51, 0xc0, 0xb5, 0xcc, 0x27, 0x02, 0xf7, 0x16, 0xe3,
+    0x9b, 0xf2, 0xba, 0xe0, 0xb1, 0x51, 0xa3, 0xd7, 0x8d, 0xc9, 0xbe, 0xe0,
+    0x0e, 0xcb, 0x21, 0x7a, 0xe5, 0xe3,
+};
+
+static const uint8_t base_521_521[] = {
+    0x79, 0xf0, 0xad, 0xee, 0x37, 0x03, 0x6b, 0x3f, 0x29, 0xb7, 0x1f, 0x24,
+    0x9a, 0x0c, 0x26, 0x35, 0xbd, 0x62, 0x3d, 0x5a, 0x58, 0x4c, 0x03, 0xcc,
+    0x34, 0x47, 0xe2, 0x68, 0x81, 0x66, 0x49, 0x12, 0x90, 0x0e, 0xa3, 0x6b,
+    0x57, 0x71, 0x8c, 0x12, 0x13, 0xce, 0x65, 0x7c, 0x3b, 0x19, 0x1e, 0xaf,
+    0x03, 0x08, 0x64, 0x11, 0xf6, 0x93, 0xe7, 0xd2, 0xa1, 0x8d, 0x75, 0x3b,
+    0xf3, 0x57, 0xeb, 0x64, 0x29, 0xa6, 0x89, 0x81, 0x69, 0xda, 0xc3, 0x50,
+    0x57, 0x8a, 0xa2, 0x4e, 0x82, 0xac, 0xdd, 0x8c, 0xa7, 0x11, 0xe6, 0xd8,
+    0xd6, 0x16, 0xa9, 0x87, 0xc3, 0x32, 0x9a, 0x08, 0x5d, 0x11, 0x03, 0xbf,
+    0x3d, 0xe2, 0x4b, 0x5e, 0x12, 0xd8, 0xeb, 0x45, 0xcf, 0x44, 0x1d, 0x8f,
+    0x26, 0x76, 0x83, 0x3e, 0x82, 0xe0, 0xa3, 0xd8, 0x56, 0x03, 0x91, 0x91,
+    0x4f, 0x30, 0x08, 0x07, 0xd9, 0xc8, 0x59, 0x1f, 0xa0, 0xb8,
+};
+
+static const uint8_t exp_521_521[] = {
+    0x37, 0x9e, 0x80, 0x5a, 0xf9, 0xe6, 0x04, 0x82, 0x2d, 0xaf, 0xc4, 0x25,
+    0x76, 0x45, 0x8f, 0xd6, 0x51, 0x5b, 0x41, 0x63, 0x30, 0x5f, 0x59, 0xc5,
+    0x89, 0xa7, 0xaf, 0x51, 0xc2, 0x27, 0xc8, 0xd7, 0x5a, 0xf2, 0x2a, 0x90,
+    0xe1, 0xfc, 0xeb, 0xc8, 0x16, 0x10, 0xd6, 0xd7, 0xf9, 0x2f, 0xb5, 0x55,
+    0x66, 0x14, 0x06, 0x29, 0xda, 0x6d, 0xfc, 0x74, 0x22, 0x7a, 0x48, 0xfc,
+    0x3d, 0xa9, 0x8f, 0xc2, 0xef,
+};
+
+static const uint8_t res_521_521[] = {
+    0x01, 0x4f, 0x4b, 0xd1, 0xc7, 0xd0, 0xf4, 0xbd, 0x43, 0xeb, 0xf8, 0xdf,
+    0xd0, 0x00, 0xc5, 0x0e, 0x5d, 0xca, 0x53, 0x1d, 0x88, 0x5d, 0xbc, 0x89,
+    0x4c, 0x48, 0x0a, 0xa0, 0x2e, 0xb6, 0x10, 0x79, 0x62, 0x2d, 0xfd, 0xfa,
+    0xdc, 0xcc, 0xee, 0xd5, 0x95, 0xf2, 0xb4, 0xe1, 0xdb, 0x43, 0x45, 0x9e,
+    0x05, 0x14, 0x80, 0x8a, 0x6f, 0x0f, 0x75, 0xf8, 0x03, 0x0f, 0xcf, 0x6e,
+    0x64, 0xd8, 0xd1, 0xd3, 0x84, 0xfe,
+};
+
+static const uint8_t mod_1024_17[] = {
+    0xfa, 0x52, 0x64, 0xe7, 0x21, 0x7d, 0x49, 0xbb, 0x85, 0xca, 0x2d, 0x84,
+    0xc0, 0xfc, 0x76, 0xc2, 0x4a, 0xfc, 0x76, 0x43, 0xbb, 0xc1, 0x51, 0x0a,
+    0x4c, 0xfc, 0x0d, 0x58, 0xdb, 0x87, 0x35, 0x05, 0xbc, 0xe1, 0xc9, 0x06,
+    0x09, 0x50, 0xf3, 0x36, 0x1d, 0xb3, 0xde, 0xe8, 0xd3, 0x00, 0xef, 0x39,
+    0xc8, 0x24, 0xbf, 0xee, 0x69, 0x7f, 0xbc, 0xb1, 0x80, 0xbc, 0x11, 0xe3,
+    0x1e, 0x30, 0x40, 0xaf, 0x7a, 0xed, 0xa2, 0xac, 0x2a, 0xb5, 0x50, 0x7b,
+    0xad, 0x12, 0x95, 0xa7, 0x06, 0xdb, 0x41, 0xfc, 0x89, 0xcf, 0x3b, 0x37,
+    0xe0, 0x87, 0x03, 0xc2, 0xc9, 0x83, 0x74, 0xf8, 0xe6, 0x69, 0xd4, 0x52,
+    0x1d, 0x63, 0x03, 0x00, 0xa8, 0xa0, 0xba, 0x07, 0x03, 0x11, 0x61, 0xb3,
+    0xfd, 0x00, 0x68, 0x08, 0xa4, 0x91, 0xce, 0x75, 0xf4, 0xb0, 0x5f, 0x9d,
+    0x71, 0x27, 0x99, 0x48, 0x6a, 0xb9, 0x51, 0x25,
+};
+
+static const uint8_t base_1024_17[] = {
+    0xaa, 0x0e, 0xe1, 0xa3, 0x99, 0xe9, 0xad, 0xcd, 0x35, 0x65, 0x37, 0xec,
+    0xad, 0x4b, 0x99, 0x16, 0x0b, 0xc0, 0x80, 0x4e, 0x47, 0xd0, 0x73, 0x5d,
+    0xd5, 0x23, 0xdc, 0xc3, 0x2a, 0xce, 0xde, 0x42, 0x41, 0xd7, 0x58, 0x03,
+    0x05, 0x6d, 0x0b, 0x18, 0xb8, 0x68, 0x70, 0x1a, 0xb2, 0xc1, 0x0e, 0x80,
+    0x7e, 0x0e, 0x92, 0xff, 0x5b, 0x59, 0xe2, 0x16, 0x58, 0xd1, 0x6e, 0xd7,
+    0x7b, 0xf8, 0xff, 0x81, 0x3b, 0x81, 0x1f, 0xae, 0x3e, 0x97, 0x43, 0x05,
+    0x62, 0x89, 0x3a, 0x82, 0xfa, 0x03, 0xa4, 0xb5, 0xb8, 0xaf, 0xb1, 0x5c,
+    0xb6, 0x81, 0x7a, 0x47, 0xea, 0x5b, 0x4c, 0x8c, 0x01, 0x55, 0x00, 0x1b,
+    0x87, 0xa3, 0x6c, 0x4f, 0x64, 0x38, 0x3b, 0x8e, 0xba, 0x65, 0x5e, 0x33,
+    0xa4, 0x5b, 0xe2, 0x54, 0xd3, 0xf5, 0xf2, 0x27, 0xcc, 0xd0, 0xf8, 0x9a,
+    0xae, 0xfa, 0x0b, 0x47, 0xe7, 0x6c, 0x72, 0xca,
+};
+
+static const uint8_t exp_1024_17[] = {
+    0x01, 0x00, 0x01,
+};
+
+static const uint8_t res_1024_17[] = {
+    0x40, 0xa5, 0x8d, 0x2c, 0x13, 0xaf, 0x73, 0x45, 0x7e, 0x5c, 0x87, 0x39,
+    0x3e, 0xc0, 0xdb, 0x89, 0xb0, 0xcc, 0xd1, 0x28, 0xbc, 0x7d, 0x81, 0x60,
+    0xbd, 0x54, 0x72, 0x15, 0x0c, 0x9f, 0xe4, 0x00, 0x23, 0x25, 0xed, 0xd6,
+    0x13, 0x83, 0x8b, 0x81, 0x1a, 0x24, 0x86, 0xa5, 0xa8, 0xb1, 0xe3, 0xd8,
+    0x7d, 0xe5, 0xe6, 0xc6, 0x86, 0x2d, 0x4a, 0x14, 0x5e, 0xbf, 0xa0, 0x91,
+    0x3b, 0x4b, 0x02, 0x6e, 0xb0, 0x4a, 0x84, 0x5f, 0x18, 0xbb, 0x40, 0x42,
+    0x71, 0x4c, 0x9e, 0xc3, 0xdf, 0x85, 0xdf, 0x24, 0xc8, 0x20, 0xc0, 0x81,
+    0x80, 0x50, 0xca, 0x39, 0x76, 0xab, 0x20, 0xba, 0x80, 0x70, 0x01, 0xcb,
+    0xd6, 0xf4, 0x5e, 0xf6, 0xca, 0xe7, 0x89, 0x71, 0xe1, 0x3c, 0x23, 0x50,
+    0x57, 0x74, 0x43, 0x47, 0x5e, 0xd4, 0x6a, 0xda, 0xc2, 0x8f, 0x63, 0xb3,
+    0xd6, 0x3a, 0x68, 0x15, 0x21, 0x9d, 0xe9, 0xcc,
+};
+
+static const uint8_t mod_1024_1024[] = {
+    0xa9, 0x7b, 0x3f, 0xcd, 0xcf, 0x2b, 0x78, 0xa4, 0xfa, 0x35, 0xa8, 0x03,
+    0xc8, 0x0e, 0x1a, 0xc3, 0xc1, 0xc2, 0x9d, 0xe7, 0xb3, 0x3f, 0xb1, 0xb9,
+    0x11, 0xea, 0x16, 0x75, 0xba, 0x20, 0xe6, 0xe3, 0xcf, 0x67, 0x90, 0xb5,
+    0xbd, 0xde, 0x11, 0xee, 0xdc, 0x4d, 0x05, 0x22, 0x29, 0x55, 0xfb, 0xad,
+    0xb7, 0x6a, 0x94, 0x1e, 0x69, 0xc9, 0x82, 0xad, 0x0d, 0xf0, 0x0f, 0x0a,
+    0x89, 0x70, 0x6f, 0x63, 0x83, 0xa1, 0xf7, 0x29, 0xe7, 0x2c, 0x74, 0x2e,
+    0xd0, 0x8c, 0x94, 0x99, 0x3d, 0x91, 0xc5, 0xf7, 0x73, 0xbe, 0x6b, 0x2b,
+    0x45, 0x6d, 0x5b, 0xdd, 0x5b, 0xb0, 0xae, 0x2f, 0xd4, 0x4d, 0xb9, 0x7c,
+    0xea, 0xec, 0xeb, 0x0f, 0x5e, 0xc8, 0x6e, 0x3b, 0xd3, 0x87, 0x80, 0xa6,
+    0xb1, 0xab, 0x59, 0xee, 0x86, 0xab, 0xaf, 0x87, 0x72, 0xba, 0x47, 0x0b,
+    0x3c, 0xe4, 0xf1, 0xa1, 0x33, 0x04, 0xdf, 0xe7,
+};
+
+static const uint8_t base_1024_1024[] = {
+    0xe6, 0xea, 0xf7, 0x73, 0x89, 0xf7, 0xdf, 0x30, 0x65, 0x89, 0x90, 0xf7,
+    0xd3, 0xda, 0x77, 0xbd, 0x57, 0xe4, 0x64, 0x72, 0x95, 0x8b, 0xa1, 0xb4,
+    0x18, 0x29, 0xe7, 0x77, 0x85, 0x32, 0xd3, 0xfd, 0xbb, 0x8c, 0xf3, 0x3c,
+    0x36, 0x4c, 0x8c, 0x52, 0x87, 0x6d, 0xb8, 0xd3, 0x74, 0xf0, 0xb3, 0xa6,
+    0xc5, 0x76, 0x79, 0x30, 0x67, 0x49, 0x35, 0x62, 0x4f, 0x38, 0xb6, 0xbc,
+    0x00, 0xc5, 0xae, 0x9a, 0x58, 0x7b, 0x31, 0xe8, 0x04, 0x76, 0xec, 0xda,
+    0x33, 0xb2, 0xe5, 0x96, 0x44, 0xcf, 0x80, 0x62, 0x00, 0xca, 0xbc, 0x7a,
+    0x62, 0x18, 0xbc, 0x95, 0x6d, 0x70, 0xfb, 0x5d, 0xd8, 0xce, 0xfd, 0x7c,
+    0x00, 0x49, 0x43, 0x42, 0x1e, 0x54, 0xe3, 0xe8, 0xc4, 0x2a, 0xbe, 0x2b,
+    0x86, 0x44, 0x7f, 0xc5, 0x88, 0x8c, 0x10, 0x38, 0xe7, 0x01, 0xb2, 0x83,
+    0xb2, 0xd3, 0x2e, 0xea, 0x5b, 0x85, 0x4f, 0x41,
+};
+
+static const uint8_t exp_1024_1024[] = {
+    0x5e, 0xea, 0x65, 0x5f, 0x04, 0xe1, 0x9f, 0x29, 0xef, 0x89, 0xa0, 0xa3,
+    0x4d, 0xfd, 0xf5, 0x1d, 0x91, 0xa2, 0x09, 0x19, 0xa1, 0xba, 0x34, 0x25,
+    0x09, 0x61, 0xb6, 0xd5, 0xe9, 0x5e, 0x28, 0xef, 0x98, 0xaf, 0x87, 0xd2,
+    0x08, 0xbf, 0x50, 0xf6, 0x8f, 0x1b, 0xf5, 0x1a, 0xbe, 0x44, 0x19, 0xa8,
+    0x50, 0x02, 0x6d, 0xe2, 0xb6, 0x1c, 0xd2, 0x51, 0x87, 0x16, 0xd4, 0xfb,
+    0x52, 0x3e, 0xd1, 0xcf, 0x9a, 0xa5, 0xc8, 0x66, 0x11, 0x97, 0xaa, 0x5e,
+    0x89, 0x45, 0x83, 0xda, 0x53, 0x2b, 0x57, 0x04, 0xff, 0x8e, 0x96, 0x43,
+    0xba, 0x6d, 0x7c, 0x89, 0x0f, 0x09, 0x30, 0xbe, 0x8c, 0xbc, 0x00, 0x4b,
+    0xc1, 0x46, 0x8e, 0x37, 0x44, 0x25, 0x64, 0xbe, 0xd5, 0x4d, 0x15, 0xc1,
+    0xdb, 0xd3, 0xb6, 0x3f, 0xf0, 0x15, 0x11, 0xfe, 0x5b, 0x63, 0x6c, 0x59,
+    0xbe, 0x73, 0x43, 0xcd, 0x12, 0xb3, 0x1b, 0x49,
+};
+
+static const uint8_t res_1024_1024[] = {
+    0x93, 0x8f, 0xa6, 0x3e, 0xa3, 0x19, 0x20, 0x98, 0xc1, 0x2a, 0xe2, 0x10,
+    0x40, 0xb7, 0x1a, 0xa8, 0x6d, 0x57, 0x77, 0x0b, 0x7b, 0x6d, 0xba, 0xec,
+    0x9c, 0x42, 0x73, 0x06, 0xc7, 0x16, 0xbf, 0x0e, 0xc1, 0x36, 0xf3, 0x23,
+    0x2f, 0x71, 0xc3, 0x2c, 0x08, 0xcf, 0x17, 0xcb, 0x11, 0x1b, 0x5c, 0x9d,
+    0x2c, 0x43, 0x26, 0x65, 0xc8, 0x75, 0xac, 0xdf, 0xa2, 0x04, 0x6a, 0x02,
+    0x6b, 0x74, 0xbe, 0xc5, 0x4d, 0xdd, 0xec, 0x36, 0xc1, 0xe9, 0x45, 0xa0,
+    0x17, 0x01, 0xae, 0xe6, 0xde, 0x08, 0x90, 0x39, 0x61, 0xfe, 0x5f, 0x49,
+    0xa5, 0x51, 0xac, 0x89, 0x56, 0x57, 0xa5, 0x5b, 0x07, 0xbb, 0xa7, 0x6c,
+    0xd5, 0x34, 0x8f, 0x76, 0x32, 0x14, 0x7d, 0x17, 0x4c, 0x38, 0x85, 0x09,
+    0xcd, 0x3e, 0xe9, 0x94, 0x91, 0xea, 0xc4, 0x20, 0x6e, 0x19, 0xc5, 0x65,
+    0x46, 0x78, 0x25, 0x00, 0x1d, 0xc2, 0xd8, 0x44,
+};
+
+static const uint8_t rsa_n[] = {
+    0xca, 0xae, 0x4b, 0xac, 0xd3, 0x88, 0x7a, 0x59, 0xb3, 0xb0, 0x98, 0x6e,
+    0x0d, 0xdb, 0x04, 0x44, 0x37, 0xdb, 0x6e, 0x4c, 0x30, 0x30, 0x8c, 0x87,
+    0xa4, 0xa0, 0xfd, 0xb9, 0x29, 0xd7, 0x45, 0x70, 0xd1, 0xb3, 0xf9, 0xd8,
+    0x32, 0x36, 0x4e, 0xea, 0x62, 0x6d, 0x0c, 0x37, 0xa6, 0x6b, 0x9a, 0xbd,
+    0xb3, 0xe3, 0x53, 0x29, 0x10, 0x24, 0xb4, 0xaa, 0x67, 0x4f, 0xc8, 0x2b,
+    0x91, 0x9f, 0x5a, 0x05,
+};
+
+static const uint8_t rsa_e[] = {
+    0x01, 0x00, 0x01,
+};
+
+static const uint8_t rsa_d[] = {
+    0x48, 0xc4, 0xef, 0x72, 0xab, 0xb8, 0x32, 0x85, 0x86, 0x58, 0x7f, 0x41,
+    0xf4, 0x43, 0x90, 0x72, 0x95, 0xc3, 0x79, 0x04, 0x6d, 0xc0, 0xe0, 0x93,
+    0xca, 0xed, 0xea, 0x6a, 0xd2, 0xb4, 0xf1, 0xbe, 0xfd, 0xa5, 0x40, 0xca,
+    0xbc, 0x29, 0x77, 0xc6, 0xb7, 0x5b, 0xbe, 0x87, 0xfb, 0xd6, 0x01, 0x8c,
+    0xf9, 0x67, 0x69, 0xa7, 0xe8, 0x97, 0xb1, 0x25, 0xac, 0xef, 0xda, 0xce,
+    0x76, 0x9b, 0x49, 0xc1,
+};
+
+static const uint8_t rsa_p[] = {
+    0xcf, 0x91, 0x54, 0x0c, 0x27, 0x75, 0x69, 0x91, 0xa0, 0x93, 0x1e, 0xd4,
+    0x2e, 0xcd, 0xcc, 0x0a, 0x62, 0xd7, 0x41, 0x45, 0xdd, 0xd4, 0xa0, 0x54,
+    0x22, 0xbf, 0xb8, 0xe0, 0x93, 0x17, 0x19, 0xfd,
+};
+
+static const uint8_t rsa_q[] = {
+    0xf9, 0xf9, 0x0f, 0x81, 0x2d, 0xd9, 0x6b, 0x62, 0x09, 0x42, 0xc3, 0xfb,
+    0xb6, 0xd3, 0xe8, 0x79, 0x88, 0xeb, 0xd5, 0x24, 0x78, 0xe2, 0x11, 0x03,
+    0xc1, 0x4b, 0x05, 0x10, 0x02, 0xc1, 0x9a, 0xa9,
+};
+
+static const uint8_t rsa_dP[] = {
+    0x5e, 0x18, 0xd5, 0xef, 0x44, 0x9c, 0x17, 0xa5, 0xab, 0x13, 0xc6, 0xf0,
+    0x0d, 0xdf, 0xc1, 0xd6, 0x1b, 0x84, 0xd5, 0xd4, 0x64, 0x82, 0x15, 0xc4,
+    0xce, 0x93, 0xf7, 0xad, 0xe7, 0x40, 0x9b, 0xc9,
+};
+
+static const uint8_t rsa_dQ[] = {
+    0x99, 0xf8, 0x05, 0xcb, 0xcc, 0xa0, 0xe1, 0xda, 0xa5, 0xd7, 0xa0, 0xfd,
+    0xb7, 0x34, 0x39, 0x3a, 0x3a, 0xd3, 0x00, 0x1b, 0x11, 0xf6, 0x35, 0x02,
+    0xba, 0x19, 0x6a, 0x49, 0xdd, 0x58, 0xc0, 0xd9,
+};
+
+static const uint8_t rsa_qInv[] = {
+    0x79, 0x87, 0xdf, 0x45, 0xdf, 0x39, 0xf0, 0x5b, 0x80, 0x22, 0xd2, 0x15,
+    0x77, 0x77, 0x8c, 0x73, 0xe2, 0xbb, 0x7c, 0xf9, 0x10, 0x2c, 0x5c, 0x16,
+    0x67, 0xe7, 0x7c, 0x56, 0x0c, 0x23, 0x78, 0x61,
+};
+
+static const uint8_t rsa_msg[] = {
+    0x09, 0x1e, 0xb5, 0xff, 0x05, 0xd5, 0x4c, 0xb2, 0xfa, 0x2f, 0x0a, 0xfd,
+    0xc7, 0x7f, 0x79, 0x35, 0xb3, 0xbd, 0x43, 0x90, 0x21, 0x24, 0x62, 0xac,
+    0x42, 0x9d, 0xf5, 0x42, 0xec, 0xde, 0x8a, 0x07, 0x07, 0x87, 0xb2, 0x6d,
+    0x9e, 0x2e, 0x5b, 0xe5, 0x6b, 0x66, 0xec, 0x95, 0x31, 0x02, 0xfa, 0xd3,
+    0x1b, 0xce, 0x1a, 0x9b, 0x51, 0x34, 0xfa, 0xb7, 0x86, 0x65, 0x34, 0xcd,
+    0x79, 0xfe, 0x0c, 0x5f,
+};
+
+static const uint8_t rsa_sig[] = {
+    0x18, 0x63, 0xf5, 0x7b, 0x8e, 0xac, 0x8e, 0xdd, 0x80, 0xd2, 0x11, 0xf5,
+    0x3c, 0xf4, 0x93, 0x03, 0x51, 0x7e, 0x43, 0xf1, 0x5a, 0x7c, 0x46, 0x3e,
+    0x6a, 0x6d, 0xfc, 0xa4, 0x3f, 0x75, 0xb8, 0xb4, 0x0e, 0x78, 0x1f, 0x3c,
+    0xba, 0x45, 0xa5, 0x59, 0x97, 0x14, 0xd4, 0x01, 0xb5, 0x1e, 0x6a, 0xae,
+    0xdd, 0x89, 0x47, 0x6e, 0xac, 0xee, 0x77, 0xd4, 0x3c, 0x19, 0x93, 0x75,
+    0xbe, 0x6a, 0x4e, 0x8e,
+};
+
+/* Computes base^exp mod mod, with the fixed-size engine or the generic code */
+void mod_power(const uint8_t *mod, int mod_len, const uint8_t *base, int base_len,
+               const uint8_t *exp, int exp_len, uint8_t *out, bool generic)
+{
+    BI_CTX *ctx = bi_initialize();
+    bi_set_mod(ctx, bi_import(ctx, mod, mod_len), BIGINT_M_OFFSET);
+    ctx->mod_offset = BIGINT_M_OFFSET;
+
+    struct _mont_ctx *mont = ctx->mont[BIGINT_M_OFFSET];
+    if (generic)
+        ctx->mont[BIGINT_M_OFFSET] = NULL;
+
+    bigint *r = bi_mod_power(ctx, bi_import(ctx, base, base_len), bi_import(ctx, exp, exp_len));
+    bi_export(ctx, r, out, mod_len);
+
+    ctx->mont[BIGINT_M_OFFSET] = mont;
+    bi_free_mod(ctx, BIGINT_M_OFFSET);
+    bi_terminate(ctx);
+}
+
+}
+
+#define CHECK_MOD_POWER(bits, ebits, generic)                                   \
+    do {                                                                        \
+        uint8_t out[sizeof(res_##bits##_##ebits)];                              \
+        mod_power(mod_##bits##_##ebits, sizeof(mod_##bits##_##ebits),           \
+                  base_##bits##_##ebits, sizeof(base_##bits##_##ebits),         \
+                  exp_##bits##_##ebits, sizeof(exp_##bits##_##ebits),           \
+                  out, generic);                                                \
+        MEMCMP_EQUAL(res_##bits##_##ebits, out, sizeof(out));                   \
+    } while (0)
+
+TEST_GROUP(BigintMont_mod_power)
+{
+};
+
+TEST(BigintMont_mod_power, mod_64)
+{
+    CHECK_MOD_POWER(64, 64, false);
+    CHECK_MOD_POWER(64, 64, true);
+}
+
+TEST(BigintMont_mod_power, mod_521_unreduced_base)
+{
+    CHECK_MOD_POWER(521, 521, false);
+    CHECK_MOD_POWER(521, 521, true);
+}
+
+TEST(BigintMont_mod_power, mod_1024_public_exponent)
+{
+    CHECK_MOD_POWER(1024, 17, false);
+    CHECK_MOD_POWER(1024, 17, true);
+}
+
+TEST(BigintMont_mod_power, mod_1024_full_exponent)
+{
+    CHECK_MOD_POWER(1024, 1024, false);
+    CHECK_MOD_POWER(1024, 1024, true);
+}
+
+TEST(BigintMont_mod_power, even_modulus_uses_generic_code)
+{
+    const uint8_t mod[] = { 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10 };
+    BI_CTX *ctx = bi_initialize();
+    bi_set_mod(ctx, bi_import(ctx, mod, sizeof(mod)), BIGINT_M_OFFSET);
+    POINTERS_EQUAL(NULL, ctx->mont[BIGINT_M_OFFSET]);
+    bi_free_mod(ctx, BIGINT_M_OFFSET);
+    bi_terminate(ctx);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_GROUP(BigintMont_rsa)
+{
+    RSA_CTX *rsa;
+
+    void setup()
+    {
+        rsa = NULL;
+        RSA_priv_key_new(&rsa, rsa_n, sizeof(rsa_n), rsa_e, sizeof(rsa_e),
+                         rsa_d, sizeof(rsa_d), rsa_p, sizeof(rsa_p),
+                         rsa_q, sizeof(rsa_q), rsa_dP, sizeof(rsa_dP),
+                         rsa_dQ, sizeof(rsa_dQ), rsa_qInv, sizeof(rsa_qInv));
+    }
+
+    void teardown()
+    {
+        RSA_free(rsa);
+    }
+};
+
+TEST(BigintMont_rsa, crt_private)
+{
+    uint8_t out[sizeof(rsa_n)];
+    CHECK(rsa->bi_ctx->mont[BIGINT_P_OFFSET] != NULL);
+    CHECK(rsa->bi_ctx->mont[BIGINT_Q_OFFSET] != NULL);
+    bi_export(rsa->bi_ctx, RSA_private(rsa, bi_import(rsa->bi_ctx, rsa_msg, sizeof(rsa_msg))),
+              out, sizeof(out));
+    MEMCMP_EQUAL(rsa_sig, out, sizeof(out));
+}
+
+TEST(BigintMont_rsa, public)
+{
+    uint8_t out[sizeof(rsa_n)];
+    uint8_t msg[sizeof(rsa_n)];
+    memset(msg, 0, sizeof(msg));
+    memcpy(&msg[sizeof(msg)-sizeof(rsa_msg)], rsa_msg, sizeof(rsa_msg));
+    bi_export(rsa->bi_ctx, RSA_public(rsa, bi_import(rsa->bi_ctx, rsa_sig, sizeof(rsa_sig))),
+              out, sizeof(out));
+    MEMCMP_EQUAL(msg, out, sizeof(out));
+}
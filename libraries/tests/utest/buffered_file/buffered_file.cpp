@@ -0,0 +1,160 @@
+/* Runs random reads, writes, seeks and syncs on a BufferedFileHandle and,
+ * in step, on a reference file without a buffer, and checks that both give
+ * the same results and that the file under the buffer ends up the same. */
+#include "TestHarness.h"
+#include <stdlib.h>
+#include <string.h>
+#include "mbed.h"
+#include "BufferedFileHandle.h"
+
+namespace {
+
+const int FILE_SIZE = 2048;
+const int SEEDS = 200;
+const int OPERATIONS = 300;
+
+// A file in memory, of at most FILE_SIZE bytes
+class MemFile : public FileHandle {
+public:
+    MemFile() : length(0), pos(0) {}
+
+    virtual ssize_t write(const void *buffer, size_t n) {
+        if (pos + (off_t)n > FILE_SIZE) {
+            n = FILE_SIZE - pos;
+        }
+        if (n == 0) {
+            return 0;
+        }
+        if (pos > length) {
+            memset(&data[length], 0, pos - length);
+        }
+        memcpy(&data[pos], buffer, n);
+        pos += n;
+        if (pos > length) {
+            length = pos;
+        }
+        return n;
+    }
+
+    virtual ssize_t read(void *buffer, size_t n) {
+        if (pos >= length) {
+            return 0;
+        }
+        if (pos + (off_t)n > length) {
+            n = length - pos;
+        }
+        memcpy(buffer, &data[pos], n);
+        pos += n;
+        return n;
+    }
+
+    virtual int close() {
+        delete this;
+        return 0;
+    }
+
+    virtual int isatty() {
+        return 0;
+    }
+
+    virtual off_t lseek(off_t offset, int whence) {
+        if (whence == SEEK_CUR) {
+            offset += pos;
+        } else if (whence == SEEK_END) {
+            offset += length;
+        }
+        if ((offset < 0) || (offset > FILE_SIZE)) {
+            return -1;
+        }
+        pos = offset;
+        return pos;
+    }
+
+    virtual int fsync() {
+        return 0;
+    }
+
+    virtual off_t flen() {
+        return length;
+    }
+
+    char data[FILE_SIZE];
+    off_t length;
+    off_t pos;
+};
+
+bool same_file(MemFile *a, MemFile *b) {
+    return (a->length == b->length) && (memcmp(a->data, b->data, a->length) == 0);
+}
+
+}
+
+TEST_GROUP(BufferedFile)
+{
+};
+
+TEST(BufferedFile, random_operations_match_the_file)
+{
+    static const size_t sizes[] = {7, 16, 64, 512};
+    char buffer[3 * 512 + 2];
+    char expected[3 * 512 + 2];
+
+    for (int seed = 1; seed <= SEEDS; seed++) {
+        srand(seed);
+        size_t size = sizes[rand() % 4];
+        MemFile *file = new MemFile();
+        MemFile reference;
+        BufferedFileHandle buffered(file, size);
+
+        for (int op = 0; op < OPERATIONS; op++) {
+            int kind = rand() % 10;
+            // up to three buffers, so that some calls go straight through
+            size_t n = rand() % (3 * size + 2);
+            if (kind < 4) {
+                // but not past the end of the reference
+                if (reference.pos + (off_t)n > FILE_SIZE) {
+                    n = FILE_SIZE - reference.pos;
+                }
+                for (size_t i = 0; i < n; i++) {
+                    buffer[i] = rand();
+                }
+                LONGS_EQUAL(reference.write(buffer, n), buffered.write(buffer, n));
+            } else if (kind < 7) {
+                ssize_t got = reference.read(expected, n);
+                LONGS_EQUAL(got, buffered.read(buffer, n));
+                MEMCMP_EQUAL(expected, buffer, got);
+            } else if (kind < 9) {
+                int whence = rand() % 3;
+                // anywhere in the file or just past it, within FILE_SIZE
+                off_t span = (reference.length + 5 < FILE_SIZE + 1) ? reference.length + 5 : FILE_SIZE + 1;
+                off_t offset = rand() % span;
+                if (whence == SEEK_CUR) {
+                    offset -= reference.pos;
+                } else if (whence == SEEK_END) {
+                    offset -= reference.length;
+                }
+                LONGS_EQUAL(reference.lseek(offset, whence), buffered.lseek(offset, whence));
+            } else {
+                LONGS_EQUAL(0, buffered.fsync());
+                CHECK(same_file(&reference, file));
+            }
+            LONGS_EQUAL(reference.flen(), buffered.flen());
+        }
+
+        LONGS_EQUAL(0, buffered.flush());
+        CHECK(same_file(&reference, file));
+    }
+}
+
+TEST(BufferedFile, starts_where_the_file_is)
+{
+    MemFile *file = new MemFile();
+    file->write("0123456789", 10);
+    BufferedFileHandle buffered(file, 16);
+
+    // as a file opened for appending is
+    LONGS_EQUAL(3, buffered.write("abc", 3));
+    LONGS_EQUAL(0, buffered.flush());
+    LONGS_EQUAL(13, file->length);
+    MEMCMP_EQUAL("0123456789abc", file->data, 13);
+}
@@ -85,3 +85,43 @@ TEST(BusOut_digitalout_write, led_1_nc_2_nc_nc_3)
     CHECK(bus_data[5].read() == 0);
 }
 #endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST_GROUP(BusOut_write)
+{
+};
+
+// Every value reads back the same, whether the bus is written a port or a pin at a time
+TEST(BusOut_write, led_1_2_3_4_all_values)
+{
+    BusOut bus_data(LED1, LED2, LED3, LED4);
+    for (int v = 0; v < 16; v++) {
+        bus_data.write(v);
+        CHECK_EQUAL(v, bus_data.read());
+    }
+}
+
+TEST(BusOut_write, led_4_nc_1_3_nc_2)
+{
+    BusOut bus_data(LED4, NC, LED1, LED3, NC, LED2);
+    for (int v = 0; v < 64; v++) {
+        bus_data.write(v);
+        CHECK_EQUAL(v & 0x2d, bus_data.read());
+    }
+}
+
+#ifdef MBED_OPERATORS
+TEST(BusOut_write, led_1_2_3_4_pins_follow_the_bus)
+{
+    BusOut bus_data(LED1, LED2, LED3, LED4);
+    bus_data = 0x5;
+    CHECK_EQUAL(1, bus_data[0].read());
+    CHECK_EQUAL(0, bus_data[1].read());
+    CHECK_EQUAL(1, bus_data[2].read());
+    CHECK_EQUAL(0, bus_data[3].read());
+
+    bus_data[1].write(1);
+    CHECK_EQUAL(0x7, bus_data.read());
+}
+#endif
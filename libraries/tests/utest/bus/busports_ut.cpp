@@ -0,0 +1,158 @@
+#include "TestHarness.h"
+#include <stdlib.h>
+#include <string.h>
+#include "mbed.h"
+
+#if DEVICE_PORTIN || DEVICE_PORTOUT
+#include "port_api.h"
+
+/* BusPorts built against a simulated target with three 32 bit ports, which
+ * counts the writes to each port and keeps the value of its pins. */
+namespace {
+
+const int SIM_PORTS = 3;
+const int SIM_PIN_BASE = 0x100;
+const int LAYOUTS = 2000;
+const int UPDATES = 20;
+
+struct SimPort {
+    port_t *obj;
+    int mask;
+    uint32_t pins;
+    int writes;
+};
+
+SimPort sim[SIM_PORTS];
+int sim_stray;
+
+PinName sim_pin(int port, int bit) {
+    return (PinName)(SIM_PIN_BASE + port * 32 + bit);
+}
+
+SimPort *sim_find(port_t *obj) {
+    for (int p=0; p<SIM_PORTS; p++) {
+        if (sim[p].obj == obj) {
+            return &sim[p];
+        }
+    }
+    // an access to a port that wasn't initialised
+    sim_stray++;
+    return &sim[0];
+}
+
+int sim_pin_port(PinName pin, PortName *port) {
+    int n = (int)pin - SIM_PIN_BASE;
+    *port = (PortName)(n / 32);
+    return n % 32;
+}
+
+void sim_port_init(port_t *obj, PortName port, int mask, PinDirection dir) {
+    sim[port].obj = obj;
+    sim[port].mask = mask;
+}
+
+void sim_port_dir(port_t *obj, PinDirection dir) {
+}
+
+void sim_port_write(port_t *obj, int value) {
+    SimPort *p = sim_find(obj);
+    p->pins = (p->pins & ~p->mask) | (value & p->mask);
+    p->writes++;
+}
+
+int sim_port_read(port_t *obj) {
+    SimPort *p = sim_find(obj);
+    return p->pins & p->mask;
+}
+
+}
+
+#undef MBED_BUSPORTS_H
+#define BusPorts SimBusPorts
+#define pin_port sim_pin_port
+#define port_init sim_port_init
+#define port_dir sim_port_dir
+#define port_write sim_port_write
+#define port_read sim_port_read
+#include "../../../mbed/common/BusPorts.cpp"
+#undef BusPorts
+#undef pin_port
+#undef port_init
+#undef port_dir
+#undef port_write
+#undef port_read
+
+TEST_GROUP(BusPorts_simulated)
+{
+};
+
+TEST(BusPorts_simulated, one_write_per_port_and_no_glitch)
+{
+    srand(1);
+    for (int layout=0; layout<LAYOUTS; layout++) {
+        // up to 16 pins on distinct bits of the three ports, some NC
+        PinName pins[16];
+        bool used[SIM_PORTS][32];
+        memset(used, 0, sizeof(used));
+        memset(sim, 0, sizeof(sim));
+        sim_stray = 0;
+        for (int i=0; i<16; i++) {
+            if (rand() % 8 == 0) {
+                pins[i] = NC;
+                continue;
+            }
+            int port, bit;
+            int prev = (i > 0 && pins[i - 1] != NC) ? (int)pins[i - 1] - SIM_PIN_BASE : -1;
+            if ((prev >= 0) && (prev % 32 < 31) && (rand() % 2)
+                && !used[prev / 32][prev % 32 + 1]) {
+                // carry on a run of consecutive bits, as boards often do
+                port = prev / 32;
+                bit = prev % 32 + 1;
+            } else {
+                do {
+                    port = rand() % SIM_PORTS;
+                    bit = rand() % 32;
+                } while (used[port][bit]);
+            }
+            used[port][bit] = true;
+            pins[i] = sim_pin(port, bit);
+        }
+
+        SimBusPorts bus;
+        bool any = false;
+        for (int i=0; i<16; i++) {
+            any = any || (pins[i] != NC);
+        }
+        CHECK_EQUAL(any, bus.init(pins, PIN_OUTPUT));
+        if (!any) {
+            continue;
+        }
+
+        for (int update=0; update<UPDATES; update++) {
+            int value = rand() & 0xFFFF;
+            for (int p=0; p<SIM_PORTS; p++) {
+                sim[p].writes = 0;
+            }
+            bus.write(value);
+
+            // a port with pins of the bus got exactly one write
+            for (int p=0; p<SIM_PORTS; p++) {
+                CHECK_EQUAL(sim[p].mask ? 1 : 0, sim[p].writes);
+            }
+            // and its pins show the value
+            int mask = 0;
+            for (int i=0; i<16; i++) {
+                if (pins[i] == NC) {
+                    continue;
+                }
+                int n = (int)pins[i] - SIM_PIN_BASE;
+                CHECK_EQUAL((value >> i) & 1, (int)(sim[n / 32].pins >> (n % 32)) & 1);
+                mask |= 1 << i;
+            }
+            CHECK_EQUAL(value & mask, bus.read());
+            CHECK_EQUAL(0, sim_stray);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,138 @@
+/* Checks the hashed lookup of FileBase names and the reuse of file
+ * descriptors, and prints the path resolutions and open/close pairs per
+ * second with many file systems mounted. */
+#include "TestHarness.h"
+#include "mbed.h"
+#include "FilePath.h"
+
+namespace {
+
+const int MOUNTS = 32;
+const int LOOKUPS = 10000;
+const int OPENS = 1000;
+
+class NullFile : public FileHandle {
+public:
+    virtual ssize_t write(const void *buffer, size_t length) {return length;}
+    virtual int close() {delete this; return 0;}
+    virtual ssize_t read(void *buffer, size_t length) {return 0;}
+    virtual int isatty() {return 0;}
+    virtual off_t lseek(off_t offset, int whence) {return 0;}
+    virtual int fsync() {return 0;}
+};
+
+class NullFileSystem : public FileSystemLike {
+public:
+    NullFileSystem(const char *name) : FileSystemLike(name), opened(0) {}
+
+    virtual FileHandle *open(const char *filename, int flags) {
+        opened++;
+        return new NullFile();
+    }
+
+    int opened;
+};
+
+char names[MOUNTS][8];
+
+}
+
+TEST_GROUP(FileTable)
+{
+    NullFileSystem *mounts[MOUNTS];
+
+    void setup() {
+        for (int i = 0; i < MOUNTS; i++) {
+            sprintf(names[i], "fs%d", i);
+            mounts[i] = new NullFileSystem(names[i]);
+        }
+    }
+
+    void teardown() {
+        for (int i = 0; i < MOUNTS; i++) {
+            delete mounts[i];
+        }
+    }
+};
+
+TEST(FileTable, lookup)
+{
+    POINTERS_EQUAL(mounts[1], FileBase::lookup("fs1", 3));
+    POINTERS_EQUAL(mounts[1], FileBase::lookup("fs1/file", 3));
+    POINTERS_EQUAL(mounts[12], FileBase::lookup("fs12", 4));
+    POINTERS_EQUAL(NULL, FileBase::lookup("fs1", 2));
+    POINTERS_EQUAL(NULL, FileBase::lookup("fs99", 4));
+
+    FilePath path("/fs7/dir/file.txt");
+    POINTERS_EQUAL(mounts[7], path.fileSystem());
+    STRCMP_EQUAL("dir/file.txt", path.fileName());
+    CHECK(!FilePath("/fs99/file.txt").exists());
+}
+
+TEST(FileTable, newest_of_a_name)
+{
+    // a mount hides the older ones of its name until it goes, cached or not
+    POINTERS_EQUAL(mounts[3], FileBase::lookup("fs3", 3));
+    NullFileSystem *again = new NullFileSystem("fs3");
+    POINTERS_EQUAL(again, FileBase::lookup("fs3", 3));
+    delete again;
+    POINTERS_EQUAL(mounts[3], FileBase::lookup("fs3", 3));
+}
+
+TEST(FileTable, directory)
+{
+    int found = 0;
+    for (int n = 0; FileBase::get(n) != NULL; n++) {
+        for (int i = 0; i < MOUNTS; i++) {
+            if (FileBase::get(n) == mounts[i]) {
+                found++;
+            }
+        }
+    }
+    LONGS_EQUAL(MOUNTS, found);
+}
+
+TEST(FileTable, descriptors_reused)
+{
+    // leaking a descriptor a close would run out of them well before the end
+    for (int i = 0; i < OPENS; i++) {
+        FILE *a = fopen("/fs0/a", "w");
+        FILE *b = fopen("/fs1/b", "w");
+        CHECK(a != NULL);
+        CHECK(b != NULL);
+        LONGS_EQUAL(0, fclose(a));
+        LONGS_EQUAL(0, fclose(b));
+    }
+    LONGS_EQUAL(OPENS, mounts[0]->opened);
+    LONGS_EQUAL(OPENS, mounts[1]->opened);
+}
+
+TEST(FileTable, per_second)
+{
+    // fs0 is the oldest mount, the last one a walk of the list of objects gets to
+    Timer t;
+    t.start();
+    int start = t.read_us();
+    for (int i = 0; i < LOOKUPS; i++) {
+        FilePath path("/fs0/file.txt");
+    }
+    int same_us = t.read_us() - start;
+
+    static const char *paths[] = {"/fs0/file.txt", "/fs31/file.txt", "/fs5/file.txt", "/fs16/file.txt"};
+    start = t.read_us();
+    for (int i = 0; i < LOOKUPS; i++) {
+        FilePath path(paths[i & 3]);
+    }
+    int mixed_us = t.read_us() - start;
+
+    start = t.read_us();
+    for (int i = 0; i < OPENS; i++) {
+        fclose(fopen("/fs0/file.txt", "w"));
+    }
+    int open_us = t.read_us() - start;
+
+    printf("Paths on one mount: %d/s, on several: %d/s, open and close: %d/s\r\n",
+           (int)(LOOKUPS * 1000000LL / (same_us ? same_us : 1)),
+           (int)(LOOKUPS * 1000000LL / (mixed_us ? mixed_us : 1)),
+           (int)(OPENS * 1000000LL / (open_us ? open_us : 1)));
+}
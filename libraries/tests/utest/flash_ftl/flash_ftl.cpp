@@ -0,0 +1,276 @@
+/* Checks the flash translation layer on a simulated NOR flash: sectors
+ * survive a remount and a power loss at any program or erase, the wear
+ * stays level under writes to a few hot sectors, worn out blocks stay out
+ * after a remount, and a FAT volume works on it. The power losses and the
+ * FAT volume are checked on flash with ECC units of 16 bytes too. Prints
+ * the write amplification, the erase counts and the throughput the
+ * simulated timing gives. */
+#include "TestHarness.h"
+#include "mbed.h"
+#include "SimFlash.h"
+#include "FlashFileSystem.h"
+
+namespace {
+
+const uint32_t ERASE_SIZE = 4096;
+const uint32_t BLOCKS = 16;
+const int HOT_WRITES = 20000;
+const int POWER_LOSSES = 200;
+
+uint8_t buffer[512];
+uint8_t expected[512];
+
+// The contents of a sector at a version of it, 0 being never written
+void fill(uint8_t *data, uint32_t sector, uint32_t version) {
+    for (int i = 0; i < 512; i++) {
+        data[i] = version ? (uint8_t)(sector * 31 + version * 7 + i) : 0;
+    }
+}
+
+bool holds(FlashFileSystem *ftl, uint32_t sector, uint32_t version) {
+    fill(expected, sector, version);
+    return (ftl->disk_read(buffer, sector, 1) == 0) && (memcmp(buffer, expected, 512) == 0);
+}
+
+uint32_t random_sector(uint32_t sectors) {
+    // nine writes in ten to the first tenth
+    uint32_t r = rand();
+    return (r % 10) ? (r / 10) % (sectors / 10) : (r / 10) % sectors;
+}
+
+}
+
+TEST_GROUP(FlashFTL)
+{
+    SimFlash *nor;
+    FlashFileSystem *ftl;
+    uint32_t *versions;
+    uint32_t sectors;
+
+    void setup() {
+        srand(1);
+        nor = NULL;
+        ftl = NULL;
+        versions = NULL;
+        use_flash(BLOCKS, 1);
+    }
+
+    void teardown() {
+        delete ftl;
+        delete nor;
+        delete[] versions;
+    }
+
+    // A new flash, of blocks erase blocks programmed program_size bytes at a time
+    void use_flash(uint32_t blocks, uint32_t program_size) {
+        teardown();
+        nor = new SimFlash(blocks * ERASE_SIZE, ERASE_SIZE, program_size);
+        ftl = new FlashFileSystem(nor, "flash");
+        LONGS_EQUAL(0, ftl->disk_initialize());
+        sectors = ftl->disk_sectors();
+        versions = new uint32_t[sectors];
+        memset(versions, 0, sectors * sizeof(uint32_t));
+    }
+
+    void remount() {
+        delete ftl;
+        ftl = new FlashFileSystem(nor, "flash");
+        LONGS_EQUAL(0, ftl->disk_initialize());
+        LONGS_EQUAL(sectors, ftl->disk_sectors());
+    }
+
+    bool write(uint32_t sector) {
+        fill(buffer, sector, versions[sector] + 1);
+        if (ftl->disk_write(buffer, sector, 1) != 0) {
+            return false;
+        }
+        versions[sector]++;
+        return true;
+    }
+
+    void check_all() {
+        for (uint32_t s = 0; s < sectors; s++) {
+            CHECK(holds(ftl, s, versions[s]));
+        }
+    }
+
+    void power_loss(uint32_t program_size) {
+        use_flash(BLOCKS, program_size);
+        for (uint32_t s = 0; s < sectors; s++) {
+            CHECK(write(s));
+        }
+        int cut_writes = 0;
+        for (int round = 0; round < POWER_LOSSES; round++) {
+            nor->power_loss_after(1 + rand() % 60);
+            uint32_t sector = 0;
+            while (true) {
+                sector = random_sector(sectors);
+                if (!write(sector)) {
+                    break;
+                }
+            }
+            nor->power_on();
+            remount();
+
+            // the write cut short left the sector as it was, or wrote it
+            if (holds(ftl, sector, versions[sector] + 1)) {
+                versions[sector]++;
+                cut_writes++;
+            }
+            check_all();
+        }
+        printf("program size %d: %d power losses, %d of the writes they cut short made it\r\n",
+               (int)program_size, POWER_LOSSES, cut_writes);
+        LONGS_EQUAL(0, nor->bad_programs());
+    }
+
+    void fat(uint32_t program_size) {
+        // a larger flash, as f_mkfs wants 128 sectors at least
+        use_flash(28, program_size);
+        LONGS_EQUAL(0, ftl->format());
+
+        char line[32];
+        FileHandle *f = ftl->open("log.txt", O_WRONLY | O_CREAT | O_TRUNC);
+        CHECK(f != NULL);
+        for (int i = 0; i < 1000; i++) {
+            sprintf(line, "%08d\n", i);
+            LONGS_EQUAL(9, f->write(line, 9));
+        }
+        LONGS_EQUAL(0, f->close());
+
+        delete ftl;
+        ftl = new FlashFileSystem(nor, "flash");
+        f = ftl->open("log.txt", O_RDONLY);
+        CHECK(f != NULL);
+        LONGS_EQUAL(9000, f->flen());
+        char in[9];
+        for (int i = 0; i < 1000; i++) {
+            sprintf(line, "%08d\n", i);
+            LONGS_EQUAL(9, f->read(in, 9));
+            MEMCMP_EQUAL(line, in, 9);
+        }
+        LONGS_EQUAL(0, f->close());
+        LONGS_EQUAL(0, nor->bad_programs());
+    }
+};
+
+TEST(FlashFTL, geometry)
+{
+    // 4 KB blocks hold 7 pages and their tags, less the spare blocks
+    LONGS_EQUAL((BLOCKS - FLASH_FTL_SPARE_BLOCKS) * 7, sectors);
+    CHECK(holds(ftl, 0, 0));
+    LONGS_EQUAL(1, ftl->disk_read(buffer, sectors, 1));
+    LONGS_EQUAL(1, ftl->disk_write(buffer, sectors - 1, 2));
+}
+
+TEST(FlashFTL, remount)
+{
+    for (int round = 0; round < 3; round++) {
+        for (uint32_t s = 0; s < sectors; s++) {
+            CHECK(write(s));
+        }
+    }
+    for (int i = 0; i < 100; i++) {
+        CHECK(write(random_sector(sectors)));
+    }
+    remount();
+    check_all();
+    // and carries on where it left off
+    for (int i = 0; i < 100; i++) {
+        CHECK(write(random_sector(sectors)));
+    }
+    remount();
+    check_all();
+    LONGS_EQUAL(0, nor->bad_programs());
+}
+
+TEST(FlashFTL, power_loss)
+{
+    power_loss(1);
+}
+
+TEST(FlashFTL, power_loss_ecc_flash)
+{
+    power_loss(16);
+}
+
+TEST(FlashFTL, wear)
+{
+    for (uint32_t s = 0; s < sectors; s++) {
+        CHECK(write(s));
+    }
+    for (int i = 0; i < HOT_WRITES; i++) {
+        CHECK(write(random_sector(sectors)));
+        if (i % 50 == 0) {
+            // idle now and then
+            CHECK(ftl->collect(FLASH_FTL_FREE_BLOCKS) >= 0);
+        }
+    }
+    FlashFTLStats stats;
+    ftl->stats(&stats);
+    uint32_t min = 0xFFFFFFFF, max = 0;
+    for (uint32_t b = 0; b < nor->blocks(); b++) {
+        if (nor->erases(b) < min) min = nor->erases(b);
+        if (nor->erases(b) > max) max = nor->erases(b);
+    }
+    LONGS_EQUAL(min, stats.min_erases);
+    LONGS_EQUAL(max, stats.max_erases);
+    // the blocks of cold sectors get their turn
+    CHECK(max - min <= 2 * FLASH_FTL_WEAR_DELTA);
+    LONGS_EQUAL(0, nor->bad_programs());
+    remount();
+    check_all();
+
+    uint64_t us = nor->elapsed_us();
+    printf("%d writes: write amplification %d.%02d, erases %d to %d (mean %d), %d KB/s\r\n",
+           (int)stats.sectors_written,
+           (int)(stats.pages_programmed / stats.sectors_written),
+           (int)(stats.pages_programmed * 100 / stats.sectors_written % 100),
+           (int)min, (int)max, (int)stats.mean_erases,
+           (int)((uint64_t)stats.sectors_written * 512 * 1000000 / (us ? us : 1) / 1024));
+}
+
+TEST(FlashFTL, worn_out)
+{
+    // the wear is spread so that the blocks wear out together, and what
+    // was written is still there when writes start failing
+    const uint32_t cycles = 300;
+    nor->set_endurance(cycles);
+    for (uint32_t s = 0; s < sectors; s++) {
+        CHECK(write(s));
+    }
+    int writes = 0;
+    while ((writes < 2 * HOT_WRITES) && write(random_sector(sectors))) {
+        writes++;
+    }
+    CHECK(writes < 2 * HOT_WRITES);
+    uint32_t min = 0xFFFFFFFF;
+    for (uint32_t b = 0; b < nor->blocks(); b++) {
+        if (nor->erases(b) < min) min = nor->erases(b);
+    }
+    CHECK(min + FLASH_FTL_WEAR_DELTA >= cycles);
+    FlashFTLStats stats;
+    ftl->stats(&stats);
+    printf("%d writes until the flash wore out, %d blocks bad, the least erased %d times of %d\r\n",
+           writes, (int)stats.bad_blocks, (int)min, (int)cycles);
+    check_all();
+
+    // the bad blocks are known again after a remount
+    CHECK(stats.bad_blocks > 0);
+    remount();
+    FlashFTLStats after;
+    ftl->stats(&after);
+    LONGS_EQUAL(stats.bad_blocks, after.bad_blocks);
+    check_all();
+    LONGS_EQUAL(0, nor->bad_programs());
+}
+
+TEST(FlashFTL, fat)
+{
+    fat(1);
+}
+
+TEST(FlashFTL, fat_ecc_flash)
+{
+    fat(16);
+}
@@ -0,0 +1,324 @@
+/* Checks HTTPResponseParser on canned responses, fed in one piece and one
+ * byte at a time the way short TLS records deliver them, and prints the
+ * header parse throughput and the time to take a keep-alive response from
+ * a stand-in server's records. Nothing else here is mbed specific, so the
+ * same file also runs under CppUTest on the host. */
+#include "TestHarness.h"
+#include <stdio.h>
+#include <string.h>
+#include "HTTPResponseParser.h"
+
+#ifdef __MBED__
+#include "mbed.h"
+#else
+#include <time.h>
+#endif
+
+namespace {
+
+const int PARSES = 2000;
+
+#ifdef __MBED__
+Timer timer;
+
+void timer_start() {
+    timer.reset();
+    timer.start();
+}
+
+int timer_us() {
+    return timer.read_us();
+}
+#else
+clock_t started;
+
+void timer_start() {
+    started = clock();
+}
+
+int timer_us() {
+    return (int)((clock() - started) * 1000000LL / CLOCKS_PER_SEC);
+}
+#endif
+
+const char response_length[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Server: stand-in\r\n"
+    "content-length: 11\r\n"
+    "\r\n"
+    "hello world";
+
+const char response_chunked[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Transfer-Encoding: chunked\r\n"
+    "\r\n"
+    "5;name=value\r\n"
+    "hello\r\n"
+    "6\r\n"
+    " world\r\n"
+    "0\r\n"
+    "Trailer: ignored\r\n"
+    "\r\n";
+
+// Feeds the response in pieces of step bytes, returns the number of bytes consumed
+int feed(HTTPResponseParser &parser, const char *data, int len, int step,
+         char *body, int body_len, int *body_total)
+{
+    int pos = 0;
+    *body_total = 0;
+    while (pos < len && !parser.done() && !parser.failed()) {
+        int n = (len - pos < step) ? len - pos : step;
+        int body_read;
+        int used = parser.parse(data + pos, n, body + *body_total, body_len - *body_total, &body_read);
+        *body_total += body_read;
+        pos += used;
+        if (used < n)
+            break;
+    }
+    return pos;
+}
+
+}
+
+TEST_GROUP(HTTPResponseParser)
+{
+    HTTPHeader header;
+    HTTPResponseParser parser;
+    char body[64];
+    int body_len;
+
+    void setup()
+    {
+        parser.reset(&header);
+        memset(body, 0, sizeof(body));
+        body_len = 0;
+    }
+};
+
+TEST(HTTPResponseParser, content_length)
+{
+    int used = feed(parser, response_length, sizeof(response_length) - 1, 512, body, sizeof(body), &body_len);
+    LONGS_EQUAL(sizeof(response_length) - 1, used);
+    CHECK(parser.done());
+    LONGS_EQUAL(200, header.getStatusCode());
+    LONGS_EQUAL(11, header.getBodyLength());
+    CHECK(header.isKeepAlive());
+    LONGS_EQUAL(11, body_len);
+    MEMCMP_EQUAL("hello world", body, 11);
+}
+
+TEST(HTTPResponseParser, content_length_byte_by_byte)
+{
+    feed(parser, response_length, sizeof(response_length) - 1, 1, body, sizeof(body), &body_len);
+    CHECK(parser.done());
+    LONGS_EQUAL(11, body_len);
+    MEMCMP_EQUAL("hello world", body, 11);
+}
+
+TEST(HTTPResponseParser, fields_are_case_insensitive)
+{
+    feed(parser, response_length, sizeof(response_length) - 1, 512, body, sizeof(body), &body_len);
+    STRCMP_EQUAL("stand-in", header.findField("server"));
+    STRCMP_EQUAL("11", header.findField("Content-Length"));
+    POINTERS_EQUAL(NULL, header.findField("Content-Type"));
+}
+
+TEST(HTTPResponseParser, chunked)
+{
+    feed(parser, response_chunked, sizeof(response_chunked) - 1, 512, body, sizeof(body), &body_len);
+    CHECK(parser.done());
+    CHECK(header.isChunked());
+    LONGS_EQUAL(-1, header.getBodyLength());
+    LONGS_EQUAL(11, body_len);
+    MEMCMP_EQUAL("hello world", body, 11);
+}
+
+TEST(HTTPResponseParser, chunked_byte_by_byte)
+{
+    feed(parser, response_chunked, sizeof(response_chunked) - 1, 1, body, sizeof(body), &body_len);
+    CHECK(parser.done());
+    LONGS_EQUAL(11, body_len);
+    MEMCMP_EQUAL("hello world", body, 11);
+}
+
+TEST(HTTPResponseParser, stops_at_end_of_header_without_body_buffer)
+{
+    int body_read;
+    int used = parser.parse(response_length, sizeof(response_length) - 1, NULL, 0, &body_read);
+    CHECK(parser.headerDone());
+    CHECK(!parser.done());
+    LONGS_EQUAL(sizeof(response_length) - 1 - 11, used);
+    LONGS_EQUAL(0, body_read);
+    LONGS_EQUAL(11, parser.bodyDirect());
+
+    // The body can then be read straight from the transport
+    parser.bodyConsumed(11);
+    CHECK(parser.done());
+}
+
+TEST(HTTPResponseParser, small_body_buffer)
+{
+    int body_read;
+    int used = parser.parse(response_length, sizeof(response_length) - 1, body, 4, &body_read);
+    LONGS_EQUAL(4, body_read);
+    CHECK(!parser.done());
+    used += parser.parse(response_length + used, sizeof(response_length) - 1 - used, body + 4, 60, &body_read);
+    LONGS_EQUAL(7, body_read);
+    CHECK(parser.done());
+    MEMCMP_EQUAL("hello world", body, 11);
+}
+
+TEST(HTTPResponseParser, back_to_back_responses)
+{
+    char data[sizeof(response_length) + sizeof(response_chunked)];
+    int len = sizeof(response_length) - 1;
+    memcpy(data, response_length, len);
+    memcpy(data + len, response_chunked, sizeof(response_chunked) - 1);
+
+    int used = feed(parser, data, len + sizeof(response_chunked) - 1, 512, body, sizeof(body), &body_len);
+    LONGS_EQUAL(len, used);
+    CHECK(parser.done());
+
+    // The next response on the same keep-alive connection
+    parser.reset(&header);
+    feed(parser, data + used, sizeof(response_chunked) - 1, 512, body, sizeof(body), &body_len);
+    CHECK(parser.done());
+    CHECK(header.isChunked());
+    MEMCMP_EQUAL("hello world", body, 11);
+}
+
+TEST(HTTPResponseParser, connection_close)
+{
+    const char response[] = "HTTP/1.1 404 Not Found\r\nConnection: close\r\nContent-Length: 0\r\n\r\n";
+    feed(parser, response, sizeof(response) - 1, 512, body, sizeof(body), &body_len);
+    CHECK(parser.done());
+    LONGS_EQUAL(404, header.getStatusCode());
+    CHECK(!header.isKeepAlive());
+}
+
+TEST(HTTPResponseParser, http_1_0)
+{
+    const char response[] = "HTTP/1.0 200 OK\r\nContent-Length: 0\r\n\r\n";
+    feed(parser, response, sizeof(response) - 1, 512, body, sizeof(body), &body_len);
+    CHECK(parser.done());
+    CHECK(!header.isKeepAlive());
+
+    const char keep_alive[] = "HTTP/1.0 200 OK\r\nConnection: Keep-Alive\r\nContent-Length: 0\r\n\r\n";
+    parser.reset(&header);
+    feed(parser, keep_alive, sizeof(keep_alive) - 1, 512, body, sizeof(body), &body_len);
+    CHECK(header.isKeepAlive());
+}
+
+TEST(HTTPResponseParser, body_until_close)
+{
+    const char response[] = "HTTP/1.1 200 OK\r\n\r\nuntil the end";
+    feed(parser, response, sizeof(response) - 1, 512, body, sizeof(body), &body_len);
+    CHECK(!parser.done());
+    LONGS_EQUAL(13, body_len);
+    CHECK(!header.isKeepAlive());
+    parser.connectionClosed();
+    CHECK(parser.done());
+}
+
+TEST(HTTPResponseParser, interim_response)
+{
+    const char response[] = "HTTP/1.1 100 Continue\r\n\r\nHTTP/1.1 204 No Content\r\n\r\n";
+    int used = feed(parser, response, sizeof(response) - 1, 512, body, sizeof(body), &body_len);
+    LONGS_EQUAL(sizeof(response) - 1, used);
+    CHECK(parser.done());
+    LONGS_EQUAL(204, header.getStatusCode());
+}
+
+TEST(HTTPResponseParser, fields_that_dont_fit_are_still_interpreted)
+{
+    char response[HTTP_HEADER_FIELDS_SIZE + 128] = "HTTP/1.1 200 OK\r\nX-Padding: ";
+    int len = strlen(response);
+    memset(response + len, 'x', HTTP_HEADER_FIELDS_SIZE - 16);
+    strcpy(response + len + HTTP_HEADER_FIELDS_SIZE - 16, "\r\nContent-Length: 2\r\n\r\nok");
+
+    feed(parser, response, strlen(response), 512, body, sizeof(body), &body_len);
+    CHECK(parser.done());
+    POINTERS_EQUAL(NULL, header.findField("Content-Length"));
+    LONGS_EQUAL(2, header.getBodyLength());
+    MEMCMP_EQUAL("ok", body, 2);
+}
+
+TEST(HTTPResponseParser, malformed_status_line)
+{
+    const char response[] = "HTTP/1.1 2x0 OK\r\n\r\n";
+    feed(parser, response, sizeof(response) - 1, 512, body, sizeof(body), &body_len);
+    CHECK(parser.failed());
+    CHECK(!parser.headerDone());
+}
+
+TEST(HTTPResponseParser, malformed_chunk_size)
+{
+    const char response[] = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n";
+    feed(parser, response, sizeof(response) - 1, 512, body, sizeof(body), &body_len);
+    CHECK(parser.failed());
+}
+
+TEST(HTTPResponseParser, truncated_body)
+{
+    feed(parser, response_length, sizeof(response_length) - 4, 512, body, sizeof(body), &body_len);
+    CHECK(!parser.done());
+    parser.connectionClosed();
+    CHECK(parser.failed());
+}
+
+TEST(HTTPResponseParser, per_second)
+{
+    // a typical header, and a 1 KB chunked response as a server would send it
+    const char header_only[] =
+        "HTTP/1.1 200 OK\r\n"
+        "Server: stand-in\r\n"
+        "Date: Mon, 19 Oct 2015 10:00:00 GMT\r\n"
+        "Content-Type: application/json\r\n"
+        "Cache-Control: no-cache\r\n"
+        "Content-Length: 0\r\n"
+        "Connection: keep-alive\r\n"
+        "\r\n";
+    static char response[1280];
+    int len = sprintf(response, "HTTP/1.1 200 OK\r\nServer: stand-in\r\nTransfer-Encoding: chunked\r\n\r\n");
+    for (int i = 0; i < 4; i++) {
+        len += sprintf(response + len, "100\r\n");
+        memset(response + len, 'a' + i, 256);
+        len += 256;
+        len += sprintf(response + len, "\r\n");
+    }
+    len += sprintf(response + len, "0\r\n\r\n");
+    char data[1024];
+    int data_len;
+
+    timer_start();
+    for (int i = 0; i < PARSES; i++) {
+        parser.reset(&header);
+        feed(parser, header_only, sizeof(header_only) - 1, 512, body, sizeof(body), &body_len);
+    }
+    int header_us = timer_us();
+    CHECK(parser.done());
+
+    // the stand-in's records of 256 bytes, as reads of them return, on one connection
+    timer_start();
+    for (int i = 0; i < PARSES; i++) {
+        parser.reset(&header);
+        feed(parser, response, len, 256, data, sizeof(data), &data_len);
+    }
+    int record_us = timer_us();
+    CHECK(parser.done());
+    LONGS_EQUAL(1024, data_len);
+
+    // and a byte per read, as HTTPSClient used to read the header
+    timer_start();
+    for (int i = 0; i < PARSES; i++) {
+        parser.reset(&header);
+        feed(parser, response, len, 1, data, sizeof(data), &data_len);
+    }
+    int byte_us = timer_us();
+    CHECK(parser.done());
+
+    printf("Headers of %d bytes: %d KB/s; %d byte responses: %d.%d us each in records, %d.%d us a byte at a time\r\n",
+           (int)sizeof(header_only) - 1,
+           (int)((long long)PARSES * (sizeof(header_only) - 1) * 1000000 / 1024 / (header_us ? header_us : 1)),
+           len, record_us / PARSES, record_us * 10 / PARSES % 10, byte_us / PARSES, byte_us * 10 / PARSES % 10);
+}
@@ -16,34 +16,11 @@
 #include <stdio.h>
 #include "TestHarness.h"
 #include "mbed.h"
+#include "sim_eeprom.h"
 
 /* EEPROM 24LC256 Test Unit, to test I2C asynchronous communication.
  */
 
-#if !DEVICE_I2C || !DEVICE_I2C_ASYNCH
-#error i2c_master_eeprom_asynch requires asynch I2C
-#endif
-
-#if defined(TARGET_K64F)
-#define TEST_SDA_PIN PTE25
-#define TEST_SCL_PIN PTE24
-
-#elif defined(TARGET_EFM32LG_STK3600) || defined(TARGET_EFM32GG_STK3700) || defined(TARGET_EFM32WG_STK3800)
-#define TEST_SDA_PIN PD6
-#define TEST_SCL_PIN PD7
-
-#elif defined(TARGET_EFM32ZG_STK3200)
-#define TEST_SDA_PIN PE12
-#define TEST_SCL_PIN PE13
-
-#elif defined(TARGET_EFM32HG_STK3400)
-#define TEST_SDA_PIN PD6
-#define TEST_SCL_PIN PD7
-
-#else
-#error Target not supported
-#endif
-
 #define PATTERN_MASK 0x66, ~0x66, 0x00, 0xFF, 0xA5, 0x5A, 0xF0, 0x0F
 
 volatile int why;
@@ -62,6 +39,9 @@ TEST_GROUP(I2C_Master_EEPROM_Asynchronous)
     event_callback_t callback;
 
     void setup() {
+#if I2C_EEPROM_SIMULATED
+        sim_eeprom_reset();
+#endif
         obj = new I2C(TEST_SDA_PIN, TEST_SCL_PIN);
         obj->frequency(400000);
         complete = false;
@@ -0,0 +1,188 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "TestHarness.h"
+#include "mbed.h"
+#include "sim_eeprom.h"
+
+/* Transfers queued by two I2C objects on the bus of the EEPROM, one at
+ * 400kHz and one at 100kHz, each a write of the memory address then a read
+ * after a repeated start.
+ */
+
+#if TRANSACTION_QUEUE_SIZE_I2C
+
+namespace {
+
+const int eeprom_address = 0xA0;
+const char pattern[] = { 0x66, ~0x66, 0x00, 0xFF, 0xA5, 0x5A, 0xF0, 0x0F };
+
+volatile int done;
+
+struct Transfer {
+    Transfer() : order(-1), event(0) {
+        callback.attach(this, &Transfer::handler);
+    }
+
+    void handler(int e) {
+        order = done++;
+        event = e;
+    }
+
+    char address[2];
+    char data[2];
+    int order;
+    int event;
+    event_callback_t callback;
+};
+
+void wait_for(int transfers) {
+    while (done < transfers) {
+        sleep();
+    }
+}
+
+}
+
+TEST_GROUP(I2C_Master_Queue)
+{
+    I2C *fast;
+    I2C *slow;
+
+    void setup() {
+#if I2C_EEPROM_SIMULATED
+        sim_eeprom_reset();
+#endif
+        fast = new I2C(TEST_SDA_PIN, TEST_SCL_PIN);
+        fast->frequency(400000);
+        slow = new I2C(TEST_SDA_PIN, TEST_SCL_PIN);
+        slow->frequency(100000);
+        done = 0;
+
+        // the pattern at 0x0100
+        char data[2 + sizeof(pattern)] = { 0x01, 0x00 };
+        memcpy(&data[2], pattern, sizeof(pattern));
+        Transfer write;
+        CHECK_EQUAL(0, fast->transfer(eeprom_address, data, sizeof(data), NULL, 0, write.callback, I2C_EVENT_ALL));
+        wait_for(1);
+        CHECK_EQUAL(I2C_EVENT_TRANSFER_COMPLETE, write.event);
+        wait_ms(10);
+
+        done = 0;
+        fast->reset_statistics();
+        slow->reset_statistics();
+    }
+
+    void teardown() {
+        fast->abort_all_transfers();
+        delete fast;
+        delete slow;
+    }
+
+    int read(I2C *i2c, Transfer *t, int offset) {
+        t->address[0] = 0x01;
+        t->address[1] = offset;
+        t->data[0] = t->data[1] = 0;
+        return i2c->transfer(eeprom_address, t->address, 2, t->data, 2, t->callback, I2C_EVENT_ALL);
+    }
+};
+
+TEST(I2C_Master_Queue, transfers_of_two_devices_complete_in_order)
+{
+    Transfer t[4];
+
+#if I2C_EEPROM_SIMULATED
+    int transfers = sim_eeprom_transfers();
+    int irq_starts = sim_eeprom_irq_starts();
+#endif
+    for (int i = 0; i < 4; i++) {
+        CHECK_EQUAL(0, read((i & 1) ? slow : fast, &t[i], i * 2));
+    }
+    wait_for(4);
+
+    for (int i = 0; i < 4; i++) {
+        CHECK_EQUAL(i, t[i].order);
+        CHECK_EQUAL(I2C_EVENT_TRANSFER_COMPLETE, t[i].event);
+        CHECK_EQUAL(0, memcmp(&pattern[i * 2], t[i].data, 2));
+    }
+
+    // the first started from the call, the others from the interrupts
+    CHECK_EQUAL(2, fast->statistics().transfers);
+    CHECK_EQUAL(1, fast->statistics().queued);
+    CHECK_EQUAL(8, fast->statistics().bytes);
+    CHECK_EQUAL(2, slow->statistics().transfers);
+    CHECK_EQUAL(2, slow->statistics().queued);
+    CHECK_EQUAL(0, slow->statistics().errors);
+    CHECK(slow->statistics().busy_us > 2 * fast->statistics().busy_us);
+
+#if I2C_EEPROM_SIMULATED
+    CHECK_EQUAL(transfers + 4, sim_eeprom_transfers());
+    CHECK_EQUAL(irq_starts + 3, sim_eeprom_irq_starts());
+    for (int i = 0; i < 4; i++) {
+        CHECK_EQUAL((i & 1) ? 100000 : 400000, sim_eeprom_transfer_hz(transfers + i));
+    }
+#endif
+}
+
+TEST(I2C_Master_Queue, frequency_is_set_when_the_device_changes)
+{
+    Transfer t[4];
+
+#if I2C_EEPROM_SIMULATED
+    int changes = sim_eeprom_frequency_changes();
+#endif
+    CHECK_EQUAL(0, read(slow, &t[0], 0));
+    CHECK_EQUAL(0, read(slow, &t[1], 2));
+    CHECK_EQUAL(0, read(fast, &t[2], 4));
+    CHECK_EQUAL(0, read(fast, &t[3], 6));
+    wait_for(4);
+
+    CHECK_EQUAL(0, memcmp(pattern, t[0].data, 2));
+    CHECK_EQUAL(0, memcmp(&pattern[6], t[3].data, 2));
+#if I2C_EEPROM_SIMULATED
+    CHECK_EQUAL(changes + 2, sim_eeprom_frequency_changes());
+#endif
+}
+
+TEST(I2C_Master_Queue, full_queue)
+{
+    Transfer t[TRANSACTION_QUEUE_SIZE_I2C + 2];
+
+    for (int i = 0; i < TRANSACTION_QUEUE_SIZE_I2C + 1; i++) {
+        CHECK_EQUAL(0, read(fast, &t[i], 0));
+    }
+    CHECK_EQUAL(-1, read(fast, &t[TRANSACTION_QUEUE_SIZE_I2C + 1], 0));
+    wait_for(TRANSACTION_QUEUE_SIZE_I2C + 1);
+
+    CHECK_EQUAL(TRANSACTION_QUEUE_SIZE_I2C + 1, fast->statistics().transfers);
+    CHECK_EQUAL(-1, t[TRANSACTION_QUEUE_SIZE_I2C + 1].order);
+}
+
+TEST(I2C_Master_Queue, missing_slave_does_not_stop_the_queue)
+{
+    Transfer t[2];
+    char data[2] = { 0x01, 0x00 };
+
+    CHECK_EQUAL(0, fast->transfer(0x42, data, 2, NULL, 0, t[0].callback, I2C_EVENT_ALL));
+    CHECK_EQUAL(0, read(slow, &t[1], 0));
+    wait_for(2);
+
+    CHECK_EQUAL(I2C_EVENT_ERROR_NO_SLAVE, t[0].event);
+    CHECK_EQUAL(1, fast->statistics().errors);
+    CHECK_EQUAL(I2C_EVENT_TRANSFER_COMPLETE, t[1].event);
+    CHECK_EQUAL(0, memcmp(pattern, t[1].data, 2));
+}
+
+#endif
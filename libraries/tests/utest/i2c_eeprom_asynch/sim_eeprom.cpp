@@ -0,0 +1,228 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sim_eeprom.h"
+
+#if I2C_EEPROM_SIMULATED
+
+#include "us_ticker_api.h"
+
+/* The I2C HAL of the target is left out of the link as these functions
+ * take its place. The bus has one 24LC256 at 0xA0: the first two bytes
+ * written are the memory address, the next ones are written in its 64
+ * byte page and reads go on from the address. A transfer lasts the time of
+ * its bits at the bus frequency and ends with an interrupt from a Timeout,
+ * and the EEPROM doesn't acknowledge its address during the 5ms write
+ * cycle which follows the stop of a write. */
+
+namespace {
+
+const int eeprom_address = 0xA0;
+const uint32_t page_size = 64;
+const uint32_t write_cycle_us = 5000;
+
+char memory[SIM_EEPROM_SIZE];
+uint32_t pointer;
+bool pending_write;
+bool writing;
+uint32_t write_end;
+
+int hz = 100000;
+int frequency_changes;
+int transfer_hz[SIM_EEPROM_LOG];
+int transfers;
+int irq_starts;
+
+Timeout bus;
+bool active;
+bool in_irq;
+uint32_t handler;
+uint32_t result;
+
+bool acknowledge(int address) {
+    if ((address & 0xFE) != eeprom_address) {
+        return false;
+    }
+    if (writing && ((int32_t)(us_ticker_read() - write_end) < 0)) {
+        return false;
+    }
+    writing = false;
+    return true;
+}
+
+void write_bytes(const char *data, int length) {
+    for (int i = 0; i < length; i++) {
+        if (i == 0) {
+            pointer = ((data[i] << 8) & (SIM_EEPROM_SIZE - 1)) | (pointer & 0xFF);
+        } else if (i == 1) {
+            pointer = (pointer & 0xFF00) | (uint8_t)data[i];
+        } else {
+            memory[pointer] = data[i];
+            pointer = (pointer & ~(page_size - 1)) | ((pointer + 1) & (page_size - 1));
+            pending_write = true;
+        }
+    }
+}
+
+void read_bytes(char *data, int length) {
+    for (int i = 0; i < length; i++) {
+        data[i] = memory[pointer];
+        pointer = (pointer + 1) % SIM_EEPROM_SIZE;
+    }
+}
+
+// The write cycle starts from the stop, done at end
+void stop(uint32_t end) {
+    if (pending_write) {
+        pending_write = false;
+        writing = true;
+        write_end = end + write_cycle_us;
+    }
+}
+
+void end_of_transfer(void) {
+    in_irq = true;
+    ((void (*)(void))handler)();
+    in_irq = false;
+}
+
+}
+
+void sim_eeprom_reset(void) {
+    bus.detach();
+    active = false;
+    memset(memory, 0xFF, sizeof(memory));
+    pointer = 0;
+    pending_write = false;
+    writing = false;
+    frequency_changes = 0;
+    transfers = 0;
+    irq_starts = 0;
+}
+
+int sim_eeprom_frequency_changes(void) {
+    return frequency_changes;
+}
+
+int sim_eeprom_transfer_hz(int n) {
+    return (n < SIM_EEPROM_LOG) ? transfer_hz[n] : 0;
+}
+
+int sim_eeprom_transfers(void) {
+    return transfers;
+}
+
+int sim_eeprom_irq_starts(void) {
+    return irq_starts;
+}
+
+void i2c_init(i2c_t *obj, PinName sda, PinName scl) {
+    hz = 100000;
+}
+
+void i2c_frequency(i2c_t *obj, int frequency) {
+    hz = frequency;
+    frequency_changes++;
+}
+
+int i2c_start(i2c_t *obj) {
+    return 0;
+}
+
+int i2c_stop(i2c_t *obj) {
+    stop(us_ticker_read());
+    return 0;
+}
+
+int i2c_read(i2c_t *obj, int address, char *data, int length, int stop_at_end) {
+    if (!acknowledge(address)) {
+        return -1;
+    }
+    read_bytes(data, length);
+    if (stop_at_end) {
+        stop(us_ticker_read());
+    }
+    return length;
+}
+
+int i2c_write(i2c_t *obj, int address, const char *data, int length, int stop_at_end) {
+    if (!acknowledge(address)) {
+        return -1;
+    }
+    write_bytes(data, length);
+    if (stop_at_end) {
+        stop(us_ticker_read());
+    }
+    return length;
+}
+
+void i2c_reset(i2c_t *obj) {
+}
+
+int i2c_byte_read(i2c_t *obj, int last) {
+    char data;
+    read_bytes(&data, 1);
+    return data;
+}
+
+int i2c_byte_write(i2c_t *obj, int data) {
+    return 1;
+}
+
+void i2c_transfer_asynch(i2c_t *obj, const void *tx, size_t tx_length, void *rx, size_t rx_length, uint32_t address, uint32_t stop_at_end, uint32_t irq, uint32_t event, DMAUsage hint) {
+    if (active) {
+        return;
+    }
+    if (transfers < SIM_EEPROM_LOG) {
+        transfer_hz[transfers] = hz;
+    }
+    transfers++;
+    irq_starts += in_irq ? 1 : 0;
+
+    // 9 bits a byte, with the address sent again before reading
+    uint32_t bits = 9;
+    if (acknowledge(address)) {
+        write_bytes((const char *)tx, tx_length);
+        read_bytes((char *)rx, rx_length);
+        bits += 9 * (tx_length + rx_length + ((tx_length && rx_length) ? 1 : 0));
+        result = I2C_EVENT_TRANSFER_COMPLETE & event;
+    } else {
+        result = I2C_EVENT_ERROR_NO_SLAVE & event;
+    }
+    uint32_t us = bits * 1000000 / hz;
+    if (stop_at_end) {
+        stop(us_ticker_read() + us);
+    }
+
+    active = true;
+    handler = irq;
+    bus.attach_us(&end_of_transfer, us);
+}
+
+uint32_t i2c_irq_handler_asynch(i2c_t *obj) {
+    active = false;
+    return result;
+}
+
+uint8_t i2c_active(i2c_t *obj) {
+    return active;
+}
+
+void i2c_abort_asynch(i2c_t *obj) {
+    bus.detach();
+    active = false;
+}
+
+#endif
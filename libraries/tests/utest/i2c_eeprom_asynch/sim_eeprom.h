@@ -0,0 +1,58 @@
+/* The pins of the 24LC256 the test talks to, or, on the targets without
+ * one wired, a 24LC256 on a simulated bus replacing the I2C HAL. */
+#ifndef SIM_EEPROM_H
+#define SIM_EEPROM_H
+
+#include "mbed.h"
+
+#if !DEVICE_I2C || !DEVICE_I2C_ASYNCH
+#error i2c_master_eeprom_asynch requires asynch I2C
+#endif
+
+#if defined(I2C_EEPROM_SIMULATED)
+#define TEST_SDA_PIN NC
+#define TEST_SCL_PIN NC
+
+#elif defined(TARGET_K64F)
+#define TEST_SDA_PIN PTE25
+#define TEST_SCL_PIN PTE24
+
+#elif defined(TARGET_EFM32LG_STK3600) || defined(TARGET_EFM32GG_STK3700) || defined(TARGET_EFM32WG_STK3800)
+#define TEST_SDA_PIN PD6
+#define TEST_SCL_PIN PD7
+
+#elif defined(TARGET_EFM32ZG_STK3200)
+#define TEST_SDA_PIN PE12
+#define TEST_SCL_PIN PE13
+
+#elif defined(TARGET_EFM32HG_STK3400)
+#define TEST_SDA_PIN PD6
+#define TEST_SCL_PIN PD7
+
+#else
+#define I2C_EEPROM_SIMULATED 1
+#define TEST_SDA_PIN NC
+#define TEST_SCL_PIN NC
+#endif
+
+#if I2C_EEPROM_SIMULATED
+
+#define SIM_EEPROM_SIZE    32768
+#define SIM_EEPROM_LOG     16
+
+// Erases the EEPROM and forgets the transfers, with the bus idle
+void sim_eeprom_reset(void);
+
+// Number of times the bus frequency was set
+int sim_eeprom_frequency_changes(void);
+
+// Frequency of the nth asynchronous transfer since the reset
+int sim_eeprom_transfer_hz(int n);
+
+// Asynchronous transfers since the reset, and those started from the interrupt ending another
+int sim_eeprom_transfers(void);
+int sim_eeprom_irq_starts(void);
+
+#endif
+
+#endif
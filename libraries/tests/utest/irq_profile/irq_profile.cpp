@@ -0,0 +1,113 @@
+/* The aggregation of the interrupt profiler, fed with made up times, and
+ * the tracking of the critical sections. */
+#include "TestHarness.h"
+#include "mbed.h"
+#include "irq_profile.h"
+
+namespace {
+
+const char FILE_A[] = "a.c";
+const char FILE_B[] = "b.c";
+
+}
+
+TEST_GROUP(IrqProfile)
+{
+    void setup() {
+        irq_profile_reset();
+    }
+
+    void teardown() {
+        irq_profile_reset();
+    }
+};
+
+TEST(IrqProfile, irq_count_max_and_mean)
+{
+    irq_profile_record_irq(0, 10);
+    irq_profile_record_irq(0, 30);
+    irq_profile_record_irq(0, 20);
+
+    const irq_profile_stat_t *stat = irq_profile_irq(0);
+    CHECK(stat != NULL);
+    LONGS_EQUAL(3, stat->count);
+    LONGS_EQUAL(30, stat->max);
+    LONGS_EQUAL(20, irq_profile_mean(stat));
+    LONGS_EQUAL(0, irq_profile_irq(1)->count);
+
+    // the ones without a vector are left out
+    irq_profile_record_irq(-1, 10);
+    CHECK(irq_profile_irq(-1) == NULL);
+    CHECK(irq_profile_irq(100000) == NULL);
+}
+
+TEST(IrqProfile, critical_sites_in_order_of_first_use)
+{
+    irq_profile_record_critical(FILE_A, 10, 5);
+    irq_profile_record_critical(FILE_B, 10, 7);
+    irq_profile_record_critical(FILE_A, 10, 9);
+    irq_profile_record_critical(FILE_A, 11, 1);
+
+    uint32_t count;
+    const irq_profile_site_t *sites = irq_profile_sites(&count);
+    LONGS_EQUAL(3, count);
+    CHECK(sites[0].file == FILE_A);
+    LONGS_EQUAL(10, sites[0].line);
+    LONGS_EQUAL(2, sites[0].stat.count);
+    LONGS_EQUAL(9, sites[0].stat.max);
+    LONGS_EQUAL(7, irq_profile_mean(&sites[0].stat));
+    CHECK(sites[1].file == FILE_B);
+    LONGS_EQUAL(11, sites[2].line);
+}
+
+TEST(IrqProfile, sites_past_the_table_are_counted_together)
+{
+    for (int line = 0; line < IRQ_PROFILE_SITES + 3; line++) {
+        irq_profile_record_critical(FILE_A, line, line);
+    }
+
+    uint32_t count;
+    const irq_profile_site_t *sites = irq_profile_sites(&count);
+    LONGS_EQUAL(IRQ_PROFILE_SITES + 1, count);
+    CHECK(sites[IRQ_PROFILE_SITES].file == NULL);
+    LONGS_EQUAL(3, sites[IRQ_PROFILE_SITES].stat.count);
+    LONGS_EQUAL(IRQ_PROFILE_SITES + 2, sites[IRQ_PROFILE_SITES].stat.max);
+
+    irq_profile_reset();
+    irq_profile_sites(&count);
+    LONGS_EQUAL(0, count);
+}
+
+TEST(IrqProfile, section_lasts_from_first_enter_to_next_exit)
+{
+    irq_profile_critical_enter(FILE_A, 1);
+    irq_profile_critical_enter(FILE_B, 2);
+    irq_profile_critical_exit();
+    irq_profile_critical_exit();
+
+    uint32_t count;
+    const irq_profile_site_t *sites = irq_profile_sites(&count);
+    LONGS_EQUAL(1, count);
+    CHECK(sites[0].file == FILE_A);
+    LONGS_EQUAL(1, sites[0].stat.count);
+}
+
+TEST(IrqProfile, basepri_and_primask_sections_overlap)
+{
+    // a PRIMASK section inside a BASEPRI one, and one ending after it
+    irq_profile_basepri_enter(FILE_A, 1);
+    irq_profile_critical_enter(FILE_B, 2);
+    irq_profile_critical_exit();
+    irq_profile_critical_enter(FILE_B, 3);
+    irq_profile_basepri_exit();
+    irq_profile_critical_exit();
+
+    uint32_t count;
+    const irq_profile_site_t *sites = irq_profile_sites(&count);
+    LONGS_EQUAL(3, count);
+    CHECK(sites[0].file == FILE_B);
+    LONGS_EQUAL(2, sites[0].line);
+    CHECK(sites[1].file == FILE_A);
+    LONGS_EQUAL(1, sites[1].line);
+    LONGS_EQUAL(3, sites[2].line);
+}
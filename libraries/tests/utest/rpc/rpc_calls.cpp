@@ -0,0 +1,245 @@
+/* Checks the hashed lookups and the binary framing of the RPC library against
+ * the text calls they replace, and compares the calls per second of both. */
+#include "TestHarness.h"
+#include "mbed.h"
+#include "mbed_rpc.h"
+
+namespace {
+
+const int OBJECTS = 32;
+const int CALLS = 10000;
+
+class RpcMath : public RPC {
+public:
+    static int add(int a, int b) {return a + b;}
+
+    static struct rpc_class *get_rpc_class() {
+        static const rpc_function funcs[] = {
+            {"add", rpc_function_caller<int, int, int, &RpcMath::add>},
+            RPC_METHOD_END
+        };
+        static rpc_class c = {"Math", funcs, NULL};
+        return &c;
+    }
+};
+
+void triple(Arguments *args, Reply *reply) {
+    reply->putData<float>(args->getArg<float>() * 3.0f);
+}
+
+// Builds a request for handle with the int arguments given
+uint32_t request(uint8_t *frame, int handle, int argc, const int *argv) {
+    uint32_t n = 0;
+    frame[n++] = RPC_BINARY_START;
+    frame[n++] = 0;
+    frame[n++] = handle;
+    frame[n++] = argc;
+    for (int i = 0; i < argc; i++) {
+        for (int b = 0; b < 4; b++) {
+            frame[n++] = (uint32_t)argv[i] >> (8 * b);
+        }
+    }
+    frame[1] = n - 2;
+    return n;
+}
+
+int reply_int(const uint8_t *reply) {
+    return reply[3] | (reply[4] << 8) | (reply[5] << 16) | (reply[6] << 24);
+}
+
+}
+
+TEST_GROUP(RPC)
+{
+    char out[RPC_MAX_STRING];
+    uint8_t frame[RPC_MAX_STRING];
+    uint8_t reply[RPC_MAX_STRING];
+
+    bool text(const char *in, const char *expected) {
+        memset(out, 0, sizeof(out));
+        return RPC::call(in, out) && (strcmp(out, expected) == 0);
+    }
+};
+
+TEST(RPC, text_calls)
+{
+    int v = 0;
+    RPCVariable<int> rpc_v(&v, "v");
+
+    CHECK(text("/v/write 5", ""));
+    LONGS_EQUAL(5, v);
+    CHECK(text("/v/read", "5"));
+    CHECK(text("/v", "read write delete"));
+    CHECK(!RPC::call("/v/none", out));
+    CHECK(!RPC::call("/none/read", out));
+}
+
+TEST(RPC, lookup_among_many_objects)
+{
+    int values[OBJECTS];
+    RPCVariable<int> *vars[OBJECTS];
+    char name[8];
+
+    for (int i = 0; i < OBJECTS; i++) {
+        values[i] = i * 3;
+        sprintf(name, "v%d", i);
+        vars[i] = new RPCVariable<int>(&values[i], name);
+    }
+    for (int i = 0; i < OBJECTS; i++) {
+        char in[16], expected[8];
+        sprintf(in, "/v%d/read", i);
+        sprintf(expected, "%d", i * 3);
+        CHECK(text(in, expected));
+        // a second time from the method cache
+        CHECK(text(in, expected));
+    }
+
+    // objects keep being listed newest first
+    delete vars[OBJECTS - 1];
+    RPC::call("/", out);
+    CHECK(strncmp(out, "v30 v29 v28", 11) == 0);
+
+    for (int i = 0; i < OBJECTS - 1; i++) {
+        delete vars[i];
+    }
+    CHECK(!RPC::call("/v3/read", out));
+}
+
+TEST(RPC, binary_calls)
+{
+    int v = 0;
+    RPCVariable<int> rpc_v(&v, "v");
+    int write = RPC::bind("v", "write");
+    int read = RPC::bind("v", "read");
+    CHECK(write >= 0);
+    CHECK(read >= 0);
+    CHECK(read != write);
+
+    int arg = -7;
+    request(frame, write, 1, &arg);
+    CHECK(RPC::call_binary(frame, reply));
+    LONGS_EQUAL(RPC_BINARY_START, reply[0]);
+    LONGS_EQUAL(1, reply[1]);
+    LONGS_EQUAL(RPC_BINARY_OK, reply[2]);
+    LONGS_EQUAL(-7, v);
+
+    request(frame, read, 0, NULL);
+    CHECK(RPC::call_binary(frame, reply));
+    LONGS_EQUAL(5, reply[1]);
+    LONGS_EQUAL(RPC_BINARY_OK, reply[2]);
+    LONGS_EQUAL(-7, reply_int(reply));
+
+    // text requests are left to call()
+    CHECK(!RPC::call_binary((const uint8_t *)"/v/read", reply));
+}
+
+TEST(RPC, bind_from_text)
+{
+    int v = 0;
+    RPCVariable<int> rpc_v(&v, "v");
+    int read = RPC::bind("v", "read");
+    char expected[8];
+
+    sprintf(expected, "%d", read);
+    CHECK(text("/RPC/bind v read", expected));
+    CHECK(text("/RPC/bind v none", "-1"));
+    CHECK(text("/RPC/bind none read", "-1"));
+}
+
+TEST(RPC, binary_class_functions_and_floats)
+{
+    static bool added = false;
+    if (!added) {
+        RPC::add_rpc_class<RpcMath>();
+        added = true;
+    }
+    RPCFunction rpc_triple(&triple, "triple");
+
+    int args[] = {40, 2};
+    request(frame, RPC::bind("Math", "add"), 2, args);
+    CHECK(RPC::call_binary(frame, reply));
+    LONGS_EQUAL(RPC_BINARY_OK, reply[2]);
+    LONGS_EQUAL(42, reply_int(reply));
+
+    float f = 1.5f;
+    int bits;
+    memcpy(&bits, &f, 4);
+    request(frame, RPC::bind("triple", "run"), 1, &bits);
+    CHECK(RPC::call_binary(frame, reply));
+    LONGS_EQUAL(5, reply[1]);
+    memcpy(&f, &reply[3], 4);
+    DOUBLES_EQUAL(4.5, f, 0.0001);
+}
+
+TEST(RPC, bad_requests)
+{
+    int v = 0;
+    RPCVariable<int> *rpc_v = new RPCVariable<int>(&v, "v");
+    int write = RPC::bind("v", "write");
+
+    // missing argument
+    request(frame, write, 0, NULL);
+    frame[3] = 1;
+    CHECK(RPC::call_binary(frame, reply));
+    LONGS_EQUAL(1, reply[1]);
+    LONGS_EQUAL(RPC_BINARY_BAD_ARGS, reply[2]);
+
+    // too long
+    request(frame, write, 0, NULL);
+    frame[1] = RPC_MAX_STRING;
+    CHECK(RPC::call_binary(frame, reply));
+    LONGS_EQUAL(RPC_BINARY_BAD_ARGS, reply[2]);
+
+    // out of range
+    request(frame, RPC_MAX_BINDINGS, 0, NULL);
+    CHECK(RPC::call_binary(frame, reply));
+    LONGS_EQUAL(RPC_BINARY_BAD_HANDLE, reply[2]);
+
+    // the handle goes with the object
+    delete rpc_v;
+    int arg = 1;
+    request(frame, write, 1, &arg);
+    CHECK(RPC::call_binary(frame, reply));
+    LONGS_EQUAL(RPC_BINARY_BAD_HANDLE, reply[2]);
+    LONGS_EQUAL(0, v);
+    LONGS_EQUAL(-1, RPC::bind("v", "write"));
+}
+
+TEST(RPC, calls_per_second)
+{
+    int values[OBJECTS];
+    RPCVariable<int> *vars[OBJECTS];
+    char name[8];
+
+    for (int i = 0; i < OBJECTS; i++) {
+        values[i] = i;
+        sprintf(name, "v%d", i);
+        vars[i] = new RPCVariable<int>(&values[i], name);
+    }
+
+    // v0 is the last object a walk of the list of objects gets to
+    Timer t;
+    t.start();
+    int start = t.read_us();
+    for (int i = 0; i < CALLS; i++) {
+        RPC::call("/v0/write 1", out);
+    }
+    int text_us = t.read_us() - start;
+
+    int arg = 1;
+    request(frame, RPC::bind("v0", "write"), 1, &arg);
+    start = t.read_us();
+    for (int i = 0; i < CALLS; i++) {
+        RPC::call_binary(frame, reply);
+    }
+    int binary_us = t.read_us() - start;
+
+    printf("RPC text: %d calls/s, binary: %d calls/s\r\n",
+           (int)(CALLS * 1000000LL / (text_us ? text_us : 1)),
+           (int)(CALLS * 1000000LL / (binary_us ? binary_us : 1)));
+    CHECK(binary_us < text_us);
+
+    for (int i = 0; i < OBJECTS; i++) {
+        delete vars[i];
+    }
+}
@@ -0,0 +1,125 @@
+/* Checks the request ids, the batching and the streamed replies of RPCPipe
+ * with a transport that keeps what is written. */
+#include "TestHarness.h"
+#include "mbed.h"
+#include "mbed_rpc.h"
+
+namespace {
+
+class TestPipe : public RPCPipe {
+public:
+    TestPipe() : writes(0), length(0) {}
+
+    void receive(const char *data) {
+        RPCPipe::receive(data, strlen(data));
+    }
+
+    int writes;
+    uint32_t length;
+    char out[4096];
+
+protected:
+    virtual void write(const char *data, uint32_t n) {
+        CHECK(length + n < sizeof(out));
+        memcpy(&out[length], data, n);
+        length += n;
+        out[length] = '\0';
+        writes++;
+    }
+};
+
+// Replies with count words of ten characters
+void words(Arguments *args, Reply *reply) {
+    int count = args->getArg<int>();
+    for (int i = 0; i < count; i++) {
+        char word[11];
+        sprintf(word, "word%06d", i);
+        reply->putData<const char*>(word);
+    }
+}
+
+}
+
+TEST_GROUP(RPCPipe)
+{
+};
+
+TEST(RPCPipe, pipelined_requests_are_answered_in_one_write)
+{
+    int v = 0;
+    RPCVariable<int> rpc_v(&v, "v");
+    TestPipe pipe;
+
+    pipe.receive("1 /v/write 3\n2 /v/read\n3 /v/none\nx7 /v/read\n");
+    LONGS_EQUAL(1, pipe.writes);
+    STRCMP_EQUAL("1 \n2 3\n3!\nx7 3\n", pipe.out);
+    LONGS_EQUAL(3, v);
+}
+
+TEST(RPCPipe, requests_split_over_receives)
+{
+    int v = 5;
+    RPCVariable<int> rpc_v(&v, "v");
+    TestPipe pipe;
+
+    pipe.receive("12 /v/re");
+    LONGS_EQUAL(0, pipe.writes);
+    pipe.receive("ad\r\n13 /v");
+    STRCMP_EQUAL("12 5\n", pipe.out);
+    pipe.receive("\n");
+    STRCMP_EQUAL("12 5\n13 read write delete\n", pipe.out);
+}
+
+TEST(RPCPipe, requests_without_id)
+{
+    int v = 5;
+    RPCVariable<int> rpc_v(&v, "v");
+    TestPipe pipe;
+
+    pipe.receive("/v/read\n/none/read\n");
+    STRCMP_EQUAL("5\n!\n", pipe.out);
+}
+
+TEST(RPCPipe, bad_lines)
+{
+    TestPipe pipe;
+    char line[RPC_MAX_STRING + 16];
+
+    memset(line, 'a', sizeof(line));
+    memcpy(line, "1 /", 3);
+    line[sizeof(line) - 2] = '\n';
+    line[sizeof(line) - 1] = '\0';
+    pipe.receive(line);
+    pipe.receive("2\n3 v/read\n");
+    STRCMP_EQUAL("1!\n2!\n3!\n", pipe.out);
+}
+
+TEST(RPCPipe, long_replies_are_streamed)
+{
+    RPCFunction rpc_words(&words, "words");
+    TestPipe pipe;
+
+    // 2200 characters, several times the reply buffer
+    pipe.receive("9 /words/run 200\n10 /words/run 1\n");
+    CHECK(pipe.writes > 1);
+    LONGS_EQUAL(2 + 200 * 11 + 14, pipe.length);
+    CHECK(strncmp(pipe.out, "9 word000000 word000001 ", 24) == 0);
+    CHECK(strstr(pipe.out, "word000199\n10 word000000\n") != NULL);
+
+    // a text call without a stream fails, with the start of the reply
+    char out[RPC_MAX_STRING];
+    CHECK(!RPC::call("/words/run 200", out));
+    LONGS_EQUAL(RPC_MAX_STRING - 1, strlen(out));
+    CHECK(RPC::call("/words/run 2", out));
+    STRCMP_EQUAL("word000000 word000001", out);
+
+    // a binary call keeps the words that fit and says so
+    int handle = RPC::bind("words", "run");
+    CHECK(handle >= 0);
+    uint8_t frame[] = {RPC_BINARY_START, 6, (uint8_t)handle, 1, 200, 0, 0, 0};
+    uint8_t reply[RPC_MAX_STRING];
+    CHECK(RPC::call_binary(frame, reply));
+    LONGS_EQUAL(RPC_BINARY_TRUNCATED, reply[2]);
+    LONGS_EQUAL(1 + (RPC_MAX_STRING - 3) / 11 * 11, reply[1]);
+    STRCMP_EQUAL("word000000", (char *)&reply[3]);
+}
@@ -0,0 +1,194 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/* The ring buffer of the continuous serial reception, filled by a
+ * simulated UART the way its DMA or its receive interrupt would. */
+#include "TestHarness.h"
+#include "mbed.h"
+#include "SerialRxRing.h"
+
+namespace {
+
+class SimUart {
+public:
+    SimUart(SerialRxRing &ring, uint8_t *buffer, uint32_t length) :
+        ring(ring), buffer(buffer), length(length), position(0), events(0) {
+    }
+
+    // A burst written by DMA, with the half full and full interrupts on the way and the idle line one at the end
+    void dma(const char *data, uint32_t n) {
+        for (uint32_t i = 0; i < n; i++) {
+            buffer[position] = data[i];
+            position = (position + 1) % length;
+            if ((position == length / 2) || (position == 0)) {
+                events |= ring.update(position);
+            }
+        }
+        events |= ring.update(position);
+    }
+
+    // A burst taken from the receive interrupt
+    void irq(const char *data, uint32_t n) {
+        for (uint32_t i = 0; i < n; i++) {
+            events |= ring.put(data[i]);
+        }
+    }
+
+    SerialRxRing &ring;
+    uint8_t *buffer;
+    uint32_t length;
+    uint32_t position;
+    int events;
+};
+
+// Everything received, in place
+uint32_t read_all(SerialRxRing &ring, char *out) {
+    uint32_t total = 0;
+    const uint8_t *data;
+    uint32_t n;
+    while ((n = ring.span(&data)) > 0) {
+        memcpy(&out[total], data, n);
+        total += n;
+        ring.consume(n);
+    }
+    out[total] = '\0';
+    return total;
+}
+
+}
+
+TEST_GROUP(SerialRxRing)
+{
+    SerialRxRing ring;
+    uint8_t buffer[64];
+};
+
+TEST(SerialRxRing, dma_bursts_are_read_in_place)
+{
+    ring.start(buffer, sizeof(buffer), '\n');
+    SimUart uart(ring, buffer, sizeof(buffer));
+    char sent[2048] = "";
+    char got[2048] = "";
+    uint32_t got_length = 0;
+
+    for (int i = 0; i < 40; i++) {
+        char line[64];
+        int n = sprintf(line, "$GPGGA,%06d,4807.038,N,01131.000,E*%02X\r\n", i * 7, i);
+        strcat(sent, line);
+        uart.events = 0;
+        uart.dma(line, n);
+        CHECK(uart.events & SERIAL_EVENT_RX_CHARACTER_MATCH);
+        got_length += read_all(ring, &got[got_length]);
+    }
+
+    STRCMP_EQUAL(sent, got);
+    LONGS_EQUAL(strlen(sent), got_length);
+    LONGS_EQUAL(0, ring.overruns());
+}
+
+TEST(SerialRxRing, spans_stop_at_the_end_of_the_buffer)
+{
+    ring.start(buffer, 16, SERIAL_RESERVED_CHAR_MATCH);
+    SimUart uart(ring, buffer, 16);
+    const uint8_t *data;
+
+    uart.dma("0123456789ab", 12);
+    LONGS_EQUAL(12, ring.span(&data));
+    ring.consume(12);
+
+    uart.dma("cdefghijkl", 10);
+    LONGS_EQUAL(10, ring.available());
+    LONGS_EQUAL(4, ring.span(&data));
+    POINTERS_EQUAL(&buffer[12], data);
+    CHECK(memcmp(data, "cdef", 4) == 0);
+    ring.consume(4);
+    LONGS_EQUAL(6, ring.span(&data));
+    POINTERS_EQUAL(buffer, data);
+    CHECK(memcmp(data, "ghijkl", 6) == 0);
+}
+
+TEST(SerialRxRing, half_full_and_complete)
+{
+    ring.start(buffer, 16, SERIAL_RESERVED_CHAR_MATCH);
+    SimUart uart(ring, buffer, 16);
+    const uint8_t *data;
+
+    uart.dma("0123456", 7);
+    LONGS_EQUAL(0, uart.events);
+    uart.dma("7", 1);
+    LONGS_EQUAL(SERIAL_EVENT_RX_HALF_FULL, uart.events);
+    ring.consume(ring.span(&data));
+
+    uart.events = 0;
+    uart.dma("89abcdefgh", 10);
+    LONGS_EQUAL(SERIAL_EVENT_RX_COMPLETE, uart.events);
+
+    // by interrupt too
+    ring.start(buffer, 16, SERIAL_RESERVED_CHAR_MATCH);
+    uart.events = 0;
+    uart.irq("01234567", 8);
+    LONGS_EQUAL(SERIAL_EVENT_RX_HALF_FULL, uart.events);
+}
+
+TEST(SerialRxRing, dma_overflow_drops_what_was_not_consumed)
+{
+    ring.start(buffer, 16, SERIAL_RESERVED_CHAR_MATCH);
+    SimUart uart(ring, buffer, 16);
+    char got[32];
+
+    uart.dma("0123456789", 10);
+    uart.dma("abcdefghij", 10);
+    CHECK(uart.events & SERIAL_EVENT_RX_OVERFLOW);
+    LONGS_EQUAL(1, ring.overruns());
+    LONGS_EQUAL(0, ring.available());
+
+    // received as before afterwards
+    uart.dma("klmno", 5);
+    LONGS_EQUAL(5, read_all(ring, got));
+    STRCMP_EQUAL("klmno", got);
+}
+
+TEST(SerialRxRing, interrupt_overflow_drops_new_characters)
+{
+    ring.start(buffer, 16, SERIAL_RESERVED_CHAR_MATCH);
+    SimUart uart(ring, buffer, 16);
+    const uint8_t *data;
+    char got[32];
+
+    uart.irq("0123456789abcdef", 16);
+    CHECK((uart.events & SERIAL_EVENT_RX_OVERFLOW) == 0);
+    uart.events = 0;
+    uart.irq("ghij", 4);
+    LONGS_EQUAL(SERIAL_EVENT_RX_OVERFLOW, uart.events);
+    LONGS_EQUAL(1, ring.overruns());
+
+    // the oldest are kept, and one overrun counted until some are consumed
+    LONGS_EQUAL(16, ring.span(&data));
+    ring.consume(4);
+    uart.irq("klmnop", 6);
+    LONGS_EQUAL(2, ring.overruns());
+    LONGS_EQUAL(16, read_all(ring, got));
+    STRCMP_EQUAL("456789abcdefklmn", got);
+}
+
+TEST(SerialRxRing, not_started)
+{
+    const uint8_t *data;
+
+    LONGS_EQUAL(0, ring.update(0));
+    ring.consume(4);
+    LONGS_EQUAL(0, ring.span(&data));
+    LONGS_EQUAL(0, ring.available());
+}
@@ -0,0 +1,85 @@
+#include <string.h>
+#include "sim_ticker.h"
+
+uint32_t sim_now;
+uint32_t sim_match;
+bool sim_armed;
+bool sim_preempt;
+uint32_t sim_step;
+
+// where the count was when the match was set, as it only fires on reaching it
+static uint32_t sim_set_at;
+
+static ticker_event_queue_t sim_queue;
+
+static void sim_init(void) {}
+
+static void sim_disable_interrupt(void) {
+    sim_armed = false;
+}
+
+static void sim_clear_interrupt(void) {}
+
+static void sim_set_interrupt(timestamp_t timestamp) {
+    sim_match = timestamp;
+    sim_set_at = sim_now;
+    sim_armed = true;
+}
+
+/* When sim_preempt is set, the next read is interrupted just after the
+ * count is read, by an interrupt half a wrap later */
+static uint32_t sim_read(void) {
+    uint32_t now = sim_now;
+    sim_now += sim_step;
+    if (sim_preempt) {
+        sim_preempt = false;
+        sim_now += 0x80000000UL;
+        sim_match = sim_now;
+        sim_set_at = sim_now;
+        sim_armed = true;
+        sim_run_interrupts();
+    }
+    return now;
+}
+
+static const ticker_interface_t sim_interface = {
+    sim_init,
+    sim_read,
+    sim_disable_interrupt,
+    sim_clear_interrupt,
+    sim_set_interrupt,
+};
+
+const ticker_data_t sim_data = {
+    &sim_interface,
+    &sim_queue,
+};
+
+void sim_reset(uint32_t now) {
+    memset(&sim_queue, 0, sizeof(sim_queue));
+    sim_now = now;
+    sim_armed = false;
+    sim_preempt = false;
+    sim_step = 0;
+}
+
+void sim_run_interrupts(void) {
+    while (sim_armed && ((sim_now - sim_set_at) >= (sim_match - sim_set_at))) {
+        sim_armed = false;
+        ticker_irq_handler(&sim_data);
+    }
+}
+
+void fast_forward(us_timestamp_t us) {
+    while (us > 0) {
+        sim_run_interrupts();
+        uint32_t step = (us > 0x10000000UL) ? 0x10000000UL : (uint32_t)us;
+        uint32_t until = sim_match - sim_now;
+        if (sim_armed && (until > 0) && (until < step)) {
+            step = until;
+        }
+        sim_now += step;
+        us -= step;
+    }
+    sim_run_interrupts();
+}
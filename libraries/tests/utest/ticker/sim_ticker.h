@@ -0,0 +1,26 @@
+/* A simulated 32-bit ticker with a match interrupt, whose time only passes
+ * when the tests fast-forward it, or by sim_step on each read. As on the
+ * hardware, the match fires when the count gets to it, so one set behind
+ * the count fires a wrap later. */
+#ifndef SIM_TICKER_H
+#define SIM_TICKER_H
+
+#include "ticker_api.h"
+
+extern uint32_t sim_now;
+extern uint32_t sim_match;
+extern bool sim_armed;
+extern bool sim_preempt;
+extern uint32_t sim_step;
+extern const ticker_data_t sim_data;
+
+// Starts the ticker afresh at now, with no events
+void sim_reset(uint32_t now);
+
+// Runs the due interrupts, as the hardware would on leaving a critical section
+void sim_run_interrupts(void);
+
+// Lets time pass, running the interrupts as they fall due
+void fast_forward(us_timestamp_t us);
+
+#endif
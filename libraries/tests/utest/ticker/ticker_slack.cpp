@@ -0,0 +1,151 @@
+/* Checks that events with slack share interrupts, and compares the interrupts
+ * taken by 100 Tickers at mixed periods with and without slack. */
+#include <stdio.h>
+#include "TestHarness.h"
+#include "mbed.h"
+#include "ticker_api.h"
+#include "sim_ticker.h"
+
+namespace {
+
+us_timestamp_t fired_at[8];
+int nfired;
+
+void record(uint32_t id) {
+    fired_at[id] = ticker_read_us(&sim_data);
+    nfired++;
+}
+
+class BenchTicker : public Ticker {
+public:
+    BenchTicker() : Ticker(&sim_data), calls(0), max_late(0) {}
+
+    void start(uint32_t period, uint32_t slack) {
+        _period = period;
+        _expected = ticker_read_us(&sim_data) + period;
+        slack_us(slack);
+        attach_us(this, &BenchTicker::call, period);
+    }
+
+    void call(void) {
+        us_timestamp_t late = ticker_read_us(&sim_data) - _expected;
+        if (late > max_late) {
+            max_late = late;
+        }
+        _expected += _period;
+        calls++;
+    }
+
+    int calls;
+    us_timestamp_t max_late;
+
+private:
+    uint32_t _period;
+    us_timestamp_t _expected;
+};
+
+const int TICKERS = 100;
+const uint32_t PERIODS[] = {1000, 2000, 2500, 5000, 10000, 20000, 50000};
+
+struct Result {
+    uint32_t interrupts;
+    uint32_t events;
+    int calls[TICKERS];
+    bool on_time;
+};
+
+/* Runs the tickers for ten simulated seconds, each with a tenth of its
+ * period as slack if with_slack is set */
+void run(bool with_slack, Result *result) {
+    BenchTicker *tickers = new BenchTicker[TICKERS];
+    result->on_time = true;
+
+    for (int i = 0; i < TICKERS; i++) {
+        uint32_t period = PERIODS[i % 7];
+        tickers[i].start(period, with_slack ? period / 10 : 0);
+        fast_forward(37 * (i % 11));
+    }
+    uint32_t interrupts = sim_data.queue->interrupts;
+    uint32_t events = sim_data.queue->events;
+    fast_forward(10000000);
+    result->interrupts = sim_data.queue->interrupts - interrupts;
+    result->events = sim_data.queue->events - events;
+
+    for (int i = 0; i < TICKERS; i++) {
+        tickers[i].detach();
+        result->calls[i] = tickers[i].calls;
+        uint32_t slack = with_slack ? PERIODS[i % 7] / 10 : 0;
+        result->on_time = result->on_time && (tickers[i].max_late <= slack);
+    }
+    delete[] tickers;
+}
+
+}
+
+TEST_GROUP(TickerSlack)
+{
+    void setup() {
+        sim_reset(0xFFF00000UL);
+        nfired = 0;
+        ticker_set_handler(&sim_data, record);
+    }
+};
+
+TEST(TickerSlack, overlapping_events_share_an_interrupt)
+{
+    ticker_event_t a, b, c;
+    us_timestamp_t start = ticker_read_us(&sim_data);
+    uint32_t interrupts = sim_data.queue->interrupts;
+
+    ticker_insert_event_us64(&sim_data, &a, start + 1000, 500, 0);
+    ticker_insert_event_us64(&sim_data, &b, start + 1200, 0, 1);
+    ticker_insert_event_us64(&sim_data, &c, start + 1300, 100, 2);
+
+    fast_forward(1199);
+    LONGS_EQUAL(0, nfired);
+    fast_forward(1);
+    LONGS_EQUAL(2, nfired);
+    CHECK(fired_at[0] == start + 1200);
+    CHECK(fired_at[1] == start + 1200);
+    LONGS_EQUAL(interrupts + 1, sim_data.queue->interrupts);
+
+    fast_forward(200);
+    LONGS_EQUAL(3, nfired);
+    CHECK(fired_at[2] == start + 1400);
+}
+
+TEST(TickerSlack, a_later_event_with_an_earlier_deadline)
+{
+    ticker_event_t a, b;
+    us_timestamp_t start = ticker_read_us(&sim_data);
+
+    // b comes after a in the queue but must be handled first
+    ticker_insert_event_us64(&sim_data, &a, start + 1000, 5000, 0);
+    ticker_insert_event_us64(&sim_data, &b, start + 2000, 0, 1);
+
+    fast_forward(2000);
+    LONGS_EQUAL(2, nfired);
+    CHECK(fired_at[0] == start + 2000);
+    CHECK(fired_at[1] == start + 2000);
+}
+
+TEST(TickerSlack, interrupts_of_100_tickers)
+{
+    static Result exact, slack;
+    run(false, &exact);
+    run(true, &slack);
+
+    printf("100 Tickers for 10 s: %lu events\r\n", (unsigned long)exact.events);
+    printf("  no slack:   %lu interrupts\r\n", (unsigned long)exact.interrupts);
+    printf("  10%% slack:  %lu interrupts, %lu saved\r\n", (unsigned long)slack.interrupts,
+           (unsigned long)(exact.interrupts - slack.interrupts));
+
+    // as many calls, none later than allowed, far fewer interrupts
+    CHECK(exact.on_time);
+    CHECK(slack.on_time);
+    for (int i = 0; i < TICKERS; i++) {
+        CHECK(slack.calls[i] >= exact.calls[i] - 1);
+        CHECK(slack.calls[i] <= exact.calls[i]);
+    }
+    CHECK(slack.interrupts * 2 < exact.interrupts);
+}
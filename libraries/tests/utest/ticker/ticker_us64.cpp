@@ -0,0 +1,165 @@
+/* Fast-forwards a simulated 32-bit ticker through many wraps and checks the
+ * 64-bit time, events and Timer built on it. */
+#include "TestHarness.h"
+#include "mbed.h"
+#include "ticker_api.h"
+#include "sim_ticker.h"
+
+namespace {
+
+const us_timestamp_t WRAP = 0x100000000ULL;
+const us_timestamp_t MINUTE = 60000000ULL;
+
+int fired[8];
+int nfired;
+
+void record(uint32_t id) {
+    fired[nfired++] = id;
+}
+
+class SimTicker : public Ticker {
+public:
+    SimTicker() : Ticker(&sim_data), calls(0) {}
+
+    void count(void) {
+        calls++;
+    }
+
+    int calls;
+};
+
+}
+
+TEST_GROUP(TickerUs64)
+{
+    void setup() {
+        sim_reset(0xFFFF0000UL);
+        nfired = 0;
+        ticker_set_handler(&sim_data, record);
+    }
+};
+
+TEST(TickerUs64, read_through_wraps)
+{
+    us_timestamp_t start = ticker_read_us(&sim_data);
+    LONGS_EQUAL(sim_now, (uint32_t)start);
+
+    fast_forward(5 * WRAP + 12345);
+    CHECK(ticker_read_us(&sim_data) - start == 5 * WRAP + 12345);
+    LONGS_EQUAL(sim_now, (uint32_t)ticker_read_us(&sim_data));
+
+    // kept up to date without any events, a few interrupts per wrap
+    CHECK(sim_data.queue->interrupts >= 10);
+    CHECK(sim_data.queue->interrupts <= 15);
+}
+
+TEST(TickerUs64, read_interrupted_by_an_update)
+{
+    us_timestamp_t start = ticker_read_us(&sim_data);
+    fast_forward(3 * WRAP);
+
+    sim_preempt = true;
+    us_timestamp_t now = ticker_read_us(&sim_data);
+    CHECK(now - start == 3 * WRAP + 0x80000000UL);
+}
+
+TEST(TickerUs64, events_hours_ahead)
+{
+    ticker_event_t two_hours, one_hour;
+    us_timestamp_t start = ticker_read_us(&sim_data);
+
+    ticker_insert_event_us64(&sim_data, &two_hours, start + 120 * MINUTE, 0, 2);
+    ticker_insert_event_us64(&sim_data, &one_hour, start + 60 * MINUTE, 0, 1);
+
+    fast_forward(60 * MINUTE - 1);
+    LONGS_EQUAL(0, nfired);
+    fast_forward(1);
+    LONGS_EQUAL(1, nfired);
+    LONGS_EQUAL(1, fired[0]);
+
+    fast_forward(60 * MINUTE - 1);
+    LONGS_EQUAL(1, nfired);
+    fast_forward(1);
+    LONGS_EQUAL(2, nfired);
+    LONGS_EQUAL(2, fired[1]);
+}
+
+TEST(TickerUs64, events_in_order_across_a_wrap)
+{
+    ticker_event_t events[4];
+    us_timestamp_t start = ticker_read_us(&sim_data);
+
+    // the second and fourth after the 32-bit count wraps
+    ticker_insert_event_us64(&sim_data, &events[3], start + 0x20000, 0, 4);
+    ticker_insert_event_us64(&sim_data, &events[0], start + 0x8000, 0, 1);
+    ticker_insert_event_us64(&sim_data, &events[2], start + 0x18000, 0, 3);
+    ticker_insert_event_us64(&sim_data, &events[1], start + 0x10000, 0, 2);
+
+    fast_forward(0x20000);
+    LONGS_EQUAL(4, nfired);
+    for (int i = 0; i < 4; i++) {
+        LONGS_EQUAL(i + 1, fired[i]);
+    }
+}
+
+TEST(TickerUs64, events_32bit_after_wraps)
+{
+    ticker_event_t soon, past, removed;
+    fast_forward(3 * WRAP + 777);
+
+    ticker_insert_event(&sim_data, &soon, sim_now + 1000, 1);
+    ticker_insert_event(&sim_data, &removed, sim_now + 500, 3);
+    ticker_remove_event(&sim_data, &removed);
+    fast_forward(999);
+    LONGS_EQUAL(0, nfired);
+    fast_forward(1);
+    LONGS_EQUAL(1, nfired);
+
+    // a timestamp in the past is due at the next tick
+    ticker_insert_event(&sim_data, &past, sim_now - 1000, 2);
+    fast_forward(1);
+    LONGS_EQUAL(2, nfired);
+    LONGS_EQUAL(2, fired[1]);
+}
+
+TEST(TickerUs64, overdue_event_while_the_count_runs)
+{
+    ticker_event_t past;
+    fast_forward(WRAP + 777);
+
+    // the count moves on while the events are scheduled
+    sim_step = 1;
+    ticker_insert_event(&sim_data, &past, sim_now - 1000, 5);
+    fast_forward(100);
+    LONGS_EQUAL(1, nfired);
+    LONGS_EQUAL(5, fired[0]);
+}
+
+TEST(TickerUs64, ticker_longer_than_half_a_wrap)
+{
+    SimTicker ticker;
+    ticker.attach_us(&ticker, &SimTicker::count, 50 * MINUTE);
+
+    fast_forward(50 * MINUTE - 1);
+    LONGS_EQUAL(0, ticker.calls);
+    fast_forward(1);
+    LONGS_EQUAL(1, ticker.calls);
+    fast_forward(100 * MINUTE);
+    LONGS_EQUAL(3, ticker.calls);
+    ticker.detach();
+}
+
+TEST(TickerUs64, timer_over_hours)
+{
+    Timer timer(&sim_data);
+    timer.start();
+    fast_forward(180 * MINUTE + 5);
+    CHECK(timer.read_high_resolution_us() == 180 * MINUTE + 5);
+    LONGS_EQUAL(180 * 60000, timer.read_ms());
+
+    timer.stop();
+    fast_forward(10 * MINUTE);
+    timer.start();
+    fast_forward(WRAP);
+    CHECK(timer.read_high_resolution_us() == 180 * MINUTE + 5 + WRAP);
+}
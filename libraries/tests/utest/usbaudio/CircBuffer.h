@@ -0,0 +1,2 @@
+/* The FIFOs of USBAudio are the CircBuffer of USBSerial */
+#include "../../../USBDevice/USBSerial/CircBuffer.h"
@@ -0,0 +1,2 @@
+/* The real USBDescriptor.h, next to the mock USBDevice.h */
+#include "../../../USBDevice/USBDevice/USBDescriptor.h"
@@ -0,0 +1,85 @@
+/* Stands in for USBDevice in the USBAudio tests: the test plays the host,
+ * handing over a packet for the isochronous OUT endpoint before each frame
+ * and picking up what was written to the IN endpoints. */
+#ifndef USBDEVICE_H
+#define USBDEVICE_H
+
+#include "mbed.h"
+#include "USBEndpoints.h"
+#include "USBDescriptor.h"
+#include "USBDevice_Types.h"
+
+#define MOCK_MAX_PACKET 1023
+
+class USBDevice {
+public:
+    USBDevice(uint16_t vendor_id, uint16_t product_id, uint16_t product_release) : out_size(0), in_size(0), feedback_size(0), connects(0) {}
+
+    // Each connection has the host read the configuration descriptor
+    void connect(bool blocking = true) {
+        connects++;
+        configuration = configurationDesc();
+    }
+    void disconnect(void) {}
+    bool realiseEndpoint(uint8_t endpoint, uint32_t maxPacket, uint32_t options) { return true; }
+    bool readStart(uint8_t endpoint, uint32_t maxSize) { return true; }
+
+    bool readEP(uint8_t endpoint, uint8_t * buffer, uint32_t * size, uint32_t maxSize) {
+        return readEP_NB(endpoint, buffer, size, maxSize);
+    }
+
+    bool readEP_NB(uint8_t endpoint, uint8_t * buffer, uint32_t * size, uint32_t maxSize) {
+        *size = (out_size < maxSize) ? out_size : maxSize;
+        memcpy(buffer, out_packet, *size);
+        out_size = 0;
+        return true;
+    }
+
+    bool writeNB(uint8_t endpoint, uint8_t * buffer, uint32_t size, uint32_t maxSize) {
+#ifdef EPISO_FEEDBACK
+        if (endpoint == EPISO_FEEDBACK) {
+            memcpy(feedback_packet, buffer, size);
+            feedback_size = size;
+            return true;
+        }
+#endif
+        {
+            memcpy(in_packet, buffer, size);
+            in_size = size;
+        }
+        return true;
+    }
+
+    // Host side: the packet the host sends in the next frame
+    void hostSend(const uint8_t * data, uint32_t size) {
+        memcpy(out_packet, data, size);
+        out_size = size;
+    }
+
+    uint8_t out_packet[MOCK_MAX_PACKET];
+    uint32_t out_size;
+    uint8_t in_packet[MOCK_MAX_PACKET];
+    uint32_t in_size;
+    uint8_t feedback_packet[3];
+    uint32_t feedback_size;
+    int connects;
+    uint8_t * configuration;
+
+protected:
+    virtual bool USBCallback_request() { return false; }
+    virtual void USBCallback_requestCompleted(uint8_t * buf, uint32_t length) {}
+    virtual bool USBCallback_setConfiguration(uint8_t configuration) { return false; }
+    virtual bool USBCallback_setInterface(uint16_t interface, uint8_t alternate) { return false; }
+    virtual uint8_t * configurationDesc() { return NULL; }
+    virtual uint8_t * stringIproductDesc() { return NULL; }
+    virtual uint8_t * stringIinterfaceDesc() { return NULL; }
+    virtual void SOF(int frameNumber) {}
+    virtual bool EPISO_OUT_callback() { return false; }
+    virtual bool EPISO_IN_callback() { return false; }
+    CONTROL_TRANSFER * getTransferPtr() { return &transfer; }
+
+private:
+    CONTROL_TRANSFER transfer;
+};
+
+#endif
@@ -0,0 +1,2 @@
+/* The real USBDevice_Types.h, next to the mock USBDevice.h */
+#include "../../../USBDevice/USBDevice/USBDevice_Types.h"
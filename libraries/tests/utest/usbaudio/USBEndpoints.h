@@ -0,0 +1,2 @@
+/* The real USBEndpoints.h, next to the mock USBDevice.h */
+#include "../../../USBDevice/USBDevice/USBEndpoints.h"
@@ -0,0 +1,267 @@
+/* Streams audio through USBAudio against the mock USBDevice in this directory,
+ * with the test playing a host whose clock drifts from the device's. */
+#include "TestHarness.h"
+#include "mbed.h"
+#include "USBAudio.h"
+
+namespace {
+
+const int FRAMES = 60000;   // a minute
+
+class TestAudio : public USBAudio {
+public:
+    TestAudio(uint32_t frequency) : USBAudio(frequency, 1, 8000, 1), frame(0) {}
+
+    // One USB frame: the host's packet arrives, then the start of frame
+    void runFrame(const uint8_t * data, uint32_t size) {
+        if (size) {
+            hostSend(data, size);
+            EPISO_OUT_callback();
+        }
+        SOF(frame++ & 0x7ff);
+    }
+
+    uint32_t lastFeedback() {
+        return feedback_size ? (feedback_packet[0] | (feedback_packet[1] << 8) | (feedback_packet[2] << 16)) : 0;
+    }
+
+    int frame;
+};
+
+// Finds a descriptor in the configuration the host read: an endpoint by its
+// address, or an interface by its number and alternate setting
+uint8_t * findDescriptor(uint8_t * config, uint8_t type, uint8_t number, uint8_t alternate = 0)
+{
+    uint32_t total = config[2] | (config[3] << 8);
+    for (uint32_t i = 0; i < total; i += config[i]) {
+        uint8_t * desc = &config[i];
+        if ((desc[1] == type) && (desc[2] == number) &&
+            ((type != INTERFACE_DESCRIPTOR) || (desc[3] == alternate)))
+            return desc;
+    }
+    return NULL;
+}
+
+// Checks that the descriptors add up to wTotalLength, followed by the terminator
+bool wellFormed(uint8_t * config)
+{
+    uint32_t total = config[2] | (config[3] << 8);
+    uint32_t i = 0;
+    while (config[i] && i < total)
+        i += config[i];
+    return (i == total) && (config[i] == 0);
+}
+
+/* Plays a host that sends samples at the rate of the last feedback (or at the
+ * nominal rate when ignoring it) and a device that plays samples drift_ppm
+ * faster than nominal. Returns the glitches counted once playing started. */
+uint32_t drift(uint32_t frequency, int drift_ppm, bool follow_feedback)
+{
+    TestAudio audio(frequency);
+    int16_t packet[MOCK_MAX_PACKET / 2];
+    int16_t played[MOCK_MAX_PACKET / 2];
+    uint32_t nominal = (frequency << 14) / 1000;
+    uint32_t host_acc = 0;
+    uint64_t device_acc = 0;
+    int16_t sent = 0, expected = 0;
+    bool playing = false;
+    bool in_order = true;
+
+    audio.stream(true);
+    for (int i = 0; i < FRAMES; i++) {
+        // the host sends whole samples and carries the fraction over
+        uint32_t fb = (follow_feedback && audio.lastFeedback()) ? audio.lastFeedback() : nominal;
+        host_acc += fb;
+        uint32_t samples = host_acc >> 14;
+        host_acc &= (1 << 14) - 1;
+        for (uint32_t n = 0; n < samples; n++)
+            packet[n] = sent++;
+        audio.runFrame((uint8_t *)packet, samples * 2);
+
+        // the device starts playing once the FIFO is half full
+        if (!playing) {
+            if (audio.streamReadable() < USBAUDIO_FIFO_SIZE / 2)
+                continue;
+            playing = true;
+            audio.resetStats();
+        }
+        device_acc += (uint64_t)frequency * (1000000 + drift_ppm);
+        uint32_t samples_played = device_acc / 1000000000;
+        device_acc %= 1000000000;
+        uint32_t got = audio.readStream((uint8_t *)played, samples_played * 2) / 2;
+        for (uint32_t n = 0; n < got; n++)
+            if (played[n] != expected++)
+                in_order = false;
+    }
+
+    USBAudio::Stats stats;
+    audio.getStats(&stats);
+    uint32_t glitches = stats.rx_overruns + stats.rx_underruns;
+    if (glitches == 0)
+        CHECK(in_order);
+    return glitches;
+}
+
+}
+
+TEST_GROUP(USBAudio)
+{
+};
+
+TEST(USBAudio, descriptors_without_streaming_are_synchronous)
+{
+    TestAudio audio(48000);
+    LONGS_EQUAL(1, audio.connects);
+    CHECK(wellFormed(audio.configuration));
+
+    // 48 kHz mono: 96 bytes per frame, no more
+    uint8_t * out = findDescriptor(audio.configuration, ENDPOINT_DESCRIPTOR, PHY_TO_DESC(EPISO_OUT));
+    CHECK(out != NULL);
+    LONGS_EQUAL(E_ISOCHRONOUS, out[3]);
+    LONGS_EQUAL(96, out[4] | (out[5] << 8));
+    LONGS_EQUAL(0, out[8]);
+    LONGS_EQUAL(1, findDescriptor(audio.configuration, INTERFACE_DESCRIPTOR, 1, 1)[4]);
+#ifdef EPISO_FEEDBACK
+    CHECK(findDescriptor(audio.configuration, ENDPOINT_DESCRIPTOR, PHY_TO_DESC(EPISO_FEEDBACK)) == NULL);
+#endif
+
+    uint8_t packet[96];
+    memset(packet, 0, sizeof(packet));
+    for (int i = 0; i < 8; i++)
+        audio.runFrame(packet, sizeof(packet));
+    LONGS_EQUAL(0, audio.feedback_size);
+}
+
+#ifdef EPISO_FEEDBACK
+TEST(USBAudio, streaming_reconnects_with_the_feedback_endpoint)
+{
+    TestAudio audio(48000);
+
+    audio.stream(true);
+    LONGS_EQUAL(2, audio.connects);
+    CHECK(wellFormed(audio.configuration));
+    uint8_t * out = findDescriptor(audio.configuration, ENDPOINT_DESCRIPTOR, PHY_TO_DESC(EPISO_OUT));
+    LONGS_EQUAL(E_ISOCHRONOUS | E_ASYNCHRONOUS, out[3]);
+    LONGS_EQUAL(98, out[4] | (out[5] << 8));
+    LONGS_EQUAL(PHY_TO_DESC(EPISO_FEEDBACK), out[8]);
+    LONGS_EQUAL(2, findDescriptor(audio.configuration, INTERFACE_DESCRIPTOR, 1, 1)[4]);
+    CHECK(findDescriptor(audio.configuration, ENDPOINT_DESCRIPTOR, PHY_TO_DESC(EPISO_FEEDBACK)) != NULL);
+
+    // back to the synchronous stream, once
+    audio.stream(false);
+    audio.stream(false);
+    LONGS_EQUAL(3, audio.connects);
+    CHECK(wellFormed(audio.configuration));
+    CHECK(findDescriptor(audio.configuration, ENDPOINT_DESCRIPTOR, PHY_TO_DESC(EPISO_FEEDBACK)) == NULL);
+    LONGS_EQUAL(E_ISOCHRONOUS, findDescriptor(audio.configuration, ENDPOINT_DESCRIPTOR, PHY_TO_DESC(EPISO_OUT))[3]);
+}
+
+TEST(USBAudio, feedback_is_nominal_at_half_full)
+{
+    TestAudio audio(48000);
+    uint8_t packet[64];
+    memset(packet, 0, sizeof(packet));
+
+    audio.stream(true);
+    while (audio.streamReadable() < USBAUDIO_FIFO_SIZE / 2)
+        audio.runFrame(packet, sizeof(packet));
+    for (int i = 0; i < 8; i++)
+        audio.runFrame(NULL, 0);
+    LONGS_EQUAL(3, audio.feedback_size);
+    LONGS_EQUAL(48 << 14, audio.lastFeedback());
+}
+
+TEST(USBAudio, feedback_asks_for_more_when_low)
+{
+    TestAudio audio(48000);
+
+    audio.stream(true);
+    for (int i = 0; i < 8; i++)
+        audio.runFrame(NULL, 0);
+    CHECK(audio.lastFeedback() > (48 << 14));
+    CHECK(audio.lastFeedback() <= (48 << 14) + (1 << 13));
+}
+
+TEST(USBAudio, no_glitch_with_device_clock_fast)
+{
+    LONGS_EQUAL(0, drift(48000, 300, true));
+}
+
+TEST(USBAudio, no_glitch_with_device_clock_slow)
+{
+    LONGS_EQUAL(0, drift(48000, -300, true));
+}
+
+TEST(USBAudio, no_glitch_at_fractional_rate)
+{
+    LONGS_EQUAL(0, drift(44100, 150, true));
+}
+#endif
+
+TEST(USBAudio, glitches_without_feedback)
+{
+    CHECK(drift(48000, 300, false) > 0);
+    CHECK(drift(48000, -300, false) > 0);
+}
+
+TEST(USBAudio, no_fifos_until_streaming)
+{
+    TestAudio audio(48000);
+    uint8_t data[16];
+    memset(data, 0x22, sizeof(data));
+
+    LONGS_EQUAL(0, audio.streamReadable());
+    LONGS_EQUAL(0, audio.streamWriteable());
+    LONGS_EQUAL(0, audio.readStream(data, sizeof(data)));
+    LONGS_EQUAL(0, audio.writeStream(data, sizeof(data)));
+
+    audio.stream(true);
+    LONGS_EQUAL(USBAUDIO_FIFO_SIZE, audio.streamWriteable());
+    LONGS_EQUAL(sizeof(data), audio.writeStream(data, sizeof(data)));
+}
+
+TEST(USBAudio, transmit_fifo_sends_a_packet_per_frame)
+{
+    TestAudio audio(48000);
+    uint8_t data[16 * 16];
+    for (uint32_t i = 0; i < sizeof(data); i++)
+        data[i] = i * 5 + 1;
+
+    // 8 kHz mono out: 16 bytes per frame
+    audio.stream(true);
+    LONGS_EQUAL(sizeof(data), audio.writeStream(data, sizeof(data)));
+    for (int i = 0; i < 16; i++) {
+        audio.runFrame(NULL, 0);
+        LONGS_EQUAL(16, audio.in_size);
+        MEMCMP_EQUAL(&data[i * 16], audio.in_packet, 16);
+    }
+
+    // nothing left: silence, counted as an underrun
+    audio.runFrame(NULL, 0);
+    LONGS_EQUAL(16, audio.in_size);
+    uint8_t silence[16];
+    memset(silence, 0, sizeof(silence));
+    MEMCMP_EQUAL(silence, audio.in_packet, 16);
+
+    USBAudio::Stats stats;
+    audio.getStats(&stats);
+    LONGS_EQUAL(17, stats.packets_out);
+    LONGS_EQUAL(1, stats.tx_underruns);
+}
+
+TEST(USBAudio, full_receive_fifo_drops_whole_packets)
+{
+    TestAudio audio(48000);
+    uint8_t packet[96];
+    memset(packet, 0x11, sizeof(packet));
+
+    audio.stream(true);
+    for (int i = 0; i < 20; i++)
+        audio.runFrame(packet, sizeof(packet));
+
+    USBAudio::Stats stats;
+    audio.getStats(&stats);
+    LONGS_EQUAL(20, stats.packets_in);
+    LONGS_EQUAL(20 - USBAUDIO_FIFO_SIZE / 96, stats.rx_overruns);
+    LONGS_EQUAL((USBAUDIO_FIFO_SIZE / 96) * 96, audio.streamReadable());
+}
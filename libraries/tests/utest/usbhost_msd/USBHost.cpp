@@ -0,0 +1,132 @@
+#include "USBHost.h"
+
+#define CBW_SIGNATURE   0x43425355
+#define CSW_SIGNATURE   0x53425355
+
+USBHost * USBHost::getHostInst() {
+    static USBHost host;
+    return &host;
+}
+
+USB_TYPE USBHost::enumerate(USBDeviceConnected * dev, IUSBEnumerator * pEnumerator) {
+    clear();
+    pEnumerator->setVidPid(dev->getVid(), dev->getPid());
+    if (pEnumerator->parseInterface(0, MSD_CLASS, 0x06, 0x50)) {
+        pEnumerator->useEndpoint(0, BULK_ENDPOINT, IN);
+        pEnumerator->useEndpoint(0, BULK_ENDPOINT, OUT);
+    }
+    return USB_TYPE_OK;
+}
+
+void USBHost::clear() {
+    log_size = 0;
+    td_errors = 0;
+    nb_written = 0;
+    data_left = 0;
+}
+
+void USBHost::checkTD(uint8_t * buf, uint32_t len) {
+    if (len > MOCK_TD_MAX_SIZE - ((uintptr_t)buf & (MOCK_TD_PAGE_SIZE - 1)))
+        td_errors++;
+}
+
+uint8_t * USBHost::writtenBlock(uint32_t block, bool allocate) {
+    for (int i = 0; i < nb_written; i++) {
+        if (written_block[i] == block)
+            return written[i];
+    }
+    if (!allocate || nb_written == MOCK_WRITTEN_BLOCKS)
+        return NULL;
+    written_block[nb_written] = block;
+    return written[nb_written++];
+}
+
+bool USBHost::readBlock(uint32_t block, uint8_t * data) {
+    uint8_t * w = writtenBlock(block, false);
+    for (int i = 0; i < MOCK_DISK_BLOCK_SIZE; i++)
+        data[i] = w ? w[i] : pattern(block, i);
+    return w != NULL;
+}
+
+uint8_t USBHost::readByte(uint32_t offset) {
+    uint32_t block = offset / MOCK_DISK_BLOCK_SIZE;
+    uint8_t * w = writtenBlock(block, false);
+    return w ? w[offset % MOCK_DISK_BLOCK_SIZE] : pattern(block, offset % MOCK_DISK_BLOCK_SIZE);
+}
+
+USB_TYPE USBHost::bulkWrite(USBDeviceConnected * dev, USBEndpoint * ep, uint8_t * buf, uint32_t len, bool blocking) {
+    checkTD(buf, len);
+
+    // data stage of a WRITE10
+    if (data_left) {
+        for (uint32_t i = 0; i < len && data_left; i++, data_left--) {
+            uint32_t offset = data_block * block_size + data_pos;
+            uint8_t * w = writtenBlock(offset / MOCK_DISK_BLOCK_SIZE, true);
+            if (w)
+                w[offset % MOCK_DISK_BLOCK_SIZE] = buf[i];
+            data_pos++;
+        }
+        return USB_TYPE_OK;
+    }
+
+    if (len != sizeof(cbw))
+        return USB_TYPE_ERROR;
+    memcpy(cbw, buf, sizeof(cbw));
+
+    uint8_t * cb = &cbw[15];
+    if ((cb[0] == 0x28) || (cb[0] == 0x2A)) {
+        Command * c = &log[(log_size < MOCK_LOG_SIZE) ? log_size : MOCK_LOG_SIZE - 1];
+        c->op = cb[0];
+        c->block = (cb[2] << 24) | (cb[3] << 16) | (cb[4] << 8) | cb[5];
+        c->count = (cb[7] << 8) | cb[8];
+        if (log_size < MOCK_LOG_SIZE)
+            log_size++;
+        data_block = c->block;
+        data_pos = 0;
+        data_left = c->count * block_size;
+    }
+    return USB_TYPE_OK;
+}
+
+USB_TYPE USBHost::bulkRead(USBDeviceConnected * dev, USBEndpoint * ep, uint8_t * buf, uint32_t len, bool blocking) {
+    checkTD(buf, len);
+
+    // status stage
+    if (len == 13 && !data_left) {
+        uint32_t signature = CSW_SIGNATURE;
+        memset(buf, 0, len);
+        memcpy(buf, &signature, 4);
+        memcpy(&buf[4], &cbw[4], 4);
+        return USB_TYPE_OK;
+    }
+
+    uint8_t * cb = &cbw[15];
+    memset(buf, 0, len);
+    switch (cb[0]) {
+        case 0x25: {
+            // READ CAPACITY: last block and block size
+            uint32_t last = MOCK_DISK_BLOCKS * MOCK_DISK_BLOCK_SIZE / block_size - 1;
+            buf[0] = last >> 24; buf[1] = last >> 16; buf[2] = last >> 8; buf[3] = last;
+            buf[6] = block_size >> 8; buf[7] = block_size & 0xff;
+            break;
+        }
+        case 0x28: {
+            // data stage of a READ10, in one transfer or several
+            for (uint32_t i = 0; i < len && data_left; i++, data_left--)
+                buf[i] = readByte(data_block * block_size + data_pos++);
+            break;
+        }
+        default:
+            break;
+    }
+    return USB_TYPE_OK;
+}
+
+USB_TYPE USBHost::controlRead(USBDeviceConnected * dev, uint8_t requestType, uint8_t request, uint32_t value, uint32_t index, uint8_t * buf, uint32_t len) {
+    memset(buf, 0, len);
+    return USB_TYPE_OK;
+}
+
+USB_TYPE USBHost::controlWrite(USBDeviceConnected * dev, uint8_t requestType, uint8_t request, uint32_t value, uint32_t index, uint8_t * buf, uint32_t len) {
+    return USB_TYPE_OK;
+}
@@ -0,0 +1,113 @@
+/* Stands in for the USB host stack in the USBHostMSD tests: a bulk-only mass
+ * storage device answers the CBWs sent with bulkWrite() and logs the READ10
+ * and WRITE10 commands it receives. */
+#ifndef USBHOST_H
+#define USBHOST_H
+
+#include "USBHostConf.h"
+#include "../../../USBHost/USBHost/USBHostTypes.h"
+#include "rtos.h"
+
+// Blocks of the mock disk and blocks it keeps the written data of
+#define MOCK_DISK_BLOCKS        1024
+#define MOCK_DISK_BLOCK_SIZE    512
+#define MOCK_WRITTEN_BLOCKS     16
+
+// Packets of the full speed bulk endpoints
+#define MOCK_PACKET_SIZE        64
+
+// Largest buffer of an OHCI transfer descriptor and the page it can cross once
+#define MOCK_TD_MAX_SIZE        8192
+#define MOCK_TD_PAGE_SIZE       4096
+
+#define MOCK_LOG_SIZE           64
+
+class USBEndpoint {
+public:
+    USBEndpoint(uint8_t address) : address(address), state(USB_TYPE_IDLE) {}
+    uint8_t getAddress() { return address; }
+    uint32_t getSize() { return MOCK_PACKET_SIZE; }
+    void setState(USB_TYPE st) { state = st; }
+    USB_TYPE getState() { return state; }
+
+private:
+    uint8_t address;
+    USB_TYPE state;
+};
+
+class USBDeviceConnected {
+public:
+    USBDeviceConnected() : bulk_in(0x81), bulk_out(0x02) {}
+    USBEndpoint * getEndpoint(uint8_t intf_nb, ENDPOINT_TYPE type, ENDPOINT_DIRECTION dir, uint8_t index = 0) {
+        return (dir == IN) ? &bulk_in : &bulk_out;
+    }
+    uint16_t getVid() { return 0x0781; }
+    uint16_t getPid() { return 0x5567; }
+    void setName(const char * name, uint8_t intf_nb) {}
+
+private:
+    USBEndpoint bulk_in;
+    USBEndpoint bulk_out;
+};
+
+class IUSBEnumerator {
+public:
+    virtual void setVidPid(uint16_t vid, uint16_t pid) = 0;
+    virtual bool parseInterface(uint8_t intf_nb, uint8_t intf_class, uint8_t intf_subclass, uint8_t intf_protocol) = 0;
+    virtual bool useEndpoint(uint8_t intf_nb, ENDPOINT_TYPE type, ENDPOINT_DIRECTION dir) = 0;
+};
+
+class USBHost {
+public:
+    typedef struct {
+        uint8_t op;
+        uint32_t block;
+        uint16_t count;
+    } Command;
+
+    USBHost() : block_size(MOCK_DISK_BLOCK_SIZE) {}
+
+    static USBHost * getHostInst();
+
+    USBDeviceConnected * getDevice(uint8_t index) { return (index == 0) ? &device : NULL; }
+    USB_TYPE enumerate(USBDeviceConnected * dev, IUSBEnumerator * pEnumerator);
+
+    template<typename T>
+    void registerDriver(USBDeviceConnected * dev, uint8_t intf, T * tptr, void (T::*mptr)(void)) {}
+
+    USB_TYPE bulkRead(USBDeviceConnected * dev, USBEndpoint * ep, uint8_t * buf, uint32_t len, bool blocking = true);
+    USB_TYPE bulkWrite(USBDeviceConnected * dev, USBEndpoint * ep, uint8_t * buf, uint32_t len, bool blocking = true);
+    USB_TYPE controlRead(USBDeviceConnected * dev, uint8_t requestType, uint8_t request, uint32_t value, uint32_t index, uint8_t * buf, uint32_t len);
+    USB_TYPE controlWrite(USBDeviceConnected * dev, uint8_t requestType, uint8_t request, uint32_t value, uint32_t index, uint8_t * buf, uint32_t len);
+
+    // Content of the mock disk, in blocks of MOCK_DISK_BLOCK_SIZE
+    static uint8_t pattern(uint32_t block, uint32_t i) { return (uint8_t)(block * 7 + i * 3 + (i >> 8)); }
+    bool readBlock(uint32_t block, uint8_t * data);
+    uint8_t readByte(uint32_t offset);
+
+    // Forgets the logged commands and the written blocks
+    void clear();
+
+    Command log[MOCK_LOG_SIZE];
+    int log_size;
+    int td_errors;      // transfers a single transfer descriptor can't hold
+
+    // Block size READ CAPACITY reports, the same disk in larger blocks
+    uint32_t block_size;
+
+private:
+    USBDeviceConnected device;
+    uint8_t cbw[31];
+    uint32_t data_left;
+    uint32_t data_block;
+    uint32_t data_pos;
+
+    uint32_t written_block[MOCK_WRITTEN_BLOCKS];
+    uint8_t written[MOCK_WRITTEN_BLOCKS][MOCK_DISK_BLOCK_SIZE];
+    int nb_written;
+
+    void checkTD(uint8_t * buf, uint32_t len);
+    uint8_t * writtenBlock(uint32_t block, bool allocate);
+};
+
+#endif
@@ -0,0 +1,9 @@
+/* Configuration of the mock USB host stack used by the USBHostMSD tests */
+#ifndef USBHOST_CONF_H
+#define USBHOST_CONF_H
+
+#define MAX_DEVICE_CONNECTED        1
+
+#define USBHOST_MSD                 1
+
+#endif
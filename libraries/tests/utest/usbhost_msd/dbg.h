@@ -0,0 +1,10 @@
+/* The USBHostMSD tests run without the USB host stack's debug output */
+#ifndef USB_DEBUG_H
+#define USB_DEBUG_H
+
+#define USB_DBG(x, ...)
+#define USB_WARN(x, ...)
+#define USB_ERR(x, ...)
+#define USB_INFO(x, ...)
+
+#endif
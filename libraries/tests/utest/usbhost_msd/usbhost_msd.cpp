@@ -0,0 +1,252 @@
+/* Checks the SCSI commands USBHostMSD sends for FAT file system accesses,
+ * against the mock USB host stack in this directory. */
+#include "TestHarness.h"
+#include <string.h>
+#include "USBHostMSD.h"
+
+namespace {
+
+const uint32_t BS = MOCK_DISK_BLOCK_SIZE;
+
+class TestMSD : public USBHostMSD {
+public:
+    TestMSD() : USBHostMSD("usbtest") {}
+    int init() { return disk_initialize(); }
+    int read(uint8_t * buf, uint32_t block, uint32_t count) { return disk_read(buf, block, count); }
+    int write(const uint8_t * buf, uint32_t block, uint32_t count) { return disk_write(buf, block, count); }
+};
+
+uint8_t buffer[32 * MOCK_DISK_BLOCK_SIZE];
+
+bool matches_disk(USBHost * host, const uint8_t * data, uint32_t block, uint32_t count)
+{
+    uint8_t expected[MOCK_DISK_BLOCK_SIZE];
+    for (uint32_t n = 0; n < count; n++) {
+        host->readBlock(block + n, expected);
+        if (memcmp(expected, &data[n * BS], BS))
+            return false;
+    }
+    return true;
+}
+
+// Compares data with the disk from a byte offset, whatever the block size
+bool matches_bytes(USBHost * host, const uint8_t * data, uint32_t offset, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        if (data[i] != host->readByte(offset + i))
+            return false;
+    }
+    return true;
+}
+
+// Blocks the first command for a transfer into buf can carry
+uint32_t td_blocks(const uint8_t * buf)
+{
+    return (MOCK_TD_MAX_SIZE - ((uintptr_t)buf & (MOCK_TD_PAGE_SIZE - 1))) / BS;
+}
+
+}
+
+TEST_GROUP(USBHostMSD)
+{
+    USBHost * host;
+    TestMSD * msd;
+
+    void setup()
+    {
+        static TestMSD test_msd;
+        msd = &test_msd;
+        host = USBHost::getHostInst();
+        if (!msd->connected()) {
+            CHECK(msd->connect());
+            LONGS_EQUAL(0, msd->init());
+        }
+        msd->setReadAhead(0);
+        host->clear();
+        msd->resetStats();
+    }
+
+    void teardown()
+    {
+        if (host->block_size != MOCK_DISK_BLOCK_SIZE) {
+            host->block_size = MOCK_DISK_BLOCK_SIZE;
+            LONGS_EQUAL(0, msd->init());
+        }
+    }
+
+    // Reconnects to the disk with another block size
+    void change_block_size(uint32_t size)
+    {
+        host->block_size = size;
+        LONGS_EQUAL(0, msd->init());
+        host->clear();
+    }
+};
+
+TEST(USBHostMSD, multi_block_read_is_one_command)
+{
+    uint8_t * buf = buffer;
+    uint32_t count = td_blocks(buf);
+    LONGS_EQUAL(0, msd->read(buf, 100, count));
+    LONGS_EQUAL(1, host->log_size);
+    LONGS_EQUAL(0x28, host->log[0].op);
+    LONGS_EQUAL(100, host->log[0].block);
+    LONGS_EQUAL(count, host->log[0].count);
+    CHECK(matches_disk(host, buf, 100, count));
+}
+
+TEST(USBHostMSD, reads_are_split_at_transfer_descriptor_limits)
+{
+    uint8_t * buf = buffer + BS;
+    uint32_t first = td_blocks(buf);
+    LONGS_EQUAL(0, msd->read(buf, 10, 22));
+    LONGS_EQUAL(0, host->td_errors);
+    CHECK(host->log_size <= 3);
+    LONGS_EQUAL(10, host->log[0].block);
+    LONGS_EQUAL(first, host->log[0].count);
+    LONGS_EQUAL(10 + first, host->log[1].block);
+    uint32_t total = 0;
+    for (int i = 0; i < host->log_size; i++)
+        total += host->log[i].count;
+    LONGS_EQUAL(22, total);
+    CHECK(matches_disk(host, buf, 10, 22));
+}
+
+TEST(USBHostMSD, multi_block_write)
+{
+    for (uint32_t i = 0; i < 4 * BS; i++)
+        buffer[i] = (uint8_t)(i * 13);
+    LONGS_EQUAL(0, msd->write(buffer, 200, 4));
+    LONGS_EQUAL(1, host->log_size);
+    LONGS_EQUAL(0x2A, host->log[0].op);
+    LONGS_EQUAL(200, host->log[0].block);
+    LONGS_EQUAL(4, host->log[0].count);
+    CHECK(matches_disk(host, buffer, 200, 4));
+}
+
+TEST(USBHostMSD, without_read_ahead_single_blocks_are_single_commands)
+{
+    for (uint32_t b = 0; b < 4; b++)
+        LONGS_EQUAL(0, msd->read(buffer, 300 + b, 1));
+    LONGS_EQUAL(4, host->log_size);
+}
+
+TEST(USBHostMSD, sequential_reads_are_read_ahead)
+{
+    msd->setReadAhead(8);
+
+    // the first read can't tell it is sequential yet
+    LONGS_EQUAL(0, msd->read(buffer, 400, 1));
+    for (uint32_t b = 1; b < 17; b++) {
+        LONGS_EQUAL(0, msd->read(buffer, 400 + b, 1));
+        CHECK(matches_disk(host, buffer, 400 + b, 1));
+    }
+    LONGS_EQUAL(3, host->log_size);
+    LONGS_EQUAL(1, host->log[0].count);
+    LONGS_EQUAL(401, host->log[1].block);
+    LONGS_EQUAL(8, host->log[1].count);
+    LONGS_EQUAL(409, host->log[2].block);
+    LONGS_EQUAL(8, host->log[2].count);
+
+    USBHostMSD::Stats stats;
+    msd->getStats(&stats);
+    LONGS_EQUAL(16, stats.cache_hits);
+    LONGS_EQUAL(3, stats.commands);
+    LONGS_EQUAL(17 * BS, stats.bytes_read);
+}
+
+TEST(USBHostMSD, random_reads_bypass_the_cache)
+{
+    msd->setReadAhead(8);
+    LONGS_EQUAL(0, msd->read(buffer, 500, 1));
+    LONGS_EQUAL(0, msd->read(buffer, 20, 2));
+    LONGS_EQUAL(0, msd->read(buffer, 700, 1));
+    LONGS_EQUAL(3, host->log_size);
+    LONGS_EQUAL(1, host->log[0].count);
+    LONGS_EQUAL(2, host->log[1].count);
+    LONGS_EQUAL(1, host->log[2].count);
+}
+
+TEST(USBHostMSD, writes_update_the_blocks_read_ahead)
+{
+    msd->setReadAhead(8);
+    LONGS_EQUAL(0, msd->read(buffer, 600, 1));
+    LONGS_EQUAL(0, msd->read(buffer, 601, 1));
+
+    uint8_t data[MOCK_DISK_BLOCK_SIZE];
+    memset(data, 0xa5, sizeof(data));
+    LONGS_EQUAL(0, msd->write(data, 603, 1));
+
+    int commands = host->log_size;
+    LONGS_EQUAL(0, msd->read(buffer, 602, 2));
+    LONGS_EQUAL(commands, host->log_size);
+    CHECK(matches_disk(host, buffer, 602, 1));
+    MEMCMP_EQUAL(data, buffer + BS, BS);
+}
+
+TEST(USBHostMSD, large_reads_go_straight_to_the_caller)
+{
+    msd->setReadAhead(4);
+    LONGS_EQUAL(0, msd->read(buffer, 800, 1));
+    LONGS_EQUAL(0, msd->read(buffer, 801, 8));
+    LONGS_EQUAL(2, host->log_size);
+    LONGS_EQUAL(8, host->log[1].count);
+    CHECK(matches_disk(host, buffer, 801, 8));
+}
+
+TEST(USBHostMSD, stats)
+{
+    LONGS_EQUAL(0, msd->read(buffer, 0, 4));
+    LONGS_EQUAL(0, msd->write(buffer, 900, 2));
+
+    USBHostMSD::Stats stats;
+    msd->getStats(&stats);
+    LONGS_EQUAL(2, stats.commands);
+    LONGS_EQUAL(4 * BS, stats.bytes_read);
+    LONGS_EQUAL(2 * BS, stats.bytes_written);
+    CHECK(stats.max_latency_us <= stats.read_time_us + stats.write_time_us);
+}
+
+TEST(USBHostMSD, cache_follows_the_block_size)
+{
+    // read ahead 4 blocks of 512 bytes, then 4 blocks of 4 KB
+    msd->setReadAhead(4);
+    LONGS_EQUAL(0, msd->read(buffer, 900, 1));
+    LONGS_EQUAL(0, msd->read(buffer, 901, 1));
+    change_block_size(4096);
+
+    LONGS_EQUAL(0, msd->read(buffer, 20, 1));
+    LONGS_EQUAL(0, msd->read(buffer, 21, 1));
+    int commands = host->log_size;
+    LONGS_EQUAL(0, msd->read(buffer + 4096, 22, 3));
+    LONGS_EQUAL(commands, host->log_size);
+    LONGS_EQUAL(21, host->log[1].block);
+    uint32_t total = 0;
+    for (int i = 1; i < host->log_size; i++)
+        total += host->log[i].count;
+    LONGS_EQUAL(4, total);
+    LONGS_EQUAL(0, host->td_errors);
+    CHECK(matches_bytes(host, buffer, 21 * 4096, 4096));
+    CHECK(matches_bytes(host, buffer + 4096, 22 * 4096, 3 * 4096));
+}
+
+TEST(USBHostMSD, blocks_larger_than_a_transfer_descriptor)
+{
+    // a block of 8 KB fits a transfer descriptor from the start of a page only
+    change_block_size(8192);
+    uint8_t * buf = buffer + (MOCK_TD_PAGE_SIZE - ((uintptr_t)buffer & (MOCK_TD_PAGE_SIZE - 1))) % MOCK_TD_PAGE_SIZE + 64;
+
+    LONGS_EQUAL(0, msd->read(buf, 3, 1));
+    LONGS_EQUAL(1, host->log_size);
+    LONGS_EQUAL(1, host->log[0].count);
+    LONGS_EQUAL(0, host->td_errors);
+    CHECK(matches_bytes(host, buf, 3 * 8192, 8192));
+
+    for (uint32_t i = 0; i < 8192; i++)
+        buf[i] = (uint8_t)(i * 11);
+    LONGS_EQUAL(0, msd->write(buf, 5, 1));
+    LONGS_EQUAL(2, host->log_size);
+    LONGS_EQUAL(0x2A, host->log[1].op);
+    LONGS_EQUAL(0, host->td_errors);
+    CHECK(matches_bytes(host, buf, 5 * 8192, 8192));
+}
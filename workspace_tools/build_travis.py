@@ -174,7 +174,17 @@ def run_test_testsuite(dry_run):
         if os.system(cmdline) != 0:
             sys.exit(1)
 
+def run_pinmap_check(dry_run):
+    """ Checks the PinMap indexes of the targets against the linear lookup
+    """
+    cmdline = "python workspace_tools/pinmap_index.py --check"
+    print "Executing: " + cmdline
+    if not dry_run:
+        if os.system(cmdline) != 0:
+            sys.exit(1)
+
 if __name__ == "__main__":
+    run_pinmap_check("-s" in sys.argv)
     run_builds("-s" in sys.argv)
     run_test_linking("-s" in sys.argv)
     run_test_testsuite("-s" in sys.argv)
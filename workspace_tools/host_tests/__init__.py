@@ -25,7 +25,7 @@ from hello_auto import HelloTest
 from detect_auto import DetectPlatformTest
 from default_auto import DefaultAuto
 from dev_null_auto import DevNullTest
-from wait_us_auto import WaitusTest
+from wait_us_auto import WaitBenchmarkTest
 from tcpecho_server_auto import TCPEchoServerTest
 from udpecho_server_auto import UDPEchoServerTest
 from tcpecho_client_auto import TCPEchoClientTest
@@ -33,6 +33,10 @@ from udpecho_client_auto import UDPEchoClientTest
 from wfi_auto import WFITest
 from serial_nc_rx_auto import SerialNCRXTest
 from serial_nc_tx_auto import SerialNCTXTest
+from https_resume_auto import HTTPSResumeTest
+from https_pool_auto import HTTPSPoolTest
+from usb_msd_replay_auto import USBMSDReplayTest
+from usb_serial_throughput_auto import USBSerialThroughputTest
 
 # Populate registry with supervising objects
 HOSTREGISTRY = HostRegistry()
@@ -43,7 +47,7 @@ HOSTREGISTRY.register_host_test("hello_auto", HelloTest())
 HOSTREGISTRY.register_host_test("stdio_auto", StdioTest())
 HOSTREGISTRY.register_host_test("detect_auto", DetectPlatformTest())
 HOSTREGISTRY.register_host_test("default_auto", DefaultAuto())
-HOSTREGISTRY.register_host_test("wait_us_auto", WaitusTest())
+HOSTREGISTRY.register_host_test("wait_us_auto", WaitBenchmarkTest())
 HOSTREGISTRY.register_host_test("dev_null_auto", DevNullTest())
 HOSTREGISTRY.register_host_test("tcpecho_server_auto", TCPEchoServerTest())
 HOSTREGISTRY.register_host_test("udpecho_server_auto", UDPEchoServerTest())
@@ -52,6 +56,10 @@ HOSTREGISTRY.register_host_test("udpecho_client_auto", UDPEchoClientTest())
 HOSTREGISTRY.register_host_test("wfi_auto", WFITest())
 HOSTREGISTRY.register_host_test("serial_nc_rx_auto", SerialNCRXTest())
 HOSTREGISTRY.register_host_test("serial_nc_tx_auto", SerialNCTXTest())
+HOSTREGISTRY.register_host_test("https_resume_auto", HTTPSResumeTest())
+HOSTREGISTRY.register_host_test("https_pool_auto", HTTPSPoolTest())
+HOSTREGISTRY.register_host_test("usb_msd_replay_auto", USBMSDReplayTest())
+HOSTREGISTRY.register_host_test("usb_serial_throughput_auto", USBSerialThroughputTest())
 
 ###############################################################################
 # Functional interface for test supervisor registry
@@ -0,0 +1,119 @@
+"""
+mbed SDK
+Copyright (c) 2011-2015 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import os
+import ssl
+import socket
+import shutil
+import tempfile
+import threading
+import subprocess
+
+
+def body(length):
+    """ The body served for 'GET /<length>', the target checks every byte
+    """
+    return "".join(chr((i * 7 + 3) & 0xFF) for i in range(length))
+
+
+class HTTPSPoolTest():
+    """ Serves 'GET /<length>' over TLS on keep-alive connections, one thread
+        per connection, so that the target can hold several sessions open and
+        interleave their requests and reads.
+    """
+    SERVER_PORT = 4434
+    # axTLS only speaks TLS 1.0/1.1 with RSA key exchange
+    SERVER_CIPHERS = "AES128-SHA:AES256-SHA:RC4-SHA:@SECLEVEL=0"
+
+    def make_context(self, workdir):
+        key = os.path.join(workdir, "key.pem")
+        cert = os.path.join(workdir, "cert.pem")
+        subprocess.check_call(["openssl", "req", "-x509", "-newkey", "rsa:1024", "-nodes",
+                               "-subj", "/CN=mbed", "-days", "1",
+                               "-keyout", key, "-out", cert],
+                              stdout=open(os.devnull, "w"), stderr=subprocess.STDOUT)
+        # the ciphers go first, their security level lets the 1024 bit key load
+        context = ssl.SSLContext(ssl.PROTOCOL_SSLv23)
+        context.set_ciphers(self.SERVER_CIPHERS)
+        context.load_cert_chain(cert, key)
+        return context
+
+    def serve(self, conn, context):
+        try:
+            s = context.wrap_socket(conn, server_side=True)
+            f = s.makefile("rb")
+            while True:
+                line = f.readline()
+                if not line:
+                    break
+                length = int(line.split()[1][1:])
+                while f.readline() not in ("\r\n", ""):
+                    pass
+                s.sendall("HTTP/1.1 200 OK\r\nContent-Length: %d\r\n\r\n" % length + body(length))
+        except (ssl.SSLError, socket.error, ValueError, IndexError):
+            pass
+        finally:
+            conn.close()
+
+    def accept(self, listener, context):
+        while True:
+            try:
+                conn, _ = listener.accept()
+            except socket.error:
+                break
+            t = threading.Thread(target=self.serve, args=(conn, context))
+            t.daemon = True
+            t.start()
+
+    def test(self, selftest):
+        workdir = tempfile.mkdtemp()
+        listener = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        try:
+            try:
+                context = self.make_context(workdir)
+            except (OSError, subprocess.CalledProcessError, ssl.SSLError), e:
+                selftest.notify("HOST: Unable to set up the TLS server: %s" % e)
+                return selftest.RESULT_ERROR
+            listener.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+            listener.bind(("", self.SERVER_PORT))
+            listener.listen(8)
+            t = threading.Thread(target=self.accept, args=(listener, context))
+            t.daemon = True
+            t.start()
+            selftest.notify("HOST: Serving HTTPS on port %d" % self.SERVER_PORT)
+
+            c = selftest.mbed.serial_readline() # 'HTTPSClient waiting for server IP and port...'
+            if c is None:
+                return selftest.RESULT_IO_SERIAL
+            selftest.notify(c.strip())
+
+            server_ip = str(socket.gethostbyname(socket.getfqdn()))
+            connection_str = server_ip + ":" + str(self.SERVER_PORT) + "\n"
+            selftest.mbed.serial_write(connection_str)
+            selftest.notify("HOST: Server address sent: " + connection_str.strip())
+
+            while True:
+                c = selftest.mbed.serial_readline()
+                if c is None:
+                    return selftest.RESULT_IO_SERIAL
+                selftest.notify(c.strip())
+                if "{{success}}" in c or "{{failure}}" in c:
+                    break
+            return selftest.RESULT_SUCCESS if "{{success}}" in c else selftest.RESULT_FAILURE
+        finally:
+            listener.close()
+            shutil.rmtree(workdir, ignore_errors=True)
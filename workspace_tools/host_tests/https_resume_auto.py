@@ -0,0 +1,96 @@
+"""
+mbed SDK
+Copyright (c) 2011-2015 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import re
+import os
+import socket
+import shutil
+import tempfile
+import subprocess
+
+
+class HTTPSResumeTest():
+    """ Runs a local 'openssl s_server' as a stand-in HTTPS server, sends its
+        address to the target and reports the handshake times measured by the
+        target for full and resumed TLS handshakes.
+    """
+    SERVER_PORT = 4433
+    # axTLS only speaks TLS 1.0/1.1 with RSA key exchange
+    SERVER_CIPHERS = "AES128-SHA:AES256-SHA:RC4-SHA:@SECLEVEL=0"
+
+    PATTERN_HANDSHAKE = "MBED: (full|resumed) handshake (\d+) ms"
+    re_handshake = re.compile(PATTERN_HANDSHAKE)
+
+    def start_server(self, selftest, workdir):
+        key = os.path.join(workdir, "key.pem")
+        cert = os.path.join(workdir, "cert.pem")
+        # 1024 bit key keeps the target's modexp in the same range as typical servers
+        subprocess.check_call(["openssl", "req", "-x509", "-newkey", "rsa:1024", "-nodes",
+                               "-subj", "/CN=mbed", "-days", "1",
+                               "-keyout", key, "-out", cert],
+                              stdout=open(os.devnull, "w"), stderr=subprocess.STDOUT)
+        selftest.notify("HOST: Starting openssl s_server on port %d" % self.SERVER_PORT)
+        return subprocess.Popen(["openssl", "s_server", "-www", "-no_ticket",
+                                 "-accept", str(self.SERVER_PORT),
+                                 "-cert", cert, "-key", key,
+                                 "-cipher", self.SERVER_CIPHERS],
+                                stdout=open(os.devnull, "w"), stderr=subprocess.STDOUT)
+
+    def test(self, selftest):
+        workdir = tempfile.mkdtemp()
+        server = None
+        try:
+            try:
+                server = self.start_server(selftest, workdir)
+            except (OSError, subprocess.CalledProcessError), e:
+                selftest.notify("HOST: Unable to start openssl s_server: %s" % e)
+                return selftest.RESULT_ERROR
+
+            c = selftest.mbed.serial_readline() # 'HTTPSClient waiting for server IP and port...'
+            if c is None:
+                return selftest.RESULT_IO_SERIAL
+            selftest.notify(c.strip())
+
+            server_ip = str(socket.gethostbyname(socket.getfqdn()))
+            connection_str = server_ip + ":" + str(self.SERVER_PORT) + "\n"
+            selftest.mbed.serial_write(connection_str)
+            selftest.notify("HOST: Server address sent: " + connection_str.strip())
+
+            times = {"full": [], "resumed": []}
+            while True:
+                c = selftest.mbed.serial_readline()
+                if c is None:
+                    return selftest.RESULT_IO_SERIAL
+                selftest.notify(c.strip())
+
+                m = self.re_handshake.search(c)
+                if m:
+                    times[m.group(1)].append(int(m.group(2)))
+                if "{{success}}" in c or "{{failure}}" in c:
+                    break
+
+            for kind in ["full", "resumed"]:
+                if times[kind]:
+                    selftest.notify("HOST: %s handshake: min %d ms, avg %d ms, max %d ms (%d runs)" %
+                                    (kind, min(times[kind]), sum(times[kind]) / len(times[kind]),
+                                     max(times[kind]), len(times[kind])))
+            result = "{{success}}" in c and len(times["resumed"]) > 0
+            return selftest.RESULT_SUCCESS if result else selftest.RESULT_FAILURE
+        finally:
+            if server is not None:
+                server.terminate()
+            shutil.rmtree(workdir, ignore_errors=True)
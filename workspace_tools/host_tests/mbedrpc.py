@@ -26,8 +26,13 @@
 # >myled = DigitalOut(mbed,"myled") <--- Where the text in quotations matches your RPC pin definition's second parameter, in this case it could be RpcDigitalOut myled(LED1,"myled");
 # >myled.write(1)
 # >
+#
+# The pipelined transports talk to an RPCSerial or RPCSocket on the mbed and
+# keep several calls in flight:
+# >mbed = TCPRPC("10.2.200.30", 5000)
+# >values = mbed.batch([("myled", "write", ["1"]), ("myvar", "read", [])])
 
-import serial, urllib2, time
+import serial, urllib2, time, socket
 
 # mbed super class
 class mbed:
@@ -56,6 +61,95 @@ class SerialRPC(mbed):
         return ret_val
 
 
+# Pipelined transports, for RPCPipe on the mbed: requests carry an id and
+# are sent without waiting for the replies of the previous ones
+class PipelinedRPC(mbed):
+    def __init__(self, window):
+        # requests in flight, limited by the receive buffer on the mbed
+        self.window = window
+        self.next_id = 0
+        self.received = ""
+
+    def _write(self, data):
+        raise NotImplementedError
+
+    # some bytes, or "" after a timeout
+    def _read(self):
+        raise NotImplementedError
+
+    def _readline(self):
+        while "\n" not in self.received:
+            data = self._read()
+            if not data:
+                raise IOError("RPC reply timeout")
+            self.received += data
+        line, self.received = self.received.split("\n", 1)
+        return line
+
+    def rpc(self, name, method, args):
+        return self.batch([(name, method, args)])[0]
+
+    # Calls each (name, method, args) and returns their replies in order,
+    # None for the calls that failed
+    def batch(self, calls):
+        results = [None] * len(calls)
+        pending = {}
+        sent = 0
+        done = 0
+        while done < len(calls):
+            requests = []
+            while sent < len(calls) and sent - done < self.window:
+                name, method, args = calls[sent]
+                id = "%x" % self.next_id
+                self.next_id = (self.next_id + 1) & 0xffff
+                pending[id] = sent
+                requests.append(id + " /" + name + "/" + method + " " + " ".join(args) + "\n")
+                sent += 1
+            # all the requests the window allows go in one write
+            if requests:
+                self._write("".join(requests))
+
+            line = self._readline().strip("\r")
+            if " " in line:
+                id, value = line.split(" ", 1)
+            else:
+                id, value = line.rstrip("!"), None
+            if id in pending:
+                results[pending.pop(id)] = value
+                done += 1
+        return results
+
+
+class SerialPipeRPC(PipelinedRPC):
+    def __init__(self, port, baud, window=8, timeout=1):
+        PipelinedRPC.__init__(self, window)
+        self.ser = serial.Serial(port, baud, timeout=timeout)
+
+    def _write(self, data):
+        self.ser.write(data)
+
+    def _read(self):
+        return self.ser.read(max(1, self.ser.inWaiting()))
+
+
+class TCPRPC(PipelinedRPC):
+    def __init__(self, host, port, window=32, timeout=1):
+        PipelinedRPC.__init__(self, window)
+        self.sock = socket.create_connection((host, port), timeout)
+
+    def _write(self, data):
+        self.sock.sendall(data)
+
+    def _read(self):
+        try:
+            return self.sock.recv(4096)
+        except socket.timeout:
+            return ""
+
+    def close(self):
+        self.sock.close()
+
+
 class HTTPRPC(mbed):
     def __init__(self, ip):
         self.host = "http://" + ip
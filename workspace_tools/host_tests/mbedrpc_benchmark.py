@@ -0,0 +1,106 @@
+"""
+mbed SDK
+Copyright (c) 2011-2015 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import sys
+import time
+import socket
+import threading
+from optparse import OptionParser
+
+from mbedrpc import TCPRPC
+
+
+class SimulatedTarget(threading.Thread):
+    """ Answers the RPCPipe protocol on a local TCP port for a few RPCVariables,
+        calling the requests of each chunk received and replying to them in
+        one write after latency seconds, as the link to a real target would.
+    """
+    def __init__(self, latency):
+        threading.Thread.__init__(self)
+        self.daemon = True
+        self.latency = latency
+        self.variables = {}
+        self.server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        self.server.bind(("127.0.0.1", 0))
+        self.server.listen(1)
+        self.port = self.server.getsockname()[1]
+
+    def call(self, request):
+        parts = request.split(" ")
+        path = parts[0].split("/")
+        if len(path) != 3:
+            return None
+        name, method = path[1], path[2]
+        if method == "write":
+            self.variables[name] = parts[1]
+            return ""
+        if method == "read" and name in self.variables:
+            return self.variables[name]
+        return None
+
+    def serve(self, conn):
+        received = ""
+        while True:
+            data = conn.recv(4096)
+            if not data:
+                return
+            received += data
+            lines = received.split("\n")
+            received = lines.pop()
+            replies = []
+            for line in lines:
+                id, request = line.split(" ", 1)
+                value = self.call(request.strip())
+                replies.append(id + "!\n" if value is None else id + " " + value + "\n")
+            time.sleep(self.latency)
+            conn.sendall("".join(replies))
+
+    def run(self):
+        while True:
+            conn, addr = self.server.accept()
+            self.serve(conn)
+            conn.close()
+
+
+def calls_per_second(port, window, calls):
+    mbed = TCPRPC("127.0.0.1", port, window=window)
+    requests = [("v%d" % (i % 8), "write", [str(i)]) for i in range(calls)]
+    start = time.time()
+    results = mbed.batch(requests)
+    elapsed = time.time() - start
+    mbed.close()
+    if results != [""] * calls:
+        raise Exception("Wrong replies")
+    return calls / elapsed
+
+
+if __name__ == '__main__':
+    parser = OptionParser(usage="%prog [options]",
+                          description="RPC calls per second, one at a time and pipelined, against a simulated target")
+    parser.add_option("-l", "--latency", type="float", default=0.001, help="Round trip time of the link in seconds")
+    parser.add_option("-n", "--calls", type="int", default=2000, help="Number of calls")
+    parser.add_option("-w", "--window", type="int", default=32, help="Pipelined requests in flight")
+    (options, args) = parser.parse_args()
+
+    target = SimulatedTarget(options.latency)
+    target.start()
+
+    one = calls_per_second(target.port, 1, options.calls)
+    pipelined = calls_per_second(target.port, options.window, options.calls)
+    print("One at a time: %d calls/s" % one)
+    print("Pipelined (%d in flight): %d calls/s" % (options.window, pipelined))
+    sys.exit(0 if pipelined > one else 1)
@@ -138,6 +138,12 @@ class UDPEchoServerTest(DefaultTest):
         self.notify("HOST: Mbed Summary:")
         mbed_stats = self.get_control_data()
         self.notify(mbed_stats)
+
+        # Datagrams/sec benchmark: sendTo() vs. sendToBatch() (copy and zero-copy)
+        self.notify("...")
+        self.notify("HOST: Mbed UDP send benchmark (datagrams/sec):")
+        bench_stats = self.get_control_data("bench\n")
+        self.notify(bench_stats)
         return self.RESULT_SUCCESS if result else self.RESULT_FAILURE
 
 
@@ -0,0 +1,209 @@
+"""
+mbed SDK
+Copyright (c) 2011-2015 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import re
+import time
+import random
+import struct
+
+
+class USBMSDReplayTest():
+    """ Talks bulk-only transport to the target's RAM disk with pyusb and
+        replays a sequence of SCSI commands: single and multi-block WRITE10
+        and READ10, sequential reads that hit the read ahead, VERIFY10 and a
+        read past the last block. Reports the host side throughput and the
+        counters kept by the target.
+    """
+    VENDOR_ID = 0x0703
+    PRODUCT_ID = 0x0105
+    BLOCK_SIZE = 512
+    TIMEOUT = 2000 # ms
+
+    CBW_SIGNATURE = 0x43425355
+    CSW_SIGNATURE = 0x53425355
+
+    TEST_UNIT_READY = 0x00
+    INQUIRY = 0x12
+    READ_CAPACITY = 0x25
+    READ10 = 0x28
+    WRITE10 = 0x2A
+    VERIFY10 = 0x2F
+
+    PATTERN_STATS = "MBED: stats read (\d+) written (\d+) disk_reads (\d+) disk_writes (\d+) " \
+                    "blocks_read (\d+) blocks_written (\d+) hits (\d+) stalls (\d+)"
+    re_stats = re.compile(PATTERN_STATS)
+
+    def open_device(self, selftest):
+        import usb.core
+        import usb.util
+        dev = None
+        for i in range(10):
+            dev = usb.core.find(idVendor=self.VENDOR_ID, idProduct=self.PRODUCT_ID)
+            if dev is not None:
+                break
+            time.sleep(1)
+        if dev is None:
+            return None
+        # The OS mass storage driver must let go of the interface
+        if dev.is_kernel_driver_active(0):
+            dev.detach_kernel_driver(0)
+        dev.set_configuration()
+        intf = dev.get_active_configuration()[(0, 0)]
+        self.ep_out = usb.util.find_descriptor(intf, custom_match=lambda e:
+            usb.util.endpoint_direction(e.bEndpointAddress) == usb.util.ENDPOINT_OUT)
+        self.ep_in = usb.util.find_descriptor(intf, custom_match=lambda e:
+            usb.util.endpoint_direction(e.bEndpointAddress) == usb.util.ENDPOINT_IN)
+        self.dev = dev
+        self.tag = 0
+        return dev
+
+    def command(self, cb, data_in=0, data_out=None):
+        """ Runs one bulk-only transaction, returns (CSW status, data read) """
+        import usb.core
+        self.tag += 1
+        length = data_in if data_out is None else len(data_out)
+        flags = 0x80 if data_in else 0x00
+        cb = cb + [0] * (16 - len(cb))
+        cbw = struct.pack("<IIIBBB16B", self.CBW_SIGNATURE, self.tag, length, flags, 0, 10, *cb)
+        self.ep_out.write(cbw, self.TIMEOUT)
+
+        data = ""
+        try:
+            if data_out is not None:
+                self.ep_out.write(data_out, self.TIMEOUT)
+            elif data_in:
+                data = self.ep_in.read(data_in, self.TIMEOUT).tostring()
+        except usb.core.USBError:
+            # The device stalls the data stage of a command it refuses
+            self.dev.clear_halt(self.ep_in if data_in else self.ep_out)
+
+        csw = self.ep_in.read(13, self.TIMEOUT).tostring()
+        signature, tag, residue, status = struct.unpack("<IIIB", csw)
+        if signature != self.CSW_SIGNATURE or tag != self.tag:
+            raise ValueError("bad CSW")
+        return status, data
+
+    def rw10(self, op, lba, count, data_out=None):
+        cb = [op, 0x02 if op == self.VERIFY10 else 0x00,
+              (lba >> 24) & 0xff, (lba >> 16) & 0xff, (lba >> 8) & 0xff, lba & 0xff,
+              0, (count >> 8) & 0xff, count & 0xff]
+        data_in = count * self.BLOCK_SIZE if op == self.READ10 else 0
+        return self.command(cb, data_in, data_out)
+
+    def replay(self, selftest):
+        """ Returns True if every command gave the expected status and data """
+        status, data = self.command([self.TEST_UNIT_READY])
+        if status != 0:
+            return False
+        status, data = self.command([self.INQUIRY, 0, 0, 0, 36], 36)
+        if status != 0 or data[8:16] != "MBED.ORG":
+            return False
+        status, data = self.command([self.READ_CAPACITY], 8)
+        last_block, block_size = struct.unpack(">II", data)
+        blocks = last_block + 1
+        selftest.notify("HOST: %d blocks of %d bytes" % (blocks, block_size))
+        if status != 0 or block_size != self.BLOCK_SIZE:
+            return False
+
+        # The whole disk in one command, then one block at a time
+        disk = "".join(chr(random.randint(0, 255)) for i in range(blocks * self.BLOCK_SIZE))
+        if self.rw10(self.WRITE10, 0, blocks, disk)[0] != 0:
+            return False
+        status, data = self.rw10(self.READ10, 0, blocks)
+        if status != 0 or data != disk:
+            selftest.notify("HOST: multi-block read back mismatch")
+            return False
+        for lba in range(blocks):
+            status, data = self.rw10(self.READ10, lba, 1)
+            if status != 0 or data != disk[lba * self.BLOCK_SIZE:(lba + 1) * self.BLOCK_SIZE]:
+                selftest.notify("HOST: single block read mismatch at %d" % lba)
+                return False
+
+        # Random writes and reads, checked against a copy of the disk
+        for i in range(200):
+            count = random.randint(1, min(blocks, 8))
+            lba = random.randint(0, blocks - count)
+            start, end = lba * self.BLOCK_SIZE, (lba + count) * self.BLOCK_SIZE
+            if random.randint(0, 1):
+                data_out = "".join(chr(random.randint(0, 255)) for j in range(end - start))
+                if self.rw10(self.WRITE10, lba, count, data_out)[0] != 0:
+                    return False
+                disk = disk[:start] + data_out + disk[end:]
+            else:
+                status, data = self.rw10(self.READ10, lba, count)
+                if status != 0 or data != disk[start:end]:
+                    selftest.notify("HOST: read mismatch at %d (%d blocks)" % (lba, count))
+                    return False
+
+        # VERIFY10 passes on matching data only
+        if self.rw10(self.VERIFY10, 0, 2, disk[:2 * self.BLOCK_SIZE])[0] != 0:
+            return False
+        wrong = chr(ord(disk[0]) ^ 0xff) + disk[1:2 * self.BLOCK_SIZE]
+        if self.rw10(self.VERIFY10, 0, 2, wrong)[0] == 0:
+            return False
+
+        # A read past the last block has to fail
+        if self.rw10(self.READ10, blocks - 1, 2)[0] == 0:
+            return False
+        return True
+
+    def throughput(self, selftest):
+        blocks = 8
+        loops = 64
+        data_out = "\x5a" * (blocks * self.BLOCK_SIZE)
+        start = time.time()
+        for i in range(loops):
+            self.rw10(self.WRITE10, 0, blocks, data_out)
+        write_time = time.time() - start
+        start = time.time()
+        for i in range(loops):
+            self.rw10(self.READ10, 0, blocks)
+        read_time = time.time() - start
+        size = loops * blocks * self.BLOCK_SIZE / 1024.0
+        selftest.notify("HOST: write %.1f KB/s, read %.1f KB/s" % (size / write_time, size / read_time))
+
+    def test(self, selftest):
+        c = selftest.mbed.serial_readline() # 'MBED: USB MSD ready'
+        if c is None:
+            return selftest.RESULT_IO_SERIAL
+        selftest.notify(c.strip())
+
+        try:
+            if self.open_device(selftest) is None:
+                selftest.notify("HOST: USB MSD %04x:%04x not found" % (self.VENDOR_ID, self.PRODUCT_ID))
+                return selftest.RESULT_ERROR
+        except ImportError:
+            selftest.notify("HOST: pyusb is required by this test")
+            return selftest.RESULT_ERROR
+
+        result = self.replay(selftest)
+        if result:
+            self.throughput(selftest)
+
+        selftest.mbed.serial_write("s")
+        c = selftest.mbed.serial_readline()
+        if c is None:
+            return selftest.RESULT_IO_SERIAL
+        selftest.notify(c.strip())
+        m = self.re_stats.search(c)
+        if m:
+            disk_reads, blocks_read, hits = int(m.group(3)), int(m.group(5)), int(m.group(7))
+            # multi-block commands have to be served with multi-block disk accesses
+            selftest.notify("HOST: %.1f blocks per disk_read, %d read ahead hits" %
+                            (float(blocks_read) / max(disk_reads, 1), hits))
+            result = result and blocks_read > disk_reads
+        return selftest.RESULT_SUCCESS if result else selftest.RESULT_FAILURE
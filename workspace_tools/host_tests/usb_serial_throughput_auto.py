@@ -0,0 +1,123 @@
+"""
+mbed SDK
+Copyright (c) 2011-2015 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+"""
+
+import time
+import random
+import struct
+import threading
+
+
+class USBSerialThroughputTest():
+    """ Opens the target's USB virtual serial port, has it stream a known
+        pattern and echo random data back, and checks every byte. Lengths
+        that are a multiple of the packet size only complete when the target
+        ends them with a zero length packet, and the echo is sent faster than
+        the target reads it, so the host gets held off instead of losing data.
+    """
+    VENDOR_ID = 0x1f00
+    PRODUCT_ID = 0x2012
+    PACKET_SIZE = 64
+    TIMEOUT = 5 # s
+
+    def find_port(self):
+        from serial.tools import list_ports
+        for i in range(10):
+            for port in list_ports.comports():
+                if getattr(port, "vid", None) == self.VENDOR_ID and getattr(port, "pid", None) == self.PRODUCT_ID:
+                    return port.device
+            time.sleep(1)
+        return None
+
+    def command(self, cmd, length):
+        self.port.write(cmd + struct.pack("<I", length))
+
+    def read_exactly(self, length):
+        data = ""
+        deadline = time.time() + self.TIMEOUT
+        while len(data) < length and time.time() < deadline:
+            data += self.port.read(length - len(data))
+        return data
+
+    def stream(self, selftest, length):
+        self.command("S", length)
+        data = self.read_exactly(length)
+        expected = "".join(chr((i * 7 + 3) & 0xff) for i in range(length))
+        if data != expected:
+            selftest.notify("HOST: stream of %d bytes: got %d, %s" %
+                            (length, len(data), "match" if expected.startswith(data) else "corrupted"))
+            return False
+        return True
+
+    def echo(self, selftest, length):
+        data_out = "".join(chr(random.randint(0, 255)) for i in range(length))
+        result = {}
+
+        # Sending all of it before reading would fill both directions and stall,
+        # the echo is read back from a second thread
+        def reader():
+            result["data"] = self.read_exactly(length)
+        thread = threading.Thread(target=reader)
+        thread.start()
+        self.command("E", length)
+        self.port.write(data_out)
+        thread.join()
+        if result["data"] != data_out:
+            selftest.notify("HOST: echo of %d bytes: got %d bytes back, %s" %
+                            (length, len(result["data"]), "in order" if data_out.startswith(result["data"]) else "corrupted"))
+            return False
+        return True
+
+    def throughput(self, selftest):
+        length = 256 * 1024
+        start = time.time()
+        result = self.stream(selftest, length)
+        tx_time = time.time() - start
+        length_echo = 64 * 1024
+        start = time.time()
+        result = result and self.echo(selftest, length_echo)
+        echo_time = time.time() - start
+        if result:
+            selftest.notify("HOST: target to host %.1f KB/s, echo %.1f KB/s" %
+                            (length / 1024.0 / tx_time, length_echo / 1024.0 / echo_time))
+        return result
+
+    def test(self, selftest):
+        c = selftest.mbed.serial_readline() # 'MBED: USB serial ready'
+        if c is None:
+            return selftest.RESULT_IO_SERIAL
+        selftest.notify(c.strip())
+
+        try:
+            import serial
+            name = self.find_port()
+            if name is None:
+                selftest.notify("HOST: USB serial %04x:%04x not found" % (self.VENDOR_ID, self.PRODUCT_ID))
+                return selftest.RESULT_ERROR
+            self.port = serial.Serial(name, timeout=0.5)
+        except ImportError:
+            selftest.notify("HOST: pyserial is required by this test")
+            return selftest.RESULT_ERROR
+
+        result = True
+        lengths = [1, self.PACKET_SIZE - 1, self.PACKET_SIZE, self.PACKET_SIZE + 1,
+                   2 * self.PACKET_SIZE, 1000, 4096] + [random.randint(1, 5000) for i in range(20)]
+        for length in lengths:
+            result = result and self.stream(selftest, length) and self.echo(selftest, length)
+        result = result and self.throughput(selftest)
+
+        self.port.close()
+        return selftest.RESULT_SUCCESS if result else selftest.RESULT_FAILURE
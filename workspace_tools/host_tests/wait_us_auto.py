@@ -17,13 +17,35 @@ limitations under the License.
 
 from time import time
 
-class WaitusTest():
-    """ This test is reading single characters from stdio
-        and measures time between their occurrences.
+class WaitBenchmarkTest():
+    """ Benchmark of the wait functions. The target first reports the
+        accuracy and the CPU availability of waits it measured itself
+        ({{measure;wait_<us>_error_us;<value>}} and
+        {{measure;wait_<us>_cpu_pct;<value>}}), then prints a single
+        character every second, whose timing is measured by the host.
     """
     TICK_LOOP_COUNTER = 13
     TICK_LOOP_SUCCESSFUL_COUNTS = 10
     DEVIATION = 0.10    # +/-10%
+    ERROR_US = 20       # plus 1% of the wait
+    CPU_PCT = 75        # left to other threads by waits of 10 ms and more
+
+    def check_measure(self, line):
+        """ Checks a measurement reported by the target, None if it isn't one
+        """
+        fields = line.strip().strip('{}').split(';')
+        if len(fields) != 3 or fields[0] != 'measure':
+            return None
+        name, value = fields[1], float(fields[2])
+        parts = name.split('_')
+        if len(parts) < 3 or parts[0] != 'wait' or not parts[1].isdigit():
+            return True
+        us = int(parts[1])
+        if name.endswith('_error_us'):
+            return abs(value) <= self.ERROR_US + us / 100
+        if name.endswith('_cpu_pct'):
+            return us < 10000 or value >= self.CPU_PCT
+        return True
 
     def test(self, selftest):
         test_result = True
@@ -40,6 +62,20 @@ class WaitusTest():
             c = selftest.mbed.serial_read(1) # Re-read first 'tick'
             if c is None:
                 return selftest.RESULT_IO_SERIAL
+        # Measurements come before the ticks, one per line
+        measures_ok = True
+        while c in ('{', '\r', '\n'):
+            if c == '{':
+                line = selftest.mbed.serial_readline()
+                if line is None:
+                    return selftest.RESULT_IO_SERIAL
+                result = self.check_measure(c + line)
+                if result is not None:
+                    measures_ok = measures_ok and result
+                    selftest.notify("%s [%s]" % ((c + line).strip(), "OK" if result else "FAIL"))
+            c = selftest.mbed.serial_read(1)
+            if c is None:
+                return selftest.RESULT_IO_SERIAL
         start_serial_pool = time()
         start = time()
 
@@ -65,5 +101,5 @@ class WaitusTest():
         measurement_time = time() - start_serial_pool
         selftest.notify("Consecutive OK timer reads: %d"% success_counter)
         selftest.notify("Completed in %.2f sec" % (measurement_time))
-        test_result = True if success_counter >= self.TICK_LOOP_SUCCESSFUL_COUNTS else False
+        test_result = True if success_counter >= self.TICK_LOOP_SUCCESSFUL_COUNTS and measures_ok else False
         return selftest.RESULT_SUCCESS if test_result else selftest.RESULT_FAILURE
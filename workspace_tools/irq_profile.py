@@ -0,0 +1,109 @@
+"""
+mbed SDK
+Copyright (c) 2011-2015 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Shows the interrupt handler and critical section times printed by
+irq_profile_dump() on the target, from its serial port or a saved log:
+
+    python workspace_tools/irq_profile.py -s COM5 -b 9600
+    python workspace_tools/irq_profile.py -f log.txt
+"""
+import re
+import sys
+from optparse import OptionParser
+
+LINE = re.compile(r"\{\{(irq_profile|irq|critical|irq_profile_end)(?:;([^}]*))?\}\}")
+
+
+class Profile:
+    def __init__(self):
+        self.frequency = 1000000
+        self.irqs = {}
+        self.sites = {}
+
+    def add(self, table, key, count, max, mean):
+        # the same site can come from several copies of inlined code
+        if key in table:
+            c, m, total = table[key]
+            table[key] = (c + count, m if m > max else max, total + mean * count)
+        else:
+            table[key] = (count, max, mean * count)
+
+    def parse_line(self, line):
+        """ Adds a line of the dump, returns False at its end
+        """
+        match = LINE.search(line)
+        if match is None:
+            return True
+        kind, fields = match.group(1), (match.group(2) or "").split(";")
+        if kind == "irq_profile_end":
+            return False
+        if kind == "irq_profile":
+            self.frequency = int(fields[0])
+        elif kind == "irq":
+            self.add(self.irqs, int(fields[0]), *map(int, fields[1:4]))
+        elif kind == "critical":
+            self.add(self.sites, fields[0], *map(int, fields[1:4]))
+        return True
+
+    def us(self, counts):
+        return counts * 1000000.0 / self.frequency
+
+    def table(self, title, entries):
+        rows = []
+        for key, (count, max, total) in entries.items():
+            rows.append((self.us(max), self.us(float(total) / count) if count else 0, count, key))
+        rows.sort(reverse=True)
+        lines = ["%-40s %10s %10s %10s" % (title, "max us", "mean us", "count")]
+        for max, mean, count, key in rows:
+            lines.append("%-40s %10.1f %10.1f %10d" % (key, max, mean, count))
+        return "\n".join(lines)
+
+    def report(self):
+        return self.table("IRQ", self.irqs) + "\n\n" + self.table("Critical section", self.sites)
+
+
+def read_serial(port, baud):
+    # Import pyserial: https://pypi.python.org/pypi/pyserial
+    from serial import Serial
+    serial = Serial(port, baud, timeout=None)
+    try:
+        while True:
+            yield serial.readline()
+    finally:
+        serial.close()
+
+
+if __name__ == '__main__':
+    parser = OptionParser(usage="%prog [options]",
+                          description="Interrupt handler and critical section times from irq_profile_dump()")
+    parser.add_option("-s", "--serial", dest="serial", default=None, help="The mbed serial port")
+    parser.add_option("-b", "--baud", dest="baud", type="int", default=9600, help="The mbed serial baud rate")
+    parser.add_option("-f", "--file", dest="file", default=None, help="A log holding the dump")
+    (options, args) = parser.parse_args()
+
+    if options.file:
+        lines = open(options.file)
+    elif options.serial:
+        lines = read_serial(options.serial, options.baud)
+    else:
+        parser.print_help()
+        sys.exit(1)
+
+    profile = Profile()
+    for line in lines:
+        if not profile.parse_line(line):
+            break
+    print(profile.report())
@@ -75,7 +75,7 @@ LIBRARIES = [
     # File system libraries
     {
         "id": "fat",
-        "source_dir": [FAT_FS, SD_FS],
+        "source_dir": [FAT_FS, SD_FS, FLASH_FS],
         "build_dir": FS_LIBRARY,
         "dependencies": [MBED_LIBRARIES]
     },
@@ -61,6 +61,7 @@ NET = join(LIB_DIR, "net")
 
 ETH_SOURCES = join(NET, "eth")
 LWIP_SOURCES = join(NET, "lwip")
+HTTPS_SOURCES = join(NET, "https")
 VODAFONE_SOURCES = join(NET, "VodafoneUSBModem")
 CELLULAR_SOURCES = join(NET, "cellular", "CellularModem")
 CELLULAR_USB_SOURCES = join(NET, "cellular", "CellularUSBModem")
@@ -75,6 +76,7 @@ UBLOX_LIBRARY = join(NET_LIBRARIES, "UbloxUSBModem")
 FS_PATH = join(LIB_DIR, "fs")
 FAT_FS = join(FS_PATH, "fat")
 SD_FS = join(FS_PATH, "sd")
+FLASH_FS = join(FS_PATH, "flash")
 FS_LIBRARY = join(BUILD_DIR, "fat")
 
 # DSP
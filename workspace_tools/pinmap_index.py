@@ -0,0 +1,260 @@
+"""
+mbed SDK
+Copyright (c) 2011-2015 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+Appends to the PeripheralPins.c of each target, for each of its PinMap
+arrays, a table giving the entry of a pin directly from its PinName, which
+pinmap_common.c uses instead of scanning the array.
+
+    python workspace_tools/pinmap_index.py              # all the targets
+    python workspace_tools/pinmap_index.py DISCO_F469NI
+    python workspace_tools/pinmap_index.py --check      # check them against the linear lookup
+
+The arrays whose pins don't fit a table of MAX_SPAN PinNames, and the
+targets whose pins or arrays depend on the preprocessor, are left to the
+linear lookup.
+"""
+import re
+import sys
+from os import walk
+from os.path import join, abspath, dirname, exists, basename, relpath
+from optparse import OptionParser
+
+ROOT = abspath(join(dirname(__file__), ".."))
+HAL = join(ROOT, "libraries", "mbed", "targets", "hal")
+
+# A table costs a byte for each PinName from the first to the last pin of its array
+MAX_SPAN = 256
+
+MARKER = "/* PinMap indexes, generated by workspace_tools/pinmap_index.py: run it\n" \
+         " * again after changing the arrays above. */\n"
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", " ", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def evaluate(expr, names):
+    """ The value of a constant expression of PinNames.h, None if it can't be told
+    """
+    expr = re.sub(r"\b(0[xX][0-9a-fA-F]+|\d+)[uUlL]*\b", lambda m: str(int(m.group(1), 0)), expr)
+    expr = re.sub(r"\(\s*(?:int|uint32_t|unsigned(?:\s+int)?|PinName)\s*\)", "", expr)
+    if not re.match(r"^[\w\s()<>|&+\-*~^]*$", expr):
+        return None
+    try:
+        return eval(expr, {"__builtins__": {}}, names)
+    except Exception:
+        return None
+
+
+def pin_values(text):
+    """ The values of the PinName enum of a PinNames.h, None if they can't be told
+    """
+    text = strip_comments(text)
+    names = {}
+    for match in re.finditer(r"^\s*#\s*define\s+(\w+)\s+(.+)$", text, re.M):
+        value = evaluate(match.group(2), names)
+        if value is not None:
+            names[match.group(1)] = value
+    for match in re.finditer(r"typedef\s+enum\s*\w*\s*\{([^}]*)\}\s*(\w+)\s*;", text):
+        body = match.group(1)
+        if "#" in body:
+            # which enumerators are in depends on the build
+            if match.group(2) == "PinName":
+                return None
+            continue
+        values = {}
+        next = 0
+        for item in body.split(","):
+            item = item.strip()
+            if not item:
+                continue
+            if "=" in item:
+                name, expr = [s.strip() for s in item.split("=", 1)]
+                value = evaluate(expr, dict(names, **values))
+                if value is None:
+                    if match.group(2) == "PinName":
+                        return None
+                    break
+            else:
+                name, value = item, next
+            values[name] = value
+            next = value + 1
+        if match.group(2) == "PinName":
+            return values
+        names.update(values)
+    return None
+
+
+def pin_maps(text):
+    """ The pins of the entries of each PinMap array of a PeripheralPins.c
+    """
+    text = strip_comments(text)
+    maps = []
+    for match in re.finditer(r"const\s+PinMap\s+(\w+)\s*\[\s*\]\s*=\s*\{(.*?)\}\s*;", text, re.S):
+        # the first field of each {pin, peripheral, function}, to the NC ending the array
+        pins = [entry.group(1) for entry in re.finditer(r"\{\s*([^,{}]+?)\s*,", match.group(2))]
+        maps.append((match.group(1), pins))
+    return maps
+
+
+def find_pin_names(directory):
+    while directory.startswith(HAL) and directory != HAL:
+        path = join(directory, "PinNames.h")
+        if exists(path):
+            return path
+        directory = dirname(directory)
+    return None
+
+
+class Target:
+    def __init__(self, directory):
+        self.name = basename(directory).replace("TARGET_", "")
+        self.path = join(directory, "PeripheralPins.c")
+        self.original = open(self.path, "rb").read()
+        self.newline = "\r\n" if "\r\n" in self.original else "\n"
+        text = self.original.replace(self.newline, "\n")
+        marker = text.find(MARKER)
+        if marker < 0:
+            self.text, self.generated = text, ""
+        else:
+            self.text, self.generated = text[:marker].rstrip("\n") + "\n", text[marker:]
+        self.maps = pin_maps(self.text)
+        path = find_pin_names(directory)
+        self.values = pin_values(open(path).read()) if path else None
+        if re.search(r"^\s*#\s*if", strip_comments(self.text), re.M):
+            # which arrays are built depends on the build
+            self.values = None
+
+    def indexes(self):
+        """ (array, first PinName, entry + 1 of each PinName from the first) of
+            the arrays that can be indexed
+        """
+        result = []
+        if self.values is None:
+            return result
+        for name, pins in self.maps:
+            if not pins or pins[-1] != "NC" or len(pins) > 255:
+                continue
+            values = [self.values.get(pin) for pin in pins[:-1]]
+            if not values or None in values or min(values) < 0 or max(values) - min(values) >= MAX_SPAN:
+                continue
+            first = min(values)
+            table = [0] * (max(values) - first + 1)
+            for i in reversed(range(len(values))):
+                # the first entry of a pin wins, as in the linear lookup
+                table[values[i] - first] = i + 1
+            result.append((name, first, table))
+        return result
+
+    def linear(self, name, value):
+        """ The entry + 1 that scanning an array finds for a PinName, as
+            pinmap_common.c did, 0 if there's none
+        """
+        for n, pins in self.maps:
+            if n == name:
+                for i, pin in enumerate(pins):
+                    if pin == "NC":
+                        return 0
+                    if self.values.get(pin) == value:
+                        return i + 1
+        return 0
+
+    def source(self):
+        """ PeripheralPins.c with the indexes, with Unix line endings
+        """
+        indexes = self.indexes()
+        if not indexes:
+            return self.text
+        lines = [self.text, MARKER.rstrip("\n")]
+        for name, first, table in indexes:
+            lines.append("static const uint8_t %s_index[%d] = {" % (name, len(table)))
+            for i in range(0, len(table), 16):
+                lines.append("    " + " ".join("%d," % v for v in table[i:i + 16]))
+            lines.append("};")
+            lines.append("")
+        lines.append("static const PinMapIndex PinMap_index[] = {")
+        for name, first, table in indexes:
+            lines.append("    {%s, %s_index, %d, %d}," % (name, name, first, len(table)))
+        lines.append("    {0, 0, 0, 0}")
+        lines.append("};")
+        lines.append("")
+        lines.append("const PinMapIndex *pinmap_index(void) {")
+        lines.append("    return PinMap_index;")
+        lines.append("}")
+        lines.append("")
+        return "\n".join(lines)
+
+    def tables(self, text):
+        """ The (first PinName, table) of each array indexed by a source
+        """
+        tables = {}
+        for match in re.finditer(r"\{(\w+), \w+_index, (\d+), (\d+)\}", text):
+            body = re.search(r"%s_index\[\d+\] = \{([^}]*)\}" % match.group(1), text).group(1)
+            tables[match.group(1)] = (int(match.group(2)), [int(v) for v in body.replace(",", " ").split()])
+        return tables
+
+
+def targets(names):
+    found = []
+    for directory, dirs, files in walk(HAL):
+        if "PeripheralPins.c" in files:
+            target = Target(directory)
+            if not names or target.name in names:
+                found.append(target)
+    return sorted(found, key=lambda t: t.path)
+
+
+def check(target):
+    """ Compares the tables in PeripheralPins.c with the linear lookup over
+        every PinName, returns the errors
+    """
+    errors = []
+    tables = target.tables(target.generated)
+    if tables != target.tables(target.source()):
+        errors.append("The indexes of %s are out of date" % relpath(target.path, ROOT))
+    values = sorted(set(target.values.values())) if target.values else []
+    for name, (first, table) in sorted(tables.items()):
+        for value in values + [-1]:
+            i = value - first
+            indexed = table[i] if 0 <= i < len(table) else 0
+            linear = target.linear(name, value)
+            if indexed != linear:
+                errors.append("%s %s: PinName %d gives entry %d, not %d" %
+                              (target.name, name, value, indexed - 1, linear - 1))
+    return errors
+
+
+if __name__ == '__main__':
+    parser = OptionParser(usage="%prog [options] [TARGET...]",
+                          description="Direct index tables of the PinMap arrays of the targets")
+    parser.add_option("-c", "--check", action="store_true", default=False,
+                      help="Check the tables against the linear lookup instead of writing them")
+    (options, args) = parser.parse_args()
+
+    errors = []
+    for target in targets(args):
+        if options.check:
+            errors += check(target)
+            continue
+        source = target.source().replace("\n", target.newline)
+        if source != target.original:
+            open(target.path, "wb").write(source)
+        print("%s: %d of %d arrays indexed" % (target.name, len(target.indexes()), len(target.maps)))
+
+    for error in errors:
+        print(error)
+    sys.exit(1 if errors else 0)
@@ -293,6 +293,20 @@ TESTS = [
         "peripherals": ["can_transceiver"],
         "mcu": ["LPC1549", "LPC1768","B96B_F446VE"],
     },
+    {
+        "id": "MBED_A28", "description": "AnalogIn and PwmOut background transfers",
+        "source_dir": join(TEST_DIR, "mbed", "analog_async"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB],
+        "automated": True,
+        "duration": 20,
+    },
+    {
+        "id": "MBED_A29", "description": "Wait accuracy",
+        "source_dir": join(TEST_DIR, "mbed", "wait"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB],
+        "automated": True,
+        "duration": 20,
+    },
     {
         "id": "MBED_BLINKY", "description": "Blinky",
         "source_dir": join(TEST_DIR, "mbed", "blinky"),
@@ -367,6 +381,13 @@ TESTS = [
         "duration": 15,
         "peripherals": ["SD"]
     },
+    {
+        "id": "PERF_4", "description": "RAM disk buffered FileHandle R/W Speed",
+        "source_dir": join(TEST_DIR, "mbed", "ram_perf_buffered"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB, FS_LIBRARY],
+        "automated": True,
+        "duration": 20,
+    },
 
 
     # Not automated MBED tests
@@ -781,6 +802,15 @@ TESTS = [
                 "KL05Z", "K64F", "KL46Z", "RZ_A1H",
                 "DISCO_F407VG", "DISCO_F429ZI", "NUCLEO_F411RE", "NUCLEO_F401RE", "NUCLEO_F410RB", "DISCO_F469NI"],
     },
+    {
+        "id": "RTOS_10", "description": "Wait CPU availability",
+        "source_dir": join(TEST_DIR, "rtos", "mbed", "wait"),
+        "dependencies": [MBED_LIBRARIES, RTOS_LIBRARIES, TEST_MBED_LIB],
+        "duration": 25,
+        "automated": True,
+        "mcu": ["LPC1768", "LPC1549", "LPC11U24", "KL25Z", "K64F", "KL46Z",
+                "DISCO_F407VG", "DISCO_F429ZI", "NUCLEO_F411RE", "NUCLEO_F401RE", "NUCLEO_F446RE", "B96B_F446VE"],
+    },
 
     # Networking Tests
     {
@@ -888,6 +918,31 @@ TESTS = [
         "host_test": "udp_link_layer_auto",
         "peripherals": ["ethernet"],
     },
+    {
+        "id": "NET_15", "description": "lwIP socket call latency",
+        "source_dir": join(TEST_DIR, "net", "benchmark", "call_latency"),
+        "dependencies": [MBED_LIBRARIES, RTOS_LIBRARIES, ETH_LIBRARY],
+        "duration": 20,
+        "peripherals": ["ethernet"],
+    },
+    {
+        "id": "NET_16", "description": "HTTPS client session resumption",
+        "source_dir": join(TEST_DIR, "net", "protocols", "HTTPSClient_Resume"),
+        "dependencies": [MBED_LIBRARIES, RTOS_LIBRARIES, ETH_LIBRARY, HTTPS_SOURCES, TEST_MBED_LIB],
+        "automated": True,
+        "duration": 120,
+        "host_test": "https_resume_auto",
+        "peripherals": ["ethernet"],
+    },
+    {
+        "id": "NET_17", "description": "HTTPS sessions sharing the record buffer pool",
+        "source_dir": join(TEST_DIR, "net", "protocols", "HTTPSClient_Pool"),
+        "dependencies": [MBED_LIBRARIES, RTOS_LIBRARIES, ETH_LIBRARY, HTTPS_SOURCES, TEST_MBED_LIB],
+        "automated": True,
+        "duration": 120,
+        "host_test": "https_pool_auto",
+        "peripherals": ["ethernet"],
+    },
 
     # u-blox tests
     {
@@ -940,6 +995,20 @@ TESTS = [
         "source_dir": join(TEST_DIR, "usb", "device", "audio"),
         "dependencies": [MBED_LIBRARIES, USB_LIBRARIES],
     },
+    {
+        "id": "USB_8", "description": "Mass storage SCSI replay",
+        "source_dir": join(TEST_DIR, "usb", "device", "msd"),
+        "dependencies": [MBED_LIBRARIES, USB_LIBRARIES, TEST_MBED_LIB],
+        "automated": True,
+        "host_test": "usb_msd_replay_auto",
+    },
+    {
+        "id": "USB_9", "description": "Serial Port throughput",
+        "source_dir": join(TEST_DIR, "usb", "device", "serial_throughput"),
+        "dependencies": [MBED_LIBRARIES, USB_LIBRARIES, TEST_MBED_LIB],
+        "automated": True,
+        "host_test": "usb_serial_throughput_auto",
+    },
 
     # CMSIS DSP
     {
@@ -1064,6 +1133,78 @@ TESTS = [
         "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB, CPPUTEST_LIBRARY],
         "automated": False,
     },
+    {
+        "id": "UT_BIGINT_MONT", "description": "axTLS fixed-size Montgomery engine",
+        "source_dir": join(TEST_DIR, "utest", "bigint_mont"),
+        "dependencies": [MBED_LIBRARIES, RTOS_LIBRARIES, ETH_LIBRARY, HTTPS_SOURCES, TEST_MBED_LIB, CPPUTEST_LIBRARY],
+        "automated": False,
+    },
+    {
+        "id": "UT_AES", "description": "axTLS AES, AES-CTR and AES-GCM",
+        "source_dir": join(TEST_DIR, "utest", "aes"),
+        "dependencies": [MBED_LIBRARIES, RTOS_LIBRARIES, ETH_LIBRARY, HTTPS_SOURCES, TEST_MBED_LIB, CPPUTEST_LIBRARY],
+        "automated": False,
+    },
+    {
+        "id": "UT_HTTP_PARSER", "description": "HTTP response parser",
+        "source_dir": join(TEST_DIR, "utest", "http_parser"),
+        "dependencies": [MBED_LIBRARIES, RTOS_LIBRARIES, ETH_LIBRARY, HTTPS_SOURCES, TEST_MBED_LIB, CPPUTEST_LIBRARY],
+        "automated": False,
+    },
+    {
+        "id": "UT_USBHOST_MSD", "description": "USBHostMSD SCSI commands against a mock host stack",
+        "source_dir": [join(TEST_DIR, "utest", "usbhost_msd"), join(USB_HOST, "USBHostMSD")],
+        "dependencies": [MBED_LIBRARIES, RTOS_LIBRARIES, FS_LIBRARY, TEST_MBED_LIB, CPPUTEST_LIBRARY],
+        "automated": False,
+    },
+    {
+        "id": "UT_USBAUDIO", "description": "USBAudio streaming against a host with a drifting clock",
+        "source_dir": [join(TEST_DIR, "utest", "usbaudio"), join(USB, "USBAudio")],
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB, CPPUTEST_LIBRARY],
+        "automated": False,
+    },
+    {
+        "id": "UT_RPC", "description": "RPC lookups, binary and pipelined calls, calls per second",
+        "source_dir": join(TEST_DIR, "utest", "rpc"),
+        "dependencies": [MBED_LIBRARIES, join(LIB_DIR, "rpc"), TEST_MBED_LIB, CPPUTEST_LIBRARY],
+        "automated": False,
+    },
+    {
+        "id": "UT_TICKER", "description": "Ticker 64-bit time and slack with a simulated ticker, interrupts saved",
+        "source_dir": join(TEST_DIR, "utest", "ticker"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB, CPPUTEST_LIBRARY],
+        "automated": False,
+    },
+    {
+        "id": "UT_SERIAL_RING", "description": "Continuous serial reception ring with a simulated UART",
+        "source_dir": join(TEST_DIR, "utest", "serial_ring"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB, CPPUTEST_LIBRARY],
+        "automated": False,
+    },
+    {
+        "id": "UT_IRQ_PROFILE", "description": "Interrupt and critical section profiler",
+        "source_dir": join(TEST_DIR, "utest", "irq_profile"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB, CPPUTEST_LIBRARY],
+        "automated": False,
+    },
+    {
+        "id": "UT_FILE_TABLE", "description": "FileBase lookups and file descriptors, lookups and opens per second",
+        "source_dir": join(TEST_DIR, "utest", "file_table"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB, CPPUTEST_LIBRARY],
+        "automated": False,
+    },
+    {
+        "id": "UT_BUFFERED_FILE", "description": "BufferedFileHandle against a file without a buffer, random operations",
+        "source_dir": join(TEST_DIR, "utest", "buffered_file"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB, CPPUTEST_LIBRARY],
+        "automated": False,
+    },
+    {
+        "id": "UT_FLASH_FTL", "description": "Flash translation layer on a simulated NOR, power loss and wear",
+        "source_dir": join(TEST_DIR, "utest", "flash_ftl"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB, FS_LIBRARY, CPPUTEST_LIBRARY],
+        "automated": False,
+    },
 
     # Tests used for target information purposes
     {